@@ -62,19 +62,21 @@ namespace Splines {
   Akima_build(
     real_type const X[],
     real_type const Y[],
+    integer         incY,
     real_type       Yp[],
+    integer         incYp,
     integer         npts
   ) {
 
     if ( npts == 2 ) { // solo 2 punti, niente da fare
-      Yp[0] = Yp[1] = (Y[1]-Y[0])/(X[1]-X[0]);
+      Yp[0] = Yp[incYp] = (Y[incY]-Y[0])/(X[1]-X[0]);
     } else {
       std::vector<real_type> m;
       m.resize( size_t(npts+3) );
 
       // calcolo slopes (npts-1) intervals + 4
       for ( size_t i = 1; i < size_t(npts); ++i )
-        m[i+1] = (Y[i]-Y[i-1])/(X[i]-X[i-1]);
+        m[i+1] = (Y[i*incY]-Y[(i-1)*incY])/(X[i]-X[i-1]);
 
       // extra slope at the boundary
       m[1] = 2*m[2]-m[3];
@@ -93,12 +95,24 @@ namespace Splines {
       // 0  1  2  3  4---- n-1 n n+1 n+2
       //       +  +  +      +  +
       for ( size_t i = 0; i < size_t(npts); ++i )
-        Yp[i] = akima_one( epsi, m[i], m[i+1], m[i+2], m[i+3] );
+        Yp[i*incYp] = akima_one( epsi, m[i], m[i+1], m[i+2], m[i+3] );
     }
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  Akima_build(
+    real_type const X[],
+    real_type const Y[],
+    real_type       Yp[],
+    integer         npts
+  ) {
+    Akima_build( X, Y, 1, Yp, 1, npts );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   AkimaSpline::build() {
     SPLINE_ASSERT(
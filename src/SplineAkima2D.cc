@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 #include <cmath>
 #include <iomanip>
 /**
@@ -291,100 +292,102 @@ namespace Splines {
     std::fill(DY.begin(),DY.end(),0);
     std::fill(DXY.begin(),DXY.end(),0);
     
-    real_type x_loc[9], y_loc[9], z_loc[9][9];
-
-    for ( size_t i0 = 0; i0 < nx; ++i0 ) {
-      size_t imin = 4  > i0   ? 4-i0      : 0;
-      size_t imax = nx < 5+i0 ? 3+(nx-i0) : 8;
-
-      for ( size_t i = imin; i <= imax; ++i ) x_loc[i] = X[i+i0-4]-X[i0];
-
-      for ( size_t j0 = 0; j0 < ny; ++j0 ) {
-        size_t jmin = 4 > j0    ? 4-j0      : 0;
-        size_t jmax = ny < 5+j0 ? 3+(ny-j0) : 8;
-
-        for ( size_t j = jmin; j <= jmax; ++j ) y_loc[j] = Y[j+j0-4]-Y[j0];
-
-        for ( size_t i = imin; i <= imax; ++i )
-          for ( size_t j = jmin; j <= jmax; ++j )
-            z_loc[i][j] = Z[size_t(ipos_C(integer(i+i0-4),
-                                          integer(j+j0-4),
-                                          integer(ny)))];
-
-        // if not enough points, extrapolate
-        size_t iadd = 0, jadd = 0;
-        if ( imax < 3+imin ) {
-          x_loc[imin-1] = 2*x_loc[imin] - x_loc[imax];
-          x_loc[imax+1] = 2*x_loc[imax] - x_loc[imin];
-          iadd = 1;
-          if ( imax == 1+imin ) {
-            real_type x0 = x_loc[imin];
-            real_type x1 = x_loc[imax];
-            for ( size_t j = jmin; j <= jmax; ++j ) {
-              real_type z0 = z_loc[imin][j];
-              real_type z1 = z_loc[imax][j];
-              z_loc[imin-1][j] = Extrapolate2( x0-x1, x_loc[imin-1]-x1, z1, z0 );
-              z_loc[imax+1][j] = Extrapolate2( x1-x0, x_loc[imax+1]-x0, z0, z1 );
-            }
-          } else {
-            real_type x0 = x_loc[imin];
-            real_type x1 = x_loc[imin+1];
-            real_type x2 = x_loc[imax];
-            for ( size_t j = jmin; j <= jmax; ++j ) {
-              real_type z0 = z_loc[imin][j];
-              real_type z1 = z_loc[imin+1][j];
-              real_type z2 = z_loc[imax][j];
-              z_loc[imin-1][j] = Extrapolate3( x1-x2, x0-x2, x_loc[imin-1]-x1, z2, z1, z0 );
-              z_loc[imax+1][j] = Extrapolate3( x1-x0, x2-x0, x_loc[imax+1]-x0, z0, z1, z2 );
+    // each block of rows has its own local stencil
+    parallel_chunks( nx, this->_build_threads, [this,nx,ny]( size_t i0a, size_t i0b ) {
+      real_type x_loc[9], y_loc[9], z_loc[9][9];
+
+      for ( size_t i0 = i0a; i0 < i0b; ++i0 ) {
+        size_t imin = 4  > i0   ? 4-i0      : 0;
+        size_t imax = nx < 5+i0 ? 3+(nx-i0) : 8;
+
+        for ( size_t i = imin; i <= imax; ++i ) x_loc[i] = X[i+i0-4]-X[i0];
+
+        for ( size_t j0 = 0; j0 < ny; ++j0 ) {
+          size_t jmin = 4 > j0    ? 4-j0      : 0;
+          size_t jmax = ny < 5+j0 ? 3+(ny-j0) : 8;
+
+          for ( size_t j = jmin; j <= jmax; ++j ) y_loc[j] = Y[j+j0-4]-Y[j0];
+
+          for ( size_t i = imin; i <= imax; ++i )
+            for ( size_t j = jmin; j <= jmax; ++j )
+              z_loc[i][j] = Z[size_t(ipos_C(integer(i+i0-4),
+                                            integer(j+j0-4),
+                                            integer(ny)))];
+
+          // if not enough points, extrapolate
+          size_t iadd = 0, jadd = 0;
+          if ( imax < 3+imin ) {
+            x_loc[imin-1] = 2*x_loc[imin] - x_loc[imax];
+            x_loc[imax+1] = 2*x_loc[imax] - x_loc[imin];
+            iadd = 1;
+            if ( imax == 1+imin ) {
+              real_type x0 = x_loc[imin];
+              real_type x1 = x_loc[imax];
+              for ( size_t j = jmin; j <= jmax; ++j ) {
+                real_type z0 = z_loc[imin][j];
+                real_type z1 = z_loc[imax][j];
+                z_loc[imin-1][j] = Extrapolate2( x0-x1, x_loc[imin-1]-x1, z1, z0 );
+                z_loc[imax+1][j] = Extrapolate2( x1-x0, x_loc[imax+1]-x0, z0, z1 );
+              }
+            } else {
+              real_type x0 = x_loc[imin];
+              real_type x1 = x_loc[imin+1];
+              real_type x2 = x_loc[imax];
+              for ( size_t j = jmin; j <= jmax; ++j ) {
+                real_type z0 = z_loc[imin][j];
+                real_type z1 = z_loc[imin+1][j];
+                real_type z2 = z_loc[imax][j];
+                z_loc[imin-1][j] = Extrapolate3( x1-x2, x0-x2, x_loc[imin-1]-x1, z2, z1, z0 );
+                z_loc[imax+1][j] = Extrapolate3( x1-x0, x2-x0, x_loc[imax+1]-x0, z0, z1, z2 );
+              }
             }
           }
-        }
-        if ( jmax < 3+jmin ) {
-          y_loc[jmin-1] = 2*y_loc[jmin] - y_loc[jmax];
-          y_loc[jmax+1] = 2*y_loc[jmax] - y_loc[jmin];
-          jadd = 1;
-          if ( jmax-jmin == 1 ) {
-            real_type y0 = y_loc[jmin];
-            real_type y1 = y_loc[jmax];
-            for ( size_t i = imin-iadd; i <= imax+iadd; ++i ) {
-              real_type z0 = z_loc[i][jmin];
-              real_type z1 = z_loc[i][jmax];
-              z_loc[i][jmin-1] = Extrapolate2( y0-y1, y_loc[jmin-1]-y1, z1, z0 );
-              z_loc[i][jmax+1] = Extrapolate2( y1-y0, y_loc[jmax+1]-y0, z0, z1 );
-            }
-          } else {
-            real_type y0 = y_loc[jmin];
-            real_type y1 = y_loc[jmin+1];
-            real_type y2 = y_loc[jmax];
-            for ( size_t i = imin-iadd; i <= imax+iadd; ++i ) {
-              real_type z0 = z_loc[i][jmin];
-              real_type z1 = z_loc[i][jmin+1];
-              real_type z2 = z_loc[i][jmax];
-              z_loc[i][imin-1] = Extrapolate3( y1-y2, y0-y2, y_loc[jmin-1]-y1, z2, z1, z0 );
-              z_loc[i][imax+1] = Extrapolate3( y1-y0, y2-y0, y_loc[jmax+1]-y0, z0, z1, z2 );
+          if ( jmax < 3+jmin ) {
+            y_loc[jmin-1] = 2*y_loc[jmin] - y_loc[jmax];
+            y_loc[jmax+1] = 2*y_loc[jmax] - y_loc[jmin];
+            jadd = 1;
+            if ( jmax-jmin == 1 ) {
+              real_type y0 = y_loc[jmin];
+              real_type y1 = y_loc[jmax];
+              for ( size_t i = imin-iadd; i <= imax+iadd; ++i ) {
+                real_type z0 = z_loc[i][jmin];
+                real_type z1 = z_loc[i][jmax];
+                z_loc[i][jmin-1] = Extrapolate2( y0-y1, y_loc[jmin-1]-y1, z1, z0 );
+                z_loc[i][jmax+1] = Extrapolate2( y1-y0, y_loc[jmax+1]-y0, z0, z1 );
+              }
+            } else {
+              real_type y0 = y_loc[jmin];
+              real_type y1 = y_loc[jmin+1];
+              real_type y2 = y_loc[jmax];
+              for ( size_t i = imin-iadd; i <= imax+iadd; ++i ) {
+                real_type z0 = z_loc[i][jmin];
+                real_type z1 = z_loc[i][jmin+1];
+                real_type z2 = z_loc[i][jmax];
+                z_loc[i][imin-1] = Extrapolate3( y1-y2, y0-y2, y_loc[jmin-1]-y1, z2, z1, z0 );
+                z_loc[i][imax+1] = Extrapolate3( y1-y0, y2-y0, y_loc[jmax+1]-y0, z0, z1, z2 );
+              }
             }
           }
-        }
 
-        size_t i0j0 = size_t(ipos_C(integer(i0),integer(j0)));
+          size_t i0j0 = size_t(ipos_C(integer(i0),integer(j0)));
 
-        AkimaSmooth( x_loc, integer(imin-iadd), integer(imax+iadd),
-                     y_loc, integer(jmin-jadd), integer(jmax+jadd),
-                     z_loc, DX[i0j0], DY[i0j0], DXY[i0j0] );
+          AkimaSmooth( x_loc, integer(imin-iadd), integer(imax+iadd),
+                       y_loc, integer(jmin-jadd), integer(jmax+jadd),
+                       z_loc, DX[i0j0], DY[i0j0], DXY[i0j0] );
+        }
       }
-    }
+    } );
   }
 
   void
   Akima2Dspline::writeToStream( ostream_type & s ) const {
-    integer ny = integer(Y.size());
     s << "Nx = " << X.size() << " Ny = " << Y.size() << '\n';
     for ( integer i = 1; i < integer(X.size()); ++i ) {
       for ( integer j = 1; j < integer(Y.size()); ++j ) {
-        size_t i00 = size_t( ipos_C(i-1,j-1,ny) );
-        size_t i10 = size_t( ipos_C(i,j-1,ny) );
-        size_t i01 = size_t( ipos_C(i-1,j,ny) );
-        size_t i11 = size_t( ipos_C(i,j,ny) );
+        size_t i00 = size_t( ipos_C(i-1,j-1) );
+        size_t i10 = size_t( ipos_C(i,j-1) );
+        size_t i01 = size_t( ipos_C(i-1,j) );
+        size_t i11 = size_t( ipos_C(i,j) );
         s << "patch (" << i << "," << j
           << ")\n DX = " << setw(10) << left << X[size_t(i)]-X[size_t(i-1)]
           <<    " DY = " << setw(10) << left << Y[size_t(j)]-Y[size_t(j-1)]
@@ -38,7 +38,9 @@ namespace Splines {
   Bessel_build(
     real_type const X[],
     real_type const Y[],
+    integer         incY,
     real_type       Yp[],
+    integer         incYp,
     integer         npts
   ) {
 
@@ -47,27 +49,39 @@ namespace Splines {
 
     // calcolo slopes
     for ( size_t i = 0; i < n; ++i )
-      m[i] = (Y[i+1]-Y[i])/(X[i+1]-X[i]);
+      m[i] = (Y[(i+1)*incY]-Y[i*incY])/(X[i+1]-X[i]);
 
     if ( npts == 2 ) { // caso speciale 2 soli punti
 
-      Yp[0] = Yp[1] = m[0];
+      Yp[0] = Yp[incYp] = m[0];
 
     } else {
 
       for ( size_t i = 1; i < n; ++i ) {
         real_type DL = X[i]   - X[i-1];
         real_type DR = X[i+1] - X[i];
-        Yp[i] = (DR*m[i-1]+DL*m[i])/((DL+DR));
+        Yp[i*incYp] = (DR*m[i-1]+DL*m[i])/((DL+DR));
       }
 
       Yp[0] = 1.5*m[0]-0.5*m[1];
-      Yp[n] = 1.5*m[n-1]-0.5*m[n-2];
+      Yp[n*incYp] = 1.5*m[n-1]-0.5*m[n-2];
     }
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  Bessel_build(
+    real_type const X[],
+    real_type const Y[],
+    real_type       Yp[],
+    integer         npts
+  ) {
+    Bessel_build( X, Y, 1, Yp, 1, npts );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   BesselSpline::build (void) {
     SPLINE_ASSERT(
@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 #include <cmath>
 #include <iomanip>
 /**
@@ -38,17 +39,54 @@ namespace Splines {
     // calcolo derivate
     integer nx = integer(this->X.size());
     integer ny = integer(this->Y.size());
-    PchipSpline sp;
-    for ( integer j = 0; j < ny; ++j ) {
-      sp.build( &this->X.front(), 1, &this->Z[size_t(this->ipos_C(0,j))], ny, nx );
-      for ( integer i = 0; i < nx; ++i )
-        this->DX[size_t(this->ipos_C(i,j))] = sp.ypNode(i);
+    // slopes are written in place: stride ny along x, stride 1 along y.
+    // A closed axis uses the periodic cubic spline, the system depends on
+    // the nodes only and is factorized once for all the lines
+    this->checkClosed();
+    vector<real_type> sysX, sysY;
+    real_type EX[2], EY[2];
+    if ( this->_x_closed ) {
+      sysX.resize( 4*size_t(nx) );
+      real_type * L = &sysX.front();
+      CubicSpline_factorize_periodic( &this->X.front(), L, L+nx, L+2*nx, L+3*nx, EX, nx );
     }
-    for ( integer i = 0; i < nx; ++i ) {
-      sp.build( &this->Y.front(), 1, &this->Z[size_t(this->ipos_C(i,0))], 1, ny );
-      for ( integer j = 0; j < ny; ++j )
-        this->DY[size_t(this->ipos_C(i,j))] = sp.ypNode(j);
+    if ( this->_y_closed ) {
+      sysY.resize( 4*size_t(ny) );
+      real_type * L = &sysY.front();
+      CubicSpline_factorize_periodic( &this->Y.front(), L, L+ny, L+2*ny, L+3*ny, EY, ny );
     }
+    parallel_chunks( size_t(ny), this->_build_threads, [this,nx,ny,&sysX,&EX]( size_t j0, size_t j1 ) {
+      vector<real_type> Zw( this->_x_closed ? size_t(nx) : 0 );
+      for ( integer j = integer(j0); j < integer(j1); ++j ) {
+        size_t ij = size_t(this->ipos_C(0,j));
+        if ( this->_x_closed ) {
+          real_type const * L = &sysX.front();
+          CubicSpline_solve_periodic(
+            &this->X.front(), &this->Z[ij], ny, &this->DX[ij], ny, &Zw.front(), 1,
+            L, L+nx, L+2*nx, L+3*nx, EX, nx
+          );
+        } else {
+          Pchip_build( &this->X.front(), &this->Z[ij], ny, &this->DX[ij], ny, nx );
+        }
+      }
+    } );
+    parallel_chunks( size_t(nx), this->_build_threads, [this,nx,ny,&sysY,&EY]( size_t i0, size_t i1 ) {
+      vector<real_type> Zw( this->_y_closed ? size_t(ny) : 0 );
+      for ( integer i = integer(i0); i < integer(i1); ++i ) {
+        size_t ij = size_t(this->ipos_C(i,0));
+        if ( this->_y_closed ) {
+          real_type const * L = &sysY.front();
+          CubicSpline_solve_periodic(
+            &this->Y.front(), &this->Z[ij], 1, &this->DY[ij], 1, &Zw.front(), 1,
+            L, L+ny, L+2*ny, L+3*ny, EY, ny
+          );
+        } else {
+          Pchip_build( &this->Y.front(), &this->Z[ij], 1, &this->DY[ij], 1, ny );
+        }
+      }
+    } );
+    SPLINE_CHECK_NAN( &this->DX.front(), "BiCubicSpline::makeSpline(): DX", nx*ny );
+    SPLINE_CHECK_NAN( &this->DY.front(), "BiCubicSpline::makeSpline(): DY", nx*ny );
     std::fill( this->DXY.begin(), this->DXY.end(), 0 );
   }
 
@@ -56,14 +94,13 @@ namespace Splines {
 
   void
   BiCubicSpline::writeToStream( ostream_type & s ) const {
-    integer ny = integer(Y.size());
     s << "Nx = " << X.size() << " Ny = " << Y.size() << '\n';
     for ( integer i = 1; i < integer(this->X.size()); ++i ) {
       for ( integer j = 1; j < integer(this->Y.size()); ++j ) {
-        size_t i00 = size_t(this->ipos_C(i-1,j-1,ny));
-        size_t i10 = size_t(this->ipos_C(i,j-1,ny));
-        size_t i01 = size_t(this->ipos_C(i-1,j,ny));
-        size_t i11 = size_t(this->ipos_C(i,j,ny));
+        size_t i00 = size_t(this->ipos_C(i-1,j-1));
+        size_t i10 = size_t(this->ipos_C(i,j-1));
+        size_t i01 = size_t(this->ipos_C(i-1,j));
+        size_t i11 = size_t(this->ipos_C(i,j));
         s << "patch (" << i << "," << j
           << ")\n DX = "  << setw(10) << left << this->X[size_t(i)]-X[size_t(i-1)]
           <<    " DY = "  << setw(10) << left << this->Y[size_t(j)]-Y[size_t(j-1)]
@@ -0,0 +1,725 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#else
+  #include <io.h>
+  #include <fcntl.h>
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+/**
+ * 
+ */
+
+namespace Splines {
+
+  using namespace std; // load standard namspace
+  using std::int64_t;
+
+  /*
+  //  file layout (native endian):
+  //
+  //  0   magic[8] nx ny tile tiles_y (int64) Z_min Z_max (real_type)
+  //  64  X[nx] Y[ny]
+  //  data_offset (multiple of mapped_align) tiles in row-major order of
+  //      the tiles, each `tile` x `tile` nodes in row-major order with
+  //      Z, DX, DY interleaved; nodes outside the grid are 0
+  */
+  static char const   mapped_magic[8]  = { 'S', 'P', 'L', 'T', 'I', 'L', 'E', '1' };
+  static size_t const mapped_header    = 64;
+  static size_t const mapped_align     = 65536;
+  static size_t const mapped_resident  = size_t(64) << 20;
+
+  static
+  size_t
+  mapped_data_offset( integer nx, integer ny ) {
+    size_t off = mapped_header + size_t(nx+ny)*sizeof(real_type);
+    return ((off+mapped_align-1)/mapped_align)*mapped_align;
+  }
+
+  static
+  void
+  mapped_put_header(
+    char      h[],
+    integer   nx,
+    integer   ny,
+    integer   tile,
+    integer   tiles_y,
+    real_type zmin,
+    real_type zmax
+  ) {
+    int64_t I[4] = { nx, ny, tile, tiles_y };
+    std::memset( h, 0, mapped_header );
+    std::memcpy( h, mapped_magic, 8 );
+    std::memcpy( h+8, I, sizeof(I) );
+    std::memcpy( h+40, &zmin, sizeof(real_type) );
+    std::memcpy( h+48, &zmax, sizeof(real_type) );
+  }
+
+  // read `n` bytes at `off` of the file `fd`, return false on a short read
+  static
+  bool
+  mapped_read( int fd, size_t off, void * buf, size_t n ) {
+    char * p = static_cast<char*>(buf);
+    while ( n > 0 ) {
+      #ifndef _WIN32
+      ssize_t r = ::pread( fd, p, n, off_t(off) );
+      #else
+      if ( _lseeki64( fd, __int64(off), SEEK_SET ) < 0 ) return false;
+      int r = _read( fd, p, unsigned(n > (1u<<30) ? (1u<<30) : n) );
+      #endif
+      if ( r <= 0 ) return false;
+      p   += r;
+      off += size_t(r);
+      n   -= size_t(r);
+    }
+    return true;
+  }
+
+  /*\
+   |   ____  _  ____      _     _      __  __                            _
+   |  | __ )(_)/ ___|   _| |__ (_) ___|  \/  | __ _ _ __  _ __   ___  __| |
+   |  |  _ \| | |  | | | | '_ \| |/ __| |\/| |/ _` | '_ \| '_ \ / _ \/ _` |
+   |  | |_) | | |__| |_| | |_) | | (__| |  | | (_| | |_) | |_) |  __/ (_| |
+   |  |____/|_|\____\__,_|_.__/|_|\___|_|  |_|\__,_| .__/| .__/ \___|\__,_|
+   |                                               |_|   |_|
+  \*/
+
+  BiCubicSplineMapped::BiCubicSplineMapped( string const & name )
+  : BiCubicSplineBase( name )
+  , _fname()
+  , _fd(-1)
+  , _tile_side(0)
+  , _tiles_y(0)
+  , _data_offset(0)
+  , _max_resident(mapped_resident)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  BiCubicSplineMapped::~BiCubicSplineMapped() {
+    this->close();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::makeSpline() {
+    SPLINE_DO_ERROR(
+      "BiCubicSplineMapped::makeSpline, use build( fname, ... ) to write the tiled file"
+    )
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::build(
+    char const          fname[],
+    real_type const     x[], integer nx,
+    real_type const     y[], integer ny,
+    BlockReader const & reader,
+    integer             tile
+  ) {
+    SPLINE_ASSERT(
+      nx >= 2 && ny >= 2,
+      "BiCubicSplineMapped::build, nx = " << nx << ", ny = " << ny <<
+      " must be >= 2"
+    )
+    SPLINE_ASSERT(
+      tile >= 4,
+      "BiCubicSplineMapped::build, tile = " << tile << " must be >= 4"
+    )
+    for ( integer i = 1; i < nx; ++i )
+      SPLINE_ASSERT(
+        x[i-1] < x[i],
+        "BiCubicSplineMapped::build, x not strictly increasing at " << i
+      )
+    for ( integer j = 1; j < ny; ++j )
+      SPLINE_ASSERT(
+        y[j-1] < y[j],
+        "BiCubicSplineMapped::build, y not strictly increasing at " << j
+      )
+
+    this->close();
+
+    integer T       = tile;
+    integer tiles_x = (nx+T-1)/T;
+    integer tiles_y = (ny+T-1)/T;
+    size_t  ntiles  = size_t(tiles_x)*size_t(tiles_y);
+    size_t  tsz     = 3*size_t(T)*size_t(T); // reals per tile
+    size_t  doff    = mapped_data_offset( nx, ny );
+
+    std::ofstream file( fname, std::ios::binary | std::ios::trunc );
+    SPLINE_ASSERT(
+      file.good(),
+      "BiCubicSplineMapped::build, cannot open \"" << fname << "\""
+    )
+
+    // header (Z range rewritten at the end), nodes, padding
+    char h[mapped_header];
+    mapped_put_header( h, nx, ny, T, tiles_y, 0, 0 );
+    file.write( h, std::streamsize(mapped_header) );
+    file.write( reinterpret_cast<char const*>(x), std::streamsize(size_t(nx)*sizeof(real_type)) );
+    file.write( reinterpret_cast<char const*>(y), std::streamsize(size_t(ny)*sizeof(real_type)) );
+    vector<char> pad( doff - mapped_header - size_t(nx+ny)*sizeof(real_type), 0 );
+    if ( !pad.empty() ) file.write( &pad.front(), std::streamsize(pad.size()) );
+
+    // one workspace for each tile of a batch, a batch is processed in parallel
+    size_t nth = this->_build_threads > 0
+               ? size_t(this->_build_threads)
+               : size_t(std::thread::hardware_concurrency());
+    if ( nth < 1 ) nth = 1;
+    integer TH = T+4; // tile plus halo
+    vector<real_type> blk( nth*size_t(TH*TH) ), dx( nth*size_t(TH*TH) ), dy( nth*size_t(TH*TH) );
+    vector<real_type> out( nth*tsz );
+    vector<integer>   box( nth*4 ); // i0, i1, j0, j1 of the blocks
+    vector<real_type> zmin( nth ), zmax( nth );
+
+    real_type Zmin = 0, Zmax = 0;
+    for ( size_t t0 = 0; t0 < ntiles; t0 += nth ) {
+      size_t nb = std::min( nth, ntiles-t0 );
+      // read the blocks with a halo of 2 nodes (the calling thread only)
+      for ( size_t b = 0; b < nb; ++b ) {
+        integer ti = integer((t0+b)/size_t(tiles_y));
+        integer tj = integer((t0+b)%size_t(tiles_y));
+        integer * B = &box[4*b];
+        B[0] = std::max( 0,  ti*T-2 );
+        B[1] = std::min( nx, ti*T+T+2 );
+        B[2] = std::max( 0,  tj*T-2 );
+        B[3] = std::min( ny, tj*T+T+2 );
+        reader( B[0], B[1], B[2], B[3], &blk[b*size_t(TH*TH)], B[3]-B[2] );
+      }
+      // slopes on the blocks: PCHIP is local, nodes at distance >= 1 from
+      // an inner side of the block (and with >= 3 points) are exact
+      parallel_chunks( nb, this->_build_threads, [&]( size_t b0, size_t b1 ) {
+        for ( size_t b = b0; b < b1; ++b ) {
+          integer const * B = &box[4*b];
+          integer mx  = B[1]-B[0];
+          integer my  = B[3]-B[2];
+          real_type * Zb  = &blk[b*size_t(TH*TH)];
+          real_type * DXb = &dx[b*size_t(TH*TH)];
+          real_type * DYb = &dy[b*size_t(TH*TH)];
+          for ( integer j = 0; j < my; ++j )
+            Pchip_build( x+B[0], Zb+j, my, DXb+j, my, mx );
+          for ( integer i = 0; i < mx; ++i )
+            Pchip_build( y+B[2], Zb+i*my, 1, DYb+i*my, 1, my );
+          SPLINE_CHECK_NAN( DXb, "BiCubicSplineMapped::build(): DX", mx*my );
+          SPLINE_CHECK_NAN( DYb, "BiCubicSplineMapped::build(): DY", mx*my );
+          // pack the tile
+          integer ti = integer((t0+b)/size_t(tiles_y));
+          integer tj = integer((t0+b)%size_t(tiles_y));
+          integer i0 = ti*T, i1 = std::min( nx, i0+T );
+          integer j0 = tj*T, j1 = std::min( ny, j0+T );
+          real_type * p = &out[b*tsz];
+          std::fill( p, p+tsz, 0 );
+          zmin[b] = zmax[b] = Zb[(i0-B[0])*my+(j0-B[2])];
+          for ( integer i = i0; i < i1; ++i ) {
+            for ( integer j = j0; j < j1; ++j ) {
+              integer   ij = (i-B[0])*my+(j-B[2]);
+              real_type * q = p + 3*((i-i0)*T+(j-j0));
+              q[0] = Zb[ij];
+              q[1] = DXb[ij];
+              q[2] = DYb[ij];
+              if      ( q[0] < zmin[b] ) zmin[b] = q[0];
+              else if ( q[0] > zmax[b] ) zmax[b] = q[0];
+            }
+          }
+        }
+      } );
+      for ( size_t b = 0; b < nb; ++b ) {
+        if ( t0+b == 0 ) { Zmin = zmin[b]; Zmax = zmax[b]; }
+        Zmin = std::min( Zmin, zmin[b] );
+        Zmax = std::max( Zmax, zmax[b] );
+      }
+      file.write(
+        reinterpret_cast<char const*>(&out.front()),
+        std::streamsize(nb*tsz*sizeof(real_type))
+      );
+      SPLINE_ASSERT(
+        file.good(),
+        "BiCubicSplineMapped::build, error writing \"" << fname << "\""
+      )
+    }
+
+    mapped_put_header( h, nx, ny, T, tiles_y, Zmin, Zmax );
+    file.seekp( 0 );
+    file.write( h, std::streamsize(mapped_header) );
+    file.close();
+    SPLINE_ASSERT(
+      !file.fail(),
+      "BiCubicSplineMapped::build, error writing \"" << fname << "\""
+    )
+    this->open( fname );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::build(
+    char const      fname[],
+    real_type const x[], integer nx,
+    real_type const y[], integer ny,
+    real_type const z[], integer ldZ,
+    integer         tile
+  ) {
+    SPLINE_ASSERT(
+      ldZ >= ny,
+      "BiCubicSplineMapped::build, ldZ = " << ldZ << " must be >= of ny = " << ny
+    )
+    BlockReader reader = [z,ldZ](
+      integer i0, integer i1, integer j0, integer j1,
+      real_type zb[], integer ldB
+    ) {
+      for ( integer i = i0; i < i1; ++i )
+        std::copy(
+          z + size_t(i)*size_t(ldZ) + size_t(j0),
+          z + size_t(i)*size_t(ldZ) + size_t(j1),
+          zb + size_t(i-i0)*size_t(ldB)
+        );
+    };
+    this->build( fname, x, nx, y, ny, reader, tile );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::open( char const fname[] ) {
+    this->close();
+    #ifndef _WIN32
+    int fd = ::open( fname, O_RDONLY );
+    #else
+    int fd = _open( fname, _O_RDONLY | _O_BINARY );
+    #endif
+    SPLINE_ASSERT(
+      fd >= 0, "BiCubicSplineMapped::open(\"" << fname << "\") cannot open file"
+    )
+    this->_fd    = fd;
+    this->_fname = fname;
+    try {
+      char    h[mapped_header];
+      int64_t I[4];
+      SPLINE_ASSERT(
+        mapped_read( fd, 0, h, mapped_header ) &&
+        std::memcmp( h, mapped_magic, 8 ) == 0,
+        "BiCubicSplineMapped::open(\"" << fname << "\") not a tiled spline file"
+      )
+      std::memcpy( I, h+8, sizeof(I) );
+      std::memcpy( &this->Z_min, h+40, sizeof(real_type) );
+      std::memcpy( &this->Z_max, h+48, sizeof(real_type) );
+      integer nx = integer(I[0]);
+      integer ny = integer(I[1]);
+      integer T  = integer(I[2]);
+      SPLINE_ASSERT(
+        nx >= 2 && ny >= 2 && T >= 4 && I[3] == (ny+T-1)/T,
+        "BiCubicSplineMapped::open(\"" << fname << "\") corrupted header"
+      )
+      this->X.resize( size_t(nx) );
+      this->Y.resize( size_t(ny) );
+      SPLINE_ASSERT(
+        mapped_read( fd, mapped_header, &this->X.front(), size_t(nx)*sizeof(real_type) ) &&
+        mapped_read( fd, mapped_header+size_t(nx)*sizeof(real_type),
+                     &this->Y.front(), size_t(ny)*sizeof(real_type) ),
+        "BiCubicSplineMapped::open(\"" << fname << "\") truncated file"
+      )
+      this->_tile_side   = T;
+      this->_tiles_y     = integer(I[3]);
+      this->_data_offset = mapped_data_offset( nx, ny );
+      size_t ntiles = size_t((nx+T-1)/T)*size_t(this->_tiles_y);
+      #ifndef _WIN32
+      struct stat st;
+      SPLINE_ASSERT(
+        fstat( fd, &st ) == 0 &&
+        size_t(st.st_size) >= this->_data_offset + ntiles*this->tileBytes(),
+        "BiCubicSplineMapped::open(\"" << fname << "\") truncated file"
+      )
+      #endif
+      this->_cache_index.assign( ntiles, this->_cache.end() );
+      this->makeHints();
+    } catch ( ... ) {
+      this->close();
+      throw;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::close() {
+    this->flushCache();
+    if ( this->_fd >= 0 ) {
+      #ifndef _WIN32
+      ::close( this->_fd );
+      #else
+      _close( this->_fd );
+      #endif
+    }
+    this->_fd          = -1;
+    this->_tile_side   = 0;
+    this->_tiles_y     = 0;
+    this->_data_offset = 0;
+    this->_fname.clear();
+    vector<TileIter>().swap( this->_cache_index );
+    SplineSurf::clear();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::evict( TileIter it ) const {
+    #ifndef _WIN32
+    munmap( it->base, it->size );
+    #else
+    delete [] static_cast<real_type*>(it->base);
+    #endif
+    this->_cache_index[size_t(it->tile)] = this->_cache.end();
+    this->_cache.erase( it );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::shrinkCache( size_t bytes ) const {
+    // drop the least recently used tiles, the pinned ones are skipped
+    size_t   tb = this->tileBytes();
+    size_t   nc = this->_cache.size();
+    TileIter it = this->_cache.end();
+    while ( nc*tb > bytes && it != this->_cache.begin() ) {
+      TileIter prev = it; --prev;
+      if ( prev->pins == 0 ) { this->evict( prev ); --nc; }
+      else                   it = prev;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::flushCache() const {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    while ( !this->_cache.empty() ) this->evict( this->_cache.begin() );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  BiCubicSplineMapped::TileIter
+  BiCubicSplineMapped::fetch( integer t ) const {
+    TileIter it = this->_cache_index[size_t(t)];
+    if ( it != this->_cache.end() ) {
+      this->_cache.splice( this->_cache.begin(), this->_cache, it );
+      return it;
+    }
+    // make room for the new tile
+    size_t tb = this->tileBytes();
+    this->shrinkCache( this->_max_resident > tb ? this->_max_resident-tb : 0 );
+    size_t     off = this->_data_offset + size_t(t)*tb;
+    CachedTile c;
+    c.tile = t;
+    c.pins = 0;
+    #ifndef _WIN32
+    size_t page = size_t(sysconf(_SC_PAGESIZE));
+    size_t aoff = off - off % page;
+    c.size = off - aoff + tb;
+    c.base = mmap( nullptr, c.size, PROT_READ, MAP_SHARED, this->_fd, off_t(aoff) );
+    SPLINE_ASSERT(
+      c.base != MAP_FAILED,
+      "BiCubicSplineMapped[" << this->_fname << "] mmap of tile " << t << " failed"
+    )
+    c.data = reinterpret_cast<real_type const*>( static_cast<char const*>(c.base) + (off-aoff) );
+    #else
+    c.size = tb;
+    c.base = new real_type[tb/sizeof(real_type)];
+    if ( !mapped_read( this->_fd, off, c.base, tb ) ) {
+      delete [] static_cast<real_type*>(c.base);
+      SPLINE_DO_ERROR(
+        "BiCubicSplineMapped[" << this->_fname << "] read of tile " << t << " failed"
+      )
+    }
+    c.data = static_cast<real_type const*>(c.base);
+    #endif
+    this->_cache.push_front( c );
+    return this->_cache_index[size_t(t)] = this->_cache.begin();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::checkOpen() const {
+    SPLINE_ASSERT(
+      this->_fd >= 0, "BiCubicSplineMapped, spline `" << this->_name << "` not open"
+    )
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type const *
+  BiCubicSplineMapped::node( integer i, integer j ) const {
+    this->checkOpen();
+    integer T = this->_tile_side;
+    real_type const * p = this->fetch( (i/T)*this->_tiles_y + j/T )->data;
+    return p + 3*((i%T)*T + j%T);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // patch `(i,j)` in the layout of `BiCubicSplineBase::gather`, DXY = 0;
+  // `node(i,j)` can release the tile of the previous node, so each node
+  // is copied before the next call
+  template <typename NODE>
+  static
+  void
+  mapped_patch( NODE & node, integer T, integer i, integer j, real_type bili3[4][4] ) {
+    real_type const * p0 = node( i, j );
+    if ( (i+1) % T != 0 && (j+1) % T != 0 ) {
+      // the 4 nodes are in the same tile
+      real_type const * p1 = p0 + 3*T;
+      bili3[0][0] = p0[0]; bili3[0][1] = p0[3];
+      bili3[0][2] = p0[2]; bili3[0][3] = p0[5];
+      bili3[1][0] = p1[0]; bili3[1][1] = p1[3];
+      bili3[1][2] = p1[2]; bili3[1][3] = p1[5];
+      bili3[2][0] = p0[1]; bili3[2][1] = p0[4];
+      bili3[3][0] = p1[1]; bili3[3][1] = p1[4];
+    } else {
+      for ( integer a = 0; a < 2; ++a ) {
+        for ( integer b = 0; b < 2; ++b ) {
+          real_type const * p = node( i+a, j+b );
+          bili3[a][b]     = p[0];
+          bili3[a][2+b]   = p[2];
+          bili3[2+a][b]   = p[1];
+        }
+      }
+    }
+    bili3[2][2] = bili3[2][3] = bili3[3][2] = bili3[3][3] = 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*\
+   |  Reader of a grid or of a batch chunk: it pins the last 4 tiles it
+   |  used, they are not evicted and are read without locking the cache.
+   |  The cache is locked only to pin another tile and by the destructor,
+   |  that releases the pins.
+  \*/
+  class BiCubicSplineMapped::TileReader {
+    BiCubicSplineMapped const & S;
+    TileIter pinned[4];
+    integer  tiles[4];
+    integer  next;
+  public:
+    explicit
+    TileReader( BiCubicSplineMapped const & s )
+    : S(s)
+    , next(0) {
+      S.checkOpen();
+      std::fill( tiles, tiles+4, -1 );
+    }
+
+    ~TileReader() {
+      std::lock_guard<std::mutex> lck(S._cache_mutex);
+      for ( integer k = 0; k < 4; ++k )
+        if ( tiles[k] >= 0 ) --pinned[k]->pins;
+      S.shrinkCache( S._max_resident ); // the pinned tiles can exceed the bound
+    }
+
+    real_type const *
+    operator () ( integer i, integer j ) {
+      integer T = S._tile_side;
+      integer t = (i/T)*S._tiles_y + j/T;
+      integer k = 0;
+      while ( k < 4 && tiles[k] != t ) ++k;
+      if ( k == 4 ) {
+        k    = next;
+        next = (next+1) % 4;
+        std::lock_guard<std::mutex> lck(S._cache_mutex);
+        if ( tiles[k] >= 0 ) --pinned[k]->pins;
+        tiles[k]  = -1;
+        pinned[k] = S.fetch( t );
+        ++pinned[k]->pins;
+        tiles[k]  = t;
+      }
+      return pinned[k]->data + 3*((i%T)*T + j%T);
+    }
+
+    void
+    load( integer i, integer j, real_type bili3[4][4] )
+    { mapped_patch( *this, S._tile_side, i, j, bili3 ); }
+  };
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::load(
+    integer i, integer j, real_type bili3[4][4]
+  ) const {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    auto node = [this]( integer ii, integer jj ) { return this->node( ii, jj ); };
+    mapped_patch( node, this->_tile_side, i, j, bili3 );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  BiCubicSplineMapped::eval_D(
+    integer dx, integer dy, real_type x, real_type y
+  ) const {
+    static GridBasis const H[3] = { Hermite3, Hermite3_D, Hermite3_DD };
+    real_type bili3[4][4], u[4], v[4];
+    integer i = this->search_x( x );
+    integer j = this->search_y( y );
+    H[dx]( x - this->X[size_t(i)], this->X[size_t(i+1)] - this->X[size_t(i)], u );
+    H[dy]( y - this->Y[size_t(j)], this->Y[size_t(j+1)] - this->Y[size_t(j)], v );
+    this->load( i, j, bili3 );
+    return bilinear3( u, bili3, v );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::gridEval(
+    integer dx, integer dy,
+    real_type const xs[], integer nx,
+    real_type const ys[], integer ny,
+    real_type       out[], integer ldOut
+  ) const {
+    static GridBasis const H[3] = { Hermite3, Hermite3_D, Hermite3_DD };
+    vector<integer>   ii, jj;
+    vector<real_type> U, V;
+    this->gridBasis( true,  xs, nx, 4, H[dx], ii, U );
+    this->gridBasis( false, ys, ny, 4, H[dy], jj, V );
+    TileReader R( *this );
+    grid_eval_patches<4>(
+      &ii.front(), &U.front(), nx,
+      &jj.front(), &V.front(), ny,
+      [&R]( integer i, integer j, real_type M[4][4] ) { R.load( i, j, M ); },
+      out, ldOut
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::batchEval(
+    integer         what,
+    size_t          n,
+    size_t    const perm[],
+    integer   const I[],
+    integer   const J[],
+    real_type const tx[],
+    real_type const ty[],
+    real_type       out[]
+  ) const {
+    static HermiteBasis const H[4] = {
+      Hermite3, Hermite3_D, Hermite3_DD, Hermite3_DDD
+    };
+    TileReader R( *this );
+    hermite_jets<4>(
+      what, H, this->X, this->Y,
+      [&R]( integer i, integer j, real_type M[4][4] ) { R.load( i, j, M ); },
+      n, perm, I, J, tx, ty, out
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::setMaxResident( size_t bytes ) {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    this->_max_resident = bytes;
+    this->shrinkCache( bytes );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  size_t
+  BiCubicSplineMapped::resident() const {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    return this->_cache.size()*this->tileBytes();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  BiCubicSplineMapped::zNode( integer i, integer j ) const {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    return this->node( i, j )[0];
+  }
+
+  real_type
+  BiCubicSplineMapped::DxNode( integer i, integer j ) const {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    return this->node( i, j )[1];
+  }
+
+  real_type
+  BiCubicSplineMapped::DyNode( integer i, integer j ) const {
+    std::lock_guard<std::mutex> lck(this->_cache_mutex);
+    return this->node( i, j )[2];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineMapped::writeToStream( ostream_type & s ) const {
+    s << "Nx = " << X.size() << " Ny = " << Y.size()
+      << " tile = " << this->_tile_side << " file = " << this->_fname << '\n';
+    real_type M[4][4];
+    for ( integer i = 1; i < integer(this->X.size()); ++i ) {
+      for ( integer j = 1; j < integer(this->Y.size()); ++j ) {
+        this->load( i-1, j-1, M );
+        s << "patch (" << i << "," << j
+          << ")\n DX = "  << setw(10) << left << this->X[size_t(i)]-X[size_t(i-1)]
+          <<    " DY = "  << setw(10) << left << this->Y[size_t(j)]-Y[size_t(j-1)]
+          << "\n Z00  = " << setw(10) << left << M[0][0]
+          <<   " Z01  = " << setw(10) << left << M[0][1]
+          <<   " Z10  = " << setw(10) << left << M[1][0]
+          <<   " Z11  = " << setw(10) << left << M[1][1]
+          << "\n Dx00 = " << setw(10) << left << M[2][0]
+          <<   " Dx01 = " << setw(10) << left << M[2][1]
+          <<   " Dx10 = " << setw(10) << left << M[3][0]
+          <<   " Dx11 = " << setw(10) << left << M[3][1]
+          << "\n Dy00 = " << setw(10) << left << M[0][2]
+          <<   " Dy01 = " << setw(10) << left << M[0][3]
+          <<   " Dy10 = " << setw(10) << left << M[1][2]
+          <<   " Dy11 = " << setw(10) << left << M[1][3]
+          << '\n';
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  char const *
+  BiCubicSplineMapped::type_name() const
+  { return "BiCubicMapped"; }
+
+}
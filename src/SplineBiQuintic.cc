@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 #include <cmath>
 #include <iomanip>
 /**
@@ -43,44 +44,73 @@ namespace Splines {
     // calcolo derivate
     integer nx = integer(X.size());
     integer ny = integer(Y.size());
-    QuinticSpline sp, sp1;
-    //
-    for ( integer j = 0; j < ny; ++j ) {
-      sp.build( &this->X.front(), 1, &this->Z[size_t(this->ipos_C(0,j))], ny, nx );
-      for ( integer i = 0; i < nx; ++i ) {
-        this->DX[size_t(this->ipos_C(i,j))]  = sp.ypNode(i);
-        this->DXX[size_t(this->ipos_C(i,j))] = sp.yppNode(i);
+    integer nth = this->_build_threads;
+    // closed axes use the periodic quintic
+    this->checkClosed();
+    QUINTIC_SPLINE_TYPE qx = this->_x_closed ? PERIODIC_QUINTIC : CUBIC_QUINTIC;
+    QUINTIC_SPLINE_TYPE qy = this->_y_closed ? PERIODIC_QUINTIC : CUBIC_QUINTIC;
+    // first and second derivatives are written in place:
+    // stride ny along x, stride 1 along y
+    parallel_chunks( size_t(ny), nth, [this,nx,ny,qx]( size_t j0, size_t j1 ) {
+      for ( integer j = integer(j0); j < integer(j1); ++j ) {
+        size_t ij = size_t(this->ipos_C(0,j));
+        Quintic_build(
+          qx, &this->X.front(),
+          &this->Z[ij], ny, &this->DX[ij], ny, &this->DXX[ij], ny, nx
+        );
       }
-    }
-    for ( integer i = 0; i < nx; ++i ) {
-      sp.build( &this->Y.front(), 1, &this->Z[size_t(this->ipos_C(i,0))], 1, ny );
-      for ( integer j = 0; j < ny; ++j ) {
-        this->DY[size_t(this->ipos_C(i,j))]  = sp.ypNode(j);
-        this->DYY[size_t(this->ipos_C(i,j))] = sp.yppNode(j);
+    } );
+    parallel_chunks( size_t(nx), nth, [this,nx,ny,qy]( size_t i0, size_t i1 ) {
+      for ( integer i = integer(i0); i < integer(i1); ++i ) {
+        size_t ij = size_t(this->ipos_C(i,0));
+        Quintic_build(
+          qy, &this->Y.front(),
+          &this->Z[ij], 1, &this->DY[ij], 1, &this->DYY[ij], 1, ny
+        );
       }
-    }
+    } );
     // interpolate derivative
-    for ( integer i = 0; i < nx; ++i ) {
-      sp.build( &this->Y.front(), 1, &this->DX[size_t(this->ipos_C(i,0))], 1, ny );
-      sp1.build( &this->Y.front(), 1, &this->DXX[size_t(this->ipos_C(i,0))], 1, ny );
-      for ( integer j = 0; j < ny; ++j ) {
-        this->DXY[size_t(this->ipos_C(i,j))]   = sp.ypNode(j);
-        this->DXYY[size_t(this->ipos_C(i,j))]  = sp.yppNode(j);
-        this->DXXY[size_t(this->ipos_C(i,j))]  = sp1.ypNode(j);
-        this->DXXYY[size_t(this->ipos_C(i,j))] = sp1.yppNode(j);
+    parallel_chunks( size_t(nx), nth, [this,ny,qy]( size_t i0, size_t i1 ) {
+      for ( integer i = integer(i0); i < integer(i1); ++i ) {
+        size_t ij = size_t(this->ipos_C(i,0));
+        Quintic_build(
+          qy, &this->Y.front(),
+          &this->DX[ij], 1, &this->DXY[ij], 1, &this->DXYY[ij], 1, ny
+        );
+        Quintic_build(
+          qy, &this->Y.front(),
+          &this->DXX[ij], 1, &this->DXXY[ij], 1, &this->DXXYY[ij], 1, ny
+        );
       }
-    }
-    // interpolate derivative again
-    for ( integer j = 0; j < ny; ++j ) {
-      sp.build( &this->X.front(), 1, &this->DY[size_t(this->ipos_C(0,j))], ny, nx );
-      sp1.build( &this->X.front(), 1, &this->DYY[size_t(this->ipos_C(0,j))], ny, nx );
-      for ( integer i = 0; i < nx; ++i ) {
-        this->DXY[size_t(this->ipos_C(i,j))]   += sp.ypNode(i);   this->DXY[size_t(this->ipos_C(i,j))]   /= 2;
-        this->DXXY[size_t(this->ipos_C(i,j))]  += sp.yppNode(i);  this->DXXY[size_t(this->ipos_C(i,j))]  /= 2;
-        this->DXYY[size_t(this->ipos_C(i,j))]  += sp1.ypNode(i);  this->DXYY[size_t(this->ipos_C(i,j))]  /= 2;
-        this->DXXYY[size_t(this->ipos_C(i,j))] += sp1.yppNode(i); this->DXXYY[size_t(this->ipos_C(i,j))] /= 2;
+    } );
+    // interpolate derivative again and average the two estimates
+    parallel_chunks( size_t(ny), nth, [this,nx,ny,qx]( size_t j0, size_t j1 ) {
+      vector<real_type> buffer(4*size_t(nx));
+      real_type * d1  = &buffer.front();
+      real_type * d2  = d1 + nx;
+      real_type * d11 = d2 + nx;
+      real_type * d12 = d11 + nx;
+      for ( integer j = integer(j0); j < integer(j1); ++j ) {
+        size_t ij = size_t(this->ipos_C(0,j));
+        Quintic_build( qx, &this->X.front(), &this->DY[ij],  ny, d1,  1, d2,  1, nx );
+        Quintic_build( qx, &this->X.front(), &this->DYY[ij], ny, d11, 1, d12, 1, nx );
+        for ( integer i = 0; i < nx; ++i ) {
+          size_t k = size_t(this->ipos_C(i,j));
+          this->DXY[k]   += d1[i];  this->DXY[k]   /= 2;
+          this->DXXY[k]  += d2[i];  this->DXXY[k]  /= 2;
+          this->DXYY[k]  += d11[i]; this->DXYY[k]  /= 2;
+          this->DXXYY[k] += d12[i]; this->DXXYY[k] /= 2;
+        }
       }
-    }
+    } );
+    SPLINE_CHECK_NAN( &this->DX.front(),    "BiQuinticSpline::makeSpline(): DX",    nx*ny );
+    SPLINE_CHECK_NAN( &this->DY.front(),    "BiQuinticSpline::makeSpline(): DY",    nx*ny );
+    SPLINE_CHECK_NAN( &this->DXX.front(),   "BiQuinticSpline::makeSpline(): DXX",   nx*ny );
+    SPLINE_CHECK_NAN( &this->DYY.front(),   "BiQuinticSpline::makeSpline(): DYY",   nx*ny );
+    SPLINE_CHECK_NAN( &this->DXY.front(),   "BiQuinticSpline::makeSpline(): DXY",   nx*ny );
+    SPLINE_CHECK_NAN( &this->DXYY.front(),  "BiQuinticSpline::makeSpline(): DXYY",  nx*ny );
+    SPLINE_CHECK_NAN( &this->DXXY.front(),  "BiQuinticSpline::makeSpline(): DXXY",  nx*ny );
+    SPLINE_CHECK_NAN( &this->DXXYY.front(), "BiQuinticSpline::makeSpline(): DXXYY", nx*ny );
 
     //std::fill( DXY.begin(), DXY.end(), 0 );
     //std::fill( DXX.begin(), DXX.end(), 0 );
@@ -91,14 +121,13 @@ namespace Splines {
 
   void
   BiQuinticSpline::writeToStream( ostream_type & s ) const {
-    integer ny = integer(this->Y.size());
     s << "Nx = " << this->X.size() << " Ny = " << this->Y.size() << '\n';
     for ( integer i = 1; i < integer(this->X.size()); ++i ) {
       for ( integer j = 1; j < integer(this->Y.size()); ++j ) {
-        size_t i00 = size_t(this->ipos_C(i-1,j-1,ny));
-        size_t i10 = size_t(this->ipos_C(i,j-1,ny));
-        size_t i01 = size_t(this->ipos_C(i-1,j,ny));
-        size_t i11 = size_t(this->ipos_C(i,j,ny));
+        size_t i00 = size_t(this->ipos_C(i-1,j-1));
+        size_t i10 = size_t(this->ipos_C(i,j-1));
+        size_t i01 = size_t(this->ipos_C(i-1,j));
+        size_t i11 = size_t(this->ipos_C(i,j));
         s << "patch (" << i << "," << j
           << ")\n DX = "  << setw(10) << left << this->X[size_t(i)]-this->X[size_t(i-1)]
           <<    " DY = "  << setw(10) << left << this->Y[size_t(j)]-this->Y[size_t(j-1)]
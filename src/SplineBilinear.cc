@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 #include <cmath>
 #include <iomanip>
 /**
@@ -30,10 +31,112 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  // (nearly) equispaced nodes: the interval from the grid step is wrong by at
+  // most one node, that is fixed comparing with the nodes
+  static
+  bool
+  is_uniform( vector<real_type> const & X, real_type & scale ) {
+    size_t n = X.size();
+    scale = 0;
+    if ( n < 2 ) return false;
+    real_type h = (X.back()-X.front())/real_type(n-1);
+    for ( size_t i = 1; i+1 < n; ++i )
+      if ( std::abs( X[i] - X.front() - real_type(i)*h ) > h/4 ) return false;
+    scale = 1/h;
+    return true;
+  }
+
+  // interval of `x` on a uniform axis, false if `x` is outside the nodes
+  static
+  inline
+  bool
+  uniform_interval(
+    vector<real_type> const & X,
+    real_type                 scale,
+    real_type                 x,
+    integer                 & i
+  ) {
+    if ( !( x >= X.front() && x <= X.back() ) ) return false;
+    integer nm2 = integer(X.size())-2;
+    i = integer( (x-X.front())*scale );
+    if ( i > nm2 ) i = nm2;
+    while ( i > 0   && x < X[size_t(i)]   ) --i;
+    while ( i < nm2 && x > X[size_t(i+1)] ) ++i;
+    return true;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  BilinearSpline::locate_x( real_type & x ) const {
+    integer i;
+    if ( this->_x_uniform && !this->_x_closed &&
+         uniform_interval( this->X, this->_x_scale, x, i ) ) return i;
+    return this->search_x( x );
+  }
+
+  integer
+  BilinearSpline::locate_y( real_type & y ) const {
+    integer j;
+    if ( this->_y_uniform && !this->_y_closed &&
+         uniform_interval( this->Y, this->_y_scale, y, j ) ) return j;
+    return this->search_y( y );
+  }
+
+  // same as above with a local hint in place of the per-thread table
+
+  integer
+  BilinearSpline::locate_x( real_type & x, integer & hint ) const {
+    if ( this->_x_uniform && !this->_x_closed &&
+         uniform_interval( this->X, this->_x_scale, x, hint ) ) return hint;
+    searchInterval(
+      integer(this->X.size()), &this->X.front(), x, hint,
+      this->_x_closed, this->_x_can_extend
+    );
+    return hint;
+  }
+
+  integer
+  BilinearSpline::locate_y( real_type & y, integer & hint ) const {
+    if ( this->_y_uniform && !this->_y_closed &&
+         uniform_interval( this->Y, this->_y_scale, y, hint ) ) return hint;
+    searchInterval(
+      integer(this->Y.size()), &this->Y.front(), y, hint,
+      this->_y_closed, this->_y_can_extend
+    );
+    return hint;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // called by `build`, `loadBinary` and `clear` when the nodes change
+  void
+  BilinearSpline::makePatches() {
+    this->_x_uniform = is_uniform( this->X, this->_x_scale );
+    this->_y_uniform = is_uniform( this->Y, this->_y_scale );
+    if ( this->_use_float && !this->Z.empty() ) {
+      vector<real_type> tmp;
+      real_type const * pZ = this->rowMajor( this->Z, tmp );
+      this->Zf.assign( pZ, pZ + this->X.size()*this->Y.size() );
+    } else {
+      vector<float>().swap( this->Zf ); // release the memory
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BilinearSpline::useFloatTable( bool yes ) {
+    this->_use_float = yes;
+    this->makePatches();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   real_type
   BilinearSpline::operator () ( real_type x, real_type y ) const {
-    integer   i   = this->search_x( x );
-    integer   j   = this->search_y( y );
+    integer   i   = this->locate_x( x );
+    integer   j   = this->locate_y( y );
     real_type DX  = this->X[size_t(i+1)] - this->X[size_t(i)];
     real_type DY  = this->Y[size_t(j+1)] - this->Y[size_t(j)];
     real_type u   = (x-this->X[size_t(i)])/DX;
@@ -52,8 +155,8 @@ namespace Splines {
 
   real_type
   BilinearSpline::Dx( real_type x, real_type y ) const {
-    integer   i   = this->search_x( x );
-    integer   j   = this->search_y( y );
+    integer   i   = this->locate_x( x );
+    integer   j   = this->locate_y( y );
     real_type DX  = this->X[size_t(i+1)] - this->X[size_t(i)];
     real_type DY  = this->Y[size_t(j+1)] - this->Y[size_t(j)];
     real_type v   = (y-this->Y[size_t(j)])/DY;
@@ -68,8 +171,8 @@ namespace Splines {
 
   real_type
   BilinearSpline::Dy( real_type x, real_type y ) const {
-    integer   i   = this->search_x( x );
-    integer   j   = this->search_y( y );
+    integer   i   = this->locate_x( x );
+    integer   j   = this->locate_y( y );
     real_type DX  = this->X[size_t(i+1)] - this->X[size_t(i)];
     real_type DY  = this->Y[size_t(j+1)] - this->Y[size_t(j)];
     real_type u   = (x-this->X[size_t(i)])/DX;
@@ -84,8 +187,8 @@ namespace Splines {
 
   void
   BilinearSpline::D( real_type x, real_type y, real_type d[3] ) const {
-    integer   i   = this->search_x( x );
-    integer   j   = this->search_y( y );
+    integer   i   = this->locate_x( x );
+    integer   j   = this->locate_y( y );
     real_type DX  = this->X[size_t(i+1)] - this->X[size_t(i)];
     real_type DY  = this->Y[size_t(j+1)] - this->Y[size_t(j)];
     real_type u   = (x-this->X[size_t(i)])/DX;
@@ -103,6 +206,202 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  static
+  void
+  Linear( real_type t, real_type h, real_type base[2] )
+  { real_type u = t/h; base[0] = 1-u; base[1] = u; }
+
+  static
+  void
+  Linear_D( real_type, real_type h, real_type base_D[2] )
+  { base_D[0] = -1/h; base_D[1] = 1/h; }
+
+  static
+  void
+  Linear_DD( real_type, real_type, real_type base_DD[2] )
+  { base_DD[0] = base_DD[1] = 0; }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BilinearSpline::gridEval(
+    integer dx, integer dy,
+    real_type const xs[], integer nx,
+    real_type const ys[], integer ny,
+    real_type       out[], integer ldOut
+  ) const {
+    if ( dx+dy == 2 ) { // second derivative are 0, as `Dxy`
+      for ( integer a = 0; a < nx; ++a )
+        std::fill( out + a*ldOut, out + a*ldOut + ny, real_type(0) );
+      return;
+    }
+    static GridBasis const H[3] = { Linear, Linear_D, Linear_DD };
+    vector<integer>   ii, jj;
+    vector<real_type> U, V;
+    this->gridBasis( true,  xs, nx, 2, H[dx], ii, U );
+    this->gridBasis( false, ys, ny, 2, H[dy], jj, V );
+    grid_eval_patches<2>(
+      &ii.front(), &U.front(), nx,
+      &jj.front(), &V.front(), ny,
+      [this]( integer i, integer j, real_type M[2][2] ) {
+        M[0][0] = this->Z[size_t(this->ipos_C(i,j))];
+        M[0][1] = this->Z[size_t(this->ipos_C(i,j+1))];
+        M[1][0] = this->Z[size_t(this->ipos_C(i+1,j))];
+        M[1][1] = this->Z[size_t(this->ipos_C(i+1,j+1))];
+      },
+      out, ldOut
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BilinearSpline::batchEval(
+    integer         what,
+    size_t          n,
+    size_t    const perm[],
+    integer   const I[],
+    integer   const J[],
+    real_type const tx[],
+    real_type const ty[],
+    real_type       out[]
+  ) const {
+    for ( size_t k = 0; k < n; ++k ) {
+      size_t    p   = perm[k];
+      integer   i   = I[k];
+      integer   j   = J[k];
+      real_type DX  = this->X[size_t(i+1)] - this->X[size_t(i)];
+      real_type DY  = this->Y[size_t(j+1)] - this->Y[size_t(j)];
+      real_type u   = tx[k]/DX;
+      real_type v   = ty[k]/DY;
+      real_type u1  = 1-u;
+      real_type v1  = 1-v;
+      real_type Z00 = this->Z[size_t(this->ipos_C(i,j))];
+      real_type Z01 = this->Z[size_t(this->ipos_C(i,j+1))];
+      real_type Z10 = this->Z[size_t(this->ipos_C(i+1,j))];
+      real_type Z11 = this->Z[size_t(this->ipos_C(i+1,j+1))];
+      if ( what == 0 ) {
+        out[p] = u1 * ( Z00 * v1 + Z01 * v ) + u * ( Z10 * v1 + Z11 * v );
+        continue;
+      }
+      integer     nj = jetSize( what );
+      real_type * d  = out + nj*p;
+      d[0] = u1 * ( Z00 * v1 + Z01 * v ) + u * ( Z10 * v1 + Z11 * v );
+      d[1] = v1 * (Z10-Z00) + v * (Z11-Z01); d[1] /= DX;
+      d[2] = u1 * (Z01-Z00) + u * (Z11-Z10); d[2] /= DY;
+      std::fill( d+3, d+nj, real_type(0) ); // second derivative are 0
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  template <typename T, typename TZ>
+  void
+  BilinearSpline::resampleChunk(
+    T const x[], T const y[], T z[], size_t n,
+    TZ const tab[], bool row_major
+  ) const {
+    size_t const BLK = 64;
+    size_t       ny  = this->Y.size();
+    integer      I[BLK], J[BLK], hi = 0, hj = 0;
+    T            U[BLK], V[BLK];
+    size_t       P[BLK];
+    bool const   fast_x = this->_x_uniform && !this->_x_closed;
+    bool const   fast_y = this->_y_uniform && !this->_y_closed;
+    for ( size_t k0 = 0; k0 < n; k0 += BLK ) {
+      size_t m = std::min( BLK, n-k0 );
+      // intervals and weights (the expressions of `operator ()`)
+      for ( size_t k = 0; k < m; ++k ) {
+        real_type xx = real_type(x[k0+k]);
+        real_type yy = real_type(y[k0+k]);
+        integer   i, j;
+        if ( !( fast_x && uniform_interval( this->X, this->_x_scale, xx, i ) ) )
+          i = this->locate_x( xx, hi );
+        if ( !( fast_y && uniform_interval( this->Y, this->_y_scale, yy, j ) ) )
+          j = this->locate_y( yy, hj );
+        U[k] = T(xx-this->X[size_t(i)])/T(this->X[size_t(i+1)]-this->X[size_t(i)]);
+        V[k] = T(yy-this->Y[size_t(j)])/T(this->Y[size_t(j+1)]-this->Y[size_t(j)]);
+        I[k] = i;
+        J[k] = j;
+      }
+      // gather and blend
+      if ( row_major ) {
+        for ( size_t k = 0; k < m; ++k )
+          P[k] = size_t(I[k])*ny + size_t(J[k]);
+        for ( size_t k = 0; k < m; ++k ) {
+          TZ const * p0 = tab + P[k];
+          TZ const * p1 = p0 + ny;
+          T u  = U[k], v = V[k];
+          T u1 = 1-u,  v1 = 1-v;
+          z[k0+k] = u1 * ( T(p0[0]) * v1 + T(p0[1]) * v ) +
+                    u  * ( T(p1[0]) * v1 + T(p1[1]) * v );
+        }
+      } else {
+        for ( size_t k = 0; k < m; ++k ) {
+          integer i = I[k], j = J[k];
+          T u  = U[k], v = V[k];
+          T u1 = 1-u,  v1 = 1-v;
+          T Z00 = T(tab[size_t(this->ipos_C(i,j))]);
+          T Z01 = T(tab[size_t(this->ipos_C(i,j+1))]);
+          T Z10 = T(tab[size_t(this->ipos_C(i+1,j))]);
+          T Z11 = T(tab[size_t(this->ipos_C(i+1,j+1))]);
+          z[k0+k] = u1 * ( Z00 * v1 + Z01 * v ) + u * ( Z10 * v1 + Z11 * v );
+        }
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BilinearSpline::resample(
+    real_type const x[],
+    real_type const y[],
+    real_type       z[],
+    size_t          n,
+    integer         nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->X.size() >= 2 && this->Y.size() >= 2,
+      "BilinearSpline::resample, spline not built"
+    )
+    real_type const * tab = &this->Z.front();
+    bool row_major = this->_tile_bits == 0;
+    parallel_chunks( n, nthreads, [=]( size_t k0, size_t k1 ) {
+      this->resampleChunk( x+k0, y+k0, z+k0, k1-k0, tab, row_major );
+    } );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BilinearSpline::resample(
+    float const x[],
+    float const y[],
+    float       z[],
+    size_t      n,
+    integer     nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->X.size() >= 2 && this->Y.size() >= 2,
+      "BilinearSpline::resample, spline not built"
+    )
+    if ( this->Zf.empty() ) {
+      real_type const * tab = &this->Z.front();
+      bool row_major = this->_tile_bits == 0;
+      parallel_chunks( n, nthreads, [=]( size_t k0, size_t k1 ) {
+        this->resampleChunk( x+k0, y+k0, z+k0, k1-k0, tab, row_major );
+      } );
+    } else {
+      float const * tab = &this->Zf.front();
+      parallel_chunks( n, nthreads, [=]( size_t k0, size_t k1 ) {
+        this->resampleChunk( x+k0, y+k0, z+k0, k1-k0, tab, true );
+      } );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   BilinearSpline::DD( real_type x, real_type y, real_type d[6] ) const {
     this->D( x, y, d );
@@ -113,14 +412,13 @@ namespace Splines {
 
   void
   BilinearSpline::writeToStream( ostream_type & s ) const {
-    integer ny = integer(Y.size());
     s << "Nx = " << X.size() << " Ny = " << Y.size() << '\n';
     for ( integer i = 1; i < integer(this->X.size()); ++i ) {
       for ( integer j = 1; j < integer(this->Y.size()); ++j ) {
-        size_t i00 = size_t(this->ipos_C(i-1,j-1,ny));
-        size_t i10 = size_t(this->ipos_C(i,j-1,ny));
-        size_t i01 = size_t(this->ipos_C(i-1,j,ny));
-        size_t i11 = size_t(this->ipos_C(i,j,ny));
+        size_t i00 = size_t(this->ipos_C(i-1,j-1));
+        size_t i10 = size_t(this->ipos_C(i,j-1));
+        size_t i01 = size_t(this->ipos_C(i-1,j));
+        size_t i11 = size_t(this->ipos_C(i,j));
         s << "patch (" << i << "," << j << ")\n"
           <<  "DX = "  << setw(10) << left << this->X[size_t(i)]-this->X[size_t(i-1)]
           << " DY = "  << setw(10) << left << this->Y[size_t(j)]-this->Y[size_t(j-1)]
@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 
 /*\
  |   ####  #    # #####  #  ####
@@ -249,173 +250,324 @@ namespace Splines {
                 L D U
                 LL L D
 
+     UU and LL (not-a-knot) are removed substituting the end rows
+     into the second and the second last rows, the end rows are then
+     decoupled and their ratios kept in E[0] and E[1] to recover the
+     end values after the solve.  The reduced rows stay diagonally
+     dominant, the plain elimination of UU leaves a zero pivot on
+     uniform knots.
   \*/
 
+  // with 2 points the spline is the segment, with 3 points not-a-knot
+  // on both sides is the parabola through the points
+  static
   void
-  CubicSpline_build(
+  cubic_bc_fix(
+    integer                npts,
+    CUBIC_SPLINE_TYPE_BC & bc0,
+    CUBIC_SPLINE_TYPE_BC & bcn
+  ) {
+    if ( npts == 2 ) {
+      bc0 = bcn = NATURAL_BC;
+    } else if ( npts == 3 && bc0 == NOT_A_KNOT && bcn == NOT_A_KNOT ) {
+      bc0 = bcn = PARABOLIC_RUNOUT_BC;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSpline_factorize(
     real_type const      X[],
-    real_type const      Y[],
-    real_type            Yp[],
-    real_type            Ypp[],
     real_type            L[],
     real_type            D[],
     real_type            U[],
+    real_type            E[2],
     integer              npts,
     CUBIC_SPLINE_TYPE_BC bc0,
     CUBIC_SPLINE_TYPE_BC bcn
   ) {
-
+    cubic_bc_fix( npts, bc0, bcn );
     size_t n = size_t(npts > 0 ? npts-1 : 0);
-    real_type * Z = Ypp;
 
-    size_t i;
-    for ( i = 1; i < n; ++i ) {
+    for ( size_t i = 1; i < n; ++i ) {
       real_type HL = X[i] - X[i-1];
       real_type HR = X[i+1] - X[i];
       real_type HH = HL+HR;
       L[i] = HL/HH;
       U[i] = HR/HH;
       D[i] = 2;
-      Z[i] = 6 * ( (Y[i+1]-Y[i])/HR - (Y[i]-Y[i-1])/HL ) / HH;
     }
 
-    real_type UU = 0, LL = 0;
-
+    E[0] = E[1] = 0;
     switch ( bc0 ) {
     case EXTRAPOLATE_BC:
+    case NATURAL_BC:
+    case PERIODIC_BC: // the periodic system is CubicSpline_factorize_periodic
       L[0] = 0; D[0] = 1; U[0] = 0;
-      if ( npts == 2 ) {
-        Z[0] = 0;
-      } else if ( npts == 3 ) {
+      break;
+    case PARABOLIC_RUNOUT_BC:
+      L[0] = 0; D[0] = 1; U[0] = -1;
+      break;
+    case NOT_A_KNOT:
+      {
+        // v0 - v1*(1+r) + r*v2 == 0
+        real_type r = (X[1] - X[0])/(X[2] - X[1]);
+        D[1] += L[1] * (1+r);
+        U[1] -= L[1] * r;
+        L[1]  = 0;
+        L[0]  = 0; D[0] = 1; U[0] = 0;
+        E[0]  = r;
+      }
+      break;
+    }
+
+    switch ( bcn ) {
+    case EXTRAPOLATE_BC:
+    case NATURAL_BC:
+    case PERIODIC_BC:
+      L[n] = 0;  D[n] = 1; U[n] = 0;
+      break;
+    case PARABOLIC_RUNOUT_BC:
+      L[n] = -1; D[n] = 1; U[n] = 0;
+      break;
+    case NOT_A_KNOT:
+      {
+        // r*v0 - v1*(1+r) + v2 == 0
+        real_type r = (X[n] - X[n-1])/(X[n-1] - X[n-2]);
+        D[n-1] += U[n-1] * (1+r);
+        L[n-1] -= U[n-1] * r;
+        U[n-1]  = 0;
+        L[n]    = 0; D[n] = 1; U[n] = 0;
+        E[1]    = r;
+      }
+      break;
+    }
+
+    tridiag_factorize( npts, L, D, U );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSpline_solve(
+    real_type const      X[],
+    real_type const      Y[],
+    integer              incY,
+    real_type            Yp[],
+    integer              incYp,
+    real_type            Z[],
+    integer              incZ,
+    real_type const      L[],
+    real_type const      D[],
+    real_type const      U[],
+    real_type const      E[2],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  ) {
+    cubic_bc_fix( npts, bc0, bcn );
+    size_t n = size_t(npts > 0 ? npts-1 : 0);
+
+    size_t i;
+    for ( i = 1; i < n; ++i ) {
+      real_type HL = X[i] - X[i-1];
+      real_type HR = X[i+1] - X[i];
+      real_type HH = HL+HR;
+      Z[i*incZ] = 6 * ( (Y[(i+1)*incY]-Y[i*incY])/HR - (Y[i*incY]-Y[(i-1)*incY])/HL ) / HH;
+    }
+
+    Z[0] = 0;
+    if ( bc0 == EXTRAPOLATE_BC ) {
+      if ( npts == 3 ) {
         real_type hR  = X[1] - X[0];
         real_type hRR = X[2] - X[1];
-        real_type SR  = (Y[1] - Y[0])/hR;
-        real_type SRR = (Y[2] - Y[1])/hRR;
+        real_type SR  = (Y[incY] - Y[0])/hR;
+        real_type SRR = (Y[2*incY] - Y[incY])/hRR;
         Z[0] = deriv2_3p_L( SR, hR, SRR, hRR );
       } else if ( npts == 4 ) {
         real_type hR   = X[1] - X[0];
         real_type hRR  = X[2] - X[1];
         real_type hRRR = X[3] - X[2];
-        real_type SR   = (Y[1] - Y[0])/hR;
-        real_type SRR  = (Y[2] - Y[1])/hRR;
-        real_type SRRR = (Y[3] - Y[2])/hRRR;
+        real_type SR   = (Y[incY] - Y[0])/hR;
+        real_type SRR  = (Y[2*incY] - Y[incY])/hRR;
+        real_type SRRR = (Y[3*incY] - Y[2*incY])/hRRR;
         Z[0] = deriv2_4p_L( SR, hR, SRR, hRR, SRRR, hRRR );
-      } else {
+      } else if ( npts > 4 ) {
         real_type hR    = X[1] - X[0];
         real_type hRR   = X[2] - X[1];
         real_type hRRR  = X[3] - X[2];
         real_type hRRRR = X[4] - X[3];
-        real_type SR    = (Y[1] - Y[0])/hR;
-        real_type SRR   = (Y[2] - Y[1])/hRR;
-        real_type SRRR  = (Y[3] - Y[2])/hRRR;
-        real_type SRRRR = (Y[4] - Y[3])/hRRRR;
+        real_type SR    = (Y[incY] - Y[0])/hR;
+        real_type SRR   = (Y[2*incY] - Y[incY])/hRR;
+        real_type SRRR  = (Y[3*incY] - Y[2*incY])/hRRR;
+        real_type SRRRR = (Y[4*incY] - Y[3*incY])/hRRRR;
         Z[0] = deriv2_5p_L( SR, hR, SRR, hRR, SRRR, hRRR, SRRRR, hRRRR );
       }
-      break;
-    case NATURAL_BC:
-      L[0] = 0; D[0] = 1; U[0] = 0; Z[0] = 0;
-      break;
-    case PARABOLIC_RUNOUT_BC:
-      L[0] = 0; D[0] = 1; U[0] = -1; Z[0] = 0;
-      break;
-    case NOT_A_KNOT:
-      {
-        real_type r = (X[1] - X[0])/(X[2] - X[1]);
-        // v0 - v1*(1+r) + r*v2 == 0
-        L[0] = 0;
-        D[0] = 1;
-        U[0] = -(1+r);
-        UU   = r;
-        Z[0] = 0;
-      }
-      break;
     }
 
-    switch ( bcn ) {
-    case EXTRAPOLATE_BC:
-      L[n] = 0;  D[n] = 1; U[n] = 0;
-      if ( npts == 2 ) {
-        Z[n] = 0;
-      } else if ( npts == 3 ) {
+    Z[n*incZ] = 0;
+    if ( bcn == EXTRAPOLATE_BC ) {
+      if ( npts == 3 ) {
         real_type hL  = X[n] - X[n-1];
         real_type hLL = X[n-1] - X[n-2];
-        real_type SL  = (Y[n] - Y[n-1])/hL;
-        real_type SLL = (Y[n-1] - Y[n-2])/hLL;
-        Z[n] = deriv2_3p_R( SL, hL, SLL, hLL );
+        real_type SL  = (Y[n*incY] - Y[(n-1)*incY])/hL;
+        real_type SLL = (Y[(n-1)*incY] - Y[(n-2)*incY])/hLL;
+        Z[n*incZ] = deriv2_3p_R( SL, hL, SLL, hLL );
       } else if ( npts == 4 ) {
         real_type hL   = X[n] - X[n-1];
         real_type hLL  = X[n-1] - X[n-2];
         real_type hLLL = X[n-2] - X[n-3];
-        real_type SL   = (Y[n] - Y[n-1])/hL;
-        real_type SLL  = (Y[n-1] - Y[n-2])/hLL;
-        real_type SLLL = (Y[n-2] - Y[n-3])/hLLL;
-        Z[n] = deriv2_4p_R(  SL, hL, SLL, hLL, SLLL, hLLL );
-      } else {
+        real_type SL   = (Y[n*incY] - Y[(n-1)*incY])/hL;
+        real_type SLL  = (Y[(n-1)*incY] - Y[(n-2)*incY])/hLL;
+        real_type SLLL = (Y[(n-2)*incY] - Y[(n-3)*incY])/hLLL;
+        Z[n*incZ] = deriv2_4p_R(  SL, hL, SLL, hLL, SLLL, hLLL );
+      } else if ( npts > 4 ) {
         real_type hL    = X[n] - X[n-1];
         real_type hLL   = X[n-1] - X[n-2];
         real_type hLLL  = X[n-2] - X[n-3];
         real_type hLLLL = X[n-3] - X[n-4];
-        real_type SL    = (Y[n] - Y[n-1])/hL;
-        real_type SLL   = (Y[n-1] - Y[n-2])/hLL;
-        real_type SLLL  = (Y[n-2] - Y[n-3])/hLLL;
-        real_type SLLLL = (Y[n-3] - Y[n-4])/hLLLL;
-        Z[n] = deriv2_5p_R(  SL, hL, SLL, hLL, SLLL, hLLL, SLLLL, hLLLL );
-      }
-      break;
-    case NATURAL_BC:
-      L[n] = 0;  D[n] = 1; U[n] = 0; Z[n] = 0;
-      break;
-    case PARABOLIC_RUNOUT_BC:
-      L[n] = -1; D[n] = 1; U[n] = 0; Z[n] = 0;
-      break;
-    case NOT_A_KNOT:
-      {
-        real_type r = (X[n-1] - X[n-2])/(X[n] - X[n-1]);
-        // r*v0 - v1*(1+r) + v2 == 0
-        U[n] = 0;
-        D[n] = 1;
-        L[n] = -(1+r);
-        LL   = r;
-        Z[n] = 0;
+        real_type SL    = (Y[n*incY] - Y[(n-1)*incY])/hL;
+        real_type SLL   = (Y[(n-1)*incY] - Y[(n-2)*incY])/hLL;
+        real_type SLLL  = (Y[(n-2)*incY] - Y[(n-3)*incY])/hLLL;
+        real_type SLLLL = (Y[(n-3)*incY] - Y[(n-4)*incY])/hLLLL;
+        Z[n*incZ] = deriv2_5p_R(  SL, hL, SLL, hLL, SLLL, hLLL, SLLLL, hLLLL );
       }
-      break;
     }
 
-    if ( n > 2 ) {
-      Z[0] /= D[0];
-      U[0] /= D[0];
-      UU   /= D[0];
-      D[1] -= L[1] * U[0];
-      U[1] -= L[1] * UU;
-      Z[1] -= L[1] * Z[0];
-      i = 1;
-      do {
-        Z[i]   /= D[i];
-        U[i]   /= D[i];
-        D[i+1] -= L[i+1] * U[i];
-        Z[i+1] -= L[i+1] * Z[i];
-      } while ( ++i < n );
-
-      D[i] -= LL * U[i-2];
-      Z[i] -= LL * Z[i-2];
-
-      Z[i] /= D[i];
-
-      do {
-        --i;
-        Z[i] -= U[i] * Z[i+1];
-      } while ( i > 0 );
-
-      Z[0] -= UU * Z[2];
-    }
+    tridiag_solve( npts, L, D, U, Z, incZ );
+
+    // not-a-knot ends
+    if ( E[0] != 0 ) Z[0]      = (1+E[0]) * Z[incZ]     - E[0] * Z[2*incZ];
+    if ( E[1] != 0 ) Z[n*incZ] = (1+E[1]) * Z[(n-1)*incZ] - E[1] * Z[(n-2)*incZ];
 
     for ( i = 0; i < n; ++i ) {
       real_type DX = X[i+1] - X[i];
-      Yp[i] = (Y[i+1]-Y[i])/DX - (2*Z[i] + Z[i+1]) * (DX/6);
+      Yp[i*incYp] = (Y[(i+1)*incY]-Y[i*incY])/DX - (2*Z[i*incZ] + Z[(i+1)*incZ]) * (DX/6);
     }
     real_type DX2 = (X[n] - X[n-1])/2;
-    Yp[n] = Yp[n-1] + DX2 * (Z[n-1] + Z[n]);
+    Yp[n*incYp] = Yp[(n-1)*incYp] + DX2 * (Z[(n-1)*incZ] + Z[n*incZ]);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*\
+     Periodic system, Y[n] == Y[0] and z(n) == z(0)
+
+     D U         L
+     L D U
+       L D U
+         .....
+           L D U
+     U       L D
+  \*/
+
+  void
+  CubicSpline_factorize_periodic(
+    real_type const X[],
+    real_type       L[],
+    real_type       D[],
+    real_type       U[],
+    real_type       Q[],
+    real_type       E[2],
+    integer         npts
+  ) {
+    size_t n = size_t(npts > 0 ? npts-1 : 0);
+    for ( size_t i = 0; i < n; ++i ) {
+      real_type HL = i == 0 ? X[n] - X[n-1] : X[i] - X[i-1];
+      real_type HR = X[i+1] - X[i];
+      real_type HH = HL+HR;
+      L[i] = HL/HH;
+      U[i] = HR/HH;
+      D[i] = 2;
+    }
+    cyclic_tridiag_factorize( integer(n), L, D, U, Q, E );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSpline_solve_periodic(
+    real_type const X[],
+    real_type const Y[],
+    integer         incY,
+    real_type       Yp[],
+    integer         incYp,
+    real_type       Z[],
+    integer         incZ,
+    real_type const L[],
+    real_type const D[],
+    real_type const U[],
+    real_type const Q[],
+    real_type const E[2],
+    integer         npts
+  ) {
+    size_t n = size_t(npts > 0 ? npts-1 : 0);
+    for ( size_t i = 0; i < n; ++i ) {
+      size_t    im = i == 0 ? n-1 : i-1;
+      real_type HL = i == 0 ? X[n] - X[n-1] : X[i] - X[i-1];
+      real_type HR = X[i+1] - X[i];
+      real_type HH = HL+HR;
+      Z[i*incZ] = 6 * ( (Y[(i+1)*incY]-Y[i*incY])/HR - (Y[i*incY]-Y[im*incY])/HL ) / HH;
+    }
+    cyclic_tridiag_solve( integer(n), L, D, U, Q, E, Z, incZ );
+    Z[n*incZ] = Z[0];
+    for ( size_t i = 0; i < n; ++i ) {
+      real_type DX = X[i+1] - X[i];
+      Yp[i*incYp] = (Y[(i+1)*incY]-Y[i*incY])/DX - (2*Z[i*incZ] + Z[(i+1)*incZ]) * (DX/6);
+    }
+    Yp[n*incYp] = Yp[0];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSpline_build(
+    real_type const      X[],
+    real_type const      Y[],
+    integer              incY,
+    real_type            Yp[],
+    integer              incYp,
+    real_type            Ypp[],
+    integer              incYpp,
+    real_type            L[],
+    real_type            D[],
+    real_type            U[],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  ) {
+    real_type E[2];
+    if ( bc0 == PERIODIC_BC || bcn == PERIODIC_BC ) {
+      vector<real_type> Q( size_t(npts > 0 ? npts : 0) );
+      CubicSpline_factorize_periodic( X, L, D, U, &Q.front(), E, npts );
+      CubicSpline_solve_periodic(
+        X, Y, incY, Yp, incYp, Ypp, incYpp, L, D, U, &Q.front(), E, npts
+      );
+    } else {
+      CubicSpline_factorize( X, L, D, U, E, npts, bc0, bcn );
+      CubicSpline_solve(
+        X, Y, incY, Yp, incYp, Ypp, incYpp, L, D, U, E, npts, bc0, bcn
+      );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  CubicSpline_build(
+    real_type const      X[],
+    real_type const      Y[],
+    real_type            Yp[],
+    real_type            Ypp[],
+    real_type            L[],
+    real_type            D[],
+    real_type            U[],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  ) {
+    CubicSpline_build( X, Y, 1, Yp, 1, Ypp, 1, L, D, U, npts, bc0, bcn );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -424,7 +576,9 @@ namespace Splines {
   CubicSpline_build(
     real_type const      X[],
     real_type const      Y[],
+    integer              incY,
     real_type            Yp[],
+    integer              incYp,
     integer              npts,
     CUBIC_SPLINE_TYPE_BC bc0,
     CUBIC_SPLINE_TYPE_BC bcn
@@ -436,7 +590,21 @@ namespace Splines {
     real_type * D = ptr; ptr += npts;
     real_type * U = ptr; ptr += npts;
     real_type * Z = ptr;
-    CubicSpline_build( X, Y, Yp, Z, L, D, U, npts, bc0, bcn );
+    CubicSpline_build( X, Y, incY, Yp, incYp, Z, 1, L, D, U, npts, bc0, bcn );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSpline_build(
+    real_type const      X[],
+    real_type const      Y[],
+    real_type            Yp[],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  ) {
+    CubicSpline_build( X, Y, 1, Yp, 1, npts, bc0, bcn );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -447,6 +615,8 @@ namespace Splines {
       this->npts > 1,
       "CubicSpline::build(): npts = " << this->npts << " not enought points"
     )
+    bool periodic = this->bc0 == PERIODIC_BC || this->bcn == PERIODIC_BC;
+    bool whole    = true;
     integer ibegin = 0;
     integer iend   = 0;
     do {
@@ -456,6 +626,18 @@ namespace Splines {
       CUBIC_SPLINE_TYPE_BC seg_bcn = NOT_A_KNOT;
       if ( ibegin == 0         ) seg_bc0 = this->bc0;
       if ( iend  == this->npts ) seg_bcn = this->bcn;
+      // periodic only on the whole range
+      if ( periodic && ( ibegin > 0 || iend < this->npts ) ) {
+        if ( seg_bc0 == PERIODIC_BC ) seg_bc0 = NOT_A_KNOT;
+        if ( seg_bcn == PERIODIC_BC ) seg_bcn = NOT_A_KNOT;
+        whole = false;
+      }
+      SPLINE_ASSERT(
+        !( seg_bc0 == PERIODIC_BC || seg_bcn == PERIODIC_BC ) ||
+        periodic_ends_match( this->Y, 1, this->npts ),
+        "CubicSpline::build(): PERIODIC_BC needs Y[npts-1] == Y[0], found " <<
+        this->Y[this->npts-1] << " and " << this->Y[0]
+      )
       CubicSpline_build(
         this->X+ibegin,
         this->Y+ibegin,
@@ -466,6 +648,8 @@ namespace Splines {
       ibegin = iend;
     } while ( iend < this->npts );
 
+    if ( periodic && whole ) this->make_closed();
+
     SPLINE_CHECK_NAN( this->Yp, "CubicSpline::build(): Yp", this->npts );
   }
 
@@ -510,6 +694,7 @@ namespace Splines {
       else if ( bc == "natural"     ) this->bc0 = NATURAL_BC;
       else if ( bc == "parabolic"   ) this->bc0 = PARABOLIC_RUNOUT_BC;
       else if ( bc == "not_a_knot"  ) this->bc0 = NOT_A_KNOT;
+      else if ( bc == "periodic"    ) this->bc0 = PERIODIC_BC;
       else {
         SPLINE_DO_ERROR(
           "CubicSpline[" << this->_name << "]::setup unknow initial bc:" << bc
@@ -525,6 +710,7 @@ namespace Splines {
       else if ( bc == "natural"     ) this->bcn = NATURAL_BC;
       else if ( bc == "parabolic"   ) this->bcn = PARABOLIC_RUNOUT_BC;
       else if ( bc == "not_a_knot"  ) this->bcn = NOT_A_KNOT;
+      else if ( bc == "periodic"    ) this->bcn = PERIODIC_BC;
       else {
         SPLINE_DO_ERROR(
           "CubicSpline[" << this->_name << "]::setup unknow final bc:" << bc
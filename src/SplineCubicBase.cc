@@ -59,6 +59,7 @@ namespace Splines {
     if ( !this->_external_alloc ) this->baseValue.free();
     this->npts = this->npts_reserved = 0;
     this->_external_alloc = false;
+    this->_is_view        = false;
     this->X = this->Y = this->Yp = nullptr;
   }
 
@@ -76,10 +77,8 @@ namespace Splines {
       this->Yp = this->baseValue( size_t(n) );
       this->_external_alloc = false;
     }
-    {
-      std::lock_guard<std::mutex> lck(lastInterval_mutex);
-      lastInterval_by_thread[std::this_thread::get_id()] = 0;
-    }
+    this->_is_view = false;
+    this->initLastInterval();
     this->npts = 0;
   }
 
@@ -97,10 +96,69 @@ namespace Splines {
     this->Y               = p_y;
     this->Yp              = p_dy;
     this->_external_alloc = true;
-    {
-      std::lock_guard<std::mutex> lck(lastInterval_mutex);
-      lastInterval_by_thread[std::this_thread::get_id()] = 0;
+    this->_is_view        = false;
+    this->initLastInterval();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSplineBase::build_view(
+    real_type const x[],
+    real_type const y[],
+    integer         n,
+    real_type const yp[]
+  ) {
+    SPLINE_ASSERT(
+      n > 1,
+      "CubicSplineBase::build_view, npts = " << n << " not enought points"
+    )
+    SPLINE_ASSERT(
+      yp != nullptr || this->type() != HERMITE_TYPE,
+      "CubicSplineBase::build_view, Hermite spline need the `yp` values"
+    )
+    this->npts            = n;
+    this->npts_reserved   = n;
+    this->_external_alloc = false;
+    this->_is_view        = true;
+    // the view is never written: the const_cast only match the storage type
+    this->X = const_cast<real_type*>(x);
+    this->Y = const_cast<real_type*>(y);
+    this->initLastInterval();
+    if ( yp != nullptr ) {
+      this->baseValue.free();
+      this->Yp = const_cast<real_type*>(yp);
+    } else {
+      this->baseValue.allocate( size_t(n) );
+      this->Yp = this->baseValue( size_t(n) );
+      this->build();
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSplineBase::build_view(
+    real_type const x[],  integer incx,
+    real_type const y[],  integer incy,
+    integer         n,
+    real_type const yp[], integer incyp
+  ) {
+    if ( incx == 1 && incy == 1 && ( yp == nullptr || incyp == 1 ) ) {
+      this->build_view( x, y, n, yp );
+      return;
     }
+    SPLINE_ASSERT(
+      n > 1,
+      "CubicSplineBase::build_view, npts = " << n << " not enought points"
+    )
+    SPLINE_ASSERT(
+      yp != nullptr || this->type() != HERMITE_TYPE,
+      "CubicSplineBase::build_view, Hermite spline need the `yp` values"
+    )
+    // the evaluation needs contiguous nodes, copy them
+    if ( yp != nullptr ) this->build( x, incx, y, incy, yp, incyp, n );
+    else                 this->build( x, incx, y, incy, n );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -157,6 +215,33 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  CubicSplineBase::jet( real_type x, integer order, real_type J[] ) const {
+    SPLINE_ASSERT(
+      order >= 0 && order <= 5,
+      "CubicSplineBase::jet, order = " << order << " must be in [0,5]"
+    )
+    size_t    i = size_t(this->search( x ));
+    real_type t = x-this->X[i];
+    real_type H = this->X[i+1]-this->X[i];
+    real_type base[4];
+    for ( integer k = 0; k <= order; ++k ) {
+      switch ( k ) {
+      case 0: Hermite3( t, H, base );     break;
+      case 1: Hermite3_D( t, H, base );   break;
+      case 2: Hermite3_DD( t, H, base );  break;
+      case 3: Hermite3_DDD( t, H, base ); break;
+      default: J[k] = 0; continue;
+      }
+      J[k] = base[0] * this->Y[i]   +
+             base[1] * this->Y[i+1] +
+             base[2] * this->Yp[i]  +
+             base[3] * this->Yp[i+1];
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   integer // order
   CubicSplineBase::coeffs(
     real_type cfs[],
@@ -210,6 +295,10 @@ namespace Splines {
   //! change X-range of the spline
   void
   CubicSplineBase::setRange( real_type xmin, real_type xmax ) {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "CubicSplineBase::setRange, cannot modify a view spline"
+    )
     Spline::setRange( xmin, xmax );
     real_type recS = ( this->X[npts-1] - this->X[0] ) / (xmax - xmin);
     real_type * iy = this->Y;
@@ -45,12 +45,45 @@ namespace Splines {
     this->npts            = 0;
     this->npts_reserved   = n;
     this->_external_alloc = true;
+    this->_is_view        = false;
     this->X               = p_x;
     this->Y               = p_y;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  LinearSpline::build_view( real_type const x[], real_type const y[], integer n ) {
+    SPLINE_ASSERT(
+      n > 1, "LinearSpline::build_view, npts = " << n << " not enought points"
+    )
+    if ( !this->_external_alloc ) this->baseValue.free();
+    this->npts            = n;
+    this->npts_reserved   = n;
+    this->_external_alloc = false;
+    this->_is_view        = true;
+    // the view is never written: the const_cast only match the storage type
+    this->X = const_cast<real_type*>(x);
+    this->Y = const_cast<real_type*>(y);
+    this->initLastInterval();
+    this->build();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  LinearSpline::build_view(
+    real_type const x[], integer incx,
+    real_type const y[], integer incy,
+    integer n
+  ) {
+    // the evaluation needs contiguous nodes, otherwise copy them
+    if ( incx == 1 && incy == 1 ) this->build_view( x, y, n );
+    else                          this->build( x, incx, y, incy, n );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   LinearSpline::reserve( integer n ) {
     if ( this->_external_alloc && n <= this->npts_reserved ) {
@@ -62,10 +95,8 @@ namespace Splines {
       this->X               = this->baseValue( size_t(n) );
       this->Y               = this->baseValue( size_t(n) );
     }
-    {
-      std::lock_guard<std::mutex> lck(lastInterval_mutex);
-      lastInterval_by_thread[std::this_thread::get_id()] = 0;
-    }
+    this->_is_view = false;
+    this->initLastInterval();
     this->npts = 0;
   }
 
@@ -76,6 +107,7 @@ namespace Splines {
     if ( !this->_external_alloc ) this->baseValue.free();
     this->npts = this->npts_reserved = 0;
     this->_external_alloc = false;
+    this->_is_view        = false;
     this->X = this->Y = nullptr;
   }
 
@@ -0,0 +1,397 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+#include <cmath>
+
+namespace Splines {
+
+  using namespace std; // load standard namspace
+
+  integer const SplineND::max_dim;
+
+  /*\
+   | The value in a cell is the contraction of the 2^N values at the corners
+   | (bit k of the corner index is the side along axis k) with a pair of
+   | weights for each axis. The cubic Hermite interpolant is the sum of
+   | N+1 such contractions: the values with the weights of the values, and
+   | the slopes along axis k with the weights of the slopes on axis k.
+   | A derivative along axis m replaces the weights of axis m with their
+   | derivative.
+  \*/
+
+  template <integer N>
+  static
+  inline
+  real_type
+  nd_contract( real_type c[], real_type const * const w[] ) {
+    for ( integer k = N-1; k >= 0; --k ) {
+      integer           h  = integer(1) << k;
+      real_type const * wk = w[k];
+      for ( integer i = 0; i < h; ++i ) c[i] = wk[0]*c[i] + wk[1]*c[i+h];
+    }
+    return c[0];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  template <integer N>
+  static
+  real_type
+  nd_kernel(
+    real_type const *       Z,
+    real_type const * const D[], // nullptr for multilinear
+    integer   const         corner[],
+    integer                 base,
+    real_type const         V[][2],
+    real_type const         V_D[][2],
+    real_type const         S[][2],
+    real_type const         S_D[][2],
+    real_type               grad[] // nullptr if not needed
+  ) {
+    integer const NC = integer(1) << N;
+    real_type c[NC], cc[NC];
+    real_type const * w[N];
+    for ( integer k = 0; k < N; ++k ) w[k] = V[k];
+
+    for ( integer q = 0; q < NC; ++q ) c[q] = Z[base+corner[q]];
+    std::copy( c, c+NC, cc );
+    real_type f = nd_contract<N>( cc, w );
+    if ( grad != nullptr ) {
+      for ( integer m = 0; m < N; ++m ) {
+        w[m] = V_D[m];
+        std::copy( c, c+NC, cc );
+        grad[m] = nd_contract<N>( cc, w );
+        w[m] = V[m];
+      }
+    }
+    if ( D == nullptr ) return f;
+
+    for ( integer k = 0; k < N; ++k ) {
+      real_type const * Dk = D[k];
+      for ( integer q = 0; q < NC; ++q ) c[q] = Dk[base+corner[q]];
+      w[k] = S[k];
+      std::copy( c, c+NC, cc );
+      f += nd_contract<N>( cc, w );
+      if ( grad != nullptr ) {
+        for ( integer m = 0; m < N; ++m ) {
+          w[m] = m == k ? S_D[k] : V_D[m];
+          std::copy( c, c+NC, cc );
+          grad[m] += nd_contract<N>( cc, w );
+          w[m] = m == k ? S[k] : V[m];
+        }
+      }
+      w[k] = V[k];
+    }
+    return f;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //! slopes of the line `Y[i*inc]` with the 1D builder of type `tp`
+  static
+  void
+  nd_slopes(
+    SplineType1D    tp,
+    real_type const X[],
+    real_type const Y[],
+    real_type       Yp[],
+    integer         inc,
+    integer         npts
+  ) {
+    switch ( tp ) {
+    case PCHIP_TYPE:  Pchip_build( X, Y, inc, Yp, inc, npts );  break;
+    case AKIMA_TYPE:  Akima_build( X, Y, inc, Yp, inc, npts );  break;
+    case BESSEL_TYPE: Bessel_build( X, Y, inc, Yp, inc, npts ); break;
+    case CUBIC_TYPE:
+      CubicSpline_build(
+        X, Y, inc, Yp, inc, npts, EXTRAPOLATE_BC, EXTRAPOLATE_BC
+      );
+      break;
+    default:
+      break;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineND::build(
+    SplineType1D            tp,
+    integer                 dim,
+    integer         const   n[],
+    real_type const * const x[],
+    real_type       const   z[]
+  ) {
+    SPLINE_ASSERT(
+      dim >= 1 && dim <= max_dim,
+      "SplineND::build, dim = " << dim << " must be in [1," << max_dim << "]"
+    )
+    SPLINE_ASSERT(
+      tp == LINEAR_TYPE || tp == PCHIP_TYPE || tp == AKIMA_TYPE ||
+      tp == BESSEL_TYPE || tp == CUBIC_TYPE,
+      "SplineND::build, type `" << spline_type_1D[tp] << "` not supported"
+    )
+    for ( integer k = 0; k < dim; ++k ) {
+      SPLINE_ASSERT(
+        n[k] >= 2,
+        "SplineND::build, axis " << k << " has " << n[k] << " < 2 points"
+      )
+      for ( integer i = 1; i < n[k]; ++i ) {
+        SPLINE_ASSERT(
+          x[k][i-1] < x[k][i],
+          "SplineND::build, axis " << k << " is not strictly increasing at " << i
+        )
+      }
+    }
+    this->clear();
+    this->_type = tp;
+    this->_dim  = dim;
+    this->_stride[dim-1] = 1;
+    for ( integer k = dim-1; k > 0; --k )
+      this->_stride[k-1] = this->_stride[k]*n[k];
+    size_t nz = size_t(this->_stride[0]*n[0]);
+    for ( integer k = 0; k < dim; ++k ) {
+      this->_npts[k] = n[k];
+      this->X[k].assign( x[k], x[k]+n[k] );
+    }
+    this->Z.assign( z, z+nz );
+
+    this->_corner.resize( size_t(1) << dim );
+    for ( size_t q = 0; q < this->_corner.size(); ++q ) {
+      integer off = 0;
+      for ( integer k = 0; k < dim; ++k )
+        if ( (q >> k) & 1 ) off += this->_stride[k];
+      this->_corner[q] = off;
+    }
+
+    if ( tp == LINEAR_TYPE ) return;
+
+    // slopes along axis k on every grid line, written in place with stride
+    for ( integer k = 0; k < dim; ++k ) {
+      integer inc = this->_stride[k];
+      integer len = inc*n[k];
+      this->D[k].resize( nz );
+      for ( integer outer = 0; outer < integer(nz); outer += len ) {
+        for ( integer inner = 0; inner < inc; ++inner ) {
+          size_t ij = size_t(outer+inner);
+          nd_slopes(
+            tp, &this->X[k].front(), &this->Z[ij], &this->D[k][ij], inc, n[k]
+          );
+        }
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineND::clear() {
+    for ( integer k = 0; k < max_dim; ++k ) {
+      this->X[k].clear();
+      this->D[k].clear();
+    }
+    this->Z.clear();
+    this->_corner.clear();
+    this->_dim = 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineND::zNode( integer const idx[] ) const {
+    integer ij = 0;
+    for ( integer k = 0; k < this->_dim; ++k ) ij += idx[k]*this->_stride[k];
+    return this->Z[size_t(ij)];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineND::search( real_type x[], integer hint[] ) const {
+    for ( integer k = 0; k < this->_dim; ++k ) {
+      integer n = this->_npts[k];
+      if ( hint[k] < 0 || hint[k] > n-2 ) hint[k] = 0;
+      searchInterval( n, &this->X[k].front(), x[k], hint[k], false, true );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineND::evalCell(
+    real_type const x[],
+    integer   const hint[],
+    real_type       grad[]
+  ) const {
+    SPLINE_ASSERT(
+      this->_dim > 0, "SplineND::evalCell, spline `" << this->_name << "` not built"
+    )
+    real_type V[max_dim][2], V_D[max_dim][2], S[max_dim][2], S_D[max_dim][2];
+    real_type const * pD[max_dim];
+    bool    cubic = this->_type != LINEAR_TYPE;
+    integer base  = 0;
+    for ( integer k = 0; k < this->_dim; ++k ) {
+      integer           i  = hint[k];
+      real_type const * Xk = &this->X[k][size_t(i)];
+      real_type         h  = Xk[1] - Xk[0];
+      real_type         dx = x[k] - Xk[0];
+      base += i*this->_stride[k];
+      if ( cubic ) {
+        real_type b[4], b_D[4];
+        Hermite3( dx, h, b );
+        V[k][0] = b[0]; V[k][1] = b[1];
+        S[k][0] = b[2]; S[k][1] = b[3];
+        if ( grad != nullptr ) {
+          Hermite3_D( dx, h, b_D );
+          V_D[k][0] = b_D[0]; V_D[k][1] = b_D[1];
+          S_D[k][0] = b_D[2]; S_D[k][1] = b_D[3];
+        }
+        pD[k] = &this->D[k].front();
+      } else {
+        real_type t = dx/h;
+        V[k][0]   = 1-t;   V[k][1]   = t;
+        V_D[k][0] = -1/h;  V_D[k][1] = 1/h;
+      }
+    }
+    real_type const * pZ = &this->Z.front();
+    real_type const * const * DD = cubic ? pD : nullptr;
+    integer   const * C  = &this->_corner.front();
+    switch ( this->_dim ) {
+    case 1: return nd_kernel<1>( pZ, DD, C, base, V, V_D, S, S_D, grad );
+    case 2: return nd_kernel<2>( pZ, DD, C, base, V, V_D, S, S_D, grad );
+    case 3: return nd_kernel<3>( pZ, DD, C, base, V, V_D, S, S_D, grad );
+    case 4: return nd_kernel<4>( pZ, DD, C, base, V, V_D, S, S_D, grad );
+    case 5: return nd_kernel<5>( pZ, DD, C, base, V, V_D, S, S_D, grad );
+    }
+    static_assert( max_dim == 6, "SplineND::evalCell, a kernel for each dimension" );
+    return nd_kernel<6>( pZ, DD, C, base, V, V_D, S, S_D, grad );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineND::eval( real_type const x[], integer hint[] ) const {
+    SPLINE_ASSERT(
+      this->_dim > 0, "SplineND::eval, spline `" << this->_name << "` not built"
+    )
+    real_type xx[max_dim];
+    std::copy( x, x+this->_dim, xx );
+    this->search( xx, hint );
+    return this->evalCell( xx, hint, nullptr );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineND::eval( real_type const x[] ) const {
+    integer hint[max_dim] = {};
+    return this->eval( x, hint );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineND::eval_D(
+    real_type const x[],
+    real_type       grad[],
+    integer         hint[]
+  ) const {
+    SPLINE_ASSERT(
+      this->_dim > 0, "SplineND::eval_D, spline `" << this->_name << "` not built"
+    )
+    real_type xx[max_dim];
+    std::copy( x, x+this->_dim, xx );
+    this->search( xx, hint );
+    return this->evalCell( xx, hint, grad );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineND::eval_D( real_type const x[], real_type grad[] ) const {
+    integer hint[max_dim] = {};
+    return this->eval_D( x, grad, hint );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineND::eval(
+    real_type const x[],
+    integer         ldX,
+    size_t          n,
+    real_type       values[],
+    integer         nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->_dim > 0, "SplineND::eval, spline `" << this->_name << "` not built"
+    )
+    SPLINE_ASSERT(
+      ldX >= this->_dim,
+      "SplineND::eval, ldX = " << ldX << " must be >= " << this->_dim
+    )
+    parallel_chunks( n, nthreads, [this,x,ldX,values]( size_t p0, size_t p1 ) {
+      integer hint[max_dim] = {};
+      for ( size_t p = p0; p < p1; ++p )
+        values[p] = this->eval( x + p*size_t(ldX), hint );
+    } );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineND::eval_D(
+    real_type const x[],
+    integer         ldX,
+    size_t          n,
+    real_type       out[],
+    integer         nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->_dim > 0, "SplineND::eval_D, spline `" << this->_name << "` not built"
+    )
+    SPLINE_ASSERT(
+      ldX >= this->_dim,
+      "SplineND::eval_D, ldX = " << ldX << " must be >= " << this->_dim
+    )
+    size_t ld = size_t(this->_dim+1);
+    parallel_chunks( n, nthreads, [this,x,ldX,out,ld]( size_t p0, size_t p1 ) {
+      integer hint[max_dim] = {};
+      for ( size_t p = p0; p < p1; ++p ) {
+        real_type * o = out + p*ld;
+        o[0] = this->eval_D( x + p*size_t(ldX), o+1, hint );
+      }
+    } );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineND::info( ostream & s ) const {
+    s << "Tensor product spline [" << this->name() << "] of type = "
+      << (this->_type == LINEAR_TYPE ? "multilinear" : spline_type_1D[this->_type])
+      << " dimension = " << this->_dim;
+    for ( integer k = 0; k < this->_dim; ++k )
+      s << (k == 0 ? " grid = " : " x ") << this->_npts[k];
+    s << '\n';
+  }
+
+}
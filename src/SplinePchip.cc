@@ -118,7 +118,9 @@ namespace Splines {
   Pchip_build(
     real_type const X[],
     real_type const Y[],
+    integer         incY,
     real_type       Yp[],
+    integer         incYp,
     integer         npts
   ) {
 
@@ -128,14 +130,14 @@ namespace Splines {
 
     // function definition is ok, go on.
     real_type h1    = X[1] - X[0];
-    real_type del1  = (Y[1]-Y[0])/h1;
+    real_type del1  = (Y[incY]-Y[0])/h1;
     real_type dsave = del1;
 
     // special case n=2 -- use linear interpolation.
-    if ( n == 1 ) { Yp[0] = Yp[1] = del1; return; }
+    if ( n == 1 ) { Yp[0] = Yp[incYp] = del1; return; }
 
     real_type h2   = X[2] - X[1];
-    real_type del2 = (Y[2]-Y[1])/h2;
+    real_type del2 = (Y[2*incY]-Y[incY])/h2;
 
     // Set Yp[0] via non-centered three-point formula, adjusted to be shape-preserving.
     real_type hsum = h1 + h2;
@@ -158,10 +160,10 @@ namespace Splines {
         h2   = X[i+1] - X[i];
         hsum = h1 + h2;
         del1 = del2;
-        del2 = (Y[i+1] - Y[i])/h2;
+        del2 = (Y[(i+1)*incY] - Y[i*incY])/h2;
       }
       // set Yp[i]=0 unless data are strictly monotonic.
-      Yp[i] = 0;
+      Yp[i*incYp] = 0;
       // count number of changes in direction of monotonicity.
       switch ( signTest(del1,del2) ) {
       case -1:
@@ -180,24 +182,36 @@ namespace Splines {
         dmin = min_abs( del1, del2 );
         real_type drat1 = del1/dmax;
         real_type drat2 = del2/dmax;
-        Yp[i] = dmin/(w1*drat1 + w2*drat2);
+        Yp[i*incYp] = dmin/(w1*drat1 + w2*drat2);
         break;
       }
     }
     // set Yp[n] via non-centered three-point formula, adjusted to be shape-preserving.
     w1 = -h2/hsum;
     w2 = (h2 + hsum)/hsum;
-    Yp[n] = w1*del1 + w2*del2;
-    if ( signTest(Yp[n],del2) <= 0 ) {
-      Yp[n] = 0;
+    Yp[n*incYp] = w1*del1 + w2*del2;
+    if ( signTest(Yp[n*incYp],del2) <= 0 ) {
+      Yp[n*incYp] = 0;
     } else if ( signTest(del1,del2) < 0 ) {
       // need do this check only if monotonicity switches.
       dmax = 3*del2;
-      if ( abs(Yp[n]) > abs(dmax) ) Yp[n] = dmax;
+      if ( abs(Yp[n*incYp]) > abs(dmax) ) Yp[n*incYp] = dmax;
     }
     // cout << "ierr = " << ierr << '\n';
   }
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  Pchip_build(
+    real_type const X[],
+    real_type const Y[],
+    real_type       Yp[],
+    integer         npts
+  ) {
+    Pchip_build( X, Y, 1, Yp, 1, npts );
+  }
+
   void
   Pchip_build_new(
     real_type const X[],
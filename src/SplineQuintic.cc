@@ -50,8 +50,11 @@ namespace Splines {
   QuinticSpline_Yppp_continuous(
     real_type const X[],
     real_type const Y[],
+    integer         incY,
     real_type const Yp[],
+    integer         incYp,
     real_type       Ypp[],
+    integer         incYpp,
     integer         npts,
     bool            setbc
   ) {
@@ -73,14 +76,14 @@ namespace Splines {
       real_type hR  = X[i+1] - X[i];
       real_type hR2 = hR*hR;
       real_type hR3 = hR*hR2;
-      real_type DL  = 60*(Y[i]-Y[i-1])/hL3;
-      real_type DR  = 60*(Y[i+1]-Y[i])/hR3;
-      real_type DDL = (36*Yp[i]+24*Yp[i-1])/hL2;
-      real_type DDR = (36*Yp[i]+24*Yp[i+1])/hR2;
+      real_type DL  = 60*(Y[i*incY]-Y[(i-1)*incY])/hL3;
+      real_type DR  = 60*(Y[(i+1)*incY]-Y[i*incY])/hR3;
+      real_type DDL = (36*Yp[i*incYp]+24*Yp[(i-1)*incYp])/hL2;
+      real_type DDR = (36*Yp[i*incYp]+24*Yp[(i+1)*incYp])/hR2;
       L[i] = -3/hL;
       D[i] = 9/hL+9/hR;
       U[i] = -3/hR;
-      Z[i] = DR-DL+DDL-DDR;
+      Z[i*incYpp] = DR-DL+DDL-DDR;
     }
     L[0] = U[0] = 0; D[0] = 1;
     L[n] = U[n] = 0; D[n] = 1;
@@ -88,99 +91,149 @@ namespace Splines {
       {
         real_type hL = X[1] - X[0];
         real_type hR = X[2] - X[1];
-        real_type SL = (Y[1]-Y[0])/hL;
-        real_type SR = (Y[2]-Y[1])/hR;
-        real_type dp0 = Yp[1];
+        real_type SL = (Y[incY]-Y[0])/hL;
+        real_type SR = (Y[2*incY]-Y[incY])/hR;
+        real_type dp0 = Yp[incYp];
         real_type dpL = Yp[0];
-        real_type dpR = Yp[2];
+        real_type dpR = Yp[2*incYp];
         Z[0] = second_deriv3p_L( SL, hL, SR, hR, dpL, dp0, dpR );
       }
       {
         real_type hL = X[n-1] - X[n-2];
         real_type hR = X[n] - X[n-1];
-        real_type SL = (Y[n-1]-Y[n-2])/hL;
-        real_type SR = (Y[n]-Y[n-1])/hR;
-        real_type dp0 = Yp[n-1];
-        real_type dpL = Yp[n-2];
-        real_type dpR = Yp[n];
-        Z[n] = second_deriv3p_R( SL, hL, SR, hR, dpL, dp0, dpR );
+        real_type SL = (Y[(n-1)*incY]-Y[(n-2)*incY])/hL;
+        real_type SR = (Y[n*incY]-Y[(n-1)*incY])/hR;
+        real_type dp0 = Yp[(n-1)*incYp];
+        real_type dpL = Yp[(n-2)*incYp];
+        real_type dpR = Yp[n*incYp];
+        Z[n*incYpp] = second_deriv3p_R( SL, hL, SR, hR, dpL, dp0, dpR );
       }
     }
 
     i = 0;
     do {
-      Z[i]   /= D[i];
+      Z[i*incYpp]   /= D[i];
       U[i]   /= D[i];
       D[i+1] -= L[i+1] * U[i];
-      Z[i+1] -= L[i+1] * Z[i];
+      Z[(i+1)*incYpp] -= L[i+1] * Z[i*incYpp];
     } while ( ++i < n );
 
-    Z[i] /= D[i];
+    Z[i*incYpp] /= D[i];
 
     do {
       --i;
-      Z[i] -= U[i] * Z[i+1];
+      Z[i*incYpp] -= U[i] * Z[(i+1)*incYpp];
     } while ( i > 0 );
   }
 
+  // periodic version, Y[n] == Y[0] and Yp[n] == Yp[0]
+  static
+  void
+  QuinticSpline_Yppp_periodic(
+    real_type const X[],
+    real_type const Y[],
+    integer         incY,
+    real_type const Yp[],
+    integer         incYp,
+    real_type       Ypp[],
+    integer         incYpp,
+    integer         npts
+  ) {
+
+    size_t n = size_t(npts > 0 ? npts-1 : 0);
+
+    vector<real_type> buffer(4*(n+1));
+    real_type * ptr = &buffer.front();
+    real_type * L = ptr; ptr += npts;
+    real_type * D = ptr; ptr += npts;
+    real_type * U = ptr; ptr += npts;
+    real_type * Q = ptr;
+    real_type * Z = Ypp;
+    real_type   E[2];
+
+    for ( size_t i = 0; i < n; ++i ) {
+      size_t    im  = i == 0 ? n-1 : i-1;
+      real_type hL  = i == 0 ? X[n] - X[n-1] : X[i] - X[i-1];
+      real_type hL2 = hL*hL;
+      real_type hL3 = hL*hL2;
+      real_type hR  = X[i+1] - X[i];
+      real_type hR2 = hR*hR;
+      real_type hR3 = hR*hR2;
+      real_type DL  = 60*(Y[i*incY]-Y[im*incY])/hL3;
+      real_type DR  = 60*(Y[(i+1)*incY]-Y[i*incY])/hR3;
+      real_type DDL = (36*Yp[i*incYp]+24*Yp[im*incYp])/hL2;
+      real_type DDR = (36*Yp[i*incYp]+24*Yp[(i+1)*incYp])/hR2;
+      L[i] = -3/hL;
+      D[i] = 9/hL+9/hR;
+      U[i] = -3/hR;
+      Z[i*incYpp] = DR-DL+DDL-DDR;
+    }
+    cyclic_tridiag_factorize( integer(n), L, D, U, Q, E );
+    cyclic_tridiag_solve( integer(n), L, D, U, Q, E, Z, incYpp );
+    Z[n*incYpp] = Z[0];
+  }
+
   static
   void
   QuinticSpline_Ypp_build(
     real_type const X[],
     real_type const Y[],
+    integer         incY,
     real_type const Yp[],
+    integer         incYp,
     real_type       Ypp[],
+    integer         incYpp,
     integer         npts
   ) {
 
     size_t n = size_t(npts > 0 ? npts-1 : 0);
 
-    if ( n == 1 ) { Ypp[0] = Ypp[1] = 0; return; }
+    if ( n == 1 ) { Ypp[0] = Ypp[incYpp] = 0; return; }
 
     {
       real_type hL = X[1] - X[0];
       real_type hR = X[2] - X[1];
-      real_type SL = (Y[1] - Y[0])/hL;
-      real_type SR = (Y[2] - Y[1])/hR;
+      real_type SL = (Y[incY] - Y[0])/hL;
+      real_type SR = (Y[2*incY] - Y[incY])/hR;
       //Ypp[0] = (2*SL-SR)*al+SL*be;
       //Ypp[0] = second_deriv3p_L( SL, hL, SR, hR, Yp[0] );
-      Ypp[0] = second_deriv3p_L( SL, hL, SR, hR, Yp[0], Yp[1], Yp[2] );
+      Ypp[0] = second_deriv3p_L( SL, hL, SR, hR, Yp[0], Yp[incYp], Yp[2*incYp] );
     }
     {
       real_type hL = X[n-1] - X[n-2];
       real_type hR = X[n] - X[n-1];
-      real_type SL = (Y[n-1] - Y[n-2])/hL;
-      real_type SR = (Y[n] - Y[n-1])/hR;
+      real_type SL = (Y[(n-1)*incY] - Y[(n-2)*incY])/hL;
+      real_type SR = (Y[n*incY] - Y[(n-1)*incY])/hR;
       //Ypp[n] = (2*SR-SL)*be+SR*al;
       //Ypp[n] = second_deriv3p_R( SL, hL, SR, hR, Yp[n] );
-      Ypp[n] = second_deriv3p_R( SL, hL, SR, hR, Yp[n-2], Yp[n-1], Yp[n] );
+      Ypp[n*incYpp] = second_deriv3p_R( SL, hL, SR, hR, Yp[(n-2)*incYp], Yp[(n-1)*incYp], Yp[n*incYp] );
     }
 
     size_t i;
     for ( i = 1; i < n; ++i ) {
       real_type hL = X[i] - X[i-1];
       real_type hR = X[i+1] - X[i];
-      real_type SL = (Y[i] - Y[i-1])/hL;
-      real_type SR = (Y[i+1] - Y[i])/hR;
+      real_type SL = (Y[i*incY] - Y[(i-1)*incY])/hL;
+      real_type SR = (Y[(i+1)*incY] - Y[i*incY])/hR;
       //Ypp[i] = second_deriv3p_C( SL, hL, SR, hR, Yp[i] );
-      real_type ddC = second_deriv3p_C( SL, hL, SR, hR, Yp[i-1], Yp[i], Yp[i+1] );
+      real_type ddC = second_deriv3p_C( SL, hL, SR, hR, Yp[(i-1)*incYp], Yp[i*incYp], Yp[(i+1)*incYp] );
       if ( i > 1 ) {
         real_type hLL = X[i-1] - X[i-2];
-        real_type SLL = (Y[i-1] - Y[i-2])/hLL;
+        real_type SLL = (Y[(i-1)*incY] - Y[(i-2)*incY])/hLL;
         //real_type dd  = second_deriv3p_R( SLL, hLL, SL, hR, Yp[i] );
-        real_type ddL = second_deriv3p_R( SLL, hLL, SL, hR, Yp[i-2], Yp[i-1], Yp[i] );
+        real_type ddL = second_deriv3p_R( SLL, hLL, SL, hR, Yp[(i-2)*incYp], Yp[(i-1)*incYp], Yp[i*incYp] );
         if      ( ddL * ddC < 0 ) ddC = 0;
         else if ( std::abs(ddL) < std::abs(ddC) ) ddC = ddL;
       }
       if ( i < n-1 ) {
         real_type hRR = X[i+2] - X[i+1];
-        real_type SRR = (Y[i+2] - Y[i+1])/hRR;
+        real_type SRR = (Y[(i+2)*incY] - Y[(i+1)*incY])/hRR;
         //real_type dd = second_deriv3p_L( SR, hR, SRR, hRR, Yp[i] );
-        real_type ddR = second_deriv3p_L( SR, hR, SRR, hRR, Yp[i], Yp[i+1], Yp[i+2] );
+        real_type ddR = second_deriv3p_L( SR, hR, SRR, hRR, Yp[i*incYp], Yp[(i+1)*incYp], Yp[(i+2)*incYp] );
         if      ( ddR * ddC < 0 ) ddC = 0;
         else if ( std::abs(ddR) < std::abs(ddC) ) ddC = ddR;
       }
-      Ypp[i] = ddC;
+      Ypp[i*incYpp] = ddC;
     }
   }
 
@@ -196,14 +249,16 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  static
   void
   Quintic_build(
     QUINTIC_SPLINE_TYPE q_sub_type,
     real_type const     X[],
     real_type const     Y[],
+    integer             incY,
     real_type           Yp[],
+    integer             incYp,
     real_type           Ypp[],
+    integer             incYpp,
     integer             npts
   ) {
     switch ( q_sub_type ) {
@@ -216,22 +271,56 @@ namespace Splines {
         real_type * D   = ptr; ptr += npts;
         real_type * U   = ptr;
         CubicSpline_build(
-          X, Y, Yp, Ypp, L, D, U, npts, EXTRAPOLATE_BC, EXTRAPOLATE_BC
+          X, Y, incY, Yp, incYp, Ypp, incYpp,
+          L, D, U, npts, EXTRAPOLATE_BC, EXTRAPOLATE_BC
+        );
+        QuinticSpline_Yppp_continuous(
+          X, Y, incY, Yp, incYp, Ypp, incYpp, npts, false
+        );
+      }
+      return;
+    case PERIODIC_QUINTIC:
+      {
+        size_t n = size_t(npts > 0 ? npts-1 : 0);
+        vector<real_type> buffer(3*(n+1));
+        real_type * ptr = &buffer.front();
+        real_type * L   = ptr; ptr += npts;
+        real_type * D   = ptr; ptr += npts;
+        real_type * U   = ptr;
+        CubicSpline_build(
+          X, Y, incY, Yp, incYp, Ypp, incYpp,
+          L, D, U, npts, PERIODIC_BC, PERIODIC_BC
+        );
+        QuinticSpline_Yppp_periodic(
+          X, Y, incY, Yp, incYp, Ypp, incYpp, npts
         );
-        QuinticSpline_Yppp_continuous( X, Y, Yp, Ypp, npts, false );
       }
       return;
     case PCHIP_QUINTIC:
-      Pchip_build( X, Y, Yp, npts );
+      Pchip_build( X, Y, incY, Yp, incYp, npts );
       break;
     case AKIMA_QUINTIC:
-      Akima_build( X, Y, Yp, npts );
+      Akima_build( X, Y, incY, Yp, incYp, npts );
       break;
     case BESSEL_QUINTIC:
-      Bessel_build( X, Y, Yp, npts );
+      Bessel_build( X, Y, incY, Yp, incYp, npts );
       break;
     }
-    QuinticSpline_Ypp_build( X, Y, Yp, Ypp, npts );
+    QuinticSpline_Ypp_build( X, Y, incY, Yp, incYp, Ypp, incYpp, npts );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  Quintic_build(
+    QUINTIC_SPLINE_TYPE q_sub_type,
+    real_type const     X[],
+    real_type const     Y[],
+    real_type           Yp[],
+    real_type           Ypp[],
+    integer             npts
+  ) {
+    Quintic_build( q_sub_type, X, Y, 1, Yp, 1, Ypp, 1, npts );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -244,11 +333,23 @@ namespace Splines {
     )
     integer ibegin = 0;
     integer iend   = 0;
+    bool    whole  = true;
     do {
       // cerca intervallo monotono strettamente crescente
       while ( ++iend < this->npts && this->X[iend-1] < this->X[iend] ) {}
+      // periodic only on the whole range
+      QUINTIC_SPLINE_TYPE qt = this->q_sub_type;
+      if ( qt == PERIODIC_QUINTIC && ( ibegin > 0 || iend < this->npts ) ) {
+        qt    = CUBIC_QUINTIC;
+        whole = false;
+      }
+      SPLINE_ASSERT(
+        qt != PERIODIC_QUINTIC || periodic_ends_match( this->Y, 1, this->npts ),
+        "QuinticSpline::build(): PERIODIC_QUINTIC needs Y[npts-1] == Y[0], found " <<
+        this->Y[this->npts-1] << " and " << this->Y[0]
+      )
       Quintic_build(
-        this->q_sub_type,
+        qt,
         this->X+ibegin,  this->Y+ibegin,
         this->Yp+ibegin, this->Ypp+ibegin,
         iend - ibegin
@@ -256,6 +357,8 @@ namespace Splines {
       ibegin = iend;
     } while ( iend < this->npts );
 
+    if ( this->q_sub_type == PERIODIC_QUINTIC && whole ) this->make_closed();
+
     SPLINE_CHECK_NAN( this->Yp,  "QuinticSpline::build(): Yp",  this->npts );
     SPLINE_CHECK_NAN( this->Ypp, "QuinticSpline::build(): Ypp", this->npts );
   }
@@ -301,6 +404,7 @@ namespace Splines {
       else if ( st == "pchip"  ) this->q_sub_type = PCHIP_QUINTIC;
       else if ( st == "akima"  ) this->q_sub_type = AKIMA_QUINTIC;
       else if ( st == "bessel" ) this->q_sub_type = BESSEL_QUINTIC;
+      else if ( st == "periodic" ) this->q_sub_type = PERIODIC_QUINTIC;
       else {
         SPLINE_DO_ERROR(
           "QuinticSpline[" << this->_name << "]::setup unknow sub type:" << st
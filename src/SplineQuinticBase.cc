@@ -46,6 +46,7 @@ namespace Splines {
     this->npts            = 0;
     this->npts_reserved   = n;
     this->_external_alloc = true;
+    this->_is_view        = false;
     this->X               = p_X;
     this->Y               = p_Y;
     this->Yp              = p_Yp;
@@ -54,6 +55,83 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  QuinticSplineBase::build_view(
+    real_type const x[],
+    real_type const y[],
+    integer         n,
+    real_type const yp[],
+    real_type const ypp[]
+  ) {
+    SPLINE_ASSERT(
+      n > 1,
+      "QuinticSplineBase::build_view, npts = " << n << " not enought points"
+    )
+    SPLINE_ASSERT(
+      (yp == nullptr) == (ypp == nullptr),
+      "QuinticSplineBase::build_view, `yp` and `ypp` must be both given or both nullptr"
+    )
+    this->npts            = n;
+    this->npts_reserved   = n;
+    this->_external_alloc = false;
+    this->_is_view        = true;
+    // the view is never written: the const_cast only match the storage type
+    this->X = const_cast<real_type*>(x);
+    this->Y = const_cast<real_type*>(y);
+    this->initLastInterval();
+    if ( yp != nullptr ) {
+      this->baseValue.free();
+      this->Yp  = const_cast<real_type*>(yp);
+      this->Ypp = const_cast<real_type*>(ypp);
+    } else {
+      this->baseValue.allocate( size_t(2*n) );
+      this->Yp  = this->baseValue( size_t(n) );
+      this->Ypp = this->baseValue( size_t(n) );
+      this->build();
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  QuinticSplineBase::build_view(
+    real_type const x[],   integer incx,
+    real_type const y[],   integer incy,
+    integer         n,
+    real_type const yp[],  integer incyp,
+    real_type const ypp[], integer incypp
+  ) {
+    if ( incx == 1 && incy == 1 &&
+         ( yp  == nullptr || incyp  == 1 ) &&
+         ( ypp == nullptr || incypp == 1 ) ) {
+      this->build_view( x, y, n, yp, ypp );
+      return;
+    }
+    SPLINE_ASSERT(
+      n > 1,
+      "QuinticSplineBase::build_view, npts = " << n << " not enought points"
+    )
+    SPLINE_ASSERT(
+      (yp == nullptr) == (ypp == nullptr),
+      "QuinticSplineBase::build_view, `yp` and `ypp` must be both given or both nullptr"
+    )
+    // the evaluation needs contiguous nodes, copy them
+    if ( yp == nullptr ) {
+      this->build( x, incx, y, incy, n );
+    } else {
+      this->reserve( n );
+      for ( size_t i = 0; i < size_t(n); ++i ) {
+        this->X[i]   = x[i*size_t(incx)];
+        this->Y[i]   = y[i*size_t(incy)];
+        this->Yp[i]  = yp[i*size_t(incyp)];
+        this->Ypp[i] = ypp[i*size_t(incypp)];
+      }
+      this->npts = n;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   QuinticSplineBase::reserve( integer n ) {
     if ( this->_external_alloc && n <= this->npts_reserved ) {
@@ -67,10 +145,8 @@ namespace Splines {
       this->Yp              = this->baseValue( size_t(n) );
       this->Ypp             = this->baseValue( size_t(n) );
     }
-    {
-      std::lock_guard<std::mutex> lck(lastInterval_mutex);
-      lastInterval_by_thread[std::this_thread::get_id()] = 0;
-    }
+    this->_is_view = false;
+    this->initLastInterval();
     this->npts = 0;
   }
 
@@ -81,6 +157,7 @@ namespace Splines {
     if ( !this->_external_alloc ) this->baseValue.free();
     this->npts = this->npts_reserved = 0;
     this->_external_alloc = false;
+    this->_is_view        = false;
     this->X = this->Y = this->Yp = this->Ypp = nullptr;
   }
 
@@ -170,6 +247,33 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  QuinticSplineBase::jet( real_type x, integer order, real_type J[] ) const {
+    SPLINE_ASSERT(
+      order >= 0 && order <= 5,
+      "QuinticSplineBase::jet, order = " << order << " must be in [0,5]"
+    )
+    size_t    i  = size_t(this->search( x ));
+    real_type x0 = this->X[i];
+    real_type H  = this->X[i+1] - x0;
+    real_type base[6];
+    for ( integer k = 0; k <= order; ++k ) {
+      switch ( k ) {
+      case 0: Hermite5( x-x0, H, base );       break;
+      case 1: Hermite5_D( x-x0, H, base );     break;
+      case 2: Hermite5_DD( x-x0, H, base );    break;
+      case 3: Hermite5_DDD( x-x0, H, base );   break;
+      case 4: Hermite5_DDDD( x-x0, H, base );  break;
+      case 5: Hermite5_DDDDD( x-x0, H, base ); break;
+      }
+      J[k] = base[0] * this->Y[i]   + base[1] * this->Y[i+1]  +
+             base[2] * this->Yp[i]  + base[3] * this->Yp[i+1] +
+             base[4] * this->Ypp[i] + base[5] * this->Ypp[i+1];
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   integer // order
   QuinticSplineBase::coeffs(
     real_type cfs[],
@@ -21,6 +21,8 @@
 #include "SplinesUtils.hh"
 
 #include <limits>
+#include <cstring>
+#include <new>
 #include <cmath>
 
 #ifdef __clang__
@@ -43,7 +45,6 @@ namespace Splines {
   SplineSet::SplineSet( string const & name )
   : _name(name)
   , baseValue(name+"_values")
-  , basePointer(name+"_pointers")
   , _npts(0)
   , _nspl(0)
   , _X(nullptr)
@@ -59,10 +60,121 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  SplineSet::SplineSet( SplineSet && s ) noexcept
+  : _name(std::move(s._name))
+  , baseValue(std::move(s.baseValue))
+  , _npts(s._npts)
+  , _nspl(s._nspl)
+  , _X(s._X)
+  , _Y(s._Y)
+  , _Yp(s._Yp)
+  , _Ypp(s._Ypp)
+  , _Ymin(s._Ymin)
+  , _Ymax(s._Ymax)
+  , splines(std::move(s.splines))
+  , is_monotone(std::move(s.is_monotone))
+  , header_to_position(std::move(s.header_to_position))
+  {
+    s._npts = s._nspl = 0;
+    s._X    = s._Ymin = s._Ymax = nullptr;
+    s._Y    = s._Yp   = s._Ypp  = nullptr;
+    s.splines.clear();
+    s.is_monotone.clear();
+    s.header_to_position.clear();
+    std::lock_guard<std::mutex> lck(s.lastInterval_mutex);
+    lastInterval_by_thread.swap( s.lastInterval_by_thread );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineSet &
+  SplineSet::operator = ( SplineSet && s ) noexcept {
+    if ( this != &s ) {
+      this->destroySplines();
+      _name              = std::move(s._name);
+      baseValue          = std::move(s.baseValue);
+      _npts              = s._npts;
+      _nspl              = s._nspl;
+      _X                 = s._X;
+      _Y                 = s._Y;
+      _Yp                = s._Yp;
+      _Ypp               = s._Ypp;
+      _Ymin              = s._Ymin;
+      _Ymax              = s._Ymax;
+      splines            = std::move(s.splines);
+      is_monotone        = std::move(s.is_monotone);
+      header_to_position = std::move(s.header_to_position);
+      s._npts = s._nspl = 0;
+      s._X    = s._Ymin = s._Ymax = nullptr;
+      s._Y    = s._Yp   = s._Ypp  = nullptr;
+      s.splines.clear();
+      s.is_monotone.clear();
+      s.header_to_position.clear();
+      std::lock( lastInterval_mutex, s.lastInterval_mutex );
+      std::lock_guard<std::mutex> lck1(lastInterval_mutex, std::adopt_lock);
+      std::lock_guard<std::mutex> lck2(s.lastInterval_mutex, std::adopt_lock);
+      lastInterval_by_thread.swap( s.lastInterval_by_thread );
+      s.lastInterval_by_thread.clear();
+    }
+    return *this;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   //! spline destructor
   SplineSet::~SplineSet() {
+    this->destroySplines();
     baseValue.free();
-    basePointer.free();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*
+  // The splines are constructed with placement new in `baseValue`:
+  // only the destructor is called, the memory is released (or reused)
+  // together with the arena.
+  */
+  void
+  SplineSet::destroySplines() {
+    for ( size_t spl = 0; spl < this->splines.size(); ++spl )
+      if ( this->splines[spl] != nullptr ) this->splines[spl]->~Spline();
+    this->splines.clear();
+    this->header_to_position.clear();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //! number of `real_type` slots of the arena used by `n` objects of type `T`
+  template <typename T>
+  static
+  inline
+  size_t
+  arena_slots( size_t n ) {
+    static_assert(
+      alignof(T) <= alignof(real_type),
+      "SplineSet arena: object alignment exceed the one of real_type"
+    );
+    return (n*sizeof(T)+sizeof(real_type)-1)/sizeof(real_type);
+  }
+
+  //! slots of the arena used by the object of a spline of type `tp`
+  static
+  size_t
+  arena_spline_slots( SplineType1D tp ) {
+    switch ( tp ) {
+    case CONSTANT_TYPE:   return arena_slots<ConstantSpline>(1);
+    case LINEAR_TYPE:     return arena_slots<LinearSpline>(1);
+    case CUBIC_TYPE:      return arena_slots<CubicSpline>(1);
+    case AKIMA_TYPE:      return arena_slots<AkimaSpline>(1);
+    case BESSEL_TYPE:     return arena_slots<BesselSpline>(1);
+    case PCHIP_TYPE:      return arena_slots<PchipSpline>(1);
+    case HERMITE_TYPE:    return arena_slots<HermiteSpline>(1);
+    case QUINTIC_TYPE:    return arena_slots<QuinticSpline>(1);
+    case SPLINE_SET_TYPE:
+    case SPLINE_VEC_TYPE:
+      break;
+    }
+    return 0;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -140,11 +252,14 @@ namespace Splines {
       npts > 1,
       "SplineSet::build expected npts = " << npts << " greather than 1"
     )
+    // splines of a previous build live in the arena, destroy them first
+    this->destroySplines();
     this->_nspl = nspl;
     this->_npts = npts;
     // allocate memory
-    splines.resize(size_t(this->_nspl));
+    splines.resize(size_t(this->_nspl),nullptr);
     is_monotone.resize(size_t(this->_nspl));
+    size_t objs = 0;
     integer mem = npts;
     for ( integer spl = 0; spl < nspl; ++spl ) {
       switch (stype[size_t(spl)]) {
@@ -170,14 +285,18 @@ namespace Splines {
           " cannot be done for type = " << stype[spl]
         )
       }
+      objs += arena_spline_slots( stype[size_t(spl)] );
     }
 
-    this->baseValue   . allocate( size_t(mem + 2*nspl) );
-    this->basePointer . allocate( size_t(3*nspl) );
+    // one block: [ spline objects | Y, Yp, Ypp pointers | values ]
+    size_t ptrs = arena_slots<real_type*>(size_t(nspl));
+    this->baseValue.allocate( objs + 3*ptrs + size_t(mem + 2*nspl) );
 
-    this->_Y    = this->basePointer(size_t(this->_nspl));
-    this->_Yp   = this->basePointer(size_t(this->_nspl));
-    this->_Ypp  = this->basePointer(size_t(this->_nspl));
+    real_type * pObjs = this->baseValue(objs);
+
+    this->_Y    = reinterpret_cast<real_type**>(this->baseValue(ptrs));
+    this->_Yp   = reinterpret_cast<real_type**>(this->baseValue(ptrs));
+    this->_Ypp  = reinterpret_cast<real_type**>(this->baseValue(ptrs));
     this->_X    = this->baseValue(size_t(this->_npts));
     this->_Ymin = this->baseValue(size_t(this->_nspl));
     this->_Ymax = this->baseValue(size_t(this->_nspl));
@@ -223,18 +342,20 @@ namespace Splines {
       }
       string h = headers[spl];
       Spline * & s = splines[spl];
+      void * mem_spl = pObjs;
+      pObjs += arena_spline_slots( stype[spl] );
 
       is_monotone[spl] = -1;
       switch (stype[size_t(spl)]) {
       case CONSTANT_TYPE:
-        s = new ConstantSpline(h);
+        s = new (mem_spl) ConstantSpline(h);
         static_cast<ConstantSpline*>(s)->reserve_external( this->_npts, this->_X, pY );
         static_cast<ConstantSpline*>(s)->npts = _npts;
         static_cast<ConstantSpline*>(s)->build();
         break;
 
       case LINEAR_TYPE:
-        s = new LinearSpline(h);
+        s = new (mem_spl) LinearSpline(h);
         static_cast<LinearSpline*>(s)->reserve_external( this->_npts, this->_X, pY );
         static_cast<LinearSpline*>(s)->npts = _npts;
         static_cast<LinearSpline*>(s)->build();
@@ -249,7 +370,7 @@ namespace Splines {
         break;
 
       case CUBIC_TYPE:
-        s = new CubicSpline(h);
+        s = new (mem_spl) CubicSpline(h);
         static_cast<CubicSpline*>(s)->reserve_external( this->_npts, _X, pY, pYp );
         static_cast<CubicSpline*>(s)->npts = this->_npts;
         static_cast<CubicSpline*>(s)->build();
@@ -257,7 +378,7 @@ namespace Splines {
         break;
 
       case AKIMA_TYPE:
-        s = new AkimaSpline(h);
+        s = new (mem_spl) AkimaSpline(h);
         static_cast<AkimaSpline*>(s)->reserve_external( this->_npts, _X, pY, pYp );
         static_cast<AkimaSpline*>(s)->npts = this->_npts;
         static_cast<AkimaSpline*>(s)->build();
@@ -265,7 +386,7 @@ namespace Splines {
         break;
 
       case BESSEL_TYPE:
-        s = new BesselSpline(h);
+        s = new (mem_spl) BesselSpline(h);
         static_cast<BesselSpline*>(s)->reserve_external( this->_npts, this->_X, pY, pYp );
         static_cast<BesselSpline*>(s)->npts = this->_npts;
         static_cast<BesselSpline*>(s)->build();
@@ -273,7 +394,7 @@ namespace Splines {
         break;
 
       case PCHIP_TYPE:
-        s = new PchipSpline(h);
+        s = new (mem_spl) PchipSpline(h);
         static_cast<PchipSpline*>(s)->reserve_external( this->_npts, this->_X, pY, pYp );
         static_cast<PchipSpline*>(s)->npts = this->_npts;
         static_cast<PchipSpline*>(s)->build();
@@ -281,15 +402,15 @@ namespace Splines {
         break;
 
       case HERMITE_TYPE:
-        s = new HermiteSpline(h);
-        static_cast<CubicSpline*>(s)->reserve_external( this->_npts, this->_X, pY, pYp );
-        static_cast<CubicSpline*>(s)->npts = this->_npts;
-        static_cast<CubicSpline*>(s)->build();
+        s = new (mem_spl) HermiteSpline(h);
+        static_cast<HermiteSpline*>(s)->reserve_external( this->_npts, this->_X, pY, pYp );
+        static_cast<HermiteSpline*>(s)->npts = this->_npts;
+        static_cast<HermiteSpline*>(s)->build();
         is_monotone[spl] = checkCubicSplineMonotonicity( this->_X, pY, pYp, this->_npts );
         break;
 
       case QUINTIC_TYPE:
-        s = new QuinticSpline(h);
+        s = new (mem_spl) QuinticSpline(h);
         static_cast<QuinticSpline*>(s)->reserve_external( this->_npts, this->_X, pY, pYp, pYpp );
         static_cast<QuinticSpline*>(s)->npts = this->_npts;
         static_cast<QuinticSpline*>(s)->build();
@@ -309,9 +430,148 @@ namespace Splines {
       this->header_to_position[s->name()] = integer(spl);
     }
 
-    this->baseValue   . must_be_empty( "SplineSet::build, baseValue" );
-    this->basePointer . must_be_empty( "SplineSet::build, basePointer" );
+    this->baseValue.must_be_empty( "SplineSet::build, baseValue" );
+
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSet::writeBinary( ostream_type & s ) const {
+    size_t n       = size_t(this->_npts);
+    size_t nspl    = size_t(this->_nspl);
+    size_t payload = 16*nspl + (n+2*nspl)*sizeof(real_type);
+    for ( size_t spl = 0; spl < nspl; ++spl ) {
+      Spline const * S  = this->splines[spl];
+      integer        nd = binary_node_derivatives(
+        S->type(), "SplineSet::writeBinary"
+      );
+      payload += binary_pad8( S->name().size() );
+      payload += (1+size_t(nd))*n*sizeof(real_type);
+    }
+    binary_put_header(
+      s, BINARY_SPLINE_SET, SPLINE_SET_TYPE, 0, this->_name,
+      this->_npts, this->_nspl, payload
+    );
+    for ( size_t spl = 0; spl < nspl; ++spl ) {
+      Spline const * S = this->splines[spl];
+      binary_put_u32( s, std::uint32_t(S->type()) );
+      binary_put_u32( s, std::uint32_t(this->is_monotone[spl]) );
+      binary_put_u32( s, std::uint32_t(S->name().size()) );
+      binary_put_u32( s, 0 );
+    }
+    for ( size_t spl = 0; spl < nspl; ++spl ) {
+      string const & h = this->splines[spl]->name();
+      s.write( h.data(), std::streamsize(h.size()) );
+      binary_put_padding( s, h.size() );
+    }
+    binary_put_reals( s, this->_X,    n );
+    binary_put_reals( s, this->_Ymin, nspl );
+    binary_put_reals( s, this->_Ymax, nspl );
+    for ( size_t spl = 0; spl < nspl; ++spl ) {
+      binary_put_reals( s, this->_Y[spl], n );
+      if ( this->_Yp[spl]  != nullptr ) binary_put_reals( s, this->_Yp[spl],  n );
+      if ( this->_Ypp[spl] != nullptr ) binary_put_reals( s, this->_Ypp[spl], n );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSet::load_view( SplineBinaryFile const & f, integer irec ) {
+    SplineBinaryFile::Record const & rec = f.record( irec );
+    SPLINE_ASSERT(
+      rec.kind == BINARY_SPLINE_SET,
+      "SplineSet::load_view, record `" << rec.name << "` is of kind " <<
+      rec.kind << " expected " << BINARY_SPLINE_SET
+    )
+    SPLINE_ASSERT(
+      rec.n1 > 1 && rec.n2 > 0 && 16*size_t(rec.n2) <= rec.size,
+      "SplineSet::load_view, record `" << rec.name << "` bad sizes npts = " <<
+      rec.n1 << " nspl = " << rec.n2
+    )
+    size_t n    = size_t(rec.n1);
+    size_t nspl = size_t(rec.n2);
+
+    // table of (type,monotone,header length,0), check the size of the record
+    vector<std::uint32_t> table(4*nspl);
+    std::memcpy( table.data(), rec.data, 16*nspl );
+    size_t hdrs = 0;
+    size_t vals = n+2*nspl;
+    size_t objs = 0;
+    for ( size_t spl = 0; spl < nspl; ++spl ) {
+      SplineType1D tp = SplineType1D(table[4*spl]);
+      integer      nd = binary_node_derivatives( tp, "SplineSet::load_view" );
+      hdrs += binary_pad8( table[4*spl+2] );
+      vals += (1+size_t(nd))*n;
+      objs += arena_spline_slots( tp );
+    }
+    SPLINE_ASSERT(
+      16*nspl + hdrs + vals*sizeof(real_type) == rec.size,
+      "SplineSet::load_view, record `" << rec.name << "` has " << rec.size <<
+      " bytes of data, expected " << 16*nspl + hdrs + vals*sizeof(real_type)
+    )
+
+    this->destroySplines();
+    this->_name = rec.name;
+    this->_npts = rec.n1;
+    this->_nspl = rec.n2;
+    splines.resize(nspl,nullptr);
+    is_monotone.resize(nspl);
+
+    // the arena hold only [ spline objects | Y, Yp, Ypp pointers ]
+    size_t ptrs = arena_slots<real_type*>(nspl);
+    this->baseValue.allocate( objs + 3*ptrs );
+
+    real_type * pObjs = this->baseValue(objs);
+
+    this->_Y   = reinterpret_cast<real_type**>(this->baseValue(ptrs));
+    this->_Yp  = reinterpret_cast<real_type**>(this->baseValue(ptrs));
+    this->_Ypp = reinterpret_cast<real_type**>(this->baseValue(ptrs));
+
+    char const * pH = reinterpret_cast<char const *>(rec.data) + 16*nspl;
+    real_type const * pV = reinterpret_cast<real_type const *>(pH + hdrs);
+
+    // the file is never written: the const_cast only match the storage type
+    this->_X    = const_cast<real_type*>(pV); pV += n;
+    this->_Ymin = const_cast<real_type*>(pV); pV += nspl;
+    this->_Ymax = const_cast<real_type*>(pV); pV += nspl;
+
+    for ( size_t spl = 0; spl < nspl; ++spl ) {
+      SplineType1D tp = SplineType1D(table[4*spl]);
+      integer      nd = binary_node_derivatives( tp, "SplineSet::load_view" );
+      string       h( pH, table[4*spl+2] );
+      pH += binary_pad8( table[4*spl+2] );
+
+      real_type const * pY   = pV; pV += n;
+      real_type const * D[2] = { nullptr, nullptr };
+      for ( integer k = 0; k < nd; ++k, pV += n ) D[k] = pV;
+      this->_Y[spl]   = const_cast<real_type*>(pY);
+      this->_Yp[spl]  = const_cast<real_type*>(D[0]);
+      this->_Ypp[spl] = const_cast<real_type*>(D[1]);
+
+      Spline * & s = splines[spl];
+      void * mem_spl = pObjs;
+      pObjs += arena_spline_slots( tp );
+      switch ( tp ) {
+      case CONSTANT_TYPE: s = new (mem_spl) ConstantSpline(h); break;
+      case LINEAR_TYPE:   s = new (mem_spl) LinearSpline(h);   break;
+      case CUBIC_TYPE:    s = new (mem_spl) CubicSpline(h);    break;
+      case AKIMA_TYPE:    s = new (mem_spl) AkimaSpline(h);    break;
+      case BESSEL_TYPE:   s = new (mem_spl) BesselSpline(h);   break;
+      case PCHIP_TYPE:    s = new (mem_spl) PchipSpline(h);    break;
+      case HERMITE_TYPE:  s = new (mem_spl) HermiteSpline(h);  break;
+      case QUINTIC_TYPE:  s = new (mem_spl) QuinticSpline(h);  break;
+      case SPLINE_SET_TYPE:
+      case SPLINE_VEC_TYPE:
+        break; // rejected by binary_node_derivatives
+      }
+      binary_build_view( s, tp, this->_X, pY, D, this->_npts );
+      is_monotone[spl] = int(std::int32_t(table[4*spl+1]));
+      this->header_to_position[h] = integer(spl);
+    }
 
+    this->baseValue.must_be_empty( "SplineSet::load_view, baseValue" );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -18,7 +18,9 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 #include <limits>
+#include <algorithm>
 #include <cmath>
 
 #ifdef __clang__
@@ -48,9 +50,16 @@ namespace Splines {
   , _npts(0)
   , _curve_is_closed(false)
   , _curve_can_extend(true)
+  , _is_view(false)
   , _X(nullptr)
   , _Y(nullptr)
   , _Yp(nullptr)
+  , _use_interleaved(false)
+  , _YYp()
+  , _arc_t()
+  , _arc_s()
+  , _arc_idx()
+  , _kappa()
   {
     std::lock_guard<std::mutex> lck(lastInterval_mutex);
     lastInterval_by_thread[std::this_thread::get_id()] = 0;
@@ -58,6 +67,70 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  SplineVec::SplineVec( SplineVec && s ) noexcept
+  : _name(std::move(s._name))
+  , baseValue(std::move(s.baseValue))
+  , basePointer(std::move(s.basePointer))
+  , _dim(s._dim)
+  , _npts(s._npts)
+  , _curve_is_closed(s._curve_is_closed)
+  , _curve_can_extend(s._curve_can_extend)
+  , _is_view(s._is_view)
+  , _X(s._X)
+  , _Y(s._Y)
+  , _Yp(s._Yp)
+  , _use_interleaved(s._use_interleaved)
+  , _YYp(std::move(s._YYp))
+  , _arc_t(std::move(s._arc_t))
+  , _arc_s(std::move(s._arc_s))
+  , _arc_idx(std::move(s._arc_idx))
+  , _kappa(std::move(s._kappa))
+  {
+    s._dim = s._npts = 0;
+    s._is_view = false;
+    s._X   = nullptr;
+    s._Y   = s._Yp = nullptr;
+    std::lock_guard<std::mutex> lck(s.lastInterval_mutex);
+    lastInterval_by_thread.swap( s.lastInterval_by_thread );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineVec &
+  SplineVec::operator = ( SplineVec && s ) noexcept {
+    if ( this != &s ) {
+      _name             = std::move(s._name);
+      baseValue         = std::move(s.baseValue);
+      basePointer       = std::move(s.basePointer);
+      _dim              = s._dim;
+      _npts             = s._npts;
+      _curve_is_closed  = s._curve_is_closed;
+      _curve_can_extend = s._curve_can_extend;
+      _is_view          = s._is_view;
+      _X                = s._X;
+      _Y                = s._Y;
+      _Yp               = s._Yp;
+      _use_interleaved  = s._use_interleaved;
+      _YYp              = std::move(s._YYp);
+      _arc_t            = std::move(s._arc_t);
+      _arc_s            = std::move(s._arc_s);
+      _arc_idx          = std::move(s._arc_idx);
+      _kappa            = std::move(s._kappa);
+      s._dim = s._npts = 0;
+      s._is_view = false;
+      s._X   = nullptr;
+      s._Y   = s._Yp = nullptr;
+      std::lock( lastInterval_mutex, s.lastInterval_mutex );
+      std::lock_guard<std::mutex> lck1(lastInterval_mutex, std::adopt_lock);
+      std::lock_guard<std::mutex> lck2(s.lastInterval_mutex, std::adopt_lock);
+      lastInterval_by_thread.swap( s.lastInterval_by_thread );
+      s.lastInterval_by_thread.clear();
+    }
+    return *this;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   //! spline destructor
   SplineVec::~SplineVec() {
     baseValue.free();
@@ -101,8 +174,9 @@ namespace Splines {
     SPLINE_ASSERT(
       npts > 1, "SplineVec::build expected npts = " << npts << " greather than 1"
     )
-    _dim  = dim;
-    _npts = npts;
+    _dim     = dim;
+    _npts    = npts;
+    _is_view = false;
 
     baseValue   . allocate( size_t((2*dim+1)*npts) );
     basePointer . allocate( size_t(2*dim) );
@@ -119,6 +193,12 @@ namespace Splines {
     baseValue   . must_be_empty( "SplineVec::build, baseValue" );
     basePointer . must_be_empty( "SplineVec::build, basePointer" );
 
+    this->_YYp.clear(); // derivatives not yet computed
+    this->dropTables();
+
+    // the interval hints may be out of the new range
+    std::lock_guard<std::mutex> lck(lastInterval_mutex);
+    lastInterval_by_thread.clear();
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -153,75 +233,69 @@ namespace Splines {
 
   void
   SplineVec::setKnots( real_type const X[] ) {
+    SPLINE_ASSERT(
+      !this->_is_view, "SplineVec::setKnots, cannot modify a view spline"
+    )
     std::copy( X, X+_npts, _X );
+    this->dropTables();
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   void
   SplineVec::computeChords() {
-    size_t nn = size_t(_npts-1);
-    switch ( _dim ) {
-    case 2:
-      for ( size_t j = 0; j < nn; ++j ) {
-        real_type dx = _Y[0][j+1] - _Y[0][j];
-        real_type dy = _Y[1][j+1] - _Y[1][j];
-        _X[j] = hypot( dx, dy );
-      }
-      break;
-    case 3:
-      for ( size_t j = 0; j < nn; ++j ) {
-        real_type dx = _Y[0][j+1] - _Y[0][j];
-        real_type dy = _Y[1][j+1] - _Y[1][j];
-        real_type dz = _Y[2][j+1] - _Y[2][j];
-        _X[j] = hypot( dx, hypot( dy, dz ) );
-      }
-      break;
-    default:
-      for ( size_t j = 0; j < nn; ++j ) {
-        real_type l = 0;
-        for ( size_t k = 0; k < size_t(_dim); ++k ) {
-          real_type d = _Y[k][j+1] - _Y[k][j];
-          l += d*d;
-        }
-        _X[j] = sqrt(l);
-      }
-      break;
-    }
+    chord_pass( _dim, _npts, _Y, _X, nullptr );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   void
   SplineVec::setKnotsChordLength() {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "SplineVec::setKnotsChordLength, cannot modify a view spline"
+    )
     computeChords();
-    size_t    nn  = size_t(_npts-1);
-    real_type acc = 0;
-    for ( size_t j = 0; j <= nn; ++j ) {
-      real_type l = _X[j];
-      _X[j] = acc;
-      acc += l;
-    }
-    for ( size_t j = 1; j < nn; ++j ) _X[j] /= acc;
-    _X[nn] = 1;
+    knots_from_lengths( _npts, _X, _X );
+    this->dropTables();
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   void
   SplineVec::setKnotsCentripetal() {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "SplineVec::setKnotsCentripetal, cannot modify a view spline"
+    )
     computeChords();
-    size_t    nn  = size_t(this->_npts-1);
-    real_type acc = 0;
-    for ( size_t j = 0; j <= nn; ++j ) {
-      real_type l = sqrt(this->_X[j]);
-      this->_X[j] = acc;
-      acc += l;
-    }
-    for ( size_t j = 1; j < nn; ++j ) this->_X[j] /= acc;
-    this->_X[nn] = 1;
+    integer nn = this->_npts-1;
+    for ( integer j = 0; j < nn; ++j ) this->_X[j] = sqrt(this->_X[j]);
+    knots_from_lengths( this->_npts, this->_X, this->_X );
+    this->dropTables();
   }
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::setKnotsFoley() {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "SplineVec::setKnotsFoley, cannot modify a view spline"
+    )
+    std::vector<real_type> th(static_cast<size_t>(_npts));
+    chord_pass( _dim, _npts, _Y, _X, &th.front() );
+    turning_angles( _npts, _X, &th.front() );
+    turning_correction( _npts, _X, &th.front(), 1.5, _X );
+    knots_from_lengths( _npts, _X, _X );
+    this->dropTables();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   SplineVec::CatmullRom() {
+    SPLINE_ASSERT(
+      !this->_is_view, "SplineVec::CatmullRom, cannot modify a view spline"
+    )
     size_t n = size_t(_npts-1);
     size_t d = size_t(_dim);
     real_type l1, l2, ll, a, b;
@@ -254,6 +328,147 @@ namespace Splines {
       this->_Yp[k][n] = b*( this->_Y[k][n-2] - this->_Y[k][n] ) -
                         a*( this->_Y[k][n-1] - this->_Y[k][n] );
 
+    this->makeInterleaved();
+    this->dropTables();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::buildCubic(
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  ) {
+    SPLINE_ASSERT(
+      !this->_is_view, "SplineVec::buildCubic, cannot modify a view spline"
+    )
+    SPLINE_ASSERT(
+      this->_npts > 1,
+      "SplineVec::buildCubic, npts = " << this->_npts << " not enought points"
+    )
+    integer n = this->_npts;
+    vector<real_type> work( 5*size_t(n) );
+    real_type * L = &work.front();
+    real_type * D = L + n;
+    real_type * U = D + n;
+    real_type * Z = U + n;
+    real_type * Q = Z + n;
+    real_type   E[2];
+    SPLINE_ASSERT(
+      (bc0 == PERIODIC_BC) == (bcn == PERIODIC_BC),
+      "SplineVec::buildCubic, PERIODIC_BC must be given at both ends, got " <<
+      bc0 << " and " << bcn
+    )
+    if ( bc0 == PERIODIC_BC ) this->_curve_is_closed = true;
+    if ( this->_curve_is_closed ) {
+      for ( integer k = 0; k < this->_dim; ++k )
+        SPLINE_ASSERT(
+          periodic_ends_match( this->_Y[k], 1, n ),
+          "SplineVec::buildCubic, closed curve needs the last point equal to "
+          "the first, component " << k << ": " << this->_Y[k][n-1] <<
+          " and " << this->_Y[k][0]
+        )
+      CubicSpline_factorize_periodic( this->_X, L, D, U, Q, E, n );
+      for ( integer k = 0; k < this->_dim; ++k )
+        CubicSpline_solve_periodic(
+          this->_X, this->_Y[k], 1, this->_Yp[k], 1, Z, 1, L, D, U, Q, E, n
+        );
+    } else {
+      CubicSpline_factorize( this->_X, L, D, U, E, n, bc0, bcn );
+      for ( integer k = 0; k < this->_dim; ++k )
+        CubicSpline_solve(
+          this->_X, this->_Y[k], 1, this->_Yp[k], 1, Z, 1,
+          L, D, U, E, n, bc0, bcn
+        );
+    }
+    this->makeInterleaved();
+    this->dropTables();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::makeInterleaved() {
+    if ( !this->_use_interleaved || this->_npts == 0 ) {
+      vector<real_type>().swap( this->_YYp ); // release the memory
+      return;
+    }
+    size_t d = size_t(this->_dim);
+    this->_YYp.resize( 2*d*size_t(this->_npts) );
+    real_type * p = &this->_YYp.front();
+    for ( size_t i = 0; i < size_t(this->_npts); ++i, p += 2*d ) {
+      for ( size_t k = 0; k < d; ++k ) {
+        p[k]   = this->_Y[k][i];
+        p[d+k] = this->_Yp[k][i];
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::useInterleaved( bool yes ) {
+    this->_use_interleaved = yes;
+    this->makeInterleaved();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // `DIM` fixed at compile time: the loop is unrolled and vectorized
+  template <int DIM>
+  static
+  inline
+  void
+  hermite_interleaved(
+    real_type const   base[4],
+    real_type const * p0,
+    real_type       * vals,
+    integer           inc
+  ) {
+    real_type const * p1 = p0 + 2*DIM;
+    real_type v[DIM];
+    for ( int k = 0; k < DIM; ++k )
+      v[k] = base[0] * p0[k]     +
+             base[1] * p1[k]     +
+             base[2] * p0[DIM+k] +
+             base[3] * p1[DIM+k];
+    for ( int k = 0; k < DIM; ++k ) vals[k*inc] = v[k];
+  }
+
+  void
+  SplineVec::evalBase(
+    real_type const base[4],
+    size_t          i,
+    real_type       vals[],
+    integer         inc
+  ) const {
+    size_t d = size_t(this->_dim);
+    if ( this->_YYp.empty() ) {
+      real_type * v = vals;
+      for ( size_t j = 0; j < d; ++j, v += inc )
+        *v = base[0] * this->_Y[j][i]   +
+             base[1] * this->_Y[j][i+1] +
+             base[2] * this->_Yp[j][i]  +
+             base[3] * this->_Yp[j][i+1];
+      return;
+    }
+    real_type const * p0 = &this->_YYp[2*d*i];
+    switch ( d ) {
+    case 2: hermite_interleaved<2>( base, p0, vals, inc ); break;
+    case 3: hermite_interleaved<3>( base, p0, vals, inc ); break;
+    case 6: hermite_interleaved<6>( base, p0, vals, inc ); break;
+    default:
+      {
+        real_type const * p1 = p0 + 2*d;
+        real_type       * v  = vals;
+        for ( size_t j = 0; j < d; ++j, v += inc )
+          *v = base[0] * p0[j]   +
+               base[1] * p1[j]   +
+               base[2] * p0[d+j] +
+               base[3] * p1[d+j];
+      }
+      break;
+    }
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -319,12 +534,7 @@ namespace Splines {
     size_t i = size_t(this->search( x ));
     real_type base[4];
     Hermite3( x-this->_X[i], this->_X[i+1]-this->_X[i], base );
-    real_type * v = vals;
-    for ( size_t j = 0; j < size_t(this->_dim); ++j, v += inc )
-      *v = base[0] * this->_Y[j][i]   +
-           base[1] * this->_Y[j][i+1] +
-           base[2] * this->_Yp[j][i]  +
-           base[3] * this->_Yp[j][i+1];
+    this->evalBase( base, i, vals, inc );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -338,12 +548,7 @@ namespace Splines {
     size_t i = size_t(this->search( x ));
     real_type base_D[4];
     Hermite3_D( x-this->_X[i], this->_X[i+1]-this->_X[i], base_D );
-    real_type * v = vals;
-    for ( size_t j = 0; j < size_t(this->_dim); ++j, v += inc )
-      *v = base_D[0] * this->_Y[j][i]   +
-           base_D[1] * this->_Y[j][i+1] +
-           base_D[2] * this->_Yp[j][i]  +
-           base_D[3] * this->_Yp[j][i+1];
+    this->evalBase( base_D, i, vals, inc );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -357,12 +562,7 @@ namespace Splines {
     size_t i = size_t(this->search( x ));
     real_type base_DD[4];
     Hermite3_DD( x-this->_X[i], this->_X[i+1]-this->_X[i], base_DD );
-    real_type * v = vals;
-    for ( size_t j = 0; j < size_t(this->_dim); ++j, v += inc )
-      *v = base_DD[0] * this->_Y[j][i]   +
-           base_DD[1] * this->_Y[j][i+1] +
-           base_DD[2] * this->_Yp[j][i]  +
-           base_DD[3] * this->_Yp[j][i+1];
+    this->evalBase( base_DD, i, vals, inc );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -376,12 +576,7 @@ namespace Splines {
     size_t i = size_t(this->search( x ));
     real_type base_DDD[4];
     Hermite3_DDD( x-this->_X[i], this->_X[i+1]-this->_X[i], base_DDD );
-    real_type * v = vals;
-    for ( size_t j = 0; j < size_t(this->_dim); ++j, v += inc )
-      *v = base_DDD[0] * this->_Y[j][i]   +
-           base_DDD[1] * this->_Y[j][i+1] +
-           base_DDD[2] * this->_Yp[j][i]  +
-           base_DDD[3] * this->_Yp[j][i+1];
+    this->evalBase( base_DDD, i, vals, inc );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -418,47 +613,246 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  SplineVec::planarJet(
+    size_t    i,
+    real_type x,
+    integer   order,
+    real_type jx[],
+    real_type jy[]
+  ) const {
+    real_type t = x-this->_X[i];
+    real_type H = this->_X[i+1]-this->_X[i];
+    size_t    d = size_t(this->_dim);
+    real_type b[4];
+    for ( integer k = 1; k <= order; ++k ) {
+      switch ( k ) {
+      case 1: Hermite3_D( t, H, b );   break;
+      case 2: Hermite3_DD( t, H, b );  break;
+      case 3: Hermite3_DDD( t, H, b ); break;
+      default: jx[k] = jy[k] = 0; continue;
+      }
+      if ( this->_YYp.empty() ) {
+        jx[k] = b[0] * this->_Y[0][i]  + b[1] * this->_Y[0][i+1] +
+                b[2] * this->_Yp[0][i] + b[3] * this->_Yp[0][i+1];
+        jy[k] = b[0] * this->_Y[1][i]  + b[1] * this->_Y[1][i+1] +
+                b[2] * this->_Yp[1][i] + b[3] * this->_Yp[1][i+1];
+      } else {
+        real_type const * p0 = &this->_YYp[2*d*i];
+        real_type const * p1 = p0 + 2*d;
+        jx[k] = b[0] * p0[0] + b[1] * p1[0] + b[2] * p0[d]   + b[3] * p1[d];
+        jy[k] = b[0] * p0[1] + b[1] * p1[1] + b[2] * p0[d+1] + b[3] * p1[d+1];
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   real_type
   SplineVec::curvature( real_type x ) const {
-    real_type D[10], DD[10];
-    this->eval_D( x, D, 1 );
-    this->eval_DD( x, DD, 1 );
-    real_type x_1 = D[0];
-    real_type x_2 = DD[0];
-    real_type y_1 = D[1];
-    real_type y_2 = DD[1];
-    real_type t4  = x_1 * x_1;
-    real_type t5  = y_1 * y_1;
-    real_type t6  = t4 + t5;
-    real_type t7  = sqrt(t6);
-    return (x_1 * y_2 - y_1 * x_2) / ( t6 * t7 );
+    size_t i = size_t(this->search( x ));
+    real_type jx[3], jy[3];
+    this->planarJet( i, x, 2, jx, jy );
+    return curvature_from_jet( jx, jy );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   real_type
   SplineVec::curvature_D( real_type x ) const {
-    real_type D[10], DD[10], DDD[10];
-    this->eval_D( x, D, 1 );
-    this->eval_DD( x, DD, 1 );
-    this->eval_DDD( x, DDD, 1 );
-    real_type x_1 = D[0];
-    real_type x_2 = DD[0];
-    real_type x_3 = DDD[0];
-    real_type y_1 = D[1];
-    real_type y_2 = DD[1];
-    real_type y_3 = DDD[1];
-    real_type t1  = x_1 * x_1;
-    real_type t9  = x_2 * x_2;
-    real_type t13 = y_1 * y_1;
-    real_type t17 = y_2 * y_2;
-    real_type t26 = t1 + t13;
-    real_type t27 = t26 * t26;
-    real_type t28 = sqrt(t26);
-    real_type aa  = y_3 * x_1 - y_1 * x_3;
-    real_type bb  = 3 * y_2 * x_2;
-    return ( t1 * ( aa - bb ) + t13 * ( aa + bb )
-           + 3 * x_1 * y_1 * ( t9 - t17 ) ) / ( t28 * t27 );
+    size_t i = size_t(this->search( x ));
+    real_type jx[4], jy[4];
+    this->planarJet( i, x, 3, jx, jy );
+    return curvature_D_from_jet( jx, jy );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::curvature_DD( real_type x ) const {
+    size_t i = size_t(this->search( x ));
+    real_type jx[5], jy[5];
+    this->planarJet( i, x, 4, jx, jy );
+    return curvature_DD_from_jet( jx, jy );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::curvature(
+    integer         n,
+    real_type const x[],
+    real_type       kappa[]
+  ) const {
+    integer   last = 0;
+    real_type jx[3], jy[3];
+    for ( integer k = 0; k < n; ++k ) {
+      real_type xk = x[k];
+      searchInterval(
+        this->_npts, this->_X, xk, last,
+        this->_curve_is_closed, this->_curve_can_extend
+      );
+      this->planarJet( size_t(last), xk, 2, jx, jy );
+      kappa[k] = curvature_from_jet( jx, jy );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::curvature_D(
+    integer         n,
+    real_type const x[],
+    real_type       kappa_D[]
+  ) const {
+    integer   last = 0;
+    real_type jx[4], jy[4];
+    for ( integer k = 0; k < n; ++k ) {
+      real_type xk = x[k];
+      searchInterval(
+        this->_npts, this->_X, xk, last,
+        this->_curve_is_closed, this->_curve_can_extend
+      );
+      this->planarJet( size_t(last), xk, 3, jx, jy );
+      kappa_D[k] = curvature_D_from_jet( jx, jy );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::curvature_DD(
+    integer         n,
+    real_type const x[],
+    real_type       kappa_DD[]
+  ) const {
+    integer   last = 0;
+    real_type jx[5], jy[5];
+    for ( integer k = 0; k < n; ++k ) {
+      real_type xk = x[k];
+      searchInterval(
+        this->_npts, this->_X, xk, last,
+        this->_curve_is_closed, this->_curve_can_extend
+      );
+      this->planarJet( size_t(last), xk, 4, jx, jy );
+      kappa_DD[k] = curvature_DD_from_jet( jx, jy );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::buildCurvatureTable( integer nsamples ) {
+    SPLINE_ASSERT(
+      this->_npts > 1 && this->_dim >= 2,
+      "SplineVec::buildCurvatureTable, expected a curve with dim >= 2"
+    )
+    SPLINE_ASSERT(
+      nsamples > 1,
+      "SplineVec::buildCurvatureTable, nsamples = " << nsamples << " < 2"
+    )
+    size_t nseg = size_t(this->_npts-1);
+    size_t ns   = size_t(nsamples);
+    this->_kappa.resize( 4*nseg );
+    vector<real_type> tk( ns+1 ), kk( ns+1 );
+    real_type jx[4], jy[4];
+    for ( size_t i = 0; i < nseg; ++i ) {
+      real_type x0 = this->_X[i];
+      real_type h  = this->_X[i+1]-x0;
+      for ( size_t k = 0; k <= ns; ++k ) {
+        tk[k] = k == ns ? this->_X[i+1] : x0 + (h*k)/ns;
+        this->planarJet( i, tk[k], 2, jx, jy );
+        kk[k] = curvature_from_jet( jx, jy );
+      }
+      real_type * K = &this->_kappa[4*i];
+      K[0] = K[2] = kk[0];
+      K[1] = K[3] = tk[0];
+      for ( size_t k = 0; k <= ns; ++k ) {
+        real_type kap = kk[k];
+        real_type t   = tk[k];
+        bool is_max = k > 0 && k < ns && kk[k] >= kk[k-1] && kk[k] >= kk[k+1];
+        bool is_min = k > 0 && k < ns && kk[k] <= kk[k-1] && kk[k] <= kk[k+1];
+        if ( is_max != is_min ) {
+          // bisection on the derivative of the curvature, the sign of
+          // the derivative at the sample select the half of the bracket
+          real_type sgn = is_max ? 1 : -1;
+          this->planarJet( i, t, 3, jx, jy );
+          real_type lo = tk[k-1], hi = tk[k+1];
+          if ( sgn*curvature_D_from_jet( jx, jy ) > 0 ) lo = t; else hi = t;
+          for ( integer iter = 0; iter < 60 && hi-lo > 1e-14*h; ++iter ) {
+            real_type m = (lo+hi)/2;
+            this->planarJet( i, m, 3, jx, jy );
+            if ( sgn*curvature_D_from_jet( jx, jy ) > 0 ) lo = m; else hi = m;
+          }
+          real_type tm = (lo+hi)/2;
+          this->planarJet( i, tm, 2, jx, jy );
+          real_type km = curvature_from_jet( jx, jy );
+          if ( sgn*(km-kap) > 0 ) { kap = km; t = tm; }
+        }
+        if ( kap < K[0] ) { K[0] = kap; K[1] = t; }
+        if ( kap > K[2] ) { K[2] = kap; K[3] = t; }
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::curvatureExtrema(
+    integer     i,
+    real_type & kmin,
+    real_type & t_kmin,
+    real_type & kmax,
+    real_type & t_kmax
+  ) const {
+    SPLINE_ASSERT(
+      !this->_kappa.empty(),
+      "SplineVec::curvatureExtrema, call buildCurvatureTable first"
+    )
+    SPLINE_ASSERT(
+      i >= 0 && i < this->_npts-1,
+      "SplineVec::curvatureExtrema, segment " << i << " out of [0," <<
+      this->_npts-1 << ")"
+    )
+    real_type const * K = &this->_kappa[4*size_t(i)];
+    kmin   = K[0];
+    t_kmin = K[1];
+    kmax   = K[2];
+    t_kmax = K[3];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::maxAbsCurvature( real_type t0, real_type t1 ) const {
+    SPLINE_ASSERT(
+      !this->_kappa.empty(),
+      "SplineVec::maxAbsCurvature, call buildCurvatureTable first"
+    )
+    if ( t1 < t0 ) std::swap( t0, t1 );
+    integer nseg = this->_npts-1;
+    integer i0 = integer(
+      std::upper_bound( this->_X, this->_X+this->_npts, t0 ) - this->_X
+    ) - 1;
+    integer i1 = integer(
+      std::lower_bound( this->_X, this->_X+this->_npts, t1 ) - this->_X
+    ) - 1;
+    i0 = std::max( 0, std::min( i0, nseg-1 ) );
+    i1 = std::max( i0, std::min( i1, nseg-1 ) );
+    real_type kmax = 0;
+    for ( integer i = i0; i <= i1; ++i ) {
+      real_type const * K = &this->_kappa[4*size_t(i)];
+      kmax = std::max( kmax, std::max( abs(K[0]), abs(K[2]) ) );
+    }
+    return kmax;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::dropTables() {
+    this->dropArcLength();
+    this->_kappa.clear();
   }
 
   /*!
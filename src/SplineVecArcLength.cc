@@ -0,0 +1,391 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace Splines {
+
+  using std::abs;
+  using std::sqrt;
+  using std::fmod;
+
+  /*\
+   |  The arc-length table is a partition of `[xMin(),xMax()]` in cells,
+   |  each contained in a single knot interval, with the arc-length at
+   |  the boundaries. Inside a cell the arc-length is integrated with
+   |  5 points Gauss-Legendre from the left boundary and inverted with
+   |  a safeguarded Newton iteration (the speed is the derivative).
+  \*/
+
+  static real_type const GL5_x[5] = {
+    -0.906179845938663992797626878299,
+    -0.538469310105683091036314420700,
+     0,
+     0.538469310105683091036314420700,
+     0.906179845938663992797626878299
+  };
+
+  static real_type const GL5_w[5] = {
+    0.236926885056189087514264040720,
+    0.478628670499366468041291514836,
+    0.568888888888888888888888888889,
+    0.478628670499366468041291514836,
+    0.236926885056189087514264040720
+  };
+
+  // maximum number of bisections of a knot interval in `buildArcLength`
+  static integer const arc_max_depth = 20;
+
+  // move the cursor `k` to the cell of `S` containing `s`
+  static
+  inline
+  void
+  arc_cell( vector<real_type> const & S, real_type s, size_t & k ) {
+    size_t m = S.size()-1; // number of cells
+    if ( k >= m || s < S[k] ) {
+      k = size_t(std::upper_bound( S.begin(), S.end(), s ) - S.begin());
+      k = k > 0 ? k-1 : 0;
+      if ( k >= m ) k = m-1;
+    } else {
+      while ( k+1 < m && s >= S[k+1] ) ++k;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::dropArcLength() {
+    this->_arc_t.clear();
+    this->_arc_s.clear();
+    this->_arc_idx.clear();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::speed( size_t i, real_type dt ) const {
+    real_type b[4];
+    Hermite3_D( dt, this->_X[i+1]-this->_X[i], b );
+    size_t    d   = size_t(this->_dim);
+    real_type acc = 0;
+    if ( this->_YYp.empty() ) {
+      for ( size_t j = 0; j < d; ++j ) {
+        real_type v = b[0] * this->_Y[j][i]   +
+                      b[1] * this->_Y[j][i+1] +
+                      b[2] * this->_Yp[j][i]  +
+                      b[3] * this->_Yp[j][i+1];
+        acc += v*v;
+      }
+    } else {
+      real_type const * p0 = &this->_YYp[2*d*i];
+      real_type const * p1 = p0 + 2*d;
+      for ( size_t j = 0; j < d; ++j ) {
+        real_type v = b[0] * p0[j]   +
+                      b[1] * p1[j]   +
+                      b[2] * p0[d+j] +
+                      b[3] * p1[d+j];
+        acc += v*v;
+      }
+    }
+    return sqrt(acc);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::arcGL( size_t i, real_type a, real_type b ) const {
+    real_type c = (a+b)/2;
+    real_type r = (b-a)/2;
+    real_type L = 0;
+    for ( integer k = 0; k < 5; ++k )
+      L += GL5_w[k] * this->speed( i, c + r * GL5_x[k] );
+    return r*L;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::buildArcLength( real_type tol ) {
+    SPLINE_ASSERT(
+      this->_npts > 1,
+      "SplineVec::buildArcLength, spline not built, npts = " << this->_npts
+    )
+    this->dropArcLength();
+    size_t    nn = size_t(this->_npts-1);
+    real_type LX = this->_X[nn] - this->_X[0];
+
+    this->_arc_t.reserve( nn+1 );
+    this->_arc_s.reserve( nn+1 );
+    this->_arc_idx.reserve( nn );
+    this->_arc_t.push_back( this->_X[0] );
+    this->_arc_s.push_back( 0 );
+
+    struct Cell { real_type a, b, L; integer depth; };
+    vector<Cell> stack;
+
+    real_type s = 0;
+    for ( size_t i = 0; i < nn; ++i ) {
+      real_type h = this->_X[i+1] - this->_X[i];
+      real_type L = this->arcGL( i, 0, h );
+      if ( tol <= 0 ) {
+        s += L;
+        this->_arc_t.push_back( this->_X[i+1] );
+        this->_arc_s.push_back( s );
+        this->_arc_idx.push_back( integer(i) );
+        continue;
+      }
+      // depth first, left to right: the cells are emitted in order
+      stack.clear();
+      stack.push_back( Cell{ 0, h, L, 0 } );
+      while ( !stack.empty() ) {
+        Cell C = stack.back(); stack.pop_back();
+        real_type m  = (C.a+C.b)/2;
+        real_type L0 = this->arcGL( i, C.a, m );
+        real_type L1 = this->arcGL( i, m, C.b );
+        if ( abs(L0+L1-C.L) <= tol*(C.b-C.a)/LX || C.depth >= arc_max_depth ) {
+          s += L0;
+          this->_arc_t.push_back( this->_X[i]+m );
+          this->_arc_s.push_back( s );
+          this->_arc_idx.push_back( integer(i) );
+          s += L1;
+          this->_arc_t.push_back( C.b == h ? this->_X[i+1] : this->_X[i]+C.b );
+          this->_arc_s.push_back( s );
+          this->_arc_idx.push_back( integer(i) );
+        } else {
+          stack.push_back( Cell{ m, C.b, L1, C.depth+1 } );
+          stack.push_back( Cell{ C.a, m, L0, C.depth+1 } );
+        }
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::length() const {
+    if ( !this->_arc_s.empty() ) return this->_arc_s.back();
+    real_type L = 0;
+    for ( size_t i = 0; i+1 < size_t(this->_npts); ++i )
+      L += this->arcGL( i, 0, this->_X[i+1] - this->_X[i] );
+    return L;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::t_to_s( real_type t ) const {
+    size_t    nn = size_t(this->_npts-1);
+    real_type t0 = this->_X[0];
+    real_type t1 = this->_X[nn];
+    if ( this->_curve_is_closed ) {
+      t = t0 + fmod( t-t0, t1-t0 );
+      if ( t < t0 ) t += t1-t0;
+    }
+    if      ( t <= t0 ) return 0;
+    else if ( t >= t1 ) return this->length();
+    if ( this->_arc_s.empty() ) {
+      real_type s = 0;
+      size_t    i = 0;
+      for ( ; this->_X[i+1] <= t; ++i )
+        s += this->arcGL( i, 0, this->_X[i+1] - this->_X[i] );
+      return s + this->arcGL( i, 0, t - this->_X[i] );
+    }
+    size_t k = size_t(
+      std::upper_bound( this->_arc_t.begin(), this->_arc_t.end(), t ) -
+      this->_arc_t.begin()
+    ) - 1;
+    size_t i = size_t(this->_arc_idx[k]);
+    return this->_arc_s[k] +
+           this->arcGL( i, this->_arc_t[k] - this->_X[i], t - this->_X[i] );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::arcRange( real_type s ) const {
+    real_type L = this->_arc_s.back();
+    if ( this->_curve_is_closed ) {
+      s = fmod( s, L );
+      if ( s < 0 ) s += L;
+    }
+    if      ( s < 0 ) s = 0;
+    else if ( s > L ) s = L;
+    return s;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::arcInvert( size_t k, real_type s ) const {
+    size_t    i  = size_t(this->_arc_idx[k]);
+    real_type Xi = this->_X[i];
+    real_type a  = this->_arc_t[k]   - Xi;
+    real_type b  = this->_arc_t[k+1] - Xi;
+    real_type s0 = this->_arc_s[k];
+    real_type s1 = this->_arc_s[k+1];
+    if ( s <= s0 ) return this->_arc_t[k];
+    if ( s >= s1 ) return this->_arc_t[k+1];
+
+    real_type const eps = std::numeric_limits<real_type>::epsilon();
+    real_type ds  = s - s0;
+    real_type tol = 10*eps*this->_arc_s.back();
+    real_type lo  = a;
+    real_type hi  = b;
+    real_type dt  = a + (b-a)*(ds/(s1-s0));
+    for ( integer iter = 0; iter < 50; ++iter ) {
+      real_type f = this->arcGL( i, a, dt ) - ds;
+      if ( abs(f) <= tol ) break;
+      if ( f > 0 ) hi = dt; else lo = dt;
+      if ( hi-lo <= eps*(abs(Xi)+b) ) break;
+      real_type v  = this->speed( i, dt );
+      real_type nt = v > 0 ? dt - f/v : lo;
+      dt = ( nt > lo && nt < hi ) ? nt : (lo+hi)/2;
+    }
+    return Xi + dt;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVec::s_to_t( real_type s ) const {
+    SPLINE_ASSERT(
+      !this->_arc_s.empty(),
+      "SplineVec::s_to_t, call buildArcLength first"
+    )
+    s = this->arcRange( s );
+    size_t k = this->_arc_idx.size();
+    arc_cell( this->_arc_s, s, k );
+    return this->arcInvert( k, s );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::s_to_t(
+    integer         n,
+    real_type const s[],
+    real_type       t[]
+  ) const {
+    SPLINE_ASSERT(
+      !this->_arc_s.empty(),
+      "SplineVec::s_to_t, call buildArcLength first"
+    )
+    size_t k = 0;
+    for ( integer j = 0; j < n; ++j ) {
+      real_type sj = this->arcRange( s[j] );
+      arc_cell( this->_arc_s, sj, k );
+      t[j] = this->arcInvert( k, sj );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::eval_at_arclength(
+    real_type s,
+    real_type vals[],
+    integer   inc
+  ) const {
+    SPLINE_ASSERT(
+      !this->_arc_s.empty(),
+      "SplineVec::eval_at_arclength, call buildArcLength first"
+    )
+    s = this->arcRange( s );
+    size_t k = this->_arc_idx.size();
+    arc_cell( this->_arc_s, s, k );
+    size_t    i = size_t(this->_arc_idx[k]);
+    real_type t = this->arcInvert( k, s );
+    real_type base[4];
+    Hermite3( t-this->_X[i], this->_X[i+1]-this->_X[i], base );
+    this->evalBase( base, i, vals, inc );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::eval_at_arclength(
+    real_type           s,
+    vector<real_type> & vals
+  ) const {
+    vals.resize(size_t(this->_dim));
+    this->eval_at_arclength( s, &vals.front(), 1 );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::eval_at_arclength(
+    integer         n,
+    real_type const s[],
+    real_type       vals[],
+    integer         ldV
+  ) const {
+    SPLINE_ASSERT(
+      !this->_arc_s.empty(),
+      "SplineVec::eval_at_arclength, call buildArcLength first"
+    )
+    size_t k = 0;
+    for ( integer j = 0; j < n; ++j ) {
+      real_type sj = this->arcRange( s[j] );
+      arc_cell( this->_arc_s, sj, k );
+      size_t    i = size_t(this->_arc_idx[k]);
+      real_type t = this->arcInvert( k, sj );
+      real_type base[4];
+      Hermite3( t-this->_X[i], this->_X[i+1]-this->_X[i], base );
+      this->evalBase( base, i, vals + size_t(j)*size_t(ldV), 1 );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::sample_arclength(
+    integer   n,
+    real_type vals[],
+    integer   ldV
+  ) const {
+    SPLINE_ASSERT(
+      !this->_arc_s.empty(),
+      "SplineVec::sample_arclength, call buildArcLength first"
+    )
+    SPLINE_ASSERT(
+      n > 1, "SplineVec::sample_arclength, expected n = " << n << " > 1"
+    )
+    real_type L = this->_arc_s.back();
+    size_t    k = 0;
+    for ( integer j = 0; j < n; ++j ) {
+      // no wrap of the last point of a closed curve
+      real_type sj = j+1 == n ? L : (L*j)/(n-1);
+      arc_cell( this->_arc_s, sj, k );
+      size_t    i = size_t(this->_arc_idx[k]);
+      real_type t = this->arcInvert( k, sj );
+      real_type base[4];
+      Hermite3( t-this->_X[i], this->_X[i+1]-this->_X[i], base );
+      this->evalBase( base, i, vals + size_t(j)*size_t(ldV), 1 );
+    }
+  }
+
+}
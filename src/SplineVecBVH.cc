@@ -0,0 +1,474 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace Splines {
+
+  using std::abs;
+  using std::sqrt;
+  using std::min;
+  using std::max;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineVecBVH::SplineVecBVH()
+  : _name("SplineVecBVH")
+  , _dim(0)
+  , _nseg(0)
+  {}
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineVecBVH::SplineVecBVH( SplineVec const & S, integer leaf )
+  : _name(S.name())
+  , _dim(0)
+  , _nseg(0)
+  { this->build( S, leaf ); }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVecBVH::build( SplineVec const & S, integer leaf ) {
+    this->_name = S.name();
+    SPLINE_ASSERT(
+      S.numPoints() > 1 && S.dimension() > 0,
+      "SplineVecBVH::build, spline not built"
+    )
+    SPLINE_ASSERT(
+      leaf > 0, "SplineVecBVH::build, expected leaf = " << leaf << " > 0"
+    )
+    size_t d  = size_t(S.dimension());
+    size_t ns = size_t(S.numPoints()-1);
+    this->_dim  = S.dimension();
+    this->_nseg = integer(ns);
+
+    this->_T.assign( S.xNodes(), S.xNodes()+ns+1 );
+    this->_C.resize( 4*d*ns );
+    this->_box.resize( 2*d*ns );
+    for ( size_t i = 0; i < ns; ++i ) {
+      real_type   h   = this->_T[i+1] - this->_T[i];
+      real_type * a   = &this->_C[4*d*i];
+      real_type * box = &this->_box[2*d*i];
+      for ( size_t j = 0; j < d; ++j ) {
+        real_type y0 = S.yNode( integer(i), integer(j) );
+        real_type y1 = S.yNode( integer(i+1), integer(j) );
+        real_type m0 = h*S.ypNode( integer(i), integer(j) );
+        real_type m1 = h*S.ypNode( integer(i+1), integer(j) );
+        a[j]     = y0;
+        a[d+j]   = m0;
+        a[2*d+j] = 3*(y1-y0)-2*m0-m1;
+        a[3*d+j] = 2*(y0-y1)+m0+m1;
+        real_type B[4];
+        hermiteToBezier( y0, y1, m0, m1, B );
+        box[j]   = min( min(B[0],B[3]), min(B[1],B[2]) );
+        box[d+j] = max( max(B[0],B[3]), max(B[1],B[2]) );
+      }
+    }
+
+    this->_perm.resize( ns );
+    for ( size_t i = 0; i < ns; ++i ) this->_perm[i] = integer(i);
+    this->_nodes.clear();
+    this->_nbox.clear();
+    this->_leaf.resize( ns );
+    this->_nodes.reserve( 2*(ns/size_t(leaf)+1) );
+    this->_nbox.reserve( 4*d*(ns/size_t(leaf)+1) );
+    this->buildNode( 0, integer(ns), leaf, -1 );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineVecBVH::buildNode(
+    integer first,
+    integer last,
+    integer leaf,
+    integer parent
+  ) {
+    size_t  d  = size_t(this->_dim);
+    integer id = integer(this->_nodes.size());
+    this->_nodes.push_back( Node{ -1, -1, first, last, parent } );
+    this->_nbox.resize( this->_nbox.size() + 2*d );
+
+    // box of the node and bounds of the box centers
+    real_type * box = &this->_nbox[2*d*size_t(id)];
+    vector<real_type> cmin( d, std::numeric_limits<real_type>::max() );
+    vector<real_type> cmax( d, -std::numeric_limits<real_type>::max() );
+    std::copy( cmin.begin(), cmin.end(), box );
+    std::copy( cmax.begin(), cmax.end(), box+d );
+    for ( integer k = first; k < last; ++k ) {
+      real_type const * sb = &this->_box[2*d*size_t(this->_perm[size_t(k)])];
+      for ( size_t j = 0; j < d; ++j ) {
+        box[j]   = min( box[j], sb[j] );
+        box[d+j] = max( box[d+j], sb[d+j] );
+        real_type c = sb[j]+sb[d+j];
+        cmin[j] = min( cmin[j], c );
+        cmax[j] = max( cmax[j], c );
+      }
+    }
+    if ( last - first <= leaf ) {
+      for ( integer k = first; k < last; ++k )
+        this->_leaf[size_t(this->_perm[size_t(k)])] = id;
+      return id;
+    }
+
+    size_t axis = 0;
+    for ( size_t j = 1; j < d; ++j )
+      if ( cmax[j]-cmin[j] > cmax[axis]-cmin[axis] ) axis = j;
+
+    integer mid = (first+last)/2;
+    real_type const * B = &this->_box.front();
+    std::nth_element(
+      this->_perm.begin()+first,
+      this->_perm.begin()+mid,
+      this->_perm.begin()+last,
+      [B,d,axis]( integer a, integer b ) {
+        return B[2*d*size_t(a)+axis] + B[2*d*size_t(a)+d+axis] <
+               B[2*d*size_t(b)+axis] + B[2*d*size_t(b)+d+axis];
+      }
+    );
+    integer L = this->buildNode( first, mid, leaf, id );
+    integer R = this->buildNode( mid, last, leaf, id );
+    // `_nodes` may have been reallocated
+    this->_nodes[size_t(id)].left  = L;
+    this->_nodes[size_t(id)].right = R;
+    return id;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVecBVH::segmentBox(
+    integer   i,
+    real_type bmin[],
+    real_type bmax[]
+  ) const {
+    SPLINE_ASSERT(
+      i >= 0 && i < this->_nseg,
+      "SplineVecBVH::segmentBox, segment " << i << " out of [0," <<
+      this->_nseg << ")"
+    )
+    size_t d = size_t(this->_dim);
+    real_type const * box = &this->_box[2*d*size_t(i)];
+    std::copy( box, box+d, bmin );
+    std::copy( box+d, box+2*d, bmax );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::boxDist2( real_type const box[], real_type const p[] ) const {
+    size_t    d   = size_t(this->_dim);
+    real_type acc = 0;
+    for ( size_t j = 0; j < d; ++j ) {
+      real_type e = max( real_type(0), max( box[j]-p[j], p[j]-box[d+j] ) );
+      acc += e*e;
+    }
+    return acc;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*\
+   |  Roots in [0,1] of c[0] + c[1] u + ... + c[n] u^n in increasing order.
+   |  The roots of the derivative split [0,1] into intervals where the
+   |  polynomial is monotone, each holds at most one root that is found
+   |  by safeguarded Newton, so no root is missed.
+  \*/
+
+  static
+  integer
+  monotoneRoots( real_type const c[], integer n, real_type r[] ) {
+    if ( n < 1 ) return 0;
+    if ( n == 1 ) {
+      if ( c[1] == 0 ) return 0;
+      real_type t = -c[0]/c[1];
+      if ( !( t >= 0 && t <= 1 ) ) return 0;
+      r[0] = t;
+      return 1;
+    }
+    real_type dc[5], br[6];
+    for ( integer k = 0; k < n; ++k ) dc[k] = (k+1)*c[k+1];
+    integer nb = 1+monotoneRoots( dc, n-1, br+1 );
+    br[0] = 0; br[nb++] = 1;
+
+    real_type const eps = std::numeric_limits<real_type>::epsilon();
+    integer nr = 0;
+    for ( integer k = 0; k+1 < nb; ++k ) {
+      real_type lo = br[k], hi = br[k+1];
+      real_type flo = 0, fhi = 0;
+      for ( integer j = n; j >= 0; --j ) { flo = flo*lo+c[j]; fhi = fhi*hi+c[j]; }
+      real_type t;
+      if ( flo == 0 ) {
+        t = lo;
+      } else if ( fhi == 0 ) {
+        t = hi;
+      } else if ( (flo < 0) == (fhi < 0) ) {
+        continue;
+      } else {
+        // orient so that the polynomial is negative at `lo`
+        bool up = flo < 0;
+        t = (lo+hi)/2;
+        for ( integer iter = 0; iter < 100 && hi-lo > 4*eps; ++iter ) {
+          real_type f = 0, df = 0;
+          for ( integer j = n; j >= 0; --j ) { df = df*t+f; f = f*t+c[j]; }
+          if ( f == 0 ) break;
+          if ( (f < 0) == up ) lo = t; else hi = t;
+          real_type nt = df != 0 ? t - f/df : lo;
+          if ( !( nt > lo && nt < hi ) ) nt = (lo+hi)/2;
+          // quadratic convergence: after a step below sqrt(eps) the
+          // error is at the level of the rounding of the polynomial
+          bool done = abs(nt-t) <= sqrt(eps);
+          t = nt;
+          if ( done ) break;
+        }
+      }
+      if ( nr == 0 || t > r[nr-1] ) r[nr++] = t;
+    }
+    return nr;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::segmentClosest(
+    integer         i,
+    real_type const p[],
+    real_type     & u
+  ) const {
+    size_t d = size_t(this->_dim);
+    real_type const * a0 = &this->_C[4*d*size_t(i)];
+    real_type const * a1 = a0+d;
+    real_type const * a2 = a1+d;
+    real_type const * a3 = a2+d;
+
+    // the minimum of |C-p|^2 is at an end or at a root of the quintic
+    // g = (C-p).C' = sum_k g[k] u^k
+    real_type g[6] = { 0, 0, 0, 0, 0, 0 };
+    for ( size_t j = 0; j < d; ++j ) {
+      real_type e[4]  = { a0[j]-p[j], a1[j], a2[j], a3[j] };
+      real_type c1[3] = { a1[j], 2*a2[j], 3*a3[j] };
+      for ( integer m = 0; m < 4; ++m )
+        for ( integer k = 0; k < 3; ++k )
+          g[m+k] += e[m]*c1[k];
+    }
+    real_type cand[7];
+    integer   nc = 1;
+    cand[0] = 0;
+    nc += monotoneRoots( g, 5, cand+1 );
+    cand[nc++] = 1;
+
+    real_type fm = std::numeric_limits<real_type>::max();
+    for ( integer k = 0; k < nc; ++k ) {
+      real_type uk = cand[k];
+      real_type f  = 0;
+      for ( size_t j = 0; j < d; ++j ) {
+        real_type e = a0[j]+uk*(a1[j]+uk*(a2[j]+uk*a3[j])) - p[j];
+        f += e*e;
+      }
+      if ( f < fm ) { fm = f; u = uk; }
+    }
+    return fm;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::query(
+    real_type const p[],
+    integer         node,
+    integer       & iseg,
+    real_type     & u,
+    real_type       best,
+    integer         skip
+  ) const {
+    size_t d = size_t(this->_dim);
+    // nodes to visit with the distance of their box, depth <= 2*log2(n)
+    integer   stack_n[128];
+    real_type stack_d[128];
+    integer   top = 0;
+    stack_n[top] = node;
+    stack_d[top] = this->boxDist2( &this->_nbox[2*d*size_t(node)], p );
+    ++top;
+    while ( top > 0 ) {
+      --top;
+      if ( stack_d[top] >= best ) continue;
+      Node const & N = this->_nodes[size_t(stack_n[top])];
+      if ( N.left < 0 ) {
+        for ( integer k = N.first; k < N.last; ++k ) {
+          integer i = this->_perm[size_t(k)];
+          if ( i == skip ) continue;
+          if ( this->boxDist2( &this->_box[2*d*size_t(i)], p ) >= best ) continue;
+          real_type ui;
+          real_type f = this->segmentClosest( i, p, ui );
+          if ( f < best ) { best = f; iseg = i; u = ui; }
+        }
+        continue;
+      }
+      real_type dl = this->boxDist2( &this->_nbox[2*d*size_t(N.left)], p );
+      real_type dr = this->boxDist2( &this->_nbox[2*d*size_t(N.right)], p );
+      // the nearest child on top of the stack
+      if ( dl < dr ) {
+        stack_n[top] = N.right; stack_d[top] = dr; ++top;
+        stack_n[top] = N.left;  stack_d[top] = dl; ++top;
+      } else {
+        stack_n[top] = N.left;  stack_d[top] = dl; ++top;
+        stack_n[top] = N.right; stack_d[top] = dr; ++top;
+      }
+    }
+    return best;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::finish(
+    integer     iseg,
+    real_type   u,
+    real_type   d2,
+    real_type & t,
+    real_type   q[]
+  ) const {
+    size_t    i  = size_t(iseg);
+    real_type T0 = this->_T[i];
+    real_type T1 = this->_T[i+1];
+    t = u >= 1 ? T1 : T0 + u*(T1-T0);
+    if ( q != nullptr ) {
+      size_t d = size_t(this->_dim);
+      real_type const * a = &this->_C[4*d*i];
+      for ( size_t j = 0; j < d; ++j )
+        q[j] = a[j]+u*(a[d+j]+u*(a[2*d+j]+u*a[3*d+j]));
+    }
+    return sqrt(d2);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::nearest(
+    real_type const p[],
+    integer         i0,
+    integer       & iseg,
+    real_type     & u
+  ) const {
+    if ( i0 < 0 ) {
+      iseg = 0;
+      u    = 0;
+      return this->query(
+        p, 0, iseg, u, std::numeric_limits<real_type>::infinity()
+      );
+    }
+    // the segment of the previous result gives the first bound
+    iseg = i0;
+    real_type d2 = this->segmentClosest( i0, p, u );
+
+    // each segment not in the leaf of `i0` is in one of the siblings
+    // of the path from the leaf to the root
+    integer node = this->_leaf[size_t(i0)];
+    d2 = this->query( p, node, iseg, u, d2, i0 );
+    for ( integer par = this->_nodes[size_t(node)].parent;
+          par >= 0;
+          node = par, par = this->_nodes[size_t(node)].parent ) {
+      Node const & N = this->_nodes[size_t(par)];
+      d2 = this->query( p, N.left == node ? N.right : N.left, iseg, u, d2 );
+    }
+    return d2;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::closestPoint(
+    real_type const p[],
+    real_type     & t,
+    real_type       q[]
+  ) const {
+    SPLINE_ASSERT(
+      this->_nseg > 0, "SplineVecBVH::closestPoint, tree not built"
+    )
+    integer   iseg;
+    real_type u;
+    real_type d2 = this->nearest( p, -1, iseg, u );
+    return this->finish( iseg, u, d2, t, q );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineVecBVH::closestPointFrom(
+    real_type const p[],
+    real_type     & t,
+    real_type       q[]
+  ) const {
+    SPLINE_ASSERT(
+      this->_nseg > 0, "SplineVecBVH::closestPointFrom, tree not built"
+    )
+    integer i0 = integer(
+      std::upper_bound( this->_T.begin(), this->_T.end(), t ) - this->_T.begin()
+    ) - 1;
+    i0 = max( 0, min( i0, this->_nseg-1 ) );
+    integer   iseg;
+    real_type u;
+    real_type d2 = this->nearest( p, i0, iseg, u );
+    return this->finish( iseg, u, d2, t, q );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVecBVH::closestPoints(
+    integer         n,
+    real_type const P[],
+    integer         ldP,
+    real_type       t[],
+    real_type       dist[],
+    real_type       Q[],
+    integer         ldQ,
+    bool            track,
+    integer         nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->_nseg > 0, "SplineVecBVH::closestPoints, tree not built"
+    )
+    SPLINE_ASSERT(
+      ldP >= this->_dim && ( Q == nullptr || ldQ >= this->_dim ),
+      "SplineVecBVH::closestPoints, bad ldP = " << ldP << " or ldQ = " << ldQ
+    )
+    if ( n <= 0 ) return;
+    parallel_chunks( size_t(n), nthreads, [=]( size_t k0, size_t k1 ) {
+      integer iseg = -1; // cold start of each chunk
+      for ( size_t k = k0; k < k1; ++k ) {
+        real_type const * p = P + k*size_t(ldP);
+        real_type       * q = Q == nullptr ? nullptr : Q + k*size_t(ldQ);
+        real_type u;
+        real_type d2 = this->nearest( p, track ? iseg : -1, iseg, u );
+        dist[k] = this->finish( iseg, u, d2, t[k], q );
+      }
+    } );
+  }
+
+}
@@ -0,0 +1,621 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace Splines {
+
+  using std::abs;
+  using std::min;
+  using std::max;
+
+  /*\
+   |  Pieces of the Bezier segments, control points b0,b1,b2,b3 (x,y each)
+   |  and the range [u0,u1] of the piece in the segment
+  \*/
+
+  struct BezierPiece {
+    real_type P[8];
+    real_type u0, u1;
+  };
+
+  struct PiecePair {
+    BezierPiece A, B;
+  };
+
+  // power form a0,a1,a2,a3 (x,y each) to control points
+  static
+  void
+  toBezier( real_type const a[8], BezierPiece & B ) {
+    for ( integer j = 0; j < 2; ++j ) {
+      B.P[j]   = a[j];
+      B.P[2+j] = a[j]+a[2+j]/3;
+      B.P[4+j] = a[j]+(2*a[2+j]+a[4+j])/3;
+      B.P[6+j] = a[j]+a[2+j]+a[4+j]+a[6+j];
+    }
+    B.u0 = 0;
+    B.u1 = 1;
+  }
+
+  // de Casteljau at 1/2
+  static
+  void
+  splitHalf( BezierPiece const & B, BezierPiece & L, BezierPiece & R ) {
+    for ( integer j = 0; j < 2; ++j ) {
+      real_type p01  = (B.P[j]+B.P[2+j])/2;
+      real_type p12  = (B.P[2+j]+B.P[4+j])/2;
+      real_type p23  = (B.P[4+j]+B.P[6+j])/2;
+      real_type p012 = (p01+p12)/2;
+      real_type p123 = (p12+p23)/2;
+      real_type m    = (p012+p123)/2;
+      L.P[j] = B.P[j]; L.P[2+j] = p01;  L.P[4+j] = p012; L.P[6+j] = m;
+      R.P[j] = m;      R.P[2+j] = p123; R.P[4+j] = p23;  R.P[6+j] = B.P[6+j];
+    }
+    real_type um = (B.u0+B.u1)/2;
+    L.u0 = B.u0; L.u1 = um;
+    R.u0 = um;   R.u1 = B.u1;
+  }
+
+  static
+  void
+  pieceBox( BezierPiece const & B, real_type box[4] ) {
+    for ( integer j = 0; j < 2; ++j ) {
+      box[j]   = min( min(B.P[j],B.P[2+j]), min(B.P[4+j],B.P[6+j]) );
+      box[2+j] = max( max(B.P[j],B.P[2+j]), max(B.P[4+j],B.P[6+j]) );
+    }
+  }
+
+  static
+  inline
+  bool
+  boxOverlap( real_type const a[], real_type const b[], integer d ) {
+    for ( integer j = 0; j < d; ++j )
+      if ( a[j] > b[d+j] || b[j] > a[d+j] ) return false;
+    return true;
+  }
+
+  // interior control points within 1% of the chord
+  static
+  bool
+  isFlat( BezierPiece const & B ) {
+    real_type cx = B.P[6]-B.P[0];
+    real_type cy = B.P[7]-B.P[1];
+    real_type L2 = cx*cx+cy*cy;
+    real_type d1 = abs( cx*(B.P[3]-B.P[1]) - cy*(B.P[2]-B.P[0]) );
+    real_type d2 = abs( cx*(B.P[5]-B.P[1]) - cy*(B.P[4]-B.P[0]) );
+    return max(d1,d2) <= 1e-2*L2;
+  }
+
+  /*\
+   |  Fat line test: the control points of `P` are in the band
+   |  dmin <= n.(X-b0) <= dmax around its chord, `Q` is separated when
+   |  all its control points are on one side of the band
+  \*/
+
+  static
+  bool
+  fatLineSeparated( BezierPiece const & P, BezierPiece const & Q, real_type slack ) {
+    real_type nx  = P.P[1]-P.P[7];
+    real_type ny  = P.P[6]-P.P[0];
+    real_type len = hypot( nx, ny );
+    if ( len == 0 ) return false;
+    nx /= len; ny /= len;
+    real_type d1 = nx*(P.P[2]-P.P[0])+ny*(P.P[3]-P.P[1]);
+    real_type d2 = nx*(P.P[4]-P.P[0])+ny*(P.P[5]-P.P[1]);
+    real_type dmin = min( real_type(0), min(d1,d2) ) - slack;
+    real_type dmax = max( real_type(0), max(d1,d2) ) + slack;
+    real_type emin = std::numeric_limits<real_type>::max();
+    real_type emax = -emin;
+    for ( integer k = 0; k < 8; k += 2 ) {
+      real_type e = nx*(Q.P[k]-P.P[0])+ny*(Q.P[k+1]-P.P[1]);
+      emin = min( emin, e );
+      emax = max( emax, e );
+    }
+    return emax < dmin || emin > dmax;
+  }
+
+  /*\
+   |  Newton on A(u) = B(v) with the segments in power form, from `u`, `v`.
+   |  True when it converges to a point of the curves within `tol`.
+  \*/
+
+  static
+  bool
+  newtonCross(
+    real_type const a[8],
+    real_type const b[8],
+    real_type     & u,
+    real_type     & v,
+    real_type       tol
+  ) {
+    real_type const eps = std::numeric_limits<real_type>::epsilon();
+    real_type F[2];
+    for ( integer iter = 0; iter < 20; ++iter ) {
+      real_type JA[2], JB[2];
+      for ( integer j = 0; j < 2; ++j ) {
+        F[j]  = a[j]+u*(a[2+j]+u*(a[4+j]+u*a[6+j]))
+              - b[j]-v*(b[2+j]+v*(b[4+j]+v*b[6+j]));
+        JA[j] = a[2+j]+u*(2*a[4+j]+3*u*a[6+j]);
+        JB[j] = b[2+j]+v*(2*b[4+j]+3*v*b[6+j]);
+      }
+      // [ JA -JB ] [du dv]^T = -F
+      real_type det = JB[0]*JA[1]-JA[0]*JB[1];
+      if ( !( abs(det) > eps*(abs(JA[0]*JB[1])+abs(JB[0]*JA[1])) ) ) return false;
+      real_type du = (JB[1]*F[0]-JB[0]*F[1])/det;
+      real_type dv = (JA[1]*F[0]-JA[0]*F[1])/det;
+      u += du;
+      v += dv;
+      if ( !( abs(u) < 2 && abs(v) < 2 ) ) return false;
+      if ( max(abs(du),abs(dv)) <= 4*eps ) break;
+    }
+    for ( integer j = 0; j < 2; ++j )
+      F[j] = a[j]+u*(a[2+j]+u*(a[4+j]+u*a[6+j]))
+           - b[j]-v*(b[2+j]+v*(b[4+j]+v*b[6+j]));
+    return abs(F[0])+abs(F[1]) <= tol;
+  }
+
+  /*\
+   |  Intersections of two planar cubic segments in power form, the pairs
+   |  (u,v) in [0,1]^2 (up to rounding) are appended to `uv`. The pieces
+   |  are split while their boxes overlap, at most `budget` pairs are
+   |  examined: return false if pairs are left (e.g. overlapping arcs).
+  \*/
+
+  static
+  bool
+  segmentCross(
+    real_type const     a[8],
+    real_type const     b[8],
+    vector<real_type> & uv,
+    vector<PiecePair> & stack
+  ) {
+    integer const budget = 4096;
+
+    PiecePair root;
+    toBezier( a, root.A );
+    toBezier( b, root.B );
+    real_type ba[4], bb[4];
+    pieceBox( root.A, ba );
+    pieceBox( root.B, bb );
+    real_type scale = 0;
+    for ( integer j = 0; j < 2; ++j )
+      scale = max( scale, max( max(abs(ba[j]),abs(ba[2+j])), max(abs(bb[j]),abs(bb[2+j])) ) );
+    real_type const tol  = 1e-10*scale;  // residual of a crossing
+    real_type const tiny = 1e-13*scale;  // size of a tangent contact
+
+    stack.clear();
+    stack.push_back( root );
+    for ( integer count = 0; !stack.empty() && count < budget; ++count ) {
+      PiecePair PP = stack.back();
+      stack.pop_back();
+      pieceBox( PP.A, ba );
+      pieceBox( PP.B, bb );
+      if ( !boxOverlap( ba, bb, 2 ) ) continue;
+      if ( fatLineSeparated( PP.A, PP.B, tiny ) ||
+           fatLineSeparated( PP.B, PP.A, tiny ) ) continue;
+
+      real_type sa = max( ba[2]-ba[0], ba[3]-ba[1] );
+      real_type sb = max( bb[2]-bb[0], bb[3]-bb[1] );
+      if ( max(sa,sb) <= tiny ) {
+        uv.push_back( (PP.A.u0+PP.A.u1)/2 );
+        uv.push_back( (PP.B.u0+PP.B.u1)/2 );
+        continue;
+      }
+
+      if ( isFlat( PP.A ) && isFlat( PP.B ) ) {
+        // start from the crossing of the chords
+        real_type const * P = PP.A.P;
+        real_type const * Q = PP.B.P;
+        real_type dax = P[6]-P[0], day = P[7]-P[1];
+        real_type dbx = Q[6]-Q[0], dby = Q[7]-Q[1];
+        real_type rx  = Q[0]-P[0], ry  = Q[1]-P[1];
+        real_type det = dbx*day-dax*dby;
+        real_type s = 0.5, r = 0.5;
+        if ( abs(det) > 1e-8*(abs(dbx*day)+abs(dax*dby)) ) {
+          s = max( real_type(0), min( real_type(1), (dbx*ry-dby*rx)/det ) );
+          r = max( real_type(0), min( real_type(1), (dax*ry-day*rx)/det ) );
+        }
+        real_type u = PP.A.u0+s*(PP.A.u1-PP.A.u0);
+        real_type v = PP.B.u0+r*(PP.B.u1-PP.B.u0);
+        real_type const du = 1e-9*(PP.A.u1-PP.A.u0);
+        real_type const dv = 1e-9*(PP.B.u1-PP.B.u0);
+        if ( newtonCross( a, b, u, v, tol ) &&
+             u >= PP.A.u0-du && u <= PP.A.u1+du &&
+             v >= PP.B.u0-dv && v <= PP.B.u1+dv ) {
+          uv.push_back( u );
+          uv.push_back( v );
+          continue;
+        }
+      }
+
+      // split the larger piece
+      PiecePair L = PP, R = PP;
+      if ( sa >= sb ) splitHalf( PP.A, L.A, R.A );
+      else            splitHalf( PP.B, L.B, R.B );
+      stack.push_back( R );
+      stack.push_back( L );
+    }
+    return stack.empty();
+  }
+
+  /*\
+   |  Real roots in [0,1] of c0 + c1 u + c2 u^2 + c3 u^3,
+   |  the negligible leading coefficients are dropped
+  \*/
+
+  static
+  integer
+  unitRoots( real_type const c[4], real_type u[3] ) {
+    real_type const eps = std::numeric_limits<real_type>::epsilon();
+    real_type cmax = max( max(abs(c[0]),abs(c[1])), max(abs(c[2]),abs(c[3])) );
+    if ( cmax == 0 ) return 0;
+    real_type re[3], im[3];
+    integer   nr = 0;
+    if ( abs(c[3]) > 1e3*eps*cmax ) {
+      nr = cubicRoots( c, re, im ).first;
+    } else if ( abs(c[2]) > 1e3*eps*cmax ) {
+      if ( c[0] == 0 ) { // quadraticRoots misses the root 0
+        re[0] = 0; re[1] = -c[1]/c[2]; nr = 2;
+      } else {
+        nr = quadraticRoots( c, re, im ).first;
+      }
+    } else if ( abs(c[1]) > 1e3*eps*cmax ) {
+      re[0] = -c[0]/c[1]; nr = 1;
+    }
+    integer n = 0;
+    for ( integer k = 0; k < nr; ++k ) {
+      real_type x = re[k];
+      if ( !( x >= -1e-9 && x <= 1+1e-9 ) ) continue;
+      // polish on the original cubic
+      for ( integer iter = 0; iter < 3; ++iter ) {
+        real_type f  = c[0]+x*(c[1]+x*(c[2]+x*c[3]));
+        real_type df = c[1]+x*(2*c[2]+3*x*c[3]);
+        if ( df == 0 ) break;
+        x -= f/df;
+      }
+      if ( x >= -1e-12 && x <= 1+1e-12 )
+        u[n++] = max( real_type(0), min( real_type(1), x ) );
+    }
+    return n;
+  }
+
+  // sort by a, b, ta and merge the hits closer than `tol` in both parameters
+  static
+  void
+  sortHits(
+    vector<SplineVecBVH::Hit> & hits,
+    size_t                      first,
+    real_type                   tolA,
+    real_type                   tolB
+  ) {
+    typedef SplineVecBVH::Hit Hit;
+    std::sort(
+      hits.begin()+std::ptrdiff_t(first), hits.end(),
+      []( Hit const & x, Hit const & y ) {
+        if ( x.a != y.a ) return x.a < y.a;
+        if ( x.b != y.b ) return x.b < y.b;
+        return x.ta < y.ta;
+      }
+    );
+    size_t k = first;
+    for ( size_t i = first; i < hits.size(); ++i ) {
+      if ( k > first ) {
+        Hit const & h = hits[k-1];
+        if ( h.a == hits[i].a && h.b == hits[i].b &&
+             abs(h.ta-hits[i].ta) <= tolA && abs(h.tb-hits[i].tb) <= tolB ) continue;
+      }
+      hits[k++] = hits[i];
+    }
+    hits.resize( k );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  SplineVecBVH::intersectHits(
+    SplineVecBVH const & B,
+    integer              a,
+    integer              b,
+    vector<Hit>        & hits
+  ) const {
+    SPLINE_ASSERT(
+      this->_nseg > 0 && B._nseg > 0, "SplineVecBVH::intersect, tree not built"
+    )
+    SPLINE_ASSERT(
+      this->_dim == 2 && B._dim == 2,
+      "SplineVecBVH::intersect, expected planar curves, dimensions " <<
+      this->_dim << " and " << B._dim
+    )
+    SPLINE_ASSERT(
+      this != &B, "SplineVecBVH::intersect, self intersection not supported"
+    )
+    size_t first = hits.size();
+    bool   complete = true;
+    vector<integer>   stack;
+    vector<PiecePair> pieces;
+    vector<real_type> uv;
+    stack.push_back( 0 );
+    stack.push_back( 0 );
+    while ( !stack.empty() ) {
+      integer nb = stack.back(); stack.pop_back();
+      integer na = stack.back(); stack.pop_back();
+      if ( !boxOverlap( &this->_nbox[4*size_t(na)], &B._nbox[4*size_t(nb)], 2 ) ) continue;
+      Node const & NA = this->_nodes[size_t(na)];
+      Node const & NB = B._nodes[size_t(nb)];
+      if ( NA.left >= 0 && ( NB.left < 0 || NA.last-NA.first >= NB.last-NB.first ) ) {
+        stack.push_back( NA.left );  stack.push_back( nb );
+        stack.push_back( NA.right ); stack.push_back( nb );
+        continue;
+      }
+      if ( NB.left >= 0 ) {
+        stack.push_back( na ); stack.push_back( NB.left );
+        stack.push_back( na ); stack.push_back( NB.right );
+        continue;
+      }
+      // two leaves
+      for ( integer ka = NA.first; ka < NA.last; ++ka ) {
+        size_t i = size_t(this->_perm[size_t(ka)]);
+        for ( integer kb = NB.first; kb < NB.last; ++kb ) {
+          size_t k = size_t(B._perm[size_t(kb)]);
+          if ( !boxOverlap( &this->_box[4*i], &B._box[4*k], 2 ) ) continue;
+          uv.clear();
+          if ( !segmentCross( &this->_C[8*i], &B._C[8*k], uv, pieces ) )
+            complete = false;
+          for ( size_t m = 0; m < uv.size(); m += 2 ) {
+            real_type hA = this->_T[i+1]-this->_T[i];
+            real_type hB = B._T[k+1]-B._T[k];
+            hits.push_back( Hit{ a, b, this->_T[i]+uv[m]*hA, B._T[k]+uv[m+1]*hB } );
+          }
+        }
+      }
+    }
+    sortHits(
+      hits, first,
+      1e-9*(this->_T.back()-this->_T.front()),
+      1e-9*(B._T.back()-B._T.front())
+    );
+    return complete;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVecBVH::segmentHits(
+    real_type const P0[],
+    real_type const P1[],
+    integer         a,
+    integer         b,
+    vector<Hit>   & hits
+  ) const {
+    SPLINE_ASSERT(
+      this->_nseg > 0, "SplineVecBVH::intersectSegment, tree not built"
+    )
+    SPLINE_ASSERT(
+      this->_dim == 2,
+      "SplineVecBVH::intersectSegment, expected a planar curve, dimension " <<
+      this->_dim
+    )
+    size_t    first = hits.size();
+    real_type box[4] = {
+      min(P0[0],P1[0]), min(P0[1],P1[1]), max(P0[0],P1[0]), max(P0[1],P1[1])
+    };
+    // signed distance from the line times |P1-P0|
+    real_type dx = P1[0]-P0[0];
+    real_type dy = P1[1]-P0[1];
+    real_type L2 = dx*dx+dy*dy;
+    if ( L2 == 0 ) return;
+    vector<integer> stack;
+    stack.push_back( 0 );
+    while ( !stack.empty() ) {
+      integer n = stack.back(); stack.pop_back();
+      if ( !boxOverlap( &this->_nbox[4*size_t(n)], box, 2 ) ) continue;
+      Node const & N = this->_nodes[size_t(n)];
+      if ( N.left >= 0 ) {
+        stack.push_back( N.right );
+        stack.push_back( N.left );
+        continue;
+      }
+      for ( integer kk = N.first; kk < N.last; ++kk ) {
+        size_t i = size_t(this->_perm[size_t(kk)]);
+        if ( !boxOverlap( &this->_box[4*i], box, 2 ) ) continue;
+        real_type const * c = &this->_C[8*i];
+        real_type cf[4] = {
+          dx*(c[1]-P0[1]) - dy*(c[0]-P0[0]),
+          dx*c[3] - dy*c[2],
+          dx*c[5] - dy*c[4],
+          dx*c[7] - dy*c[6]
+        };
+        real_type u[3];
+        integer   nr = unitRoots( cf, u );
+        for ( integer k = 0; k < nr; ++k ) {
+          real_type x = c[0]+u[k]*(c[2]+u[k]*(c[4]+u[k]*c[6]));
+          real_type y = c[1]+u[k]*(c[3]+u[k]*(c[5]+u[k]*c[7]));
+          real_type s = ( (x-P0[0])*dx + (y-P0[1])*dy ) / L2;
+          if ( s < -1e-12 || s > 1+1e-12 ) continue;
+          real_type h = this->_T[i+1]-this->_T[i];
+          hits.push_back(
+            Hit{ a, b, this->_T[i]+u[k]*h, max( real_type(0), min( real_type(1), s ) ) }
+          );
+        }
+      }
+    }
+    sortHits( hits, first, 1e-9*(this->_T.back()-this->_T.front()), 1e-9 );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineVecBVH::intersect(
+    SplineVecBVH const & B,
+    vector<real_type>  & ta,
+    vector<real_type>  & tb,
+    bool               * complete
+  ) const {
+    vector<Hit> hits;
+    bool ok = this->intersectHits( B, 0, 0, hits );
+    if ( complete != nullptr ) *complete = ok;
+    ta.resize( hits.size() );
+    tb.resize( hits.size() );
+    for ( size_t k = 0; k < hits.size(); ++k ) {
+      ta[k] = hits[k].ta;
+      tb[k] = hits[k].tb;
+    }
+    return integer(hits.size());
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineVecBVH::intersectSegment(
+    real_type const     P0[],
+    real_type const     P1[],
+    vector<real_type> & t,
+    vector<real_type> & s
+  ) const {
+    vector<Hit> hits;
+    this->segmentHits( P0, P1, 0, 0, hits );
+    t.resize( hits.size() );
+    s.resize( hits.size() );
+    for ( size_t k = 0; k < hits.size(); ++k ) {
+      t[k] = hits[k].ta;
+      s[k] = hits[k].tb;
+    }
+    return integer(hits.size());
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // chunks of work done by the threads, joined in the order of `first`
+  struct HitChunk {
+    size_t                    first;
+    bool                      complete;
+    vector<SplineVecBVH::Hit> hits;
+  };
+
+  static
+  bool
+  joinChunks( vector<HitChunk> & parts, vector<SplineVecBVH::Hit> & hits ) {
+    std::sort(
+      parts.begin(), parts.end(),
+      []( HitChunk const & x, HitChunk const & y ) { return x.first < y.first; }
+    );
+    bool complete = true;
+    hits.clear();
+    for ( HitChunk const & c : parts ) {
+      hits.insert( hits.end(), c.hits.begin(), c.hits.end() );
+      complete = complete && c.complete;
+    }
+    return complete;
+  }
+
+  void
+  SplineVecBVH::checkPlanarTree( char const where[] ) const {
+    SPLINE_ASSERT( this->_nseg > 0, where << ", tree not built" )
+    SPLINE_ASSERT(
+      this->_dim == 2,
+      where << ", expected planar curves, dimension " << this->_dim
+    )
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  SplineVecBVH::intersectAll(
+    vector<SplineVecBVH const *> const & curves,
+    vector<Hit>                        & hits,
+    integer                              nthreads
+  ) {
+    for ( SplineVecBVH const * c : curves )
+      c->checkPlanarTree( "SplineVecBVH::intersectAll" );
+    // pairs (i,j), i < j, enumerated by rows, row i starts at off[i]
+    size_t n = curves.size();
+    vector<size_t> off( n+1, 0 );
+    for ( size_t i = 0; i < n; ++i ) off[i+1] = off[i] + (n-1-i);
+
+    std::mutex       mtx;
+    vector<HitChunk> parts;
+    parallel_chunks( off[n], nthreads, [&]( size_t k0, size_t k1 ) {
+      HitChunk chunk;
+      chunk.first    = k0;
+      chunk.complete = true;
+      size_t i = size_t( std::upper_bound( off.begin(), off.end(), k0 ) - off.begin() ) - 1;
+      size_t j = i+1+(k0-off[i]);
+      for ( size_t k = k0; k < k1; ++k ) {
+        SplineVecBVH const & A = *curves[i];
+        SplineVecBVH const & B = *curves[j];
+        if ( boxOverlap( &A._nbox.front(), &B._nbox.front(), 2 ) &&
+             !A.intersectHits( B, integer(i), integer(j), chunk.hits ) )
+          chunk.complete = false;
+        if ( ++j == n ) { ++i; j = i+1; }
+      }
+      std::lock_guard<std::mutex> lck(mtx);
+      parts.push_back( std::move(chunk) );
+    } );
+    return joinChunks( parts, hits );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVecBVH::intersectAllSegments(
+    vector<SplineVecBVH const *> const & curves,
+    integer                              n,
+    real_type const                      P0[],
+    real_type const                      P1[],
+    integer                              ldP,
+    vector<Hit>                        & hits,
+    integer                              nthreads
+  ) {
+    for ( SplineVecBVH const * c : curves )
+      c->checkPlanarTree( "SplineVecBVH::intersectAllSegments" );
+    std::mutex       mtx;
+    vector<HitChunk> parts;
+    parallel_chunks( curves.size(), nthreads, [&]( size_t i0, size_t i1 ) {
+      HitChunk chunk;
+      chunk.first    = i0;
+      chunk.complete = true;
+      for ( size_t i = i0; i < i1; ++i ) {
+        SplineVecBVH const & A = *curves[i];
+        real_type const * root = &A._nbox.front();
+        for ( integer k = 0; k < n; ++k ) {
+          real_type const * p0 = P0 + size_t(k)*size_t(ldP);
+          real_type const * p1 = P1 + size_t(k)*size_t(ldP);
+          real_type box[4] = {
+            min(p0[0],p1[0]), min(p0[1],p1[1]), max(p0[0],p1[0]), max(p0[1],p1[1])
+          };
+          if ( boxOverlap( root, box, 2 ) )
+            A.segmentHits( p0, p1, integer(i), k, chunk.hits );
+        }
+      }
+      std::lock_guard<std::mutex> lck(mtx);
+      parts.push_back( std::move(chunk) );
+    } );
+    joinChunks( parts, hits );
+  }
+
+}
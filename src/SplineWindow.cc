@@ -0,0 +1,287 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+/**
+ * 
+ */
+
+namespace Splines {
+
+  using namespace std; // load standard namspace
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineWindow::SplineWindow( string const & name )
+  : _name(name)
+  , baseValue(name+"_values")
+  , _stype(PCHIP_TYPE)
+  , _curve_can_extend(true)
+  , _capacity(0)
+  , _npts(0)
+  , _head(0)
+  , _X(nullptr)
+  , _Y(nullptr)
+  , _Yp(nullptr)
+  {
+    std::lock_guard<std::mutex> lck(lastInterval_mutex);
+    lastInterval_by_thread[std::this_thread::get_id()] = 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineWindow::SplineWindow( SplineWindow && s ) noexcept
+  : _name(std::move(s._name))
+  , baseValue(std::move(s.baseValue))
+  , _stype(s._stype)
+  , _curve_can_extend(s._curve_can_extend)
+  , _capacity(s._capacity)
+  , _npts(s._npts)
+  , _head(s._head)
+  , _X(s._X)
+  , _Y(s._Y)
+  , _Yp(s._Yp)
+  {
+    s._capacity = s._npts = s._head = 0;
+    s._X = s._Y = s._Yp = nullptr;
+    std::lock_guard<std::mutex> lck(s.lastInterval_mutex);
+    lastInterval_by_thread.swap( s.lastInterval_by_thread );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineWindow &
+  SplineWindow::operator = ( SplineWindow && s ) noexcept {
+    if ( this != &s ) {
+      _name             = std::move(s._name);
+      baseValue         = std::move(s.baseValue);
+      _stype            = s._stype;
+      _curve_can_extend = s._curve_can_extend;
+      _capacity         = s._capacity;
+      _npts             = s._npts;
+      _head             = s._head;
+      _X                = s._X;
+      _Y                = s._Y;
+      _Yp               = s._Yp;
+      s._capacity = s._npts = s._head = 0;
+      s._X = s._Y = s._Yp = nullptr;
+      std::lock( lastInterval_mutex, s.lastInterval_mutex );
+      std::lock_guard<std::mutex> lck1(lastInterval_mutex, std::adopt_lock);
+      std::lock_guard<std::mutex> lck2(s.lastInterval_mutex, std::adopt_lock);
+      lastInterval_by_thread.swap( s.lastInterval_by_thread );
+      s.lastInterval_by_thread.clear();
+    }
+    return *this;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineWindow::~SplineWindow() {
+    baseValue.free();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineWindow::reserve( integer capacity, SplineType1D stype ) {
+    SPLINE_ASSERT(
+      capacity > 1,
+      "SplineWindow::reserve, capacity = " << capacity << " must be >= 2"
+    )
+    SPLINE_ASSERT(
+      stype == LINEAR_TYPE || stype == PCHIP_TYPE ||
+      stype == AKIMA_TYPE  || stype == BESSEL_TYPE,
+      "SplineWindow::reserve, spline type `" << spline_type_1D[stype] <<
+      "' not supported, use linear, pchip, akima or bessel"
+    )
+    this->_stype    = stype;
+    this->_capacity = capacity;
+    this->_npts     = 0;
+    this->_head     = 0;
+    size_t n2 = size_t(2*capacity);
+    if ( stype == LINEAR_TYPE ) {
+      baseValue.allocate( 2*n2 );
+      this->_X  = baseValue( n2 );
+      this->_Y  = baseValue( n2 );
+      this->_Yp = nullptr;
+    } else {
+      baseValue.allocate( 3*n2 );
+      this->_X  = baseValue( n2 );
+      this->_Y  = baseValue( n2 );
+      this->_Yp = baseValue( n2 );
+    }
+    baseValue.must_be_empty( "SplineWindow::reserve" );
+    std::lock_guard<std::mutex> lck(lastInterval_mutex);
+    lastInterval_by_thread.clear();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*
+  // Slopes of PCHIP, Bessel and Akima depend on at most 2 nodes on each
+  // side, so the slopes in [i0,i1) are computed on the subwindow extended
+  // by 3 nodes per side: only nodes of the subwindow near its artificial
+  // boundaries differ from a full rebuild and they are not copied back.
+  */
+  void
+  SplineWindow::updateSlopes( integer i0, integer i1 ) {
+    if ( this->_stype == LINEAR_TYPE ) return;
+    if ( i0 < 0          ) i0 = 0;
+    if ( i1 > this->_npts ) i1 = this->_npts;
+    if ( i0 >= i1 ) return;
+    integer s = i0 > 3 ? i0-3 : 0;
+    integer e = i1+3 < this->_npts ? i1+3 : this->_npts;
+    real_type Yp[16];
+    SPLINE_ASSERT(
+      e-s <= 16,
+      "SplineWindow::updateSlopes, too much slopes to update: " << e-s
+    )
+    real_type const * X = this->_X + this->ipos(s);
+    real_type const * Y = this->_Y + this->ipos(s);
+    switch ( this->_stype ) {
+    case PCHIP_TYPE:  Pchip_build( X, Y, Yp, e-s );  break;
+    case AKIMA_TYPE:  Akima_build( X, Y, Yp, e-s );  break;
+    case BESSEL_TYPE: Bessel_build( X, Y, Yp, e-s ); break;
+    default: break;
+    }
+    for ( integer i = i0; i < i1; ++i ) this->store( this->_Yp, i, Yp[i-s] );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineWindow::pushBack( real_type x, real_type y ) {
+    SPLINE_ASSERT(
+      this->_capacity > 1,
+      "SplineWindow::pushBack, call reserve before pushing points"
+    )
+    SPLINE_ASSERT(
+      this->_npts == 0 || x > this->xMax(),
+      "SplineWindow::pushBack, non monotone insert at insert N. " << this->_npts <<
+      "\nX[ N-1 ] = " << this->xMax() << " must be less than x = " << x
+    )
+    bool evicted = false;
+    if ( this->_npts == this->_capacity ) {
+      // drop the oldest point, its slot becomes the new last slot
+      if ( ++this->_head == this->_capacity ) this->_head = 0;
+      --this->_npts;
+      evicted = true;
+    }
+    this->store( this->_X, this->_npts, x );
+    this->store( this->_Y, this->_npts, y );
+    ++this->_npts;
+    if ( this->_npts > 1 ) {
+      if ( evicted ) this->updateSlopes( 0, 3 );
+      this->updateSlopes( this->_npts-3, this->_npts );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineWindow::operator () ( real_type x ) const {
+    SPLINE_ASSERT(
+      this->_npts > 1, "in SplineWindow::operator(), npts = " << this->_npts
+    )
+    if ( this->_stype == LINEAR_TYPE ) {
+      if ( x < this->xMin() ) return this->yNode(0);
+      if ( x > this->xMax() ) return this->yNode(this->_npts-1);
+      size_t    i = size_t(this->ipos(this->search(x)));
+      real_type s = (x-this->_X[i])/(this->_X[i+1] - this->_X[i]);
+      return (1-s)*this->_Y[i] + s * this->_Y[i+1];
+    }
+    size_t    i = size_t(this->ipos(this->search(x)));
+    real_type base[4];
+    Hermite3( x-this->_X[i], this->_X[i+1]-this->_X[i], base );
+    return base[0] * this->_Y[i]  +
+           base[1] * this->_Y[i+1] +
+           base[2] * this->_Yp[i] +
+           base[3] * this->_Yp[i+1];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineWindow::D( real_type x ) const {
+    SPLINE_ASSERT(
+      this->_npts > 1, "in SplineWindow::D(), npts = " << this->_npts
+    )
+    if ( this->_stype == LINEAR_TYPE ) {
+      if ( x < this->xMin() || x > this->xMax() ) return 0;
+      size_t i = size_t(this->ipos(this->search(x)));
+      return ( this->_Y[i+1] - this->_Y[i] ) / ( this->_X[i+1] - this->_X[i] );
+    }
+    size_t    i = size_t(this->ipos(this->search(x)));
+    real_type base_D[4];
+    Hermite3_D( x-this->_X[i], this->_X[i+1]-this->_X[i], base_D );
+    return base_D[0] * this->_Y[i]  +
+           base_D[1] * this->_Y[i+1] +
+           base_D[2] * this->_Yp[i] +
+           base_D[3] * this->_Yp[i+1];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineWindow::DD( real_type x ) const {
+    SPLINE_ASSERT(
+      this->_npts > 1, "in SplineWindow::DD(), npts = " << this->_npts
+    )
+    if ( this->_stype == LINEAR_TYPE ) return 0;
+    size_t    i = size_t(this->ipos(this->search(x)));
+    real_type base_DD[4];
+    Hermite3_DD( x-this->_X[i], this->_X[i+1]-this->_X[i], base_DD );
+    return base_DD[0] * this->_Y[i]  +
+           base_DD[1] * this->_Y[i+1] +
+           base_DD[2] * this->_Yp[i] +
+           base_DD[3] * this->_Yp[i+1];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type
+  SplineWindow::DDD( real_type x ) const {
+    SPLINE_ASSERT(
+      this->_npts > 1, "in SplineWindow::DDD(), npts = " << this->_npts
+    )
+    if ( this->_stype == LINEAR_TYPE ) return 0;
+    size_t    i = size_t(this->ipos(this->search(x)));
+    real_type base_DDD[4];
+    Hermite3_DDD( x-this->_X[i], this->_X[i+1]-this->_X[i], base_DDD );
+    return base_DDD[0] * this->_Y[i]  +
+           base_DDD[1] * this->_Y[i+1] +
+           base_DDD[2] * this->_Yp[i] +
+           base_DDD[3] * this->_Yp[i+1];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineWindow::info( ostream_type & s ) const {
+    s << "SplineWindow[" << name() << "] type = " << type_name()
+      << " n.points = " << this->_npts << " / " << this->_capacity << '\n';
+  }
+
+}
@@ -41,6 +41,7 @@
 #ifdef __clang__
 #pragma clang diagnostic ignored "-Wc++98-compat"
 #pragma clang diagnostic ignored "-Wglobal-constructors"
+#pragma clang diagnostic ignored "-Wimplicit-fallthrough"
 #endif
 
 #ifdef SPLINES_OS_OSX
@@ -115,6 +116,177 @@ namespace Splines {
    |
   \*/
 
+  /*
+  //  chord pass, one sweep of the points computes the chords and the
+  //  products of consecutive chords. `DIM` > 0 unrolls the loop over the
+  //  components for the planar and spatial cases, `DIM` = 0 uses `dim`
+  */
+
+  template <integer DIM, bool DOT>
+  static
+  inline
+  void
+  chord_pass_fixed(
+    integer         dim,
+    integer         npts,
+    real_type const pnts[],
+    integer         ld_pnts,
+    real_type       d[],
+    real_type       dot[]
+  ) {
+    integer const D    = DIM > 0 ? DIM : dim;
+    integer const nseg = npts-1;
+    if ( nseg < 1 ) return;
+    real_type const * p0 = pnts;
+    real_type dst = 0;
+    for ( integer j = 0; j < D; ++j ) {
+      real_type c = p0[j+ld_pnts] - p0[j];
+      dst += c*c;
+    }
+    d[0] = sqrt(dst);
+    for ( integer k = 1; k < nseg; ++k ) {
+      real_type const * pm = p0;
+      p0 += ld_pnts;
+      real_type const * p1 = p0 + ld_pnts;
+      real_type pr = 0;
+      dst = 0;
+      for ( integer j = 0; j < D; ++j ) {
+        real_type c = p1[j] - p0[j];
+        dst += c*c;
+        if ( DOT ) pr += c * (p0[j] - pm[j]);
+      }
+      d[k] = sqrt(dst);
+      if ( DOT ) dot[k] = pr;
+    }
+  }
+
+  void
+  chord_pass(
+    integer         dim,
+    integer         npts,
+    real_type const pnts[],
+    integer         ld_pnts,
+    real_type       d[],
+    real_type       dot[]
+  ) {
+    if ( dot == nullptr ) {
+      switch ( dim ) {
+      case 2:  chord_pass_fixed<2,false>( dim, npts, pnts, ld_pnts, d, dot ); break;
+      case 3:  chord_pass_fixed<3,false>( dim, npts, pnts, ld_pnts, d, dot ); break;
+      default: chord_pass_fixed<0,false>( dim, npts, pnts, ld_pnts, d, dot ); break;
+      }
+    } else {
+      switch ( dim ) {
+      case 2:  chord_pass_fixed<2,true>( dim, npts, pnts, ld_pnts, d, dot ); break;
+      case 3:  chord_pass_fixed<3,true>( dim, npts, pnts, ld_pnts, d, dot ); break;
+      default: chord_pass_fixed<0,true>( dim, npts, pnts, ld_pnts, d, dot ); break;
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  chord_pass(
+    integer                 dim,
+    integer                 npts,
+    real_type const * const Y[],
+    real_type               d[],
+    real_type               dot[]
+  ) {
+    // components are contiguous: every loop is stride-1.
+    // The sums are accumulated in the same order of the row storage version
+    integer nseg = npts-1;
+    std::fill( d, d+nseg, 0 );
+    if ( dot != nullptr && nseg > 1 ) std::fill( dot+1, dot+nseg, 0 );
+    for ( integer j = 0; j < dim; ++j ) {
+      real_type const * Yj = Y[j];
+      for ( integer k = 0; k < nseg; ++k ) {
+        real_type c = Yj[k+1] - Yj[k];
+        d[k] += c*c;
+      }
+      if ( dot != nullptr )
+        for ( integer k = 1; k < nseg; ++k )
+          dot[k] += (Yj[k+1] - Yj[k]) * (Yj[k] - Yj[k-1]);
+    }
+    for ( integer k = 0; k < nseg; ++k ) d[k] = sqrt(d[k]);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  static real_type const m_pi_2 = 1.57079632679489661923132169164; // pi/2
+
+  void
+  turning_angles(
+    integer         npts,
+    real_type const d[],
+    real_type       dot[]
+  ) {
+    // exterior angle bounded by pi/2, acos only for the acute turns
+    dot[0] = dot[npts-1] = 0;
+    for ( integer k = 1; k < npts-1; ++k ) {
+      real_type dd = d[k-1]*d[k];
+      real_type c  = dd > 0 ? dot[k]/dd : 1;
+      if      ( c >= 1 ) dot[k] = 0;
+      else if ( c <= 0 ) dot[k] = m_pi_2;
+      else               dot[k] = std::acos(c);
+    }
+  }
+
+  static
+  inline
+  real_type
+  turning_weight( real_type a, real_type b )
+  { return a+b > 0 ? a/(a+b) : 0; }
+
+  void
+  turning_correction(
+    integer         npts,
+    real_type const len[],
+    real_type const th[],
+    real_type       c,
+    real_type       out[]
+  ) {
+    // `out` may be `len`: the uncorrected previous length is kept in `lm1`
+    integer   nseg = npts-1;
+    real_type lm1  = 0;
+    for ( integer k = 0; k < nseg; ++k ) {
+      real_type lk = len[k];
+      real_type f  = 0;
+      if ( k > 0      ) f += th[k]   * turning_weight( lm1, lk );
+      if ( k+1 < nseg ) f += th[k+1] * turning_weight( len[k+1], lk );
+      out[k] = lk * ( 1 + c * f );
+      lm1    = lk;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  knots_from_lengths(
+    integer         npts,
+    real_type const len[],
+    real_type       t[]
+  ) {
+    integer   nseg = npts-1;
+    real_type acc  = 0;
+    for ( integer k = 0; k < nseg; ++k ) {
+      real_type l = len[k]; // `len` may alias `t`
+      t[k] = acc;
+      acc += l;
+    }
+    real_type const nn = static_cast<real_type>(nseg);
+    if ( acc > 0 ) {
+      real_type const bf = 1/acc;
+      for ( integer k = 1; k < nseg; ++k ) t[k] *= bf;
+    } else { // all the points coincide
+      for ( integer k = 1; k < nseg; ++k ) t[k] = k/nn;
+    }
+    t[nseg] = 1;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   uniform(
     integer         /* dim */,
@@ -123,10 +295,11 @@ namespace Splines {
     integer         /* ld_pnts */,
     real_type       t[]
   ) {
+    real_type const nn = static_cast<real_type>(npts-1);
     t[0]      = 0;
     t[npts-1] = 1;
     for ( integer k = 1; k < npts-1; ++k )
-      t[k] = static_cast<real_type>(k)/static_cast<real_type>(npts);
+      t[k] = static_cast<real_type>(k)/nn;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -139,19 +312,8 @@ namespace Splines {
     integer         ld_pnts,
     real_type       t[]
   ) {
-    t[0] = 0;
-    real_type const * p0 = pnts;
-    for ( integer k = 1; k < npts; ++k ) {
-      real_type const * p1 = p0 + ld_pnts;
-      real_type dst = 0;
-      for ( integer j = 0; j < dim; ++j ) {
-        real_type c = p1[j] - p0[j];
-        dst += c*c;
-      }
-      t[k] = t[k-1] + sqrt(dst);
-    }
-    for ( integer k = 1; k < npts-1; ++k ) t[k] /= t[npts-1];
-    t[npts-1] = 1;
+    chord_pass( dim, npts, pnts, ld_pnts, t, nullptr );
+    knots_from_lengths( npts, t, t );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -165,31 +327,112 @@ namespace Splines {
     real_type const alpha,
     real_type       t[]
   ) {
-    t[0] = 0;
-    real_type const * p0 = pnts;
-    for ( integer k = 1; k < npts; ++k ) {
-      real_type const * p1 = p0 + ld_pnts;
-      real_type dst = 0;
-      for ( integer j = 0; j < dim; ++j ) {
-        real_type c = p1[j] - p0[j];
-        dst += c*c;
+    chord_pass( dim, npts, pnts, ld_pnts, t, nullptr );
+    if ( alpha == 0.5 )
+      for ( integer k = 0; k < npts-1; ++k ) t[k] = sqrt(t[k]);
+    else
+      for ( integer k = 0; k < npts-1; ++k ) t[k] = pow(t[k],alpha);
+    knots_from_lengths( npts, t, t );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*
+  //  Cox-de Boor evaluation of the single B-spline N(i,p) on the knots U
+  */
+  static
+  real_type
+  one_basis(
+    integer         i,
+    integer         p,
+    real_type const U[],
+    real_type       u
+  ) {
+    if ( u < U[i] || u >= U[i+p+1] ) return 0;
+    real_type N[4];
+    for ( integer j = 0; j <= p; ++j )
+      N[j] = ( u >= U[i+j] && u < U[i+j+1] ) ? 1 : 0;
+    for ( integer k = 1; k <= p; ++k ) {
+      real_type saved = 0;
+      if ( N[0] != 0 ) saved = ((u-U[i])*N[0])/(U[i+k]-U[i]);
+      for ( integer j = 0; j <= p-k; ++j ) {
+        real_type Uleft  = U[i+j+1];
+        real_type Uright = U[i+j+k+1];
+        if ( N[j+1] == 0 ) {
+          N[j]  = saved;
+          saved = 0;
+        } else {
+          real_type tmp = N[j+1]/(Uright-Uleft);
+          N[j]  = saved + (Uright-u)*tmp;
+          saved = (u-Uleft)*tmp;
+        }
       }
-      t[k] = t[k-1] + pow(dst,alpha/2);
     }
-    for ( integer k = 1; k < npts-1; ++k ) t[k] /= t[npts-1];
-    t[npts-1] = 1;
+    return N[0];
   }
 
-  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // derivative of N(i,p), p > 0
+  static
+  real_type
+  one_basis_D(
+    integer         i,
+    integer         p,
+    real_type const U[],
+    real_type       u
+  ) {
+    real_type res = 0;
+    real_type h0  = U[i+p]-U[i];
+    real_type h1  = U[i+p+1]-U[i+1];
+    if ( h0 > 0 ) res += one_basis( i,   p-1, U, u )/h0;
+    if ( h1 > 0 ) res -= one_basis( i+1, p-1, U, u )/h1;
+    return p*res;
+  }
 
   void
   universal(
-    integer         dim,
+    integer         /* dim */,
     integer         npts,
-    real_type const pnts[],
-    integer         ld_pnts,
+    real_type const []/* pnts    */,
+    integer         /* ld_pnts */,
     real_type       t[]
-  ); // to be done
+  ) {
+    /*
+    // Lim universal parametrization: t[i] is the maximum of the i-th
+    // B-spline of degree p = min(3,npts-1) on the clamped uniform knots.
+    // Far from the extrema the support is symmetric and the maximum is
+    // its midpoint, the first p are found by bisection on the sign of the
+    // derivative (the B-splines are unimodal) and the last p by symmetry.
+    */
+    integer p = std::min( integer(3), npts-1 );
+    real_type const nn = static_cast<real_type>(npts-p);
+    // the first 2p+2 knots of the clamped uniform vector are enough for
+    // the B-splines searched numerically
+    real_type U[8];
+    for ( integer k = 0; k <= 2*p+1; ++k ) {
+      if      ( k <= p    ) U[k] = 0;
+      else if ( k >= npts ) U[k] = 1;
+      else                  U[k] = (k-p)/nn;
+    }
+    t[0]      = 0;
+    t[npts-1] = 1;
+    for ( integer i = 1; i < npts-1; ++i ) {
+      if ( i >= p && i+p+1 <= npts ) {
+        t[i] = (2*i+1-p)/(2*nn); // midpoint of [U(i),U(i+p+1)]
+      } else if ( 2*i < npts ) {
+        real_type a = U[i];
+        real_type b = U[i+p+1];
+        while ( b-a > 1e-15 ) {
+          real_type c = (a+b)/2;
+          if ( c <= a || c >= b ) break;
+          if ( one_basis_D( i, p, U, c ) > 0 ) a = c;
+          else                             b = c;
+        }
+        t[i] = (a+b)/2;
+      } else {
+        t[i] = 1-t[npts-1-i];
+      }
+    }
+  }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -200,7 +443,14 @@ namespace Splines {
     real_type const pnts[],
     integer         ld_pnts,
     real_type       t[]
-  ); // to be done
+  ) {
+    // chord lengths corrected by 3/2 of the turning angles
+    std::vector<real_type> th(static_cast<size_t>(npts));
+    chord_pass( dim, npts, pnts, ld_pnts, t, &th.front() );
+    turning_angles( npts, t, &th.front() );
+    turning_correction( npts, t, &th.front(), 1.5, t );
+    knots_from_lengths( npts, t, t );
+  }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -211,7 +461,16 @@ namespace Splines {
     real_type const pnts[],
     integer         ld_pnts,
     real_type       t[]
-  ); // to be done
+  ) {
+    // refined centripetal: square root of the chords corrected by 1/2
+    // of the turning angles
+    std::vector<real_type> th(static_cast<size_t>(npts));
+    chord_pass( dim, npts, pnts, ld_pnts, t, &th.front() );
+    turning_angles( npts, t, &th.front() );
+    for ( integer k = 0; k < npts-1; ++k ) t[k] = sqrt(t[k]);
+    turning_correction( npts, t, &th.front(), 0.5, t );
+    knots_from_lengths( npts, t, t );
+  }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -531,6 +790,31 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  Spline &
+  Spline::operator = ( Spline && s ) noexcept {
+    if ( this != &s ) {
+      this->_name             = std::move(s._name);
+      this->_curve_is_closed  = s._curve_is_closed;
+      this->_curve_can_extend = s._curve_can_extend;
+      this->_is_view          = s._is_view;
+      this->npts              = s.npts;
+      this->npts_reserved     = s.npts_reserved;
+      this->X                 = s.X;
+      this->Y                 = s.Y;
+      s.npts = s.npts_reserved = 0;
+      s.X    = s.Y = nullptr;
+      s._is_view = false;
+      std::lock( this->lastInterval_mutex, s.lastInterval_mutex );
+      std::lock_guard<std::mutex> lck1(this->lastInterval_mutex, std::adopt_lock);
+      std::lock_guard<std::mutex> lck2(s.lastInterval_mutex, std::adopt_lock);
+      this->lastInterval_by_thread.swap( s.lastInterval_by_thread );
+      s.lastInterval_by_thread.clear();
+    }
+    return *this;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   Spline::build(
     real_type const x[], integer incx,
@@ -561,6 +845,10 @@ namespace Splines {
 
   void
   Spline::pushBack( real_type x, real_type y ) {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "Spline::pushBack, cannot modify a view spline"
+    )
     if ( npts > 0 ) {
       SPLINE_ASSERT(
         x >= X[size_t(npts-1)], // ammetto punti doppi
@@ -594,6 +882,10 @@ namespace Splines {
 
   void
   Spline::setOrigin( real_type x0 ) {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "Spline::setOrigin, cannot modify a view spline"
+    )
     real_type Tx = x0 - X[0];
     real_type *ix = X;
     while ( ix < X+npts ) *ix++ += Tx;
@@ -603,6 +895,10 @@ namespace Splines {
 
   void
   Spline::setRange( real_type xmin, real_type xmax ) {
+    SPLINE_ASSERT(
+      !this->_is_view,
+      "Spline::setRange, cannot modify a view spline"
+    )
     SPLINE_ASSERT(
       xmax > xmin,
       "Spline::setRange( " << xmin <<
@@ -631,80 +927,104 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  Spline::jet( real_type x, integer order, real_type J[] ) const {
+    SPLINE_ASSERT(
+      order >= 0 && order <= 5,
+      "Spline::jet, order = " << order << " must be in [0,5]"
+    )
+    switch ( order ) {
+    case 5: J[5] = this->DDDDD(x);
+    case 4: J[4] = this->DDDD(x);
+    case 3: J[3] = this->DDD(x);
+    case 2: J[2] = this->DD(x);
+    case 1: J[1] = this->D(x);
+    case 0: J[0] = (*this)(x);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   real_type
   curvature( real_type s, Spline const & X, Spline const & Y ) {
-    real_type x_1 = X.D(s);
-    real_type x_2 = X.DD(s);
-    real_type y_1 = Y.D(s);
-    real_type y_2 = Y.DD(s);
-    real_type t4  = x_1 * x_1;
-    real_type t5  = y_1 * y_1;
-    real_type t6  = t4 + t5;
-    real_type t7  = sqrt(t6);
-    return (x_1 * y_2 - y_1 * x_2) / ( t6 * t7 );
+    real_type jx[3], jy[3];
+    X.jet( s, 2, jx );
+    Y.jet( s, 2, jy );
+    return curvature_from_jet( jx, jy );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   real_type
   curvature_D( real_type s, Spline const & X, Spline const & Y ) {
-    real_type x_1 = X.D(s);
-    real_type x_2 = X.DD(s);
-    real_type x_3 = X.DDD(s);
-    real_type y_1 = Y.D(s);
-    real_type y_2 = Y.DD(s);
-    real_type y_3 = Y.DDD(s);
-    real_type t1  = x_1 * x_1;
-    real_type t9  = x_2 * x_2;
-    real_type t13 = y_1 * y_1;
-    real_type t17 = y_2 * y_2;
-    real_type t26 = t1 + t13;
-    real_type t27 = t26 * t26;
-    real_type t28 = sqrt(t26);
-    real_type aa  = y_3 * x_1 - y_1 * x_3;
-    real_type bb  = 3 * y_2 * x_2;
-    return ( t1 * ( aa - bb ) + t13 * ( aa + bb )
-             + 3 * x_1 * y_1 * ( t9 - t17 ) ) / ( t28 * t27 );
+    real_type jx[4], jy[4];
+    X.jet( s, 3, jx );
+    Y.jet( s, 3, jy );
+    return curvature_D_from_jet( jx, jy );
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   real_type
   curvature_DD( real_type s, Spline const & X, Spline const & Y ) {
-    real_type x_1 = X.D(s);
-    real_type x_2 = X.DD(s);
-    real_type x_3 = X.DDD(s);
-    real_type x_4 = X.DDDD(s);
-    real_type y_1 = Y.D(s);
-    real_type y_2 = Y.DD(s);
-    real_type y_3 = Y.DDD(s);
-    real_type y_4 = Y.DDDD(s);
-
-    real_type t1  = y_1 * y_1;
-    real_type t2  = t1 * t1;
-    real_type t12 = x_2 * x_2;
-    real_type t13 = t12 * x_2;
-    real_type t15 = x_1 * x_3;
-    real_type t16 = 9 * t15;
-    real_type t17 = y_2 * y_2;
-    real_type t21 = x_1 * x_1;
-    real_type t22 = x_4 * t21;
-    real_type t26 = 9 * x_1 * y_2 * y_3;
-    real_type t30 = t21 * x_1;
-    real_type t40 = t17 * y_2;
-    real_type t64 = t21 + t1;
-    real_type t65 = t64 * t64;
-    real_type t67 = sqrt(t64);
-    return (
-      t2 * (x_1 * y_4 + 4 * x_2 * y_3 + 5 * x_3 * y_2 - y_1 * x_4)
-      + t1 * y_1 * (3 * t13 + x_2 * (t16 - 12 * t17) - 2 * t22 - t26)
-      + t1 * ( x_1 * ( 12 * t40 - 33 * y_2 * t12 )
-               + t21 * ( y_2 * x_3 - y_3 * x_2)
-               + 2 * y_4 * t30 )
-      - y_1 * t21 * ( 12 * t13 - x_2 * (t16+33*t17) + t22 + t26 )
-      + t30 * ( y_2 * (12 * t12 - 4 * t15) + y_4 * t21
-                -5 * x_1 * x_2 * y_3 - 3 * t40)
-    ) / (t67*t65*t64);
+    real_type jx[5], jy[5];
+    X.jet( s, 4, jx );
+    Y.jet( s, 4, jy );
+    return curvature_DD_from_jet( jx, jy );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  curvature(
+    integer         n,
+    real_type const s[],
+    Spline const  & X,
+    Spline const  & Y,
+    real_type       kappa[]
+  ) {
+    real_type jx[3], jy[3];
+    for ( integer k = 0; k < n; ++k ) {
+      X.jet( s[k], 2, jx );
+      Y.jet( s[k], 2, jy );
+      kappa[k] = curvature_from_jet( jx, jy );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  curvature_D(
+    integer         n,
+    real_type const s[],
+    Spline const  & X,
+    Spline const  & Y,
+    real_type       kappa_D[]
+  ) {
+    real_type jx[4], jy[4];
+    for ( integer k = 0; k < n; ++k ) {
+      X.jet( s[k], 3, jx );
+      Y.jet( s[k], 3, jy );
+      kappa_D[k] = curvature_D_from_jet( jx, jy );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  curvature_DD(
+    integer         n,
+    real_type const s[],
+    Spline const  & X,
+    Spline const  & Y,
+    real_type       kappa_DD[]
+  ) {
+    real_type jx[5], jy[5];
+    for ( integer k = 0; k < n; ++k ) {
+      X.jet( s[k], 4, jx );
+      Y.jet( s[k], 4, jy );
+      kappa_DD[k] = curvature_DD_from_jet( jx, jy );
+    }
   }
 
   /*
@@ -115,6 +115,16 @@ namespace Splines {
     AKIMA2D_TYPE   = 3
   } SplineType2D;
 
+  //! Kind of object stored in a record of a binary spline file
+  typedef enum {
+    BINARY_SPLINE_1D   = 1,
+    BINARY_SPLINE_SET  = 2,
+    BINARY_SPLINE_VEC  = 3,
+    BINARY_SPLINE_SURF = 4
+  } SplineBinaryKind;
+
+  class SplineBinaryFile;
+
   extern char const *spline_type_1D[];
 
   extern SplineType1D string_to_splineType( string const & n );
@@ -171,6 +181,44 @@ namespace Splines {
   void Hermite5_DDDD( real_type x, real_type H, real_type base_DDDD[6] );
   void Hermite5_DDDDD( real_type x, real_type H, real_type base_DDDDD[6] );
 
+  /*
+  //   ____            _
+  //  | __ )  ___ ___(_) ___ _ __
+  //  |  _ \ / _ \_  / |/ _ \ '__|
+  //  | |_) |  __// /| |  __/ |
+  //  |____/ \___/___|_|\___|_|
+  */
+  //! Bezier control points of the cubic with values `p0`, `p1` and
+  //! derivatives `t0`, `t1` at the ends of [0,1]
+  void
+  hermiteToBezier(
+    real_type p0,
+    real_type p1,
+    real_type t0,
+    real_type t1,
+    real_type P[4]
+  );
+
+  //! values `p0`, `p1` and derivatives `t0`, `t1` at the ends of [0,1]
+  //! of the cubic Bezier `P`
+  void
+  bezierToHermite(
+    real_type const P[4],
+    real_type     & p0,
+    real_type     & p1,
+    real_type     & t0,
+    real_type     & t1
+  );
+
+  //! de Casteljau, the cubic Bezier `P` is `L` on [0,u] and `R` on [u,1]
+  void
+  bezierSplit(
+    real_type const P[4],
+    real_type       u,
+    real_type       L[4],
+    real_type       R[4]
+  );
+
   /*
   //   ____  _ _ _
   //  | __ )(_) (_)_ __   ___  __ _ _ __
@@ -238,6 +286,38 @@ namespace Splines {
     , pMalloc(nullptr)
     {}
 
+    //! move constructor, steal the memory of `s`
+    SplineMalloc( SplineMalloc<T> && s ) noexcept
+    : _name(std::move(s._name))
+    , numTotValues(s.numTotValues)
+    , numTotReserved(s.numTotReserved)
+    , numAllocated(s.numAllocated)
+    , pMalloc(s.pMalloc)
+    {
+      s.numTotValues   = 0;
+      s.numTotReserved = 0;
+      s.numAllocated   = 0;
+      s.pMalloc        = nullptr;
+    }
+
+    //! move assignment, release the memory and steal the one of `s`
+    SplineMalloc<T> &
+    operator = ( SplineMalloc<T> && s ) noexcept {
+      if ( this != &s ) {
+        this->free();
+        _name          = std::move(s._name);
+        numTotValues   = s.numTotValues;
+        numTotReserved = s.numTotReserved;
+        numAllocated   = s.numAllocated;
+        pMalloc        = s.pMalloc;
+        s.numTotValues   = 0;
+        s.numTotReserved = 0;
+        s.numAllocated   = 0;
+        s.pMalloc        = nullptr;
+      }
+      return *this;
+    }
+
     //! malloc object destructor
     ~SplineMalloc()
     { free(); }
@@ -334,6 +414,7 @@ namespace Splines {
    |
   \*/
 
+  //! uniform knots `t[k] = k/(npts-1)`
   void
   uniform(
     integer         dim,
@@ -343,6 +424,7 @@ namespace Splines {
     real_type       t[]
   );
 
+  //! knots proportional to the chord lengths
   void
   chordal(
     integer         dim,
@@ -352,6 +434,7 @@ namespace Splines {
     real_type       t[]
   );
 
+  //! knots proportional to the chord lengths to the power `alpha`
   void
   centripetal(
     integer         dim,
@@ -362,6 +445,7 @@ namespace Splines {
     real_type       t[]
   );
 
+  //! Lim universal knots: maxima of the clamped uniform cubic B-splines
   void
   universal(
     integer         dim,
@@ -371,6 +455,7 @@ namespace Splines {
     real_type       t[]
   );
 
+  //! Foley-Nielsen knots: chord lengths corrected by the turning angles
   void
   FoleyNielsen(
     integer         dim,
@@ -380,6 +465,7 @@ namespace Splines {
     real_type       t[]
   );
 
+  //! Fang-Hung refined centripetal knots
   void
   FangHung(
     integer         dim,
@@ -414,6 +500,7 @@ namespace Splines {
     string _name;
     bool   _curve_is_closed;
     bool   _curve_can_extend;
+    bool   _is_view; // X and Y are caller-owned and read only
 
     integer   npts, npts_reserved;
     real_type *X; // allocated in the derived class!
@@ -444,10 +531,11 @@ namespace Splines {
       return lastInterval;
     }
 
+    //! reset the interval hints, `search` restart from interval 0
     void
     initLastInterval() {
       std::lock_guard<std::mutex> lck(lastInterval_mutex);
-      lastInterval_by_thread[std::this_thread::get_id()] = 0;
+      lastInterval_by_thread.clear();
     }
 
     Spline( Spline const & ) = delete;
@@ -460,6 +548,7 @@ namespace Splines {
     : _name(name)
     , _curve_is_closed(false)
     , _curve_can_extend(true)
+    , _is_view(false)
     , npts(0)
     , npts_reserved(0)
     , X(nullptr)
@@ -467,6 +556,28 @@ namespace Splines {
     {
       this->initLastInterval();
     }
+
+    //! move constructor, steal the support points of `s` that is left empty
+    Spline( Spline && s ) noexcept
+    : _name(std::move(s._name))
+    , _curve_is_closed(s._curve_is_closed)
+    , _curve_can_extend(s._curve_can_extend)
+    , _is_view(s._is_view)
+    , npts(s.npts)
+    , npts_reserved(s.npts_reserved)
+    , X(s.X)
+    , Y(s.Y)
+    {
+      s.npts = s.npts_reserved = 0;
+      s.X    = s.Y = nullptr;
+      s._is_view = false;
+      std::lock_guard<std::mutex> lck(s.lastInterval_mutex);
+      this->lastInterval_by_thread.swap( s.lastInterval_by_thread );
+    }
+
+    //! move assignment, steal the support points of `s` that is left empty
+    Spline & operator = ( Spline && s ) noexcept;
+
     //! spline destructor
     virtual
     ~Spline()
@@ -482,6 +593,24 @@ namespace Splines {
     void make_unbounded() { this->_curve_can_extend = true; }
     void make_bounded()   { this->_curve_can_extend = false; }
 
+    /*!
+     | true if the spline was built with `build_view`.
+     |
+     | A view spline reference the caller-owned `x` and `y` arrays (and
+     | optionally the derivatives) without copying them:
+     |
+     | - the arrays must stay valid and unchanged until the spline is
+     |   destroyed, cleared or rebuilt (any `build`, `reserve`, `clear`);
+     | - the spline never write to them, so read-only memory (e.g. a file
+     |   mapped with `PROT_READ`) is allowed;
+     | - the in-place modifiers `pushBack`, `setOrigin` and `setRange`
+     |   throw on a view;
+     | - moving the spline moves the view, the arrays are not touched;
+     | - the strided `build_view` is a view only when the strides are 1,
+     |   otherwise it copy the nodes like `build`.
+    \*/
+    bool is_view() const { return this->_is_view; }
+
     //! return the number of support points of the spline.
     integer
     numPoints(void) const { return this->npts; }
@@ -630,6 +759,27 @@ namespace Splines {
       file.close();
     }
 
+    //! Polyline of the graph within `tol` of the spline
+    /*!
+     | Each knot interval is split in `m` equal parts with
+     | `(h/m)^2 max|y''|/8 <= tol`, the bound of the linear interpolation
+     | error. `max|y''|` is computed from the Hermite data of the segment
+     | (`nodeDerivatives`), exact for the cubic splines and a Bernstein
+     | bound for the quintic ones; the splines without derivatives at the
+     | nodes are sampled at the knots only. The segments are counted and
+     | filled by `nthreads` threads.
+     | Return the number of points `n`; `x[0..n)`, `y[0..n)` are written
+     | only if `n <= nmax` (call with `nmax = 0` to size the buffers).
+    \*/
+    integer
+    tessellate(
+      real_type tol,
+      integer   nmax,
+      real_type x[],
+      real_type y[],
+      integer   nthreads = 1
+    ) const;
+
     ///////////////////////////////////////////////////////////////////////////
     //! Evaluate spline value
     virtual
@@ -671,6 +821,16 @@ namespace Splines {
     real_type eval_DDDD( real_type x ) const { return this->DDDD(x); }
     real_type eval_DDDDD( real_type x ) const { return this->DDDDD(x); }
 
+    //! `J[k]` = k-th derivative at `x`, `k = 0..order` (`order` <= 5)
+    /*!
+     | The default calls `operator ()`, `D`, `DD`, ... each one searching
+     | the interval, the cubic and quintic Hermite splines override it
+     | with a single search.
+    \*/
+    virtual
+    void
+    jet( real_type x, integer order, real_type J[] ) const;
+
     //! get the piecewise polinomials of the spline
     virtual
     integer // order
@@ -689,6 +849,16 @@ namespace Splines {
     void
     writeToStream( ostream_type & s ) const SPLINES_PURE_VIRTUAL;
 
+    //! Write the built spline as a binary record (see `SplineBinaryFile`)
+    void
+    writeBinary( ostream_type & s ) const;
+
+    //! pointers to the derivatives stored at the nodes, return how many
+    virtual
+    integer
+    nodeDerivatives( real_type const * [2] ) const
+    { return 0; }
+
     //! Return spline typename
     char const *
     type_name() const
@@ -718,6 +888,39 @@ namespace Splines {
   real_type
   curvature_DD( real_type s, Spline const & X, Spline const & Y );
 
+  //! curvature of a planar curve at the `n` parameters `s[k]`
+  /*!
+   | One `jet` per spline and point, sorted `s` keep the searches local.
+  \*/
+  void
+  curvature(
+    integer         n,
+    real_type const s[],
+    Spline const  & X,
+    Spline const  & Y,
+    real_type       kappa[]
+  );
+
+  //! curvature derivative of a planar curve at the `n` parameters `s[k]`
+  void
+  curvature_D(
+    integer         n,
+    real_type const s[],
+    Spline const  & X,
+    Spline const  & Y,
+    real_type       kappa_D[]
+  );
+
+  //! curvature second derivative of a planar curve at the `n` parameters `s[k]`
+  void
+  curvature_DD(
+    integer         n,
+    real_type const s[],
+    Spline const  & X,
+    Spline const  & Y,
+    real_type       kappa_DD[]
+  );
+
   /*\
    |    ____      _     _        ____        _ _              ____
    |   / ___|   _| |__ (_) ___  / ___| _ __ | (_)_ __   ___  | __ )  __ _ ___  ___
@@ -746,6 +949,25 @@ namespace Splines {
     , _external_alloc(false)
     {}
 
+    CubicSplineBase( CubicSplineBase && s ) noexcept
+    : Spline( std::move(s) )
+    , baseValue( std::move(s.baseValue) )
+    , Yp(s.Yp)
+    , _external_alloc(s._external_alloc)
+    { s.Yp = nullptr; s._external_alloc = false; }
+
+    CubicSplineBase &
+    operator = ( CubicSplineBase && s ) noexcept {
+      if ( this != &s ) {
+        Spline::operator = ( std::move(s) );
+        this->baseValue       = std::move(s.baseValue);
+        this->Yp              = s.Yp;
+        this->_external_alloc = s._external_alloc;
+        s.Yp = nullptr; s._external_alloc = false;
+      }
+      return *this;
+    }
+
     virtual
     ~CubicSplineBase() SPLINES_OVERRIDE
     {}
@@ -771,6 +993,37 @@ namespace Splines {
       real_type * & p_dy
     );
 
+    //! Build a spline referencing caller-owned nodes (see `is_view`)
+    /*!
+     | \param x  vector of x-coordinates (not copied)
+     | \param y  vector of y-coordinates (not copied)
+     | \param n  total number of points
+     | \param yp derivatives at the nodes (not copied), if `nullptr` only
+     |           `Yp` is allocated and computed by `build()`
+    \*/
+    void
+    build_view(
+      real_type const x[],
+      real_type const y[],
+      integer         n,
+      real_type const yp[] = nullptr
+    );
+
+    //! Build a spline referencing strided caller-owned nodes
+    /*!
+     | Same as `build_view( x, y, n, yp )` when all the strides are 1.
+     | The evaluation reads the nodes contiguously, so with other strides
+     | the values are copied as by `build` and `is_view()` is false.
+    \*/
+    void
+    build_view(
+      real_type const x[],  integer incx,
+      real_type const y[],  integer incy,
+      integer         n,
+      real_type const yp[] = nullptr,
+      integer         incyp = 1
+    );
+
     // --------------------------- VIRTUALS -----------------------------------
     //! Evaluate spline value
     virtual
@@ -792,11 +1045,21 @@ namespace Splines {
     real_type
     DDD( real_type x ) const SPLINES_OVERRIDE;
 
+    //! value and derivatives with a single search
+    virtual
+    void
+    jet( real_type x, integer order, real_type J[] ) const SPLINES_OVERRIDE;
+
     //! Print spline coefficients
     virtual
     void
     writeToStream( ostream_type & s ) const SPLINES_OVERRIDE;
 
+    virtual
+    integer
+    nodeDerivatives( real_type const * D[2] ) const SPLINES_OVERRIDE
+    { D[0] = this->Yp; return 1; }
+
     // --------------------------- VIRTUALS -----------------------------------
 
     //! Allocate memory for `npts` points
@@ -882,6 +1145,29 @@ namespace Splines {
     integer // order
     order() const SPLINES_OVERRIDE;
 
+    //! Bezier control points of all the segments
+    /*!
+     | `P[3*i..3*i+3]` are the control points of the segment `i`, the
+     | segments share the end points so `P` has `3*(numPoints()-1)+1`
+     | values. The abscissa of `P[3*i+k]` is `X[i]+k*(X[i+1]-X[i])/3`.
+    \*/
+    void
+    toBezier( real_type P[] ) const;
+
+    //! Restriction of the spline to `[a,b]` (within the range) in `S`
+    /*!
+     | The knots of `S` are `a`, the knots in `(a,b)` and `b`, with
+     | values and derivatives taken from this spline, so `S` is the same
+     | piecewise cubic and no system is solved. `S` may be this spline.
+    \*/
+    void
+    cut( real_type a, real_type b, CubicSplineBase & S ) const;
+
+    //! The parts on `[xMin(),x]` and `[x,xMax()]` in `L` and `R` (not
+    //! this spline), see `cut`
+    void
+    split( real_type x, CubicSplineBase & L, CubicSplineBase & R ) const;
+
   };
 
   /*\
@@ -893,11 +1179,14 @@ namespace Splines {
    |                                |_|
   \*/
 
+  //! boundary conditions of the cubic spline, `PERIODIC_BC` on either
+  //! side gives the periodic spline (the last value must repeat the first)
   typedef enum {
     EXTRAPOLATE_BC = 0,
     NATURAL_BC,
     PARABOLIC_RUNOUT_BC,
-    NOT_A_KNOT
+    NOT_A_KNOT,
+    PERIODIC_BC
   } CUBIC_SPLINE_TYPE_BC;
 
   void
@@ -924,6 +1213,37 @@ namespace Splines {
     CUBIC_SPLINE_TYPE_BC bcn
   );
 
+  //! cubic spline slopes with strided data, `Ypp` is used as workspace
+  void
+  CubicSpline_build(
+    real_type const      X[],
+    real_type const      Y[],
+    integer              incY,
+    real_type            Yp[],
+    integer              incYp,
+    real_type            Ypp[],
+    integer              incYpp,
+    real_type            L[],
+    real_type            D[],
+    real_type            U[],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  );
+
+  //! cubic spline slopes with strided data, workspace allocated internally
+  void
+  CubicSpline_build(
+    real_type const      X[],
+    real_type const      Y[],
+    integer              incY,
+    real_type            Yp[],
+    integer              incYp,
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  );
+
   //! Cubic Spline Management Class
   class CubicSpline : public CubicSplineBase {
   private:
@@ -940,6 +1260,12 @@ namespace Splines {
     , bcn( EXTRAPOLATE_BC )
     {}
 
+    //! move constructor
+    CubicSpline( CubicSpline && ) = default;
+
+    //! move assignment
+    CubicSpline & operator = ( CubicSpline && ) = default;
+
     //! spline destructor
     virtual
     ~CubicSpline() SPLINES_OVERRIDE
@@ -994,6 +1320,17 @@ namespace Splines {
     integer         npts
   );
 
+  //! Akima slopes with strided data: reads `Y[i*incY]`, writes `Yp[i*incYp]`
+  void
+  Akima_build(
+    real_type const X[],
+    real_type const Y[],
+    integer         incY,
+    real_type       Yp[],
+    integer         incYp,
+    integer         npts
+  );
+
   //! Akima spline class
   /*!
    |  Reference
@@ -1011,6 +1348,12 @@ namespace Splines {
     : CubicSplineBase( name )
     {}
 
+    //! move constructor
+    AkimaSpline( AkimaSpline && ) = default;
+
+    //! move assignment
+    AkimaSpline & operator = ( AkimaSpline && ) = default;
+
     //! spline destructor
     virtual
     ~AkimaSpline() SPLINES_OVERRIDE
@@ -1052,6 +1395,17 @@ namespace Splines {
     integer         npts
   );
 
+  //! Bessel slopes with strided data: reads `Y[i*incY]`, writes `Yp[i*incYp]`
+  void
+  Bessel_build(
+    real_type const X[],
+    real_type const Y[],
+    integer         incY,
+    real_type       Yp[],
+    integer         incYp,
+    integer         npts
+  );
+
   //! Bessel spline class
   class BesselSpline : public CubicSplineBase {
   public:
@@ -1064,6 +1418,12 @@ namespace Splines {
     : CubicSplineBase( name )
     {}
 
+    //! move constructor
+    BesselSpline( BesselSpline && ) = default;
+
+    //! move assignment
+    BesselSpline & operator = ( BesselSpline && ) = default;
+
     //! spline destructor
     virtual
     ~BesselSpline() SPLINES_OVERRIDE
@@ -1103,6 +1463,17 @@ namespace Splines {
     integer         npts
   );
 
+  //! Pchip slopes with strided data: reads `Y[i*incY]`, writes `Yp[i*incYp]`
+  void
+  Pchip_build(
+    real_type const X[],
+    real_type const Y[],
+    integer         incY,
+    real_type       Yp[],
+    integer         incYp,
+    integer         npts
+  );
+
   //! Pchip (Piecewise Cubic Hermite Interpolating Polynomial) spline class
   class PchipSpline : public CubicSplineBase {
   public:
@@ -1115,6 +1486,12 @@ namespace Splines {
     : CubicSplineBase( name )
     {}
 
+    //! move constructor
+    PchipSpline( PchipSpline && ) = default;
+
+    //! move assignment
+    PchipSpline & operator = ( PchipSpline && ) = default;
+
     //! spline destructor
     virtual
     ~PchipSpline() SPLINES_OVERRIDE
@@ -1161,6 +1538,12 @@ namespace Splines {
     , _external_alloc(false)
     {}
 
+    //! move constructor
+    LinearSpline( LinearSpline && ) = default;
+
+    //! move assignment
+    LinearSpline & operator = ( LinearSpline && ) = default;
+
     virtual
     ~LinearSpline() SPLINES_OVERRIDE
     {}
@@ -1173,6 +1556,18 @@ namespace Splines {
       real_type *& p_y
     );
 
+    //! Build a spline referencing caller-owned nodes (see `Spline::is_view`)
+    void
+    build_view( real_type const x[], real_type const y[], integer n );
+
+    //! Same as `build_view( x, y, n )` with unit strides, otherwise copy
+    void
+    build_view(
+      real_type const x[], integer incx,
+      real_type const y[], integer incy,
+      integer n
+    );
+
     // --------------------------- VIRTUALS -----------------------------------
 
     //! Evalute spline value at `x`
@@ -1284,6 +1679,12 @@ namespace Splines {
     , _external_alloc(false)
     {}
 
+    //! move constructor
+    ConstantSpline( ConstantSpline && ) = default;
+
+    //! move assignment
+    ConstantSpline & operator = ( ConstantSpline && ) = default;
+
     ~ConstantSpline() SPLINES_OVERRIDE
     {}
 
@@ -1295,6 +1696,18 @@ namespace Splines {
       real_type * & p_y
     );
 
+    //! Build a spline referencing caller-owned nodes (see `Spline::is_view`)
+    void
+    build_view( real_type const x[], real_type const y[], integer n );
+
+    //! Same as `build_view( x, y, n )` with unit strides, otherwise copy
+    void
+    build_view(
+      real_type const x[], integer incx,
+      real_type const y[], integer incy,
+      integer n
+    );
+
     // --------------------------- VIRTUALS -----------------------------------
     //! Build a spline.
     virtual
@@ -1395,6 +1808,12 @@ namespace Splines {
     : CubicSplineBase( name )
     {}
 
+    //! move constructor
+    HermiteSpline( HermiteSpline && ) = default;
+
+    //! move assignment
+    HermiteSpline & operator = ( HermiteSpline && ) = default;
+
     //! spline destructor
     virtual
     ~HermiteSpline() SPLINES_OVERRIDE
@@ -1459,6 +1878,27 @@ namespace Splines {
     , _external_alloc(false)
     {}
 
+    QuinticSplineBase( QuinticSplineBase && s ) noexcept
+    : Spline( std::move(s) )
+    , baseValue( std::move(s.baseValue) )
+    , Yp(s.Yp)
+    , Ypp(s.Ypp)
+    , _external_alloc(s._external_alloc)
+    { s.Yp = s.Ypp = nullptr; s._external_alloc = false; }
+
+    QuinticSplineBase &
+    operator = ( QuinticSplineBase && s ) noexcept {
+      if ( this != &s ) {
+        Spline::operator = ( std::move(s) );
+        this->baseValue       = std::move(s.baseValue);
+        this->Yp              = s.Yp;
+        this->Ypp             = s.Ypp;
+        this->_external_alloc = s._external_alloc;
+        s.Yp = s.Ypp = nullptr; s._external_alloc = false;
+      }
+      return *this;
+    }
+
     virtual
     ~QuinticSplineBase() SPLINES_OVERRIDE
     {}
@@ -1490,6 +1930,43 @@ namespace Splines {
       real_type * & p_Ypp
     );
 
+    //! Build a spline referencing caller-owned nodes (see `Spline::is_view`)
+    /*!
+     | \param x   vector of x-coordinates (not copied)
+     | \param y   vector of y-coordinates (not copied)
+     | \param n   total number of points
+     | \param yp  first derivatives at the nodes (not copied)
+     | \param ypp second derivatives at the nodes (not copied)
+     |
+     | if `yp` and `ypp` are `nullptr` they are allocated and computed by
+     | `build()`, otherwise both must be given.
+    \*/
+    void
+    build_view(
+      real_type const x[],
+      real_type const y[],
+      integer         n,
+      real_type const yp[]  = nullptr,
+      real_type const ypp[] = nullptr
+    );
+
+    //! Build a spline referencing strided caller-owned nodes
+    /*!
+     | Same as `build_view( x, y, n, yp, ypp )` when all the strides are 1,
+     | otherwise the values are copied as by `build` and `is_view()` is
+     | false.
+    \*/
+    void
+    build_view(
+      real_type const x[],   integer incx,
+      real_type const y[],   integer incy,
+      integer         n,
+      real_type const yp[]   = nullptr,
+      integer         incyp  = 1,
+      real_type const ypp[]  = nullptr,
+      integer         incypp = 1
+    );
+
     // --------------------------- VIRTUALS -----------------------------------
 
     //! Evaluate spline value
@@ -1520,11 +1997,21 @@ namespace Splines {
     real_type
     DDDDD( real_type x ) const SPLINES_OVERRIDE;
 
+    //! value and derivatives with a single search
+    virtual
+    void
+    jet( real_type x, integer order, real_type J[] ) const SPLINES_OVERRIDE;
+
     //! Print spline coefficients
     virtual
     void
     writeToStream( ostream_type & s ) const SPLINES_OVERRIDE;
 
+    virtual
+    integer
+    nodeDerivatives( real_type const * D[2] ) const SPLINES_OVERRIDE
+    { D[0] = this->Yp; D[1] = this->Ypp; return 2; }
+
     //! Return spline type (as number)
     virtual
     unsigned
@@ -1566,13 +2053,40 @@ namespace Splines {
    |
   \*/
 
+  //! `PERIODIC_QUINTIC` is `CUBIC_QUINTIC` on periodic systems
+  //! (the last value must repeat the first)
   typedef enum {
     CUBIC_QUINTIC = 0,
     PCHIP_QUINTIC,
     AKIMA_QUINTIC,
-    BESSEL_QUINTIC
+    BESSEL_QUINTIC,
+    PERIODIC_QUINTIC
   } QUINTIC_SPLINE_TYPE;
 
+  void
+  Quintic_build(
+    QUINTIC_SPLINE_TYPE q_sub_type,
+    real_type const     X[],
+    real_type const     Y[],
+    real_type           Yp[],
+    real_type           Ypp[],
+    integer             npts
+  );
+
+  //! quintic spline first and second derivatives with strided data
+  void
+  Quintic_build(
+    QUINTIC_SPLINE_TYPE q_sub_type,
+    real_type const     X[],
+    real_type const     Y[],
+    integer             incY,
+    real_type           Yp[],
+    integer             incYp,
+    real_type           Ypp[],
+    integer             incYpp,
+    integer             npts
+  );
+
   //! Quintic spline class
   class QuinticSpline : public QuinticSplineBase {
     QUINTIC_SPLINE_TYPE q_sub_type;
@@ -1587,6 +2101,12 @@ namespace Splines {
     , q_sub_type(CUBIC_QUINTIC)
     {}
 
+    //! move constructor
+    QuinticSpline( QuinticSpline && ) = default;
+
+    //! move assignment
+    QuinticSpline & operator = ( QuinticSpline && ) = default;
+
     //! spline destructor
     virtual
     ~QuinticSpline() SPLINES_OVERRIDE
@@ -1636,9 +2156,27 @@ namespace Splines {
     , pSpline(nullptr)
     {}
 
+    //! move constructor, take the ownership of the spline of `s`
+    Spline1D( Spline1D && s ) noexcept
+    : _name(std::move(s._name))
+    , pSpline(s.pSpline)
+    { s.pSpline = nullptr; }
+
+    //! move assignment, take the ownership of the spline of `s`
+    Spline1D &
+    operator = ( Spline1D && s ) noexcept {
+      if ( this != &s ) {
+        if ( this->pSpline != nullptr ) delete this->pSpline;
+        this->_name   = std::move(s._name);
+        this->pSpline = s.pSpline;
+        s.pSpline     = nullptr;
+      }
+      return *this;
+    }
+
     //! spline destructor
     ~Spline1D()
-    {}
+    { if ( pSpline != nullptr ) delete pSpline; }
 
     string const & name() const { return pSpline->name(); }
 
@@ -1782,6 +2320,17 @@ namespace Splines {
       pSpline->dump( fname, nintervals, header );
     }
 
+    //! Adaptive polyline, see `Spline::tessellate`
+    integer
+    tessellate(
+      real_type tol,
+      integer   nmax,
+      real_type x[],
+      real_type y[],
+      integer   nthreads = 1
+    ) const
+    { return pSpline->tessellate( tol, nmax, x, y, nthreads ); }
+
     ///////////////////////////////////////////////////////////////////////////
     //! Evaluate spline value
     real_type
@@ -1832,6 +2381,19 @@ namespace Splines {
     writeToStream( ostream_type & s ) const
     { return pSpline->writeToStream( s ); }
 
+    //! Write the built spline as a binary record (see `SplineBinaryFile`)
+    void
+    writeBinary( ostream_type & s ) const
+    { pSpline->writeBinary( s ); }
+
+    //! Build a view spline (see `Spline::is_view`) on the record `irec` of `f`
+    /*!
+     | The spline take the name stored in the record, `f` must stay
+     | open until the spline is destroyed or rebuilt.
+    \*/
+    void
+    load_view( SplineBinaryFile const & f, integer irec );
+
     //! Return spline typename
     char const *
     type_name() const
@@ -1847,41 +2409,57 @@ namespace Splines {
     { pSpline->info( s ); }
   };
 
-
   /*\
-   |   ____        _ _          __     __
-   |  / ___| _ __ | (_)_ __   __\ \   / /__  ___
-   |  \___ \| '_ \| | | '_ \ / _ \ \ / / _ \/ __|
-   |   ___) | |_) | | | | | |  __/\ V /  __/ (__
-   |  |____/| .__/|_|_|_| |_|\___| \_/ \___|\___|
+   |   ____        _ _          __        ___           _
+   |  / ___| _ __ | (_)_ __   __\ \      / (_)_ __   __| | _____      __
+   |  \___ \| '_ \| | | '_ \ / _ \ \ /\ / /| | '_ \ / _` |/ _ \ \ /\ / /
+   |   ___) | |_) | | | | | |  __/\ V  V / | | | | | (_| | (_) \ V  V /
+   |  |____/| .__/|_|_|_| |_|\___| \_/\_/  |_|_| |_|\__,_|\___/ \_/\_/
    |        |_|
   \*/
 
-  //! Splines Management Class
-  class SplineVec {
+  //! Sliding window spline over the last `capacity` samples of a stream
+  /*!
+   | The support points are stored in a ring buffer of fixed capacity.
+   | Every slot is written twice (at `p` and at `p+capacity`) so that the
+   | logical window `[0,npts)` is always the contiguous block starting at
+   | the physical offset `head`: logical node `i` is physical node `head+i`.
+   | In this way `searchInterval` is used unchanged on `X+head`.
+   |
+   | `pushBack` on a full window evicts the oldest point in O(1) and
+   | recompute only the slopes of the nodes near the two ends of the window.
+   | Supported types are `LINEAR_TYPE` and the local cubic splines
+   | `PCHIP_TYPE`, `AKIMA_TYPE`, `BESSEL_TYPE` (`CUBIC_TYPE` is global and
+   | can not be updated locally).
+   |
+   | Abscissae must be pushed in strictly increasing order.
+  \*/
+  class SplineWindow {
 
-    SplineVec( SplineVec const & ) = delete;
-    SplineVec const & operator = ( SplineVec const & ) = delete;
+    SplineWindow( SplineWindow const & ) = delete;
+    SplineWindow const & operator = ( SplineWindow const & ) = delete;
 
   protected:
 
-    string const _name;
+    string _name;
 
-    SplineMalloc<real_type>  baseValue;
-    SplineMalloc<real_type*> basePointer;
+    SplineMalloc<real_type> baseValue;
 
-    integer _dim;
+    SplineType1D _stype;
+    bool         _curve_can_extend;
+
+    integer _capacity;
     integer _npts;
-    bool    _curve_is_closed;
-    bool    _curve_can_extend;
+    integer _head;
 
-    real_type *  _X;
-    real_type ** _Y;
-    real_type ** _Yp;
+    real_type * _X;  // 2*_capacity values (mirrored ring buffer)
+    real_type * _Y;  // 2*_capacity values (mirrored ring buffer)
+    real_type * _Yp; // 2*_capacity values (mirrored ring buffer)
 
     mutable std::mutex                   lastInterval_mutex;
     mutable map<std::thread::id,integer> lastInterval_by_thread;
 
+    //! return the logical interval containing `x`
     integer
     search( real_type & x ) const {
       integer lastInterval;
@@ -1889,12 +2467,14 @@ namespace Splines {
         std::lock_guard<std::mutex> lck(lastInterval_mutex);
         lastInterval = lastInterval_by_thread[std::this_thread::get_id()];
       }
+      // evictions shift the logical numbering, the hint may be stale
+      if ( lastInterval < 0 || lastInterval > this->_npts-2 ) lastInterval = 0;
       searchInterval(
         this->_npts,
-        this->_X,
+        this->_X+this->_head,
         x,
         lastInterval,
-        this->_curve_is_closed,
+        false,
         this->_curve_can_extend
       );
       {
@@ -1904,33 +2484,307 @@ namespace Splines {
       return lastInterval;
     }
 
-    ///////////////////////////////////////////////////////////////////////////
+    //! physical position of logical node `i`
+    integer
+    ipos( integer i ) const
+    { return this->_head+i; }
+
+    //! store `v` in the slot of logical node `i` and in its mirror
     void
-    allocate( integer dim, integer npts );
+    store( real_type * V, integer i, real_type v ) {
+      integer p = (this->_head+i) % this->_capacity;
+      V[p] = V[p+this->_capacity] = v;
+    }
 
+    //! recompute the slopes of logical nodes `[i0,i1)`
     void
-    computeChords();
+    updateSlopes( integer i0, integer i1 );
 
   public:
 
     //! spline constructor
-    SplineVec( string const & name = "SplineVec" );
+    SplineWindow( string const & name = "SplineWindow" );
+
+    //! move constructor, steal the memory of `s` that is left empty
+    SplineWindow( SplineWindow && s ) noexcept;
+
+    //! move assignment, steal the memory of `s` that is left empty
+    SplineWindow & operator = ( SplineWindow && s ) noexcept;
 
     //! spline destructor
     virtual
-    ~SplineVec();
+    ~SplineWindow();
 
-    bool is_closed() const { return this->_curve_is_closed; }
-    void make_closed() { this->_curve_is_closed = true; }
-    void make_open()   { this->_curve_is_closed = false; }
+    string const & name() const { return this->_name; }
 
-    bool can_extend() const { return this->_curve_can_extend; }
+    bool is_bounded() const { return !this->_curve_can_extend; }
     void make_unbounded() { this->_curve_can_extend = true; }
-    void make_buonded()   { this->_curve_can_extend = false; }
+    void make_bounded()   { this->_curve_can_extend = false; }
 
-    string const &
-    name() const
-    { return this->_name; }
+    //! Allocate the ring buffer for `capacity` points and empty the window
+    void
+    reserve( integer capacity, SplineType1D stype = PCHIP_TYPE );
+
+    //! Empty the window, capacity and type are kept
+    void
+    clear(void)
+    { this->_npts = this->_head = 0; }
+
+    //! Add a support point (x,y), evicting the oldest if the window is full
+    void
+    pushBack( real_type x, real_type y );
+
+    //! Return spline type (as number)
+    unsigned
+    type() const
+    { return unsigned(this->_stype); }
+
+    //! Return spline typename
+    char const *
+    type_name() const
+    { return Splines::spline_type_1D[this->_stype]; }
+
+    //! maximum number of points in the window
+    integer
+    capacity(void) const
+    { return this->_capacity; }
+
+    //! return the number of support points in the window
+    integer
+    numPoints(void) const
+    { return this->_npts; }
+
+    //! true if the next `pushBack` will evict a point
+    bool
+    is_full(void) const
+    { return this->_npts == this->_capacity; }
+
+    //! return the i-th node of the window (x component), 0 is the oldest
+    real_type
+    xNode( integer i ) const
+    { return this->_X[size_t(this->ipos(i))]; }
+
+    //! return the i-th node of the window (y component), 0 is the oldest
+    real_type
+    yNode( integer i ) const
+    { return this->_Y[size_t(this->ipos(i))]; }
+
+    //! return the i-th node of the window (y' component), 0 is the oldest
+    real_type
+    ypNode( integer i ) const
+    { return this->_stype == LINEAR_TYPE ? 0 : this->_Yp[size_t(this->ipos(i))]; }
+
+    //! return x-minumum spline value
+    real_type
+    xMin() const
+    { return this->xNode(0); }
+
+    //! return x-maximum spline value
+    real_type
+    xMax() const
+    { return this->xNode(this->_npts-1); }
+
+    //! contiguous view of the x-nodes of the window (`numPoints()` values)
+    real_type const *
+    xNodes() const
+    { return this->_X+this->_head; }
+
+    //! contiguous view of the y-nodes of the window (`numPoints()` values)
+    real_type const *
+    yNodes() const
+    { return this->_Y+this->_head; }
+
+    //! Evaluate spline value
+    real_type
+    operator () ( real_type x ) const;
+
+    //! First derivative
+    real_type
+    D( real_type x ) const;
+
+    //! Second derivative
+    real_type
+    DD( real_type x ) const;
+
+    //! Third derivative
+    real_type
+    DDD( real_type x ) const;
+
+    //! Some aliases
+    real_type eval( real_type x ) const { return (*this)(x); }
+    real_type eval_D( real_type x ) const { return this->D(x); }
+    real_type eval_DD( real_type x ) const { return this->DD(x); }
+    real_type eval_DDD( real_type x ) const { return this->DDD(x); }
+
+    void
+    info( ostream_type & s ) const;
+
+  };
+
+
+  /*\
+   |   ____        _ _          __     __
+   |  / ___| _ __ | (_)_ __   __\ \   / /__  ___
+   |  \___ \| '_ \| | | '_ \ / _ \ \ / / _ \/ __|
+   |   ___) | |_) | | | | | |  __/\ V /  __/ (__
+   |  |____/| .__/|_|_|_| |_|\___| \_/ \___|\___|
+   |        |_|
+  \*/
+
+  //! Splines Management Class
+  class SplineVec {
+
+    SplineVec( SplineVec const & ) = delete;
+    SplineVec const & operator = ( SplineVec const & ) = delete;
+
+  protected:
+
+    string _name;
+
+    SplineMalloc<real_type>  baseValue;
+    SplineMalloc<real_type*> basePointer;
+
+    integer _dim;
+    integer _npts;
+    bool    _curve_is_closed;
+    bool    _curve_can_extend;
+    bool    _is_view; // X, Y and Yp are in a `SplineBinaryFile`
+
+    real_type *  _X;
+    real_type ** _Y;
+    real_type ** _Yp;
+
+    bool              _use_interleaved;
+    vector<real_type> _YYp; // Y[0..dim) Yp[0..dim) of each knot, see `useInterleaved`
+
+    // arc-length table, see `buildArcLength`
+    vector<real_type> _arc_t;   // parameter at the cell boundaries
+    vector<real_type> _arc_s;   // arc-length at the cell boundaries
+    vector<integer>   _arc_idx; // knot interval containing each cell
+
+    // kmin, t of kmin, kmax, t of kmax of each segment, see `buildCurvatureTable`
+    vector<real_type> _kappa;
+
+    mutable std::mutex                   lastInterval_mutex;
+    mutable map<std::thread::id,integer> lastInterval_by_thread;
+
+    integer
+    search( real_type & x ) const {
+      integer lastInterval;
+      {
+        std::lock_guard<std::mutex> lck(lastInterval_mutex);
+        lastInterval = lastInterval_by_thread[std::this_thread::get_id()];
+      }
+      searchInterval(
+        this->_npts,
+        this->_X,
+        x,
+        lastInterval,
+        this->_curve_is_closed,
+        this->_curve_can_extend
+      );
+      {
+        std::lock_guard<std::mutex> lck(lastInterval_mutex);
+        lastInterval_by_thread[std::this_thread::get_id()] = lastInterval;
+      }
+      return lastInterval;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void
+    allocate( integer dim, integer npts );
+
+    void
+    computeChords();
+
+    void
+    makeInterleaved();
+
+    //! drop the tables computed from the knots (arc-length, curvature)
+    void
+    dropTables();
+
+    void
+    dropArcLength();
+
+    //! derivatives `jx[1..order]`, `jy[1..order]` of the first two
+    //! components at `x` in the interval `i` (`order` <= 4)
+    void
+    planarJet(
+      size_t    i,
+      real_type x,
+      integer   order,
+      real_type jx[],
+      real_type jy[]
+    ) const;
+
+    //! norm of the first derivative at `X[i]+dt`
+    real_type
+    speed( size_t i, real_type dt ) const;
+
+    //! length of the arc in `[X[i]+a,X[i]+b]`, 5 points Gauss-Legendre
+    real_type
+    arcGL( size_t i, real_type a, real_type b ) const;
+
+    //! parameter of arc-length `s` in the cell `k` of the table
+    real_type
+    arcInvert( size_t k, real_type s ) const;
+
+    //! map `s` in `[0,length()]` (wrap for closed curves)
+    real_type
+    arcRange( real_type s ) const;
+
+    //! `vals[j*inc] = base^T [ Y_j(i), Y_j(i+1), Yp_j(i), Yp_j(i+1) ]`
+    void
+    evalBase(
+      real_type const base[4],
+      size_t          i,
+      real_type       vals[],
+      integer         inc
+    ) const;
+
+  public:
+
+    //! spline constructor
+    SplineVec( string const & name = "SplineVec" );
+
+    //! move constructor, steal the memory of `s` that is left empty
+    SplineVec( SplineVec && s ) noexcept;
+
+    //! move assignment, steal the memory of `s` that is left empty
+    SplineVec & operator = ( SplineVec && s ) noexcept;
+
+    //! spline destructor
+    virtual
+    ~SplineVec();
+
+    bool is_closed() const { return this->_curve_is_closed; }
+    void make_closed() { this->_curve_is_closed = true; }
+    void make_open()   { this->_curve_is_closed = false; }
+
+    bool can_extend() const { return this->_curve_can_extend; }
+    void make_unbounded() { this->_curve_can_extend = true; }
+    void make_buonded()   { this->_curve_can_extend = false; }
+
+    //! Keep an interleaved copy of the values and derivatives at the knots
+    /*!
+     | `Y[0..dim)` and `Yp[0..dim)` of each knot are contiguous, so the
+     | evaluation of all the components (`eval`, `eval_D`, ...) read two
+     | blocks of `2*dim` values instead of `4*dim` separate cache lines.
+     | For `dim` = 2, 3, 6 the kernel has the dimension fixed at compile
+     | time. The copy is refreshed by `CatmullRom` and `load_view`, `setup`
+     | empties it until the derivatives are computed. Results are unchanged.
+    \*/
+    void
+    useInterleaved( bool yes = true );
+
+    bool
+    interleaved() const
+    { return this->_use_interleaved; }
+
+    string const &
+    name() const
+    { return this->_name; }
 
     //! return the number of support points of the splines
     integer
@@ -1957,6 +2811,11 @@ namespace Splines {
     yNode( integer npt, integer j ) const
     { return this->_Y[size_t(j)][size_t(npt)]; }
 
+    //! return the derivative at the npt-th node of the spline (y component).
+    real_type
+    ypNode( integer npt, integer j ) const
+    { return this->_Yp[size_t(j)][size_t(npt)]; }
+
     //! return x-minumum spline value
     real_type
     xMin() const
@@ -2159,18 +3018,172 @@ namespace Splines {
     void
     setKnotsCentripetal();
 
+    //! Foley-Nielsen knots, see `FoleyNielsen`
     void
     setKnotsFoley();
 
     void
     CatmullRom();
 
+    //! C2 cubic spline through the points on the current knots
+    /*!
+     | The tridiagonal system depends on the knots only: it is factorized
+     | once and every component is a right hand side. On a closed curve
+     | (`make_closed`) or with `PERIODIC_BC` the spline is periodic (the
+     | curve is made closed) and the last point must repeat the first one.
+     | `PERIODIC_BC` must be given at both ends or at neither.
+    \*/
+    void
+    buildCubic(
+      CUBIC_SPLINE_TYPE_BC bc0 = EXTRAPOLATE_BC,
+      CUBIC_SPLINE_TYPE_BC bcn = EXTRAPOLATE_BC
+    );
+
     real_type
     curvature( real_type x ) const;
 
     real_type
     curvature_D( real_type x ) const;
 
+    real_type
+    curvature_DD( real_type x ) const;
+
+    //! curvature of the first two components at the `n` parameters `x[k]`
+    /*!
+     | A single search for each point and only the components 0 and 1
+     | are evaluated; the search hint is local to the call.
+    \*/
+    void
+    curvature(
+      integer         n,
+      real_type const x[],
+      real_type       kappa[]
+    ) const;
+
+    void
+    curvature_D(
+      integer         n,
+      real_type const x[],
+      real_type       kappa_D[]
+    ) const;
+
+    void
+    curvature_DD(
+      integer         n,
+      real_type const x[],
+      real_type       kappa_DD[]
+    ) const;
+
+    //! Table of the extrema of the curvature on each segment
+    /*!
+     | The curvature is sampled at `nsamples+1` points of each knot
+     | interval, the interior extrema are refined by bisection on the
+     | derivative of the curvature; the end points are candidates too.
+     | Dropped as the arc-length table.
+    \*/
+    void
+    buildCurvatureTable( integer nsamples = 16 );
+
+    bool
+    hasCurvatureTable() const
+    { return !this->_kappa.empty(); }
+
+    //! minimum and maximum (signed) curvature on the segment `i`
+    void
+    curvatureExtrema(
+      integer     i,
+      real_type & kmin,
+      real_type & t_kmin,
+      real_type & kmax,
+      real_type & t_kmax
+    ) const;
+
+    //! bound of `|curvature|` on `[t0,t1]` from the table
+    /*!
+     | The segments containing `t0` and `t1` are taken whole, so the
+     | value is an upper bound, exact when `t0`, `t1` are knots.
+    \*/
+    real_type
+    maxAbsCurvature( real_type t0, real_type t1 ) const;
+
+    //! Build the table for the arc-length reparametrization
+    /*!
+     | Every knot interval is integrated with 5 points Gauss-Legendre.
+     | If `tol` > 0 the intervals are bisected until two levels of the
+     | quadrature agree within `tol` (absolute, shared among the intervals
+     | in proportion to their width). The table must be rebuilt after
+     | `setup`, `setKnots*`, `CatmullRom` or `load_view`, that drop it.
+    \*/
+    void
+    buildArcLength( real_type tol = 0 );
+
+    //! true if `buildArcLength` was called on the current curve
+    bool
+    hasArcLength() const
+    { return !this->_arc_s.empty(); }
+
+    //! number of cells of the arc-length table
+    integer
+    arcLengthCells() const
+    { return integer(this->_arc_idx.size()); }
+
+    //! Length of the curve, from the table if available
+    real_type
+    length() const;
+
+    //! arc-length from `xMin()` to the parameter `t`
+    real_type
+    t_to_s( real_type t ) const;
+
+    //! parameter at the arc-length `s`
+    /*!
+     | `s` is clamped to `[0,length()]`, or taken modulo `length()` if
+     | the curve is closed. Needs `buildArcLength`.
+    \*/
+    real_type
+    s_to_t( real_type s ) const;
+
+    //! `t[k] = s_to_t(s[k])`, `k=0..n-1`
+    /*!
+     | The cell of the table is tracked with a cursor, for nondecreasing
+     | `s` the cost is O(n + cells), other orderings fall back to a
+     | binary search on the backward steps.
+    \*/
+    void
+    s_to_t(
+      integer         n,
+      real_type const s[],
+      real_type       t[]
+    ) const;
+
+    //! Evaluate all the splines at the arc-length `s`
+    void
+    eval_at_arclength(
+      real_type s,
+      real_type vals[],
+      integer   inc
+    ) const;
+
+    void
+    eval_at_arclength( real_type s, vector<real_type> & vals ) const;
+
+    //! `vals[j+k*ldV]` = component `j` at the arc-length `s[k]`, `k=0..n-1`
+    void
+    eval_at_arclength(
+      integer         n,
+      real_type const s[],
+      real_type       vals[],
+      integer         ldV
+    ) const;
+
+    //! `n` points equally spaced in arc-length, end points included
+    void
+    sample_arclength(
+      integer   n,
+      real_type vals[],
+      integer   ldV
+    ) const;
+
     virtual
     void
     setup( GenericContainer const & gc );
@@ -2191,10 +3204,328 @@ namespace Splines {
     void
     dump_table( ostream_type & s, integer num_points ) const;
 
-  };
+    //! Polyline within `tol` of the curve
+    /*!
+     | As `Spline::tessellate`, each knot interval is split in `m` equal
+     | parts with `max|C''|/(8 m^2) <= tol` (derivatives in the local
+     | parameter of the segment). `C''` is linear on a segment, the bound
+     | is the largest norm at its ends and the polyline is at distance
+     | at most `tol` from the curve.
+     | Return the number of points `n`; `t[k]` and `P[k*ldP+j]` are
+     | written only if `n <= nmax`.
+    \*/
+    integer
+    tessellate(
+      real_type tol,
+      integer   nmax,
+      real_type t[],
+      real_type P[],
+      integer   ldP,
+      integer   nthreads = 1
+    ) const;
 
-  /*\
-   |   ____        _ _            ____       _
+    //! Bezier control points of all the segments, as `CubicSplineBase::toBezier`
+    /*!
+     | Control point `k` (`0 <= k <= 3*(numPoints()-1)`) is
+     | `P[k*ldP+j]`, `j = 0..dim-1`, the segment `i` uses `k = 3*i..3*i+3`.
+    \*/
+    void
+    toBezier( real_type P[], integer ldP ) const;
+
+    //! Restriction of the curve to `[a,b]` (within the knots) in `S`
+    /*!
+     | As `CubicSplineBase::cut`: `S` has the knots in `(a,b)` plus the
+     | ends, the values and derivatives are copied or evaluated so the
+     | curve is the same, `S` is open. `S` may be this spline.
+    \*/
+    void
+    cut( real_type a, real_type b, SplineVec & S ) const;
+
+    //! The parts on `[xMin(),t]` and `[t,xMax()]` in `L` and `R` (not
+    //! this spline), see `cut`
+    void
+    split( real_type t, SplineVec & L, SplineVec & R ) const;
+
+    //! true if the nodes are referenced from a `SplineBinaryFile`
+    bool is_view() const { return this->_is_view; }
+
+    //! Write the spline as a binary record (see `SplineBinaryFile`)
+    void
+    writeBinary( ostream_type & s ) const;
+
+    //! Reference the record `irec` of `f` without copying the nodes
+    /*!
+     | `f` must stay open until the spline is destroyed or rebuilt,
+     | `setKnots*` and `CatmullRom` throw on a view.
+    \*/
+    void
+    load_view( SplineBinaryFile const & f, integer irec );
+
+  };
+
+  /*\
+   |   ____     ___   _
+   |  | __ ) \   / / | | |
+   |  |  _ \\ \ / /| |_| |
+   |  | |_) |\ V / |  _  |
+   |  |____/  \_/  |_| |_|
+  \*/
+
+  //! Bounding volume hierarchy on the segments of a `SplineVec`
+  /*!
+   | Each knot interval of the curve is a cubic Bezier segment and the box
+   | of its 4 control points contains the segment. The boxes are stored in
+   | a binary tree (median split along the widest side) with up to `leaf`
+   | segments per leaf. The index keeps a copy of the segments in power
+   | form, the spline can be modified or destroyed after `build`.
+   |
+   | `closestPoint` visits the tree nearest box first and prunes the boxes
+   | farther than the best distance found so far. On a candidate segment
+   | every root of the quintic `(C(t)-p).C'(t) = 0` is found on the
+   | intervals where it is monotone (split by the roots of its
+   | derivatives), the nearest of them and of the two ends is the minimum.
+   | All the queries are const and can run concurrently.
+  \*/
+  class SplineVecBVH {
+
+    SplineVecBVH( SplineVecBVH const & ) = delete;
+    SplineVecBVH const & operator = ( SplineVecBVH const & ) = delete;
+
+    // internal node if `left` >= 0, else leaf with the segments
+    // `_perm[first..last)`, `parent` < 0 for the root
+    typedef struct {
+      integer left, right, first, last, parent;
+    } Node;
+
+    string  _name;
+    integer _dim;
+    integer _nseg;
+
+    vector<real_type> _T;     // knots
+    vector<real_type> _C;     // segment i: a0,a1,a2,a3 (dim each), u in [0,1]
+    vector<real_type> _box;   // segment i: min[0..dim) max[0..dim)
+    vector<real_type> _nbox;  // the same for the nodes
+    vector<Node>      _nodes;
+    vector<integer>   _perm;
+    vector<integer>   _leaf;  // leaf of each segment
+
+    integer
+    buildNode( integer first, integer last, integer leaf, integer parent );
+
+    real_type
+    boxDist2( real_type const box[], real_type const p[] ) const;
+
+    //! squared distance from `p` of segment `i`, `u` in [0,1] of the minimum
+    real_type
+    segmentClosest( integer i, real_type const p[], real_type & u ) const;
+
+    //! closest point in the subtree `node` if nearer than `sqrt(best)`,
+    //! the segment `skip` is already done
+    real_type
+    query(
+      real_type const p[],
+      integer         node,
+      integer       & iseg,
+      real_type     & u,
+      real_type       best,
+      integer         skip = -1
+    ) const;
+
+    //! squared distance of the closest point, `i0` >= 0 for a warm start
+    real_type
+    nearest(
+      real_type const p[],
+      integer         i0,
+      integer       & iseg,
+      real_type     & u
+    ) const;
+
+    real_type
+    finish(
+      integer   iseg,
+      real_type u,
+      real_type d2,
+      real_type & t,
+      real_type q[]
+    ) const;
+
+  public:
+
+    //! intersection of the curve `a` at `ta` with the curve (or line segment) `b` at `tb`
+    struct Hit {
+      integer   a, b;
+      real_type ta, tb;
+    };
+
+  private:
+
+    //! error if the tree is not built or the curve is not planar
+    void checkPlanarTree( char const where[] ) const;
+
+    //! intersections with `B` appended to `hits`, labelled `a` and `b`
+    //! return false if the subdivision budget was exhausted
+    bool
+    intersectHits(
+      SplineVecBVH const & B,
+      integer              a,
+      integer              b,
+      vector<Hit>        & hits
+    ) const;
+
+    //! intersections with the segment `P0`-`P1` appended to `hits`
+    void
+    segmentHits(
+      real_type const P0[],
+      real_type const P1[],
+      integer         a,
+      integer         b,
+      vector<Hit>   & hits
+    ) const;
+
+  public:
+
+    SplineVecBVH();
+
+    explicit
+    SplineVecBVH( SplineVec const & S, integer leaf = 4 );
+
+    //! Build the tree on the curve `S`
+    void
+    build( SplineVec const & S, integer leaf = 4 );
+
+    //! name of the indexed spline
+    string const & name() const { return this->_name; }
+
+    integer dimension()   const { return this->_dim; }
+    integer numSegments() const { return this->_nseg; }
+    integer numNodes()    const { return integer(this->_nodes.size()); }
+
+    //! box of the Bezier control points of the segment `i`
+    void
+    segmentBox( integer i, real_type bmin[], real_type bmax[] ) const;
+
+    //! Distance of `p[0..dim)` from the curve
+    /*!
+     | On exit `t` is the parameter of the closest point and, if not null,
+     | `q[0..dim)` the closest point.
+    \*/
+    real_type
+    closestPoint(
+      real_type const p[],
+      real_type     & t,
+      real_type       q[] = nullptr
+    ) const;
+
+    //! As `closestPoint` with `t` on input the previous result (tracking)
+    /*!
+     | The segment of the previous `t` gives a distance bound, then the
+     | tree is visited from its leaf up to the root, opening only the
+     | siblings nearer than the bound. The distance is the same of
+     | `closestPoint`.
+    \*/
+    real_type
+    closestPointFrom(
+      real_type const p[],
+      real_type     & t,
+      real_type       q[] = nullptr
+    ) const;
+
+    //! Closest points of the `n` points `P[k*ldP+j]`
+    /*!
+     | `t[k]` and `dist[k]` receive the parameter and the distance,
+     | `Q[k*ldQ+j]` (if not null) the closest point. With `track` each point
+     | is warm started with the result of the previous one (GPS traces).
+     | With `nthreads != 1` the points are split in contiguous chunks.
+    \*/
+    void
+    closestPoints(
+      integer         n,
+      real_type const P[],
+      integer         ldP,
+      real_type       t[],
+      real_type       dist[],
+      real_type       Q[]      = nullptr,
+      integer         ldQ      = 0,
+      bool            track    = false,
+      integer         nthreads = 1
+    ) const;
+
+    //! All the intersections with the curve `B`, planar curves only
+    /*!
+     | The pairs of nodes with overlapping boxes are visited on both trees,
+     | then the pairs of segments are subdivided (de Casteljau) while the
+     | boxes of their Bezier control points overlap. When both pieces are
+     | flat, Newton on `A(ta) = B(tb)` from the intersection of the chords
+     | gives the crossing. Tangent contacts are located by subdivision to
+     | the rounding level, overlapping arcs give a sampling of the overlap.
+     | On exit `ta[k]`, `tb[k]` are the parameters sorted by `ta`, the
+     | number of intersections is returned.
+     |
+     | At most 4096 pairs of pieces are examined for each pair of
+     | segments. When this budget is exhausted (overlapping or nearly
+     | tangent arcs) the hits found so far are returned and `*complete`
+     | (if not null) is false.
+    \*/
+    integer
+    intersect(
+      SplineVecBVH const & B,
+      vector<real_type>  & ta,
+      vector<real_type>  & tb,
+      bool               * complete = nullptr
+    ) const;
+
+    //! All the intersections with the line segment `P0`-`P1`, planar curves only
+    /*!
+     | On each segment whose box crosses the box of the line segment the
+     | signed distance from the line is a cubic, its roots come from
+     | `cubicRoots` (or `quadraticRoots`) and are polished by Newton.
+     | On exit `t[k]` is the parameter on the curve, `s[k]` in [0,1] the
+     | one on the line segment, sorted by `t`.
+    \*/
+    integer
+    intersectSegment(
+      real_type const     P0[],
+      real_type const     P1[],
+      vector<real_type> & t,
+      vector<real_type> & s
+    ) const;
+
+    //! Intersections of all the pairs `i < j` of `curves`
+    /*!
+     | The pairs are split in contiguous chunks among `nthreads` threads,
+     | the hits are sorted by `a`, `b` and `ta` whatever the threads.
+     | Return false if the subdivision budget of `intersect` was exhausted
+     | on some pair, the hits of that pair may be incomplete.
+    \*/
+    static
+    bool
+    intersectAll(
+      vector<SplineVecBVH const *> const & curves,
+      vector<Hit>                        & hits,
+      integer                              nthreads = 1
+    );
+
+    //! Intersections of `curves` with the `n` line segments `P0+k*ldP`-`P1+k*ldP`
+    /*!
+     | `Hit::b` is the index of the line segment and `Hit::tb` the
+     | parameter in [0,1] on it, threads and sorting as `intersectAll`.
+    \*/
+    static
+    void
+    intersectAllSegments(
+      vector<SplineVecBVH const *> const & curves,
+      integer                              n,
+      real_type const                      P0[],
+      real_type const                      P1[],
+      integer                              ldP,
+      vector<Hit>                        & hits,
+      integer                              nthreads = 1
+    );
+
+  };
+
+  /*\
+   |   ____        _ _            ____       _
    |  / ___| _ __ | (_)_ __   ___/ ___|  ___| |_
    |  \___ \| '_ \| | | '_ \ / _ \___ \ / _ \ __|
    |   ___) | |_) | | | | | |  __/___) |  __/ |_
@@ -2210,10 +3541,10 @@ namespace Splines {
 
   protected:
 
-    string const _name;
+    string _name;
 
-    SplineMalloc<real_type>  baseValue;
-    SplineMalloc<real_type*> basePointer;
+    // single arena for the spline objects, the pointers and the values
+    SplineMalloc<real_type> baseValue;
 
     integer _npts;
     integer _nspl;
@@ -2242,11 +3573,21 @@ namespace Splines {
     Spline const *
     intersect( integer spl, real_type zeta, real_type & x ) const;
 
+    //! destroy the splines placed in the arena
+    void
+    destroySplines();
+
   public:
 
     //! spline constructor
     SplineSet( string const & name = "SplineSet" );
 
+    //! move constructor, steal the memory of `s` that is left empty
+    SplineSet( SplineSet && s ) noexcept;
+
+    //! move assignment, steal the memory of `s` that is left empty
+    SplineSet & operator = ( SplineSet && s ) noexcept;
+
     //! spline destructor
     virtual
     ~SplineSet();
@@ -3324,6 +4665,19 @@ namespace Splines {
     void
     dump_table( ostream_type & s, integer num_points ) const;
 
+    //! Write the set as a binary record (see `SplineBinaryFile`)
+    void
+    writeBinary( ostream_type & s ) const;
+
+    //! Build the set on the record `irec` of `f` without copying the nodes
+    /*!
+     | All the splines are view splines (see `Spline::is_view`) and
+     | nothing is rebuilt: `f` must stay open until the set is destroyed
+     | or rebuilt.
+    \*/
+    void
+    load_view( SplineBinaryFile const & f, integer irec );
+
   };
 
   /*\
@@ -3342,7 +4696,7 @@ namespace Splines {
 
   protected:
 
-    string const _name;
+    string _name;
     bool         _x_closed;
     bool         _y_closed;
     bool         _x_can_extend;
@@ -3352,6 +4706,30 @@ namespace Splines {
 
     real_type Z_min, Z_max;
 
+    integer _build_threads; // threads used by `makeSpline`, see `setBuildThreads`
+    integer _tile;          // requested tile side of the node tables, see `setTileSize`
+    integer _tile_bits;     // log2 of the tile side of the current layout, 0 = row-major
+    integer _tile_ny;       // number of tiles along y of the current layout
+
+    /*!
+     | Starting hints for `searchInterval` at scattered points: the
+     | interval containing the left end of each of `2*(npts-1)` uniform
+     | buckets. For reasonably graded nodes the hint is the interval or
+     | the previous one, so the search is O(1) instead of a bisection.
+    \*/
+    class IntervalHint {
+      real_type       x0, scale;
+      vector<integer> table;
+    public:
+      IntervalHint() : x0(0), scale(0), table() {}
+      void build( vector<real_type> const & X );
+      integer operator () ( real_type x ) const;
+    };
+
+    IntervalHint _hint_x, _hint_y; // rebuilt with the nodes by `makeHints`
+
+    void makeHints();
+
     mutable std::mutex                   lastInterval_x_mutex;
     mutable map<std::thread::id,integer> lastInterval_x_by_thread;
 
@@ -3414,9 +4792,15 @@ namespace Splines {
     ipos_F( integer i, integer j, integer ldZ ) const
     { return i + ldZ*j; }
 
+    //! position of the node `(i,j)` in `Z` and in the derived node tables
     integer
-    ipos_C( integer i, integer j ) const
-    { return this->ipos_C(i,j,integer(this->Y.size())); }
+    ipos_C( integer i, integer j ) const {
+      if ( this->_tile_bits == 0 ) return this->ipos_C(i,j,integer(this->Y.size()));
+      integer b = this->_tile_bits;
+      integer m = (integer(1)<<b)-1;
+      integer t = (i>>b)*this->_tile_ny+(j>>b); // tile of the node
+      return (((t<<b)+(i&m))<<b)+(j&m);
+    }
 
     integer
     ipos_F( integer i, integer j ) const
@@ -3424,6 +4808,110 @@ namespace Splines {
 
     virtual void makeSpline() SPLINES_PURE_VIRTUAL;
 
+    //! error if a closed axis has a last row (column) of `Z` that does not
+    //! repeat the first one, called by the periodic `makeSpline`
+    void checkClosed() const;
+
+    //! optional per-patch tables, rebuilt after `makeSpline` and on load
+    virtual void makePatches() {}
+
+    //! move `Z` and the node tables from row-major to the requested tiles
+    void makeTiles();
+
+    //! `V` (a node table) in row-major order, `tmp` is used if it is tiled
+    real_type const *
+    rowMajor( vector<real_type> const & V, vector<real_type> & tmp ) const;
+
+    //! derived tables computed by `makeSpline`, return how many
+    virtual
+    integer
+    nodeArrays( vector<real_type> * [8] )
+    { return 0; }
+
+    virtual
+    integer
+    nodeArrays( vector<real_type> const * [8] ) const
+    { return 0; }
+
+    //! basis of derivative order `d` along one direction, see `gridBasis`
+    typedef void (*GridBasis)( real_type t, real_type h, real_type base[] );
+
+    //! interval and basis (`K` values for each point) of the points `p`
+    /*!
+     | The search uses a local hint, so sorted points are located in O(1)
+     | and the per-thread tables of `search_x`, `search_y` are not touched.
+    \*/
+    void
+    gridBasis(
+      bool                along_x,
+      real_type const     p[],
+      integer             n,
+      integer             K,
+      GridBasis           basis,
+      vector<integer>   & idx,
+      vector<real_type> & B
+    ) const;
+
+    //! evaluate the derivative of order `dx`,`dy` on the grid `xs` x `ys`
+    virtual
+    void
+    gridEval(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const SPLINES_PURE_VIRTUAL;
+
+    //! evaluate the jets of order `what` at the `n` points of a batch
+    /*!
+     | The point `k` is in the patch `(I[k],J[k])` at local coordinates
+     | `tx[k]`, `ty[k]`, its jet (see `jet`) goes in `out[p*jetSize(what)]`
+     | with `p = perm[k]`. Order 0, 1, 2 are the value, `D` and `DD`.
+    \*/
+    virtual
+    void
+    batchEval(
+      integer         what,
+      size_t          n,
+      size_t    const perm[],
+      integer   const I[],
+      integer   const J[],
+      real_type const tx[],
+      real_type const ty[],
+      real_type       out[]
+    ) const SPLINES_PURE_VIRTUAL;
+
+    //! bounds of `|f_uu|`, `|f_uv|`, `|f_vv|` on the patch `(i,j)`
+    /*!
+     | `u`, `v` in [0,1] are the local coordinates of the patch. The bounds
+     | are the largest differences of the Bezier net of the patch, which
+     | are the coefficients of the derivatives in the Bernstein basis.
+    \*/
+    virtual
+    void
+    patchBound( integer i, integer j, real_type B[3] ) const SPLINES_PURE_VIRTUAL;
+
+    void
+    batchChunk(
+      integer         what,
+      real_type const x[],
+      real_type const y[],
+      real_type       out[],
+      size_t          n,
+      bool            sort
+    ) const;
+
+    void
+    evalBatch(
+      integer         what,
+      real_type const x[],
+      real_type const y[],
+      real_type       out[],
+      size_t          n,
+      bool            sort,
+      integer         nthreads
+    ) const;
+
   public:
 
     //! spline constructor
@@ -3438,6 +4926,12 @@ namespace Splines {
     , Z()
     , Z_min(0)
     , Z_max(0)
+    , _build_threads(1)
+    , _tile(0)
+    , _tile_bits(0)
+    , _tile_ny(0)
+    , _hint_x()
+    , _hint_y()
     {
       {
         std::lock_guard<std::mutex> lck(lastInterval_x_mutex);
@@ -3449,10 +4943,22 @@ namespace Splines {
       }
     }
 
+    //! move constructor, steal the data of `s` that is left empty
+    SplineSurf( SplineSurf && s ) noexcept;
+
+    //! move assignment, steal the data of `s` that is left empty
+    SplineSurf & operator = ( SplineSurf && s ) noexcept;
+
     //! spline destructor
     virtual
     ~SplineSurf();
 
+    /*!
+     | A closed axis wraps the evaluation and, when set before `build`,
+     | makes BiCubicSpline and BiQuinticSpline use periodic conditions
+     | along it; the last row (column) of `Z` must repeat the first one,
+     | up to sqrt(epsilon) relative to the line, or `build` fails.
+    \*/
     bool is_x_closed() const { return this->_x_closed; }
     void make_x_closed()     { this->_x_closed = true; }
     void make_x_opened()     { this->_x_closed = false; }
@@ -3469,6 +4975,30 @@ namespace Splines {
     void make_y_unbounded()   { this->_y_can_extend = true; }
     void make_y_bounded()     { this->_y_can_extend = false; }
 
+    //! Threads used by `build` to compute the derivatives at the nodes
+    /*!
+     | Rows, columns (and for Akima2D the nodes) are split in contiguous
+     | blocks, each with its own 1D workspace, so the result is bitwise
+     | identical to the serial build. `n <= 0` means all the hardware
+     | threads, the default is 1.
+    \*/
+    void    setBuildThreads( integer n ) { this->_build_threads = n; }
+    integer buildThreads() const { return this->_build_threads; }
+
+    //! Store `Z` and the derivative tables in `tile` x `tile` blocks
+    /*!
+     | `tile` must be 0 (row-major, the default) or a power of 2.
+     | With tiles the nodes of a patch neighbourhood are in a few cache
+     | lines, so sweeps along x (that in row-major order stride by `ny`)
+     | and clustered random queries touch less memory. The derivatives
+     | are always computed in row-major order and the tables are moved in
+     | blocks at the end of `build` (or here, if the spline is already
+     | built); the tables are padded to a whole number of tiles.
+     | Evaluation and binary files do not depend on the layout.
+    \*/
+    void    setTileSize( integer tile );
+    integer tileSize() const { return this->_tile; }
+
     string const &
     name() const
     { return this->_name; }
@@ -3497,7 +5027,8 @@ namespace Splines {
     yNode( integer i ) const
     { return this->Y[size_t(i)]; }
 
-    //! return the i-th node of the spline (y component).
+    //! return the value of the spline at node `(i,j)`
+    virtual
     real_type
     zNode( integer i, integer j ) const
     { return this->Z[size_t(this->ipos_C(i,j))]; }
@@ -3696,6 +5227,208 @@ namespace Splines {
     eval_D_2_2( real_type x, real_type y ) const
     { return this->Dyy(x,y); }
 
+    //! Evaluate the derivative of order `dx`,`dy` (`dx+dy <= 2`) on a grid
+    /*!
+     | `out[i*ldOut+j]` is computed at `(xs[i],ys[j])`, i.e. the result is
+     | stored as the C-matrix `Z` of `build`.
+     | Each `xs[i]` and `ys[j]` is searched once and its basis is computed
+     | once, points falling in the same patch reuse the loaded coefficients.
+     | Results are the same of the pointwise evaluation; no per-object
+     | state is used so concurrent calls are safe.
+    \*/
+    void
+    evalGrid_D(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const;
+
+    //! Evaluate spline value on the grid `xs` x `ys`, see `evalGrid_D`
+    void
+    evalGrid(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { this->evalGrid_D( 0, 0, xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dx(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { this->evalGrid_D( 1, 0, xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dy(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { this->evalGrid_D( 0, 1, xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dxx(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { this->evalGrid_D( 2, 0, xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dxy(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { this->evalGrid_D( 1, 1, xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dyy(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { this->evalGrid_D( 0, 2, xs, nx, ys, ny, out, ldOut ); }
+
+    //! Triangle mesh within `tol` of the surface
+    /*!
+     | Each cell of the grid is split in `mx` x `my` rectangles cut along a
+     | diagonal, with `(Mxx hx^2 + 2 Mxy hx hy + Myy hy^2)/8 <= tol`, the
+     | bound of the linear interpolation error on the triangles. The `M`
+     | bound the second derivatives on the cell, they are computed from
+     | the Bezier net of the Hermite patch (see `patchBound`), so the
+     | mesh is within `tol` of the surface.
+     | `mx` is the largest of the column and `my` of the row, so the mesh
+     | is a tensor grid without cracks.
+     | Vertex `k` is `V[3*k..3*k+2]` = (x,y,z), triangle `k` is
+     | `T[3*k..3*k+2]` (counterclockwise). Return the number of vertices
+     | `nv` and in `nt` the number of triangles, written only if
+     | `nv <= nvmax` and `nt <= ntmax`.
+    \*/
+    integer
+    tessellate(
+      real_type tol,
+      integer   nvmax,
+      real_type V[],
+      integer   ntmax,
+      integer   T[],
+      integer & nt,
+      integer   nthreads = 1
+    ) const;
+
+    //! Evaluate the derivative of order `dx`,`dy` at `(xs[i],y)`, see `evalGrid_D`
+    void
+    evalScanline_D(
+      integer dx, integer dy,
+      real_type y, real_type const xs[], integer n, real_type out[]
+    ) const
+    { this->evalGrid_D( dx, dy, xs, n, &y, 1, out, 1 ); }
+
+    //! Evaluate spline value at `(xs[i],y)` for `i=0..n-1`
+    void
+    evalScanline( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { this->evalGrid_D( 0, 0, xs, n, &y, 1, out, 1 ); }
+
+    void
+    evalScanline_Dx( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { this->evalGrid_D( 1, 0, xs, n, &y, 1, out, 1 ); }
+
+    void
+    evalScanline_Dy( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { this->evalGrid_D( 0, 1, xs, n, &y, 1, out, 1 ); }
+
+    void
+    evalScanline_Dxx( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { this->evalGrid_D( 2, 0, xs, n, &y, 1, out, 1 ); }
+
+    void
+    evalScanline_Dxy( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { this->evalGrid_D( 1, 1, xs, n, &y, 1, out, 1 ); }
+
+    void
+    evalScanline_Dyy( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { this->evalGrid_D( 0, 2, xs, n, &y, 1, out, 1 ); }
+
+    //! Evaluate spline value at the `n` scattered points `(x[k],y[k])`
+    /*!
+     | Every point is located once. If `sort` the points are evaluated
+     | grouped by tiles of 8x8 patches, so the coefficients of a tile are
+     | read from cache, and the results are scattered back in input order.
+     | With `nthreads > 1` (`0` means all the hardware threads) the points
+     | are split in contiguous chunks evaluated in parallel.
+     | Results are identical to the pointwise evaluation; no per-object
+     | state is used so concurrent calls are safe.
+    \*/
+    void
+    eval(
+      real_type const x[],
+      real_type const y[],
+      real_type       z[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { this->evalBatch( 0, x, y, z, n, sort, nthreads ); }
+
+    //! Value and gradient at `n` points, `d[3*k+0..2]` as computed by `D`
+    void
+    eval_D(
+      real_type const x[],
+      real_type const y[],
+      real_type       d[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { this->evalBatch( 1, x, y, d, n, sort, nthreads ); }
+
+    //! Value, gradient and Hessian at `n` points, `dd[6*k+0..5]` as `DD`
+    void
+    eval_DD(
+      real_type const x[],
+      real_type const y[],
+      real_type       dd[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { this->evalBatch( 2, x, y, dd, n, sort, nthreads ); }
+
+    //! number of partial derivatives of order `<= order`
+    static
+    integer
+    jetSize( integer order )
+    { return (order+1)*(order+2)/2; }
+
+    //! All the partial derivatives of order `<= order` at `(x,y)`
+    /*!
+     | `J` receives the `jetSize(order)` values
+     | `f, f_x, f_y, f_xx, f_xy, f_yy, f_xxx, f_xxy, f_xyy, f_yyy, ...`
+     | sorted by total order and then by decreasing order in `x`, so that
+     | order 1 and 2 give the layout of `D` and `DD`.
+     | The point is searched once, the patch is loaded once and each basis
+     | derivative is computed once. Derivatives above the degree of the
+     | patches are 0 (bilinear: as `DD`, the second derivatives are 0).
+    \*/
+    void
+    jet( real_type x, real_type y, integer order, real_type J[] ) const;
+
+    //! Jets of order `order` at `n` points, `J[k*jetSize(order)+...]`, see `eval`
+    void
+    jet(
+      real_type const x[],
+      real_type const y[],
+      integer         order,
+      real_type       J[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { this->evalBatch( order, x, y, J, n, sort, nthreads ); }
+
     //! Print spline coefficients
     virtual
     void
@@ -3706,9 +5439,26 @@ namespace Splines {
     char const *
     type_name() const SPLINES_PURE_VIRTUAL;
 
+    //! Return spline type (as number)
+    virtual
+    unsigned
+    type() const SPLINES_PURE_VIRTUAL;
+
     void
     info( ostream & s ) const;
 
+    //! Write the built spline as a binary record (see `SplineBinaryFile`)
+    void
+    writeBinary( ostream_type & s ) const;
+
+    //! Load the record `irec` of `f` written by a spline of the same type
+    /*!
+     | Nodes and derived tables are copied (the storage is `std::vector`)
+     | but `makeSpline` is not called.
+    \*/
+    void
+    loadBinary( SplineBinaryFile const & f, integer irec );
+
   };
 
   /*\
@@ -3722,13 +5472,74 @@ namespace Splines {
   //! bilinear spline base class
   class BilinearSpline : public SplineSurf {
     virtual void makeSpline() SPLINES_OVERRIDE {}
+
+    bool          _x_uniform; // nodes (nearly) equispaced, see `makePatches`
+    bool          _y_uniform;
+    real_type     _x_scale;   // (nx-1)/(X.back()-X.front())
+    real_type     _y_scale;
+    bool          _use_float;
+    vector<float> Zf;         // row-major float copy of `Z`, see `useFloatTable`
+
+    integer locate_x( real_type & x, integer & hint ) const;
+    integer locate_y( real_type & y, integer & hint ) const;
+    integer locate_x( real_type & x ) const;
+    integer locate_y( real_type & y ) const;
+
+    template <typename T, typename TZ>
+    void
+    resampleChunk(
+      T const x[], T const y[], T z[], size_t n,
+      TZ const tab[], bool row_major
+    ) const;
+
+  protected:
+
+    virtual void makePatches() SPLINES_OVERRIDE;
+
+    virtual
+    void
+    gridEval(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    batchEval(
+      integer         what,
+      size_t          n,
+      size_t    const perm[],
+      integer   const I[],
+      integer   const J[],
+      real_type const tx[],
+      real_type const ty[],
+      real_type       out[]
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    patchBound( integer i, integer j, real_type B[3] ) const SPLINES_OVERRIDE;
+
   public:
 
     //! spline constructor
     BilinearSpline( string const & name = "Spline" )
     : SplineSurf(name)
+    , _x_uniform(false)
+    , _y_uniform(false)
+    , _x_scale(0)
+    , _y_scale(0)
+    , _use_float(false)
     {}
 
+    //! move constructor
+    BilinearSpline( BilinearSpline && ) = default;
+
+    //! move assignment
+    BilinearSpline & operator = ( BilinearSpline && ) = default;
+
     virtual
     ~BilinearSpline() SPLINES_OVERRIDE
     {}
@@ -3771,6 +5582,52 @@ namespace Splines {
     Dyy( real_type , real_type ) const SPLINES_OVERRIDE
     { return 0; }
 
+    //! true if the nodes along x (y) are equispaced
+    /*!
+     | On a uniform axis the interval of a point is computed in O(1) from
+     | `(x-X[0])*(nx-1)/(X[nx-1]-X[0])` (then checked against the nodes),
+     | without the search and without the per-thread hint table.
+     | The nodes need only to be equispaced to within 1/4 of the step.
+     | Closed axes and points outside the nodes use the usual search.
+    \*/
+    bool isUniformX() const { return this->_x_uniform; }
+    bool isUniformY() const { return this->_y_uniform; }
+
+    //! Keep a row-major `float` copy of `Z` for `resample` in single precision
+    void
+    useFloatTable( bool yes = true );
+
+    bool
+    floatTable() const
+    { return this->_use_float; }
+
+    //! Values at the `n` scattered points `(x[k],y[k])`, for image resampling
+    /*!
+     | Same results of `operator ()` (and of `eval`) but the points are
+     | neither sorted nor moved: the intervals and the weights are computed
+     | for a block of points and then the 4 nodes of each point are read
+     | in a separate loop that the compiler can vectorize with gathers.
+     | With `nthreads != 1` the points are split in contiguous chunks.
+    \*/
+    void
+    resample(
+      real_type const x[],
+      real_type const y[],
+      real_type       z[],
+      size_t          n,
+      integer         nthreads = 1
+    ) const;
+
+    //! Single precision `resample`, it read the `float` table if present
+    void
+    resample(
+      float const x[],
+      float const y[],
+      float       z[],
+      size_t      n,
+      integer     nthreads = 1
+    ) const;
+
     //! Print spline coefficients
     virtual
     void
@@ -3781,6 +5638,12 @@ namespace Splines {
     char const *
     type_name() const SPLINES_OVERRIDE;
 
+    //! Return spline type (as number)
+    virtual
+    unsigned
+    type() const SPLINES_OVERRIDE
+    { return BILINEAR_TYPE; }
+
   };
 
   /*\
@@ -3796,8 +5659,50 @@ namespace Splines {
   protected:
 
     vector<real_type> DX, DY, DXY;
+    bool              _use_patches;
+    vector<real_type> patches; // 16 values for each patch, see `usePatchLayout`
+
+    void gather( integer i, integer j, real_type bili3[4][4] ) const;
     void load( integer i, integer j, real_type bili3[4][4] ) const;
 
+    virtual void makePatches() SPLINES_OVERRIDE;
+
+    virtual
+    integer
+    nodeArrays( vector<real_type> * D[8] ) SPLINES_OVERRIDE
+    { D[0] = &DX; D[1] = &DY; D[2] = &DXY; return 3; }
+
+    virtual
+    integer
+    nodeArrays( vector<real_type> const * D[8] ) const SPLINES_OVERRIDE
+    { D[0] = &DX; D[1] = &DY; D[2] = &DXY; return 3; }
+
+    virtual
+    void
+    gridEval(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    batchEval(
+      integer         what,
+      size_t          n,
+      size_t    const perm[],
+      integer   const I[],
+      integer   const J[],
+      real_type const tx[],
+      real_type const ty[],
+      real_type       out[]
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    patchBound( integer i, integer j, real_type B[3] ) const SPLINES_OVERRIDE;
+
   public:
 
     //! spline constructor
@@ -3805,24 +5710,52 @@ namespace Splines {
     : SplineSurf( name )
     , DX()
     , DY()
+    , _use_patches(false)
     {}
 
+    //! move constructor
+    BiCubicSplineBase( BiCubicSplineBase && ) = default;
+
+    //! move assignment
+    BiCubicSplineBase & operator = ( BiCubicSplineBase && ) = default;
+
     virtual
     ~BiCubicSplineBase() SPLINES_OVERRIDE
     {}
 
+    //! return the x-derivative of the spline at node `(i,j)`
+    virtual
     real_type
     DxNode ( integer i, integer j ) const
     { return this->DX[size_t(this->ipos_C(i,j))]; }
 
+    //! return the y-derivative of the spline at node `(i,j)`
+    virtual
     real_type
     DyNode ( integer i, integer j ) const
     { return this->DY[size_t(this->ipos_C(i,j))]; }
 
+    //! return the mixed derivative of the spline at node `(i,j)`
+    virtual
     real_type
     DxyNode( integer i, integer j ) const
     { return this->DXY[size_t(this->ipos_C(i,j))]; }
 
+    //! Store the 16 coefficients of each patch in a contiguous block
+    /*!
+     | The coefficients (values and derivatives at the 4 corners, in the
+     | Hermite form used by `bilinear3`) are copied patch by patch, so an
+     | evaluation read one block of 128 bytes instead of 16 values from
+     | 4 arrays. The table cost 4 times the memory of `Z`, `DX`, `DY`, `DXY`
+     | and is kept up to date by `build`. Results are unchanged.
+    \*/
+    void
+    usePatchLayout( bool yes = true );
+
+    bool
+    patchLayout() const
+    { return this->_use_patches; }
+
     //! Evaluate spline value
     virtual
     real_type
@@ -3867,7 +5800,13 @@ namespace Splines {
    |  |____/|_|\____\__,_|_.__/|_|\___|____/| .__/|_|_|_| |_|\___|
    |                                        |_|
   \*/
-  //! cubic spline base class
+  /*!
+   | Bicubic spline with PCHIP slopes, shape preserving along the open
+   | axes. Along a closed axis the slopes come from the C2 periodic cubic
+   | spline instead: the surface is smooth across the seam but it is not
+   | shape preserving and may overshoot the data. Closed surfaces used
+   | PCHIP slopes on every axis before, so their values change.
+  \*/
   class BiCubicSpline : public BiCubicSplineBase {
     virtual void makeSpline() SPLINES_OVERRIDE;
 
@@ -3878,6 +5817,12 @@ namespace Splines {
     : BiCubicSplineBase( name )
     {}
 
+    //! move constructor
+    BiCubicSpline( BiCubicSpline && ) = default;
+
+    //! move assignment
+    BiCubicSpline & operator = ( BiCubicSpline && ) = default;
+
     virtual
     ~BiCubicSpline() SPLINES_OVERRIDE
     {}
@@ -3885,37 +5830,305 @@ namespace Splines {
     //! Print spline coefficients
     virtual
     void
-    writeToStream( ostream_type & s ) const SPLINES_OVERRIDE;
+    writeToStream( ostream_type & s ) const SPLINES_OVERRIDE;
+
+    //! Return spline typename
+    virtual
+    char const *
+    type_name() const SPLINES_OVERRIDE;
+
+    //! Return spline type (as number)
+    virtual
+    unsigned
+    type() const SPLINES_OVERRIDE
+    { return BICUBIC_TYPE; }
+
+  };
+
+  /*\
+   |      _    _    _                 ____  ____            _ _
+   |     / \  | | _(_)_ __ ___   __ _|___ \|  _ \ ___ _ __ | (_)_ __   ___
+   |    / _ \ | |/ / | '_ ` _ \ / _` | __) | | | / __| '_ \| | | '_ \ / _ \
+   |   / ___ \|   <| | | | | | | (_| |/ __/| |_| \__ \ |_) | | | | | |  __/
+   |  /_/   \_\_|\_\_|_| |_| |_|\__,_|_____|____/|___/ .__/|_|_|_| |_|\___|
+   |                                                 |_|
+  \*/
+  //! cubic spline base class
+  class Akima2Dspline : public BiCubicSplineBase {
+    virtual void makeSpline() SPLINES_OVERRIDE;
+
+  public:
+
+    //! spline constructor
+    Akima2Dspline( string const & name = "Spline" )
+    : BiCubicSplineBase( name )
+    {}
+
+    //! move constructor
+    Akima2Dspline( Akima2Dspline && ) = default;
+
+    //! move assignment
+    Akima2Dspline & operator = ( Akima2Dspline && ) = default;
+
+    virtual
+    ~Akima2Dspline() SPLINES_OVERRIDE
+    {}
+
+    //! Print spline coefficients
+    virtual
+    void
+    writeToStream( ostream_type & s ) const SPLINES_OVERRIDE;
+
+    //! Return spline typename
+    virtual
+    char const *
+    type_name() const SPLINES_OVERRIDE;
+
+    //! Return spline type (as number)
+    virtual
+    unsigned
+    type() const SPLINES_OVERRIDE
+    { return AKIMA2D_TYPE; }
+
+  };
+
+  /*\
+   |   __  __                            _
+   |  |  \/  | __ _ _ __  _ __   ___  __| |
+   |  | |\/| |/ _` | '_ \| '_ \ / _ \/ _` |
+   |  | |  | | (_| | |_) | |_) |  __/ (_| |
+   |  |_|  |_|\__,_| .__/| .__/ \___|\__,_|
+   |               |_|   |_|
+  \*/
+  //! BiCubic (PCHIP) spline whose nodes live in a memory-mapped tiled file
+  /*!
+   | For surfaces too large to keep `Z`, `DX`, `DY`, `DXY` in memory.
+   | Only `X` and `Y` are in RAM, the nodes are stored in a file in
+   | `tile` x `tile` blocks, each block with `Z`, `DX`, `DY` interleaved
+   | node by node (`DXY` is 0 as in `BiCubicSpline`).
+   |
+   | `build` reads the data block by block with a halo of 2 nodes, so the
+   | slopes computed on the block (PCHIP is local) are bitwise identical
+   | to the ones of `BiCubicSpline`, and writes the file sequentially.
+   |
+   | Evaluation maps (`mmap`) only the tiles of the queried patches and
+   | touch only their pages; the mapped tiles are kept in a LRU cache
+   | whose size is bounded by `setMaxResident`. All the evaluation methods
+   | of `SplineSurf` (grids, batches, jets) are available and thread safe.
+   | Grids and batches pin the tiles they are reading, so each thread
+   | locks the cache only when it moves to another tile; the least
+   | recently used tile is found in O(1).
+   | On systems without `mmap` the tiles are read in memory buffers.
+   |
+   | The file is native endian and is not a `SplineBinaryFile`:
+   | `writeBinary`, `loadBinary`, `usePatchLayout` and `setTileSize` do
+   | not apply to this class.
+  \*/
+  class BiCubicSplineMapped : public BiCubicSplineBase {
+
+    struct CachedTile {
+      void            * base;  // start of the mapping (page aligned)
+      size_t            size;  // length of the mapping
+      real_type const * data;  // first node of the tile
+      integer           tile;  // tile index
+      integer           pins;  // readers using the tile, see `TileReader`
+    };
+
+    typedef std::list<CachedTile>::iterator TileIter;
+
+    class TileReader;
+
+    string  _fname;
+    int     _fd;
+    integer _tile_side;    // nodes per tile side
+    integer _tiles_y;      // number of tiles along y
+    size_t  _data_offset;  // offset of the first tile in the file
+    size_t  _max_resident; // bound in bytes of the mapped tiles
+
+    mutable std::mutex            _cache_mutex;
+    mutable std::list<CachedTile> _cache;       // most recently used first
+    mutable vector<TileIter>      _cache_index; // tile -> `_cache` or `_cache.end()`
+
+    virtual void makeSpline() SPLINES_OVERRIDE;
+    virtual void makePatches() SPLINES_OVERRIDE {}
+
+    size_t tileBytes() const
+    { return 3*sizeof(real_type)*size_t(this->_tile_side)*size_t(this->_tile_side); }
+
+    void checkOpen() const;
+
+    // the cache mutex must be locked by the callers of these
+    real_type const * node( integer i, integer j ) const;
+    TileIter fetch( integer t ) const;
+    void evict( TileIter it ) const;
+    void shrinkCache( size_t bytes ) const;
+
+    void flushCache() const;
+
+    //! patch `(i,j)` in the layout of `BiCubicSplineBase::gather`
+    void load( integer i, integer j, real_type bili3[4][4] ) const;
+
+    //! derivative `dx`,`dy` at `(x,y)`, the body of `operator ()`, `Dx`, ...
+    real_type eval_D( integer dx, integer dy, real_type x, real_type y ) const;
+
+  protected:
+
+    virtual
+    void
+    gridEval(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    batchEval(
+      integer         what,
+      size_t          n,
+      size_t    const perm[],
+      integer   const I[],
+      integer   const J[],
+      real_type const tx[],
+      real_type const ty[],
+      real_type       out[]
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    patchBound( integer i, integer j, real_type B[3] ) const SPLINES_OVERRIDE;
+
+  public:
+
+    //! reader of the sub-matrix `z[(i-i0)*ldZ+(j-j0)] = Z(i,j)`, `i0 <= i < i1`, `j0 <= j < j1`
+    typedef std::function<void(
+      integer i0, integer i1, integer j0, integer j1,
+      real_type z[], integer ldZ
+    )> BlockReader;
+
+    //! spline constructor
+    BiCubicSplineMapped( string const & name = "Spline" );
+
+    virtual
+    ~BiCubicSplineMapped() SPLINES_OVERRIDE;
+
+    /*! Build the tiled file `fname` and open it
+     | \param fname  file to be written
+     | \param x      vector of x-coordinates
+     | \param nx     number of points in direction x
+     | \param y      vector of y-coordinates
+     | \param ny     number of points in direction y
+     | \param reader called for each tile (plus halo) to get the z-values
+     | \param tile   nodes per tile side (at least 4)
+     |
+     | The memory used is a few tiles for each of the `buildThreads()`
+     | threads; `reader` is called by the calling thread only.
+    \*/
+    void
+    build(
+      char const        fname[],
+      real_type const   x[], integer nx,
+      real_type const   y[], integer ny,
+      BlockReader const & reader,
+      integer           tile = 64
+    );
+
+    //! Build the tiled file `fname` from the C-matrix `z[i*ldZ+j] = Z(i,j)`
+    void
+    build(
+      char const      fname[],
+      real_type const x[], integer nx,
+      real_type const y[], integer ny,
+      real_type const z[], integer ldZ,
+      integer         tile = 64
+    );
+
+    //! open a file written by `build`
+    void
+    open( char const fname[] );
+
+    //! unmap the tiles, close the file and empty the spline
+    void
+    close();
+
+    void
+    clear()
+    { this->close(); }
+
+    //! Bound in bytes of the mapped tiles, default 64MB
+    /*!
+     | At least one tile is mapped; the tiles pinned by the grids and
+     | batches being evaluated (up to 4 for each thread) are not evicted.
+    \*/
+    void
+    setMaxResident( size_t bytes );
+
+    size_t
+    maxResident() const
+    { return this->_max_resident; }
+
+    //! bytes of the tiles currently mapped
+    size_t
+    resident() const;
+
+    //! nodes per tile side of the open file
+    integer
+    tileSide() const
+    { return this->_tile_side; }
+
+    string const &
+    fileName() const
+    { return this->_fname; }
+
+    //! node values read from the file, also through a `SplineSurf` or `BiCubicSplineBase` reference
+    virtual real_type zNode  ( integer i, integer j ) const SPLINES_OVERRIDE;
+    virtual real_type DxNode ( integer i, integer j ) const SPLINES_OVERRIDE;
+    virtual real_type DyNode ( integer i, integer j ) const SPLINES_OVERRIDE;
+    virtual real_type DxyNode( integer, integer ) const SPLINES_OVERRIDE { return 0; }
+
+    //! Evaluate spline value
+    virtual
+    real_type
+    operator () ( real_type x, real_type y ) const SPLINES_OVERRIDE
+    { return this->eval_D( 0, 0, x, y ); }
+
+    //! First derivative
+    virtual
+    void
+    D( real_type x, real_type y, real_type d[3] ) const SPLINES_OVERRIDE
+    { this->jet( x, y, 1, d ); }
+
+    virtual
+    real_type
+    Dx( real_type x, real_type y ) const SPLINES_OVERRIDE
+    { return this->eval_D( 1, 0, x, y ); }
+
+    virtual
+    real_type
+    Dy( real_type x, real_type y ) const SPLINES_OVERRIDE
+    { return this->eval_D( 0, 1, x, y ); }
+
+    //! Second derivative
+    virtual
+    void
+    DD( real_type x, real_type y, real_type dd[6] ) const SPLINES_OVERRIDE
+    { this->jet( x, y, 2, dd ); }
 
-    //! Return spline typename
     virtual
-    char const *
-    type_name() const SPLINES_OVERRIDE;
-
-  };
-
-  /*\
-   |      _    _    _                 ____  ____            _ _
-   |     / \  | | _(_)_ __ ___   __ _|___ \|  _ \ ___ _ __ | (_)_ __   ___
-   |    / _ \ | |/ / | '_ ` _ \ / _` | __) | | | / __| '_ \| | | '_ \ / _ \
-   |   / ___ \|   <| | | | | | | (_| |/ __/| |_| \__ \ |_) | | | | | |  __/
-   |  /_/   \_\_|\_\_|_| |_| |_|\__,_|_____|____/|___/ .__/|_|_|_| |_|\___|
-   |                                                 |_|
-  \*/
-  //! cubic spline base class
-  class Akima2Dspline : public BiCubicSplineBase {
-    virtual void makeSpline() SPLINES_OVERRIDE;
-
-  public:
+    real_type
+    Dxx( real_type x, real_type y ) const SPLINES_OVERRIDE
+    { return this->eval_D( 2, 0, x, y ); }
 
-    //! spline constructor
-    Akima2Dspline( string const & name = "Spline" )
-    : BiCubicSplineBase( name )
-    {}
+    virtual
+    real_type
+    Dxy( real_type x, real_type y ) const SPLINES_OVERRIDE
+    { return this->eval_D( 1, 1, x, y ); }
 
     virtual
-    ~Akima2Dspline() SPLINES_OVERRIDE
-    {}
+    real_type
+    Dyy( real_type x, real_type y ) const SPLINES_OVERRIDE
+    { return this->eval_D( 0, 2, x, y ); }
 
     //! Print spline coefficients
     virtual
@@ -3927,6 +6140,18 @@ namespace Splines {
     char const *
     type_name() const SPLINES_OVERRIDE;
 
+    //! Return spline type (as number)
+    /*!
+     | The mapped spline evaluates as a `BiCubicSpline` built on the same
+     | nodes, so it reports `BICUBIC_TYPE`; `type_name()` tells the two
+     | apart. It has no node tables in memory and cannot be written as
+     | a `SplineBinaryFile` record.
+    \*/
+    virtual
+    unsigned
+    type() const SPLINES_OVERRIDE
+    { return BICUBIC_TYPE; }
+
   };
 
   /*\
@@ -3942,8 +6167,56 @@ namespace Splines {
   protected:
 
     vector<real_type> DX, DXX, DY, DYY, DXY, DXYY, DXXY, DXXYY;
+    bool              _use_patches;
+    vector<real_type> patches; // 36 values for each patch, see `usePatchLayout`
+
+    void gather( integer i, integer j, real_type bili5[6][6] ) const;
     void load( integer i, integer j, real_type bili5[6][6] ) const;
 
+    virtual void makePatches() SPLINES_OVERRIDE;
+
+    virtual
+    integer
+    nodeArrays( vector<real_type> * D[8] ) SPLINES_OVERRIDE {
+      D[0] = &DX;  D[1] = &DXX;  D[2] = &DY;   D[3] = &DYY;
+      D[4] = &DXY; D[5] = &DXYY; D[6] = &DXXY; D[7] = &DXXYY;
+      return 8;
+    }
+
+    virtual
+    integer
+    nodeArrays( vector<real_type> const * D[8] ) const SPLINES_OVERRIDE {
+      D[0] = &DX;  D[1] = &DXX;  D[2] = &DY;   D[3] = &DYY;
+      D[4] = &DXY; D[5] = &DXYY; D[6] = &DXXY; D[7] = &DXXYY;
+      return 8;
+    }
+
+    virtual
+    void
+    gridEval(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    batchEval(
+      integer         what,
+      size_t          n,
+      size_t    const perm[],
+      integer   const I[],
+      integer   const J[],
+      real_type const tx[],
+      real_type const ty[],
+      real_type       out[]
+    ) const SPLINES_OVERRIDE;
+
+    virtual
+    void
+    patchBound( integer i, integer j, real_type B[3] ) const SPLINES_OVERRIDE;
+
   public:
 
     //! spline constructor
@@ -3954,8 +6227,15 @@ namespace Splines {
     , DY()
     , DYY()
     , DXY()
+    , _use_patches(false)
     {}
 
+    //! move constructor
+    BiQuinticSplineBase( BiQuinticSplineBase && ) = default;
+
+    //! move assignment
+    BiQuinticSplineBase & operator = ( BiQuinticSplineBase && ) = default;
+
     virtual
     ~BiQuinticSplineBase() SPLINES_OVERRIDE
     {}
@@ -3980,6 +6260,19 @@ namespace Splines {
     DxyNode( integer i, integer j ) const
     { return this->DXY[size_t(this->ipos_C(i,j))]; }
 
+    //! Store the 36 coefficients of each patch in a contiguous block
+    /*!
+     | As `BiCubicSplineBase::usePatchLayout`: one block of 288 bytes per
+     | evaluation instead of 36 values from 9 arrays, at the cost of 4 times
+     | the memory of the node tables.
+    \*/
+    void
+    usePatchLayout( bool yes = true );
+
+    bool
+    patchLayout() const
+    { return this->_use_patches; }
+
     //! Evaluate spline value
     virtual
     real_type
@@ -4034,6 +6327,12 @@ namespace Splines {
     : BiQuinticSplineBase( name )
     {}
 
+    //! move constructor
+    BiQuinticSpline( BiQuinticSpline && ) = default;
+
+    //! move assignment
+    BiQuinticSpline & operator = ( BiQuinticSpline && ) = default;
+
     virtual
     ~BiQuinticSpline() SPLINES_OVERRIDE
     {}
@@ -4048,6 +6347,12 @@ namespace Splines {
     char const *
     type_name() const SPLINES_OVERRIDE;
 
+    //! Return spline type (as number)
+    virtual
+    unsigned
+    type() const SPLINES_OVERRIDE
+    { return BIQUINTIC_TYPE; }
+
   };
 
   /*\
@@ -4064,32 +6369,99 @@ namespace Splines {
   protected:
     std::string  _name;
     SplineSurf * pSpline2D;
+    integer      _build_threads;
+    integer      _tile;
+    bool         _x_closed;     // flags applied to the surface of every `build`
+    bool         _y_closed;
+    bool         _x_can_extend;
+    bool         _y_can_extend;
+
+    //! replace the spline with an empty one of type `tp`
+    void allocate( SplineType2D tp );
+
+    //! pass the closed/bounded flags to the surface, if any
+    void applyFlags();
+
   public:
 
     //! spline constructor
     Spline2D( string const & name = "Spline2D" )
     : _name(name)
     , pSpline2D( nullptr )
+    , _build_threads(1)
+    , _tile(0)
+    , _x_closed(false)
+    , _y_closed(false)
+    , _x_can_extend(true)
+    , _y_can_extend(true)
     {}
 
+    //! move constructor, take the ownership of the spline of `s`
+    Spline2D( Spline2D && s ) noexcept
+    : _name(std::move(s._name))
+    , pSpline2D(s.pSpline2D)
+    , _build_threads(s._build_threads)
+    , _tile(s._tile)
+    , _x_closed(s._x_closed)
+    , _y_closed(s._y_closed)
+    , _x_can_extend(s._x_can_extend)
+    , _y_can_extend(s._y_can_extend)
+    { s.pSpline2D = nullptr; }
+
+    //! move assignment, take the ownership of the spline of `s`
+    Spline2D &
+    operator = ( Spline2D && s ) noexcept {
+      if ( this != &s ) {
+        if ( this->pSpline2D != nullptr ) delete this->pSpline2D;
+        this->_name     = std::move(s._name);
+        this->pSpline2D = s.pSpline2D;
+        this->_build_threads = s._build_threads;
+        this->_tile          = s._tile;
+        this->_x_closed      = s._x_closed;
+        this->_y_closed      = s._y_closed;
+        this->_x_can_extend  = s._x_can_extend;
+        this->_y_can_extend  = s._y_can_extend;
+        s.pSpline2D     = nullptr;
+      }
+      return *this;
+    }
+
     ~Spline2D()
-    {}
+    { if ( pSpline2D != nullptr ) delete pSpline2D; }
+
+    /*!
+     | The closed and bounded flags are kept by the wrapper: they can be
+     | set before the first `build` and every `build` applies them to the
+     | new surface.
+    \*/
+    bool is_x_closed() const { return this->_x_closed; }
+    void make_x_closed()     { this->_x_closed     = true;  this->applyFlags(); }
+    void make_x_opened()     { this->_x_closed     = false; this->applyFlags(); }
+
+    bool is_y_closed() const { return this->_y_closed; }
+    void make_y_closed()     { this->_y_closed     = true;  this->applyFlags(); }
+    void make_y_opened()     { this->_y_closed     = false; this->applyFlags(); }
 
-    bool is_x_closed() const { return pSpline2D->is_x_closed(); }
-    void make_x_closed()     { pSpline2D->make_x_closed(); }
-    void make_x_opened()     { pSpline2D->make_x_opened(); }
+    bool is_x_bounded() const { return !this->_x_can_extend; }
+    void make_x_unbounded()  { this->_x_can_extend = true;  this->applyFlags(); }
+    void make_x_bounded()    { this->_x_can_extend = false; this->applyFlags(); }
 
-    bool is_y_closed() const { return pSpline2D->is_y_closed(); }
-    void make_y_closed()     { pSpline2D->make_y_closed(); }
-    void make_y_opened()     { pSpline2D->make_y_opened(); }
+    bool is_y_bounded() const { return !this->_y_can_extend; }
+    void make_y_unbounded()  { this->_y_can_extend = true;  this->applyFlags(); }
+    void make_y_bounded()    { this->_y_can_extend = false; this->applyFlags(); }
 
-    bool is_x_bounded() const { return pSpline2D->is_x_bounded(); }
-    void make_x_unbounded()   { pSpline2D->make_x_unbounded(); }
-    void make_x_bounded()     { pSpline2D->make_x_bounded(); }
+    //! Threads used by the next `build`, see `SplineSurf::setBuildThreads`
+    void    setBuildThreads( integer n ) { this->_build_threads = n; }
+    integer buildThreads() const { return this->_build_threads; }
 
-    bool is_y_bounded() const { return pSpline2D->is_y_bounded(); }
-    void make_y_unbounded()   { pSpline2D->make_y_unbounded(); }
-    void make_y_bounded()     { pSpline2D->make_y_bounded(); }
+    //! Tile side of the node tables, see `SplineSurf::setTileSize`
+    void
+    setTileSize( integer tile ) {
+      this->_tile = tile;
+      if ( this->pSpline2D != nullptr ) this->pSpline2D->setTileSize( tile );
+    }
+
+    integer tileSize() const { return this->_tile; }
 
     string const & name() const { return pSpline2D->name(); }
 
@@ -4278,6 +6650,160 @@ namespace Splines {
     eval_D_2_2( real_type x, real_type y ) const
     { return this->Dyy(x,y); }
 
+    //! Evaluate on the grid `xs` x `ys`, see `SplineSurf::evalGrid_D`
+    void
+    evalGrid_D(
+      integer dx, integer dy,
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid_D( dx, dy, xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid( xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dx(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid_Dx( xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dy(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid_Dy( xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dxx(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid_Dxx( xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dxy(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid_Dxy( xs, nx, ys, ny, out, ldOut ); }
+
+    void
+    evalGrid_Dyy(
+      real_type const xs[], integer nx,
+      real_type const ys[], integer ny,
+      real_type       out[], integer ldOut
+    ) const
+    { pSpline2D->evalGrid_Dyy( xs, nx, ys, ny, out, ldOut ); }
+
+    //! Adaptive triangle mesh, see `SplineSurf::tessellate`
+    integer
+    tessellate(
+      real_type tol,
+      integer   nvmax,
+      real_type V[],
+      integer   ntmax,
+      integer   T[],
+      integer & nt,
+      integer   nthreads = 1
+    ) const
+    { return pSpline2D->tessellate( tol, nvmax, V, ntmax, T, nt, nthreads ); }
+
+    //! Evaluate along the line `y`, see `SplineSurf::evalScanline_D`
+    void
+    evalScanline_D(
+      integer dx, integer dy,
+      real_type y, real_type const xs[], integer n, real_type out[]
+    ) const
+    { pSpline2D->evalScanline_D( dx, dy, y, xs, n, out ); }
+
+    void
+    evalScanline( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { pSpline2D->evalScanline( y, xs, n, out ); }
+
+    void
+    evalScanline_Dx( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { pSpline2D->evalScanline_Dx( y, xs, n, out ); }
+
+    void
+    evalScanline_Dy( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { pSpline2D->evalScanline_Dy( y, xs, n, out ); }
+
+    void
+    evalScanline_Dxx( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { pSpline2D->evalScanline_Dxx( y, xs, n, out ); }
+
+    void
+    evalScanline_Dxy( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { pSpline2D->evalScanline_Dxy( y, xs, n, out ); }
+
+    void
+    evalScanline_Dyy( real_type y, real_type const xs[], integer n, real_type out[] ) const
+    { pSpline2D->evalScanline_Dyy( y, xs, n, out ); }
+
+    //! Evaluate at `n` scattered points, see `SplineSurf::eval`
+    void
+    eval(
+      real_type const x[],
+      real_type const y[],
+      real_type       z[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { pSpline2D->eval( x, y, z, n, sort, nthreads ); }
+
+    void
+    eval_D(
+      real_type const x[],
+      real_type const y[],
+      real_type       d[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { pSpline2D->eval_D( x, y, d, n, sort, nthreads ); }
+
+    void
+    eval_DD(
+      real_type const x[],
+      real_type const y[],
+      real_type       dd[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { pSpline2D->eval_DD( x, y, dd, n, sort, nthreads ); }
+
+    //! Partial derivatives up to `order`, see `SplineSurf::jet`
+    void
+    jet( real_type x, real_type y, integer order, real_type J[] ) const
+    { pSpline2D->jet( x, y, order, J ); }
+
+    void
+    jet(
+      real_type const x[],
+      real_type const y[],
+      integer         order,
+      real_type       J[],
+      size_t          n,
+      bool            sort     = true,
+      integer         nthreads = 1
+    ) const
+    { pSpline2D->jet( x, y, order, J, n, sort, nthreads ); }
+
     //! Print spline coefficients
     void
     writeToStream( ostream_type & s ) const
@@ -4290,6 +6816,285 @@ namespace Splines {
 
   };
 
+  /*\
+   |   ____        _ _            _   _ ____
+   |  / ___| _ __ | (_)_ __   ___| \ | |  _ \
+   |  \___ \| '_ \| | | '_ \ / _ \  \| | | | |
+   |   ___) | |_) | | | | | |  __/ |\  | |_| |
+   |  |____/| .__/|_|_|_| |_|\___|_| \_|____/
+   |        |_|
+  \*/
+
+  //! Tensor product spline on a rectilinear grid of dimension 1 to `max_dim`
+  /*!
+   | The values `Z` are stored in row-major order (the last axis run
+   | fastest), the node of indices `(i_0,...,i_{d-1})` is at
+   | `sum_k i_k*stride(k)`.
+   |
+   | - `LINEAR_TYPE`: multilinear interpolation (`BilinearSpline` for d=2)
+   | - `PCHIP_TYPE`, `AKIMA_TYPE`, `BESSEL_TYPE`, `CUBIC_TYPE`: cubic
+   |   Hermite interpolation, the slopes along each axis are computed with
+   |   the corresponding 1D builder on every grid line and the cross
+   |   derivatives are 0 (`BiCubicSpline` for d=2 and `PCHIP_TYPE`).
+   |
+   | The interval along each axis is searched from a caller owned hint,
+   | `hint[k]` is updated with the interval found, so a sequence of close
+   | queries costs O(1) per axis. The interpolation kernel is instantiated
+   | for each dimension. Points outside the grid are extrapolated.
+  \*/
+  class SplineND {
+
+    SplineND( SplineND const & ) = delete;
+    SplineND const & operator = ( SplineND const & ) = delete;
+
+  public:
+
+    static integer const max_dim = 6;
+
+  protected:
+
+    string            _name;
+    SplineType1D      _type;
+    integer           _dim;
+    integer           _npts[max_dim];
+    integer           _stride[max_dim];
+    vector<real_type> X[max_dim];     // grid along each axis
+    vector<real_type> Z;              // values at the nodes
+    vector<real_type> D[max_dim];     // slopes along each axis (cubic only)
+    vector<integer>   _corner;        // offset of the 2^dim corners of a cell
+
+    //! interval along each axis, `hint` is the initial guess and the result
+    void
+    search( real_type x[], integer hint[] ) const;
+
+    //! value (and gradient if `grad != nullptr`) in the cell `hint`
+    real_type
+    evalCell( real_type const x[], integer const hint[], real_type grad[] ) const;
+
+  public:
+
+    //! spline constructor
+    SplineND( string const & name = "SplineND" )
+    : _name(name)
+    , _type(LINEAR_TYPE)
+    , _dim(0)
+    {}
+
+    //! move constructor
+    SplineND( SplineND && ) = default;
+
+    //! move assignment
+    SplineND & operator = ( SplineND && ) = default;
+
+    ~SplineND() {}
+
+    string const & name() const { return this->_name; }
+
+    //! Return spline type (as number)
+    SplineType1D type() const { return this->_type; }
+
+    //! dimension of the grid
+    integer dimension() const { return this->_dim; }
+
+    //! number of nodes along axis `k`
+    integer numPoints( integer k ) const { return this->_npts[k]; }
+
+    //! distance in `Z` of two consecutive nodes along axis `k`
+    integer stride( integer k ) const { return this->_stride[k]; }
+
+    //! grid along axis `k`
+    real_type const * grid( integer k ) const { return this->X[k].data(); }
+
+    //! value at the node `idx[0..dim)`
+    real_type zNode( integer const idx[] ) const;
+
+    //! Build the spline
+    /*!
+     | \param tp   `LINEAR_TYPE` or the 1D spline used for the slopes
+     | \param dim  dimension, 1 to `max_dim`
+     | \param n    number of nodes along each axis (at least 2)
+     | \param x    `x[k]` grid along axis `k`, strictly increasing
+     | \param z    values, row-major (last axis fastest)
+    \*/
+    void
+    build(
+      SplineType1D            tp,
+      integer                 dim,
+      integer         const   n[],
+      real_type const * const x[],
+      real_type       const   z[]
+    );
+
+    //! Cancel the support points, empty the spline.
+    void clear();
+
+    //! value at `x[0..dim)`, `hint[0..dim)` are the intervals of the last query
+    real_type
+    eval( real_type const x[], integer hint[] ) const;
+
+    //! value at `x[0..dim)`, the intervals are searched from scratch
+    real_type
+    eval( real_type const x[] ) const;
+
+    //! value and gradient (`grad[0..dim)`) at `x[0..dim)`
+    real_type
+    eval_D( real_type const x[], real_type grad[], integer hint[] ) const;
+
+    //! value and gradient (`grad[0..dim)`) at `x[0..dim)`
+    real_type
+    eval_D( real_type const x[], real_type grad[] ) const;
+
+    //! Evaluate at `n` points, the point `p` is `x[p*ldX+k]`, `k=0..dim-1`
+    /*!
+     | The hints are carried from a point to the next one, so points along
+     | a path are located in O(1). With `nthreads != 1` the points are split
+     | in contiguous blocks, each with its own hints (`nthreads <= 0` means
+     | all the hardware threads).
+    \*/
+    void
+    eval(
+      real_type const x[],
+      integer         ldX,
+      size_t          n,
+      real_type       values[],
+      integer         nthreads = 1
+    ) const;
+
+    //! As the batch `eval`, `out[p*(dim+1)]` is the value, then the gradient
+    void
+    eval_D(
+      real_type const x[],
+      integer         ldX,
+      size_t          n,
+      real_type       out[],
+      integer         nthreads = 1
+    ) const;
+
+    //! Return spline typename
+    char const * type_name() const { return "SplineND"; }
+
+    void info( ostream & s ) const;
+
+  };
+
+  /*\
+   |   ____        _ _            ____  _                        _____ _ _
+   |  / ___| _ __ | (_)_ __   ___| __ )(_)_ __   __ _ _ __ _   _|  ___(_) | ___
+   |  \___ \| '_ \| | | '_ \ / _ \  _ \| | '_ \ / _` | '__| | | | |_  | | |/ _ \
+   |   ___) | |_) | | | | | |  __/ |_) | | | | | (_| | |  | |_| |  _| | | |  __/
+   |  |____/| .__/|_|_|_| |_|\___|____/|_|_| |_|\__,_|_|   \__, |_|   |_|_|\___|
+   |        |_|                                             |___/
+  \*/
+
+  //! Read only access to a file of binary spline records
+  /*!
+   | A file is the concatenation of the records written by the `writeBinary`
+   | methods. All the values are little-endian and every block start at a
+   | multiple of 8 bytes, so that the `real_type` arrays can be used in place.
+   | A record is a 48 bytes header
+   |
+   |   offset  0  char[4] magic "SPLB"
+   |   offset  4  uint32  version (`VERSION`)
+   |   offset  8  uint32  kind (`SplineBinaryKind`)
+   |   offset 12  uint32  type (`SplineType1D` or `SplineType2D`)
+   |   offset 16  uint32  flags (closed/can extend, bit 0-1 for x, 2-3 for y)
+   |   offset 20  uint32  length of the name
+   |   offset 24  int64   n1 (number of points, nx for surfaces)
+   |   offset 32  int64   n2 (0, number of splines, dimension or ny)
+   |   offset 40  uint64  size in bytes of the payload
+   |
+   | followed by the name (padded to 8 bytes) and by the payload:
+   |
+   | - 1D:      X, Y and the derivatives at the nodes (Yp, Ypp)
+   | - Set:     per spline (type,monotone,header length,0) as 4 uint32,
+   |            the headers (each padded), X, Ymin, Ymax, then for each
+   |            spline Y and its derivatives
+   | - Vec:     X, Y[0..dim), Yp[0..dim)
+   | - Surf:    X, Y, Z, Zmin, Zmax and the tables of `makeSpline`
+   |
+   | The file is mapped read only (`mmap`) and the loaders build view
+   | objects on it: loading cost only the page faults of the touched data.
+  \*/
+  class SplineBinaryFile {
+
+    SplineBinaryFile( SplineBinaryFile const & ) = delete;
+    SplineBinaryFile const & operator = ( SplineBinaryFile const & ) = delete;
+
+  public:
+
+    static unsigned const VERSION = 1;
+
+    //! description of a record, `data` point to the payload in the file
+    typedef struct {
+      SplineBinaryKind      kind;
+      unsigned              type;
+      unsigned              flags;
+      integer               n1;
+      integer               n2;
+      string                name;
+      unsigned char const * data;
+      size_t                size;
+    } Record;
+
+  private:
+
+    string                _fname;
+    unsigned char const * _data;
+    size_t                _size;
+    bool                  _mapped;
+    vector<real_type>     _buffer; // used when `mmap` is not available
+    vector<Record>        _records;
+
+    void scan();
+
+  public:
+
+    SplineBinaryFile()
+    : _data(nullptr)
+    , _size(0)
+    , _mapped(false)
+    {}
+
+    explicit
+    SplineBinaryFile( char const fname[] )
+    : _data(nullptr)
+    , _size(0)
+    , _mapped(false)
+    { this->open( fname ); }
+
+    ~SplineBinaryFile()
+    { this->close(); }
+
+    //! map the file `fname` and check all the record headers
+    void open( char const fname[] );
+
+    //! unmap the file, the objects loaded from it become invalid
+    void close();
+
+    bool is_open() const { return this->_data != nullptr; }
+
+    //! name of the mapped file
+    string const & name() const { return this->_fname; }
+
+    integer
+    numRecords() const
+    { return integer(this->_records.size()); }
+
+    Record const &
+    record( integer i ) const {
+      SPLINE_ASSERT(
+        i >= 0 && i < this->numRecords(),
+        "SplineBinaryFile::record( " << i << " ) argument out of range [0," <<
+        this->numRecords()-1 << "]"
+      )
+      return this->_records[size_t(i)];
+    }
+
+    //! return the position of the first record named `name` or -1
+    integer find( string const & name ) const;
+
+  };
+
 }
 
 namespace SplinesLoad {
@@ -4304,15 +7109,20 @@ namespace SplinesLoad {
   using Splines::ConstantSpline;
   using Splines::QuinticSpline;
   using Splines::Spline1D;
+  using Splines::SplineWindow;
 
   using Splines::BilinearSpline;
   using Splines::BiCubicSpline;
   using Splines::BiQuinticSpline;
   using Splines::Akima2Dspline;
+  using Splines::BiCubicSplineMapped;
   using Splines::Spline2D;
+  using Splines::SplineND;
 
   using Splines::SplineVec;
+  using Splines::SplineVecBVH;
   using Splines::SplineSet;
+  using Splines::SplineBinaryFile;
 
   using Splines::SplineType1D;
   using Splines::SplineType2D;
@@ -4320,6 +7130,10 @@ namespace SplinesLoad {
   using Splines::quadraticRoots;
   using Splines::cubicRoots;
 
+  using Splines::hermiteToBezier;
+  using Splines::bezierToHermite;
+  using Splines::bezierSplit;
+
 }
 
 #ifdef __GNUC__
@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 
 //! Various kind of splines
 namespace Splines {
@@ -33,7 +34,7 @@ namespace Splines {
     case BESSEL_TYPE:     return new BesselSpline(_name);
     case PCHIP_TYPE:      return new PchipSpline(_name);
     case QUINTIC_TYPE:    return new QuinticSpline(_name);
-    case HERMITE_TYPE:    break;
+    case HERMITE_TYPE:    return new HermiteSpline(_name);
     case SPLINE_SET_TYPE: break;
     case SPLINE_VEC_TYPE: break;
     }
@@ -53,6 +54,30 @@ namespace Splines {
     pSpline->build( x, incx, y, incy, n );
   }
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  Spline1D::load_view( SplineBinaryFile const & f, integer irec ) {
+    SplineBinaryFile::Record const & rec = f.record( irec );
+    integer nd = binary_node_derivatives( rec.type, "Spline1D::load_view" );
+    size_t  n  = size_t(rec.n1);
+    real_type const * X = binary_payload(
+      rec, BINARY_SPLINE_1D, (2+size_t(nd))*n*sizeof(real_type),
+      "Spline1D::load_view"
+    );
+    real_type const * D[2] = {
+      nd > 0 ? X+2*n : nullptr,
+      nd > 1 ? X+3*n : nullptr
+    };
+    if ( this->pSpline != nullptr ) delete this->pSpline;
+    this->_name   = rec.name;
+    this->pSpline = new_Spline1D( rec.name, SplineType1D(rec.type) );
+    binary_build_view( this->pSpline, rec.type, X, X+n, D, rec.n1 );
+    if ( (rec.flags & 1) != 0 ) this->pSpline->make_closed();
+    if ( (rec.flags & 2) != 0 ) this->pSpline->make_unbounded();
+    else                        this->pSpline->make_bounded();
+  }
+
   /*
   //    ____  ____   ____                               _
   //   / ___|/ ___| / ___| _   _ _ __  _ __   ___  _ __| |_
@@ -22,6 +22,37 @@
 //! Various kind of splines
 namespace Splines {
 
+  void
+  Spline2D::allocate( SplineType2D tp ) {
+    if ( this->pSpline2D != nullptr ) delete this->pSpline2D;
+    switch ( tp ) {
+    case BILINEAR_TYPE:  this->pSpline2D = new BilinearSpline(this->_name);  break;
+    case BICUBIC_TYPE:   this->pSpline2D = new BiCubicSpline(this->_name);   break;
+    case BIQUINTIC_TYPE: this->pSpline2D = new BiQuinticSpline(this->_name); break;
+    case AKIMA2D_TYPE:   this->pSpline2D = new Akima2Dspline(this->_name);   break;
+    }
+    this->pSpline2D->setBuildThreads( this->_build_threads );
+    this->pSpline2D->setTileSize( this->_tile );
+    this->applyFlags();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  Spline2D::applyFlags() {
+    if ( this->pSpline2D == nullptr ) return;
+    if ( this->_x_closed ) this->pSpline2D->make_x_closed();
+    else                   this->pSpline2D->make_x_opened();
+    if ( this->_y_closed ) this->pSpline2D->make_y_closed();
+    else                   this->pSpline2D->make_y_opened();
+    if ( this->_x_can_extend ) this->pSpline2D->make_x_unbounded();
+    else                       this->pSpline2D->make_x_bounded();
+    if ( this->_y_can_extend ) this->pSpline2D->make_y_unbounded();
+    else                       this->pSpline2D->make_y_bounded();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   void
   Spline2D::build(
     SplineType2D    tp,
@@ -32,32 +63,11 @@ namespace Splines {
     bool fortran_storage,
     bool transposed
   ) {
-    switch ( tp ) {
-    case BILINEAR_TYPE:
-      static_cast<BilinearSpline*>(pSpline2D)->build(
-        x, incx, y, incy, z, ldZ, nx, ny,
-        fortran_storage, transposed
-      );
-      break;
-    case BICUBIC_TYPE:
-      static_cast<BiCubicSpline*>(pSpline2D)->build(
-        x, incx, y, incy, z, ldZ, nx, ny,
-        fortran_storage, transposed
-      );
-      break;
-    case BIQUINTIC_TYPE:
-      static_cast<BiQuinticSpline*>(pSpline2D)->build(
-        x, incx, y, incy, z, ldZ, nx, ny,
-        fortran_storage, transposed
-      );
-      break;
-    case AKIMA2D_TYPE:
-      static_cast<Akima2Dspline*>(pSpline2D)->build(
-        x, incx, y, incy, z, ldZ, nx, ny,
-        fortran_storage, transposed
-      );
-      break;
-    }
+    this->allocate( tp );
+    this->pSpline2D->build(
+      x, incx, y, incy, z, ldZ, nx, ny,
+      fortran_storage, transposed
+    );
   }
 
   void
@@ -69,28 +79,10 @@ namespace Splines {
     bool fortran_storage,
     bool transposed
   ) {
-    switch ( tp ) {
-    case BILINEAR_TYPE:
-      static_cast<BilinearSpline*>(pSpline2D)->build(
-        x, y, z, fortran_storage, transposed
-      );
-      break;
-    case BICUBIC_TYPE:
-      static_cast<BiCubicSpline*>(pSpline2D)->build(
-        x, y, z, fortran_storage, transposed
-      );
-      break;
-    case BIQUINTIC_TYPE:
-      static_cast<BiQuinticSpline*>(pSpline2D)->build(
-        x, y, z, fortran_storage, transposed
-      );
-      break;
-    case AKIMA2D_TYPE:
-      static_cast<Akima2Dspline*>(pSpline2D)->build(
-        x, y, z, fortran_storage, transposed
-      );
-      break;
-    }
+    this->allocate( tp );
+    this->pSpline2D->build(
+      x, y, z, fortran_storage, transposed
+    );
   }
 
   void
@@ -103,28 +95,10 @@ namespace Splines {
     bool fortran_storage,
     bool transposed
   ) {
-    switch ( tp ) {
-    case BILINEAR_TYPE:
-      static_cast<BilinearSpline*>(pSpline2D)->build(
-        z, ldZ, nx, ny, fortran_storage, transposed
-      );
-      break;
-    case BICUBIC_TYPE:
-      static_cast<BiCubicSpline*>(pSpline2D)->build(
-        z, ldZ, nx, ny, fortran_storage, transposed
-      );
-      break;
-    case BIQUINTIC_TYPE:
-      static_cast<BiQuinticSpline*>(pSpline2D)->build(
-        z, ldZ, nx, ny, fortran_storage, transposed
-      );
-      break;
-    case AKIMA2D_TYPE:
-      static_cast<Akima2Dspline*>(pSpline2D)->build(
-        z, ldZ, nx, ny, fortran_storage, transposed
-      );
-      break;
-    }
+    this->allocate( tp );
+    this->pSpline2D->build(
+      z, ldZ, nx, ny, fortran_storage, transposed
+    );
   }
 
   void
@@ -136,28 +110,10 @@ namespace Splines {
     bool fortran_storage,
     bool transposed
   ) {
-    switch ( tp ) {
-    case BILINEAR_TYPE:
-      static_cast<BilinearSpline*>(pSpline2D)->build(
-        z, nx, ny, fortran_storage, transposed
-      );
-      break;
-    case BICUBIC_TYPE:
-      static_cast<BiCubicSpline*>(pSpline2D)->build(
-        z, nx, ny, fortran_storage, transposed
-      );
-      break;
-    case BIQUINTIC_TYPE:
-      static_cast<BiQuinticSpline*>(pSpline2D)->build(
-        z, nx, ny, fortran_storage, transposed
-      );
-      break;
-    case AKIMA2D_TYPE:
-      static_cast<Akima2Dspline*>(pSpline2D)->build(
-        z, nx, ny, fortran_storage, transposed
-      );
-      break;
-    }
+    this->allocate( tp );
+    this->pSpline2D->build(
+      z, nx, ny, fortran_storage, transposed
+    );
   }
 
 
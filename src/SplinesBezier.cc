@@ -0,0 +1,264 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace Splines {
+
+  using std::vector;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  hermiteToBezier(
+    real_type p0,
+    real_type p1,
+    real_type t0,
+    real_type t1,
+    real_type P[4]
+  ) {
+    P[0] = p0;
+    P[1] = p0 + t0/3;
+    P[2] = p1 - t1/3;
+    P[3] = p1;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bezierToHermite(
+    real_type const P[4],
+    real_type     & p0,
+    real_type     & p1,
+    real_type     & t0,
+    real_type     & t1
+  ) {
+    p0 = P[0];
+    p1 = P[3];
+    t0 = 3*(P[1]-P[0]);
+    t1 = 3*(P[3]-P[2]);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  bezierSplit(
+    real_type const P[4],
+    real_type       u,
+    real_type       L[4],
+    real_type       R[4]
+  ) {
+    real_type p01  = P[0]+u*(P[1]-P[0]);
+    real_type p12  = P[1]+u*(P[2]-P[1]);
+    real_type p23  = P[2]+u*(P[3]-P[2]);
+    real_type p012 = p01+u*(p12-p01);
+    real_type p123 = p12+u*(p23-p12);
+    real_type m    = p012+u*(p123-p012);
+    L[0] = P[0]; L[1] = p01;  L[2] = p012; L[3] = m;
+    R[0] = m;    R[1] = p123; R[2] = p23;  R[3] = P[3];
+  }
+
+  /*\
+   |  Segments of the knots `X[0..n)` containing `a` < `b`, the knots
+   |  strictly inside (a,b) are `X[ia+1..ib]`
+  \*/
+
+  static
+  void
+  cutRange(
+    real_type const X[],
+    integer         n,
+    real_type       a,
+    real_type       b,
+    integer       & ia,
+    integer       & ib
+  ) {
+    ia = integer( std::upper_bound( X, X+n, a ) - X ) - 1;
+    ib = integer( std::lower_bound( X, X+n, b ) - X ) - 1;
+    if ( ia < 0   ) ia = 0;
+    if ( ib > n-2 ) ib = n-2;
+    if ( ib < ia  ) ib = ia;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSplineBase::toBezier( real_type P[] ) const {
+    SPLINE_ASSERT( this->npts > 1, "toBezier, spline not built" )
+    for ( integer i = 0; i+1 < this->npts; ++i ) {
+      real_type h = this->X[i+1]-this->X[i];
+      hermiteToBezier( this->Y[i], this->Y[i+1], h*this->Yp[i], h*this->Yp[i+1], P+3*i );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSplineBase::cut( real_type a, real_type b, CubicSplineBase & S ) const {
+    SPLINE_ASSERT( this->npts > 1, "cut, spline not built" )
+    SPLINE_ASSERT(
+      a >= this->X[0] && a < b && b <= this->X[this->npts-1],
+      "cut, bad range [" << a << "," << b << "] for [" <<
+      this->X[0] << "," << this->X[this->npts-1] << "]"
+    )
+    integer ia, ib;
+    cutRange( this->X, this->npts, a, b, ia, ib );
+    size_t m = size_t(ib-ia+2);
+    vector<real_type> x(m), y(m), yp(m);
+    real_type base[4], base_D[4];
+    for ( integer e = 0; e < 2; ++e ) {
+      integer   i  = e == 0 ? ia : ib;
+      real_type t  = e == 0 ? a  : b;
+      size_t    k  = e == 0 ? 0  : m-1;
+      real_type h  = this->X[i+1]-this->X[i];
+      Hermite3  ( t-this->X[i], h, base   );
+      Hermite3_D( t-this->X[i], h, base_D );
+      x[k]  = t;
+      y[k]  = base[0]*this->Y[i] + base[1]*this->Y[i+1] +
+              base[2]*this->Yp[i] + base[3]*this->Yp[i+1];
+      yp[k] = base_D[0]*this->Y[i] + base_D[1]*this->Y[i+1] +
+              base_D[2]*this->Yp[i] + base_D[3]*this->Yp[i+1];
+    }
+    for ( size_t k = 1; k+1 < m; ++k ) {
+      size_t i = size_t(ia)+k;
+      x[k]  = this->X[i];
+      y[k]  = this->Y[i];
+      yp[k] = this->Yp[i];
+    }
+    S.CubicSplineBase::reserve( integer(m) );
+    S.npts = integer(m);
+    std::copy( x.begin(),  x.end(),  S.X  );
+    std::copy( y.begin(),  y.end(),  S.Y  );
+    std::copy( yp.begin(), yp.end(), S.Yp );
+    S.make_opened(); // a sub-range is never periodic
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  CubicSplineBase::split(
+    real_type         x,
+    CubicSplineBase & L,
+    CubicSplineBase & R
+  ) const {
+    SPLINE_ASSERT(
+      &L != this && &R != this && &L != &R,
+      "split, the parts must be distinct from the spline"
+    )
+    this->cut( this->xMin(), x, L );
+    this->cut( x, this->xMax(), R );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::toBezier( real_type P[], integer ldP ) const {
+    SPLINE_ASSERT( this->_npts > 1, "SplineVec::toBezier, spline not built" )
+    SPLINE_ASSERT(
+      ldP >= this->_dim,
+      "SplineVec::toBezier, ldP = " << ldP << " < dimension = " << this->_dim
+    )
+    size_t d = size_t(this->_dim);
+    size_t L = size_t(ldP);
+    for ( size_t i = 0; i+1 < size_t(this->_npts); ++i ) {
+      real_type h = this->_X[i+1]-this->_X[i];
+      real_type * p = P + 3*i*L;
+      for ( size_t j = 0; j < d; ++j ) {
+        real_type B[4];
+        hermiteToBezier(
+          this->_Y[j][i], this->_Y[j][i+1], h*this->_Yp[j][i], h*this->_Yp[j][i+1], B
+        );
+        p[j] = B[0]; p[L+j] = B[1]; p[2*L+j] = B[2]; p[3*L+j] = B[3];
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::cut( real_type a, real_type b, SplineVec & S ) const {
+    SPLINE_ASSERT( this->_npts > 1, "SplineVec::cut, spline not built" )
+    SPLINE_ASSERT(
+      a >= this->_X[0] && a < b && b <= this->_X[this->_npts-1],
+      "SplineVec::cut, bad range [" << a << "," << b << "] for [" <<
+      this->_X[0] << "," << this->_X[this->_npts-1] << "]"
+    )
+    integer ia, ib;
+    cutRange( this->_X, this->_npts, a, b, ia, ib );
+    size_t d = size_t(this->_dim);
+    size_t m = size_t(ib-ia+2);
+    // knot k: x, Y[0..d), Yp[0..d)
+    vector<real_type> tmp( m*(2*d+1) );
+    real_type base[4], base_D[4];
+    for ( integer e = 0; e < 2; ++e ) {
+      size_t    i = size_t(e == 0 ? ia : ib);
+      real_type t = e == 0 ? a : b;
+      real_type * p = &tmp[(e == 0 ? 0 : m-1)*(2*d+1)];
+      real_type h = this->_X[i+1]-this->_X[i];
+      Hermite3  ( t-this->_X[i], h, base   );
+      Hermite3_D( t-this->_X[i], h, base_D );
+      p[0] = t;
+      this->evalBase( base,   i, p+1,   1 );
+      this->evalBase( base_D, i, p+1+d, 1 );
+    }
+    for ( size_t k = 1; k+1 < m; ++k ) {
+      size_t i = size_t(ia)+k;
+      real_type * p = &tmp[k*(2*d+1)];
+      p[0] = this->_X[i];
+      for ( size_t j = 0; j < d; ++j ) {
+        p[1+j]   = this->_Y[j][i];
+        p[1+d+j] = this->_Yp[j][i];
+      }
+    }
+    bool extend = this->_curve_can_extend;
+    S.allocate( integer(d), integer(m) );
+    for ( size_t k = 0; k < m; ++k ) {
+      real_type const * p = &tmp[k*(2*d+1)];
+      S._X[k] = p[0];
+      for ( size_t j = 0; j < d; ++j ) {
+        S._Y[j][k]  = p[1+j];
+        S._Yp[j][k] = p[1+d+j];
+      }
+    }
+    S._curve_is_closed  = false;
+    S._curve_can_extend = extend;
+    S.makeInterleaved();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::split( real_type t, SplineVec & L, SplineVec & R ) const {
+    SPLINE_ASSERT(
+      &L != this && &R != this && &L != &R,
+      "SplineVec::split, the parts must be distinct from the spline"
+    )
+    this->cut( this->xMin(), t, L );
+    this->cut( t, this->xMax(), R );
+  }
+
+}
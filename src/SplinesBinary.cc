@@ -0,0 +1,512 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <new>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+/**
+ * 
+ */
+
+namespace Splines {
+
+  using std::uint32_t;
+  using std::uint64_t;
+  using std::int64_t;
+
+  static char const     binary_magic[4] = { 'S', 'P', 'L', 'B' };
+  static size_t const   binary_header_size = 48;
+
+  /*
+  //  the format is little-endian: the writer swap the bytes on big-endian
+  //  hosts, the reader (that use the data in place) refuse to map the file
+  */
+  static
+  bool
+  host_is_little_endian() {
+    uint32_t      one = 1;
+    unsigned char c;
+    std::memcpy( &c, &one, 1 );
+    return c == 1;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  //! write `n` values of `sz` bytes in little-endian order
+  static
+  void
+  put_le( ostream_type & s, void const * p, size_t sz, size_t n ) {
+    char const * c = static_cast<char const *>(p);
+    if ( host_is_little_endian() ) {
+      s.write( c, std::streamsize(sz*n) );
+    } else {
+      char buf[8];
+      for ( size_t i = 0; i < n; ++i, c += sz ) {
+        for ( size_t k = 0; k < sz; ++k ) buf[k] = c[sz-1-k];
+        s.write( buf, std::streamsize(sz) );
+      }
+    }
+  }
+
+  void
+  binary_put_u32( ostream_type & s, uint32_t v )
+  { put_le( s, &v, sizeof(v), 1 ); }
+
+  void
+  binary_put_reals( ostream_type & s, real_type const * v, size_t n )
+  { put_le( s, v, sizeof(real_type), n ); }
+
+  void
+  binary_put_padding( ostream_type & s, size_t n ) {
+    static char const zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    s.write( zeros, std::streamsize(binary_pad8(n)-n) );
+  }
+
+  void
+  binary_put_header(
+    ostream_type &   s,
+    SplineBinaryKind kind,
+    unsigned         type,
+    unsigned         flags,
+    string const &   name,
+    integer          n1,
+    integer          n2,
+    size_t           payload
+  ) {
+    int64_t  i1 = n1;
+    int64_t  i2 = n2;
+    uint64_t sz = payload;
+    s.write( binary_magic, 4 );
+    binary_put_u32( s, SplineBinaryFile::VERSION );
+    binary_put_u32( s, uint32_t(kind) );
+    binary_put_u32( s, uint32_t(type) );
+    binary_put_u32( s, uint32_t(flags) );
+    binary_put_u32( s, uint32_t(name.size()) );
+    put_le( s, &i1, sizeof(i1), 1 );
+    put_le( s, &i2, sizeof(i2), 1 );
+    put_le( s, &sz, sizeof(sz), 1 );
+    s.write( name.data(), std::streamsize(name.size()) );
+    binary_put_padding( s, name.size() );
+  }
+
+  real_type const *
+  binary_payload(
+    SplineBinaryFile::Record const & rec,
+    SplineBinaryKind                 kind,
+    size_t                           nbytes,
+    char const                       where[]
+  ) {
+    if ( rec.kind != kind || rec.size != nbytes ) {
+      std::ostringstream ost;
+      ost << where << ", record `" << rec.name << "` of kind " << rec.kind
+          << " with " << rec.size << " bytes of data, expected kind " << kind
+          << " with " << nbytes << " bytes\n";
+      throw std::runtime_error(ost.str());
+    }
+    return reinterpret_cast<real_type const *>(rec.data);
+  }
+
+  /*\
+   |   ____        _ _            ____  _                        _____ _ _
+   |  / ___| _ __ | (_)_ __   ___| __ )(_)_ __   __ _ _ __ _   _|  ___(_) | ___
+   |  \___ \| '_ \| | | '_ \ / _ \  _ \| | '_ \ / _` | '__| | | | |_  | | |/ _ \
+   |   ___) | |_) | | | | | |  __/ |_) | | | | | (_| | |  | |_| |  _| | | |  __/
+   |  |____/| .__/|_|_|_| |_|\___|____/|_|_| |_|\__,_|_|   \__, |_|   |_|_|\___|
+   |        |_|                                             |___/
+  \*/
+
+  void
+  SplineBinaryFile::open( char const fname[] ) {
+    this->close();
+    SPLINE_ASSERT(
+      host_is_little_endian(),
+      "SplineBinaryFile::open(\"" << fname << "\") big-endian host not supported"
+    )
+    this->_fname = fname;
+    #ifndef _WIN32
+    int fd = ::open( fname, O_RDONLY );
+    SPLINE_ASSERT(
+      fd >= 0, "SplineBinaryFile::open(\"" << fname << "\") cannot open file"
+    )
+    struct stat st;
+    if ( fstat( fd, &st ) != 0 ) {
+      ::close( fd );
+      SPLINE_DO_ERROR( "SplineBinaryFile::open(\"" << fname << "\") fstat failed" )
+    }
+    this->_size = size_t(st.st_size);
+    if ( this->_size > 0 ) {
+      void * p = mmap( nullptr, this->_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      ::close( fd );
+      SPLINE_ASSERT(
+        p != MAP_FAILED,
+        "SplineBinaryFile::open(\"" << fname << "\") mmap failed"
+      )
+      this->_data   = static_cast<unsigned char const *>(p);
+      this->_mapped = true;
+    } else {
+      ::close( fd );
+    }
+    #else
+    std::ifstream file( fname, std::ios::binary | std::ios::ate );
+    SPLINE_ASSERT(
+      file.good(), "SplineBinaryFile::open(\"" << fname << "\") cannot open file"
+    )
+    this->_size = size_t(file.tellg());
+    // real_type storage keep the arrays aligned as in a mapped file
+    this->_buffer.resize( (this->_size+sizeof(real_type)-1)/sizeof(real_type) );
+    file.seekg( 0 );
+    file.read(
+      reinterpret_cast<char*>(this->_buffer.data()),
+      std::streamsize(this->_size)
+    );
+    this->_data = reinterpret_cast<unsigned char const *>(this->_buffer.data());
+    #endif
+    try {
+      this->scan();
+    } catch ( ... ) {
+      this->close();
+      throw;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineBinaryFile::close() {
+    #ifndef _WIN32
+    if ( this->_mapped )
+      munmap( const_cast<unsigned char*>(this->_data), this->_size );
+    #endif
+    this->_data   = nullptr;
+    this->_size   = 0;
+    this->_mapped = false;
+    this->_buffer.clear();
+    this->_records.clear();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineBinaryFile::scan() {
+    size_t off = 0;
+    while ( off < this->_size ) {
+      SPLINE_ASSERT(
+        off + binary_header_size <= this->_size,
+        "SplineBinaryFile[" << this->_fname << "] truncated header at " << off
+      )
+      unsigned char const * h = this->_data + off;
+      SPLINE_ASSERT(
+        std::memcmp( h, binary_magic, 4 ) == 0,
+        "SplineBinaryFile[" << this->_fname << "] bad magic at " << off
+      )
+      uint32_t u[5];
+      int64_t  n[2];
+      uint64_t sz;
+      std::memcpy( u,   h+4,  sizeof(u) );
+      std::memcpy( n,   h+24, sizeof(n) );
+      std::memcpy( &sz, h+40, sizeof(sz) );
+      SPLINE_ASSERT(
+        u[0] == VERSION,
+        "SplineBinaryFile[" << this->_fname << "] version " << u[0] <<
+        " at " << off << ", expected " << VERSION
+      )
+      SPLINE_ASSERT(
+        u[1] >= BINARY_SPLINE_1D && u[1] <= BINARY_SPLINE_SURF,
+        "SplineBinaryFile[" << this->_fname << "] unknown kind " << u[1] <<
+        " at " << off
+      )
+      SPLINE_ASSERT(
+        n[0] >= 0 && n[0] <= std::numeric_limits<integer>::max() &&
+        n[1] >= 0 && n[1] <= std::numeric_limits<integer>::max(),
+        "SplineBinaryFile[" << this->_fname << "] bad sizes at " << off
+      )
+      size_t data = off + binary_header_size + binary_pad8(u[4]);
+      SPLINE_ASSERT(
+        binary_pad8(sz) == sz && data <= this->_size && sz <= this->_size - data,
+        "SplineBinaryFile[" << this->_fname << "] truncated record at " << off
+      )
+      Record rec;
+      rec.kind  = SplineBinaryKind(u[1]);
+      rec.type  = u[2];
+      rec.flags = u[3];
+      rec.n1    = integer(n[0]);
+      rec.n2    = integer(n[1]);
+      rec.name.assign(
+        reinterpret_cast<char const *>(h+binary_header_size), u[4]
+      );
+      rec.data = this->_data + data;
+      rec.size = size_t(sz);
+      this->_records.push_back( rec );
+      off = data + size_t(sz);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineBinaryFile::find( string const & name ) const {
+    for ( size_t i = 0; i < this->_records.size(); ++i )
+      if ( this->_records[i].name == name ) return integer(i);
+    return -1;
+  }
+
+  /*\
+   |   _ ____
+   |  / |  _ \
+   |  | | | | |
+   |  | | |_| |
+   |  |_|____/
+  \*/
+
+  void
+  Spline::writeBinary( ostream_type & s ) const {
+    real_type const * D[2];
+    integer  nd    = this->nodeDerivatives( D );
+    unsigned flags = (this->_curve_is_closed  ? 1u : 0u) |
+                     (this->_curve_can_extend ? 2u : 0u);
+    size_t   n     = size_t(this->npts);
+    binary_put_header(
+      s, BINARY_SPLINE_1D, this->type(), flags, this->_name,
+      this->npts, 0, (2+size_t(nd))*n*sizeof(real_type)
+    );
+    binary_put_reals( s, this->X, n );
+    binary_put_reals( s, this->Y, n );
+    for ( integer k = 0; k < nd; ++k ) binary_put_reals( s, D[k], n );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  binary_node_derivatives( unsigned tp, char const where[] ) {
+    switch ( tp ) {
+    case CONSTANT_TYPE:
+    case LINEAR_TYPE:
+      return 0;
+    case CUBIC_TYPE:
+    case AKIMA_TYPE:
+    case BESSEL_TYPE:
+    case PCHIP_TYPE:
+    case HERMITE_TYPE:
+      return 1;
+    case QUINTIC_TYPE:
+      return 2;
+    }
+    std::ostringstream ost;
+    ost << where << ", spline type " << tp << " not allowed\n";
+    throw std::runtime_error(ost.str());
+  }
+
+  void
+  binary_build_view(
+    Spline *          S,
+    unsigned          tp,
+    real_type const * X,
+    real_type const * Y,
+    real_type const * D[2],
+    integer           n
+  ) {
+    switch ( tp ) {
+    case CONSTANT_TYPE:
+      static_cast<ConstantSpline*>(S)->build_view( X, Y, n );
+      break;
+    case LINEAR_TYPE:
+      static_cast<LinearSpline*>(S)->build_view( X, Y, n );
+      break;
+    case CUBIC_TYPE:
+    case AKIMA_TYPE:
+    case BESSEL_TYPE:
+    case PCHIP_TYPE:
+    case HERMITE_TYPE:
+      static_cast<CubicSplineBase*>(S)->build_view( X, Y, n, D[0] );
+      break;
+    case QUINTIC_TYPE:
+      static_cast<QuinticSplineBase*>(S)->build_view( X, Y, n, D[0], D[1] );
+      break;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*\
+   |   ____        _ _          __     __
+   |  / ___| _ __ | (_)_ __   __\ \   / /__  ___
+   |  \___ \| '_ \| | | '_ \ / _ \ \ / / _ \/ __|
+   |   ___) | |_) | | | | | |  __/\ V /  __/ (__
+   |  |____/| .__/|_|_|_| |_|\___| \_/ \___|\___|
+   |        |_|
+  \*/
+
+  void
+  SplineVec::writeBinary( ostream_type & s ) const {
+    unsigned flags = (this->_curve_is_closed  ? 1u : 0u) |
+                     (this->_curve_can_extend ? 2u : 0u);
+    size_t   n     = size_t(this->_npts);
+    binary_put_header(
+      s, BINARY_SPLINE_VEC, SPLINE_VEC_TYPE, flags, this->_name,
+      this->_npts, this->_dim, (1+2*size_t(this->_dim))*n*sizeof(real_type)
+    );
+    binary_put_reals( s, this->_X, n );
+    for ( size_t k = 0; k < size_t(this->_dim); ++k )
+      binary_put_reals( s, this->_Y[k], n );
+    for ( size_t k = 0; k < size_t(this->_dim); ++k )
+      binary_put_reals( s, this->_Yp[k], n );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineVec::load_view( SplineBinaryFile const & f, integer irec ) {
+    SplineBinaryFile::Record const & rec = f.record( irec );
+    size_t n   = size_t(rec.n1);
+    size_t dim = size_t(rec.n2);
+    real_type const * pV = binary_payload(
+      rec, BINARY_SPLINE_VEC, (1+2*dim)*n*sizeof(real_type),
+      "SplineVec::load_view"
+    );
+    SPLINE_ASSERT(
+      rec.n1 > 1 && rec.n2 > 0,
+      "SplineVec::load_view, record `" << rec.name << "` bad sizes npts = " <<
+      rec.n1 << " dim = " << rec.n2
+    )
+    this->_name             = rec.name;
+    this->_dim              = rec.n2;
+    this->_npts             = rec.n1;
+    this->_curve_is_closed  = (rec.flags & 1) != 0;
+    this->_curve_can_extend = (rec.flags & 2) != 0;
+    this->_is_view          = true;
+
+    this->baseValue.free();
+    this->basePointer.allocate( 2*dim );
+    this->_Y  = this->basePointer(dim);
+    this->_Yp = this->basePointer(dim);
+
+    // the file is never written: the const_cast only match the storage type
+    this->_X = const_cast<real_type*>(pV); pV += n;
+    for ( size_t k = 0; k < dim; ++k, pV += n )
+      this->_Y[k] = const_cast<real_type*>(pV);
+    for ( size_t k = 0; k < dim; ++k, pV += n )
+      this->_Yp[k] = const_cast<real_type*>(pV);
+
+    this->basePointer.must_be_empty( "SplineVec::load_view, basePointer" );
+    this->makeInterleaved();
+    this->dropTables();
+
+    std::lock_guard<std::mutex> lck(this->lastInterval_mutex);
+    this->lastInterval_by_thread.clear();
+  }
+
+  /*\
+   |   ____        _ _            ____              __
+   |  / ___| _ __ | (_)_ __   ___/ ___| _   _ _ __ / _|
+   |  \___ \| '_ \| | | '_ \ / _ \___ \| | | | '__| |_
+   |   ___) | |_) | | | | | |  __/___) | |_| | |  |  _|
+   |  |____/| .__/|_|_|_| |_|\___|____/ \__,_|_|  |_|
+   |        |_|
+  \*/
+
+  void
+  SplineSurf::writeBinary( ostream_type & s ) const {
+    vector<real_type> const * D[8];
+    integer  nd    = this->nodeArrays( D );
+    unsigned flags = (this->_x_closed     ? 1u : 0u) |
+                     (this->_x_can_extend ? 2u : 0u) |
+                     (this->_y_closed     ? 4u : 0u) |
+                     (this->_y_can_extend ? 8u : 0u);
+    size_t nx  = this->X.size();
+    size_t ny  = this->Y.size();
+    size_t nxy = nx*ny;
+    SPLINE_ASSERT(
+      this->Z.size() >= nxy,
+      "SplineSurf::writeBinary, spline `" << this->_name << "` has no node tables"
+    )
+    binary_put_header(
+      s, BINARY_SPLINE_SURF, this->type(), flags, this->_name,
+      integer(nx), integer(ny),
+      (nx+ny+2+(1+size_t(nd))*nxy)*sizeof(real_type)
+    );
+    vector<real_type> tmp; // node tables are saved in row-major order
+    binary_put_reals( s, this->X.data(), nx );
+    binary_put_reals( s, this->Y.data(), ny );
+    binary_put_reals( s, this->rowMajor( this->Z, tmp ), nxy );
+    binary_put_reals( s, &this->Z_min, 1 );
+    binary_put_reals( s, &this->Z_max, 1 );
+    for ( integer k = 0; k < nd; ++k ) {
+      SPLINE_ASSERT(
+        D[k]->size() == this->Z.size(),
+        "SplineSurf::writeBinary, spline `" << this->_name << "` not built"
+      )
+      binary_put_reals( s, this->rowMajor( *D[k], tmp ), nxy );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::loadBinary( SplineBinaryFile const & f, integer irec ) {
+    SplineBinaryFile::Record const & rec = f.record( irec );
+    SPLINE_ASSERT(
+      rec.type == this->type(),
+      "SplineSurf::loadBinary, record `" << rec.name << "` of type " << rec.type <<
+      " cannot be loaded in a " << this->type_name()
+    )
+    vector<real_type> * D[8];
+    integer nd  = this->nodeArrays( D );
+    size_t  nx  = size_t(rec.n1);
+    size_t  ny  = size_t(rec.n2);
+    size_t  nxy = nx*ny;
+    real_type const * pV = binary_payload(
+      rec, BINARY_SPLINE_SURF,
+      (nx+ny+2+(1+size_t(nd))*nxy)*sizeof(real_type),
+      "SplineSurf::loadBinary"
+    );
+    this->clear();
+    this->_name         = rec.name;
+    this->_x_closed     = (rec.flags & 1) != 0;
+    this->_x_can_extend = (rec.flags & 2) != 0;
+    this->_y_closed     = (rec.flags & 4) != 0;
+    this->_y_can_extend = (rec.flags & 8) != 0;
+    this->X.assign( pV, pV+nx );  pV += nx;
+    this->Y.assign( pV, pV+ny );  pV += ny;
+    this->Z.assign( pV, pV+nxy ); pV += nxy;
+    this->Z_min = *pV++;
+    this->Z_max = *pV++;
+    for ( integer k = 0; k < nd; ++k, pV += nxy )
+      D[k]->assign( pV, pV+nxy );
+    this->makeTiles();
+    this->makeHints();
+    this->makePatches();
+  }
+
+}
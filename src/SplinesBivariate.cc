@@ -18,6 +18,7 @@
 \*--------------------------------------------------------------------------*/
 
 #include "Splines.hh"
+#include "SplinesUtils.hh"
 #include <cmath>
 #include <iomanip>
 
@@ -29,6 +30,83 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  SplineSurf::SplineSurf( SplineSurf && s ) noexcept
+  : _name(std::move(s._name))
+  , _x_closed(s._x_closed)
+  , _y_closed(s._y_closed)
+  , _x_can_extend(s._x_can_extend)
+  , _y_can_extend(s._y_can_extend)
+  , X(std::move(s.X))
+  , Y(std::move(s.Y))
+  , Z(std::move(s.Z))
+  , Z_min(s.Z_min)
+  , Z_max(s.Z_max)
+  , _build_threads(s._build_threads)
+  , _tile(s._tile)
+  , _tile_bits(s._tile_bits)
+  , _tile_ny(s._tile_ny)
+  , _hint_x(std::move(s._hint_x))
+  , _hint_y(std::move(s._hint_y))
+  {
+    s.X.clear(); s.Y.clear(); s.Z.clear();
+    s.Z_min = s.Z_max = 0;
+    s._tile_bits = s._tile_ny = 0;
+    s.makeHints();
+    {
+      std::lock_guard<std::mutex> lck(s.lastInterval_x_mutex);
+      lastInterval_x_by_thread.swap( s.lastInterval_x_by_thread );
+    }
+    {
+      std::lock_guard<std::mutex> lck(s.lastInterval_y_mutex);
+      lastInterval_y_by_thread.swap( s.lastInterval_y_by_thread );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  SplineSurf &
+  SplineSurf::operator = ( SplineSurf && s ) noexcept {
+    if ( this != &s ) {
+      _name         = std::move(s._name);
+      _x_closed     = s._x_closed;
+      _y_closed     = s._y_closed;
+      _x_can_extend = s._x_can_extend;
+      _y_can_extend = s._y_can_extend;
+      X             = std::move(s.X);
+      Y             = std::move(s.Y);
+      Z             = std::move(s.Z);
+      Z_min         = s.Z_min;
+      Z_max         = s.Z_max;
+      _build_threads = s._build_threads;
+      _tile          = s._tile;
+      _tile_bits     = s._tile_bits;
+      _tile_ny       = s._tile_ny;
+      _hint_x        = std::move(s._hint_x);
+      _hint_y        = std::move(s._hint_y);
+      s.X.clear(); s.Y.clear(); s.Z.clear();
+      s.Z_min = s.Z_max = 0;
+      s._tile_bits = s._tile_ny = 0;
+      s.makeHints();
+      {
+        std::lock( lastInterval_x_mutex, s.lastInterval_x_mutex );
+        std::lock_guard<std::mutex> lck1(lastInterval_x_mutex, std::adopt_lock);
+        std::lock_guard<std::mutex> lck2(s.lastInterval_x_mutex, std::adopt_lock);
+        lastInterval_x_by_thread.swap( s.lastInterval_x_by_thread );
+        s.lastInterval_x_by_thread.clear();
+      }
+      {
+        std::lock( lastInterval_y_mutex, s.lastInterval_y_mutex );
+        std::lock_guard<std::mutex> lck1(lastInterval_y_mutex, std::adopt_lock);
+        std::lock_guard<std::mutex> lck2(s.lastInterval_y_mutex, std::adopt_lock);
+        lastInterval_y_by_thread.swap( s.lastInterval_y_by_thread );
+        s.lastInterval_y_by_thread.clear();
+      }
+    }
+    return *this;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   SplineSurf::~SplineSurf()
   {}
 
@@ -49,6 +127,9 @@ namespace Splines {
     Y.clear();
     Z.clear();
     Z_min = Z_max = 0;
+    _tile_bits = _tile_ny = 0;
+    makeHints();
+    makePatches();
     {
       std::lock_guard<std::mutex> lck(lastInterval_x_mutex);
       lastInterval_x_by_thread[std::this_thread::get_id()] = 0;
@@ -73,6 +154,7 @@ namespace Splines {
     X.resize( size_t(nx) );
     Y.resize( size_t(ny) );
     Z.resize( size_t(nx*ny) );
+    _tile_bits = _tile_ny = 0; // derivatives are computed in row-major order
     for ( size_t i = 0; i < size_t(nx); ++i ) X[i] = x[i*size_t(incx)];
     for ( size_t i = 0; i < size_t(ny); ++i ) Y[i] = y[i*size_t(incy)];
     if ( (fortran_storage && transposed) || (!fortran_storage && !transposed) ) {
@@ -95,6 +177,134 @@ namespace Splines {
     Z_max = *std::max_element(Z.begin(),Z.end());
     Z_min = *std::min_element(Z.begin(),Z.end());
     makeSpline();
+    makeTiles();
+    makeHints();
+    makePatches();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::setTileSize( integer tile ) {
+    SPLINE_ASSERT(
+      tile >= 0 && (tile & (tile-1)) == 0,
+      "SplineSurf::setTileSize( " << tile << " ) tile must be 0 or a power of 2"
+    )
+    this->_tile = tile;
+    this->makeTiles();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::checkClosed() const {
+    integer nx = integer(this->X.size());
+    integer ny = integer(this->Y.size());
+    for ( integer j = 0; this->_x_closed && j < ny; ++j )
+      SPLINE_ASSERT(
+        periodic_ends_match( &this->Z[size_t(this->ipos_C(0,j))], ny, nx ),
+        "SplineSurf::checkClosed, closed x axis needs Z(" << nx-1 << "," <<
+        j << ") == Z(0," << j << ")"
+      )
+    for ( integer i = 0; this->_y_closed && i < nx; ++i )
+      SPLINE_ASSERT(
+        periodic_ends_match( &this->Z[size_t(this->ipos_C(i,0))], 1, ny ),
+        "SplineSurf::checkClosed, closed y axis needs Z(" << i << "," <<
+        ny-1 << ") == Z(" << i << ",0)"
+      )
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::makeTiles() {
+    integer bits = 0;
+    while ( (integer(1)<<bits) < this->_tile ) ++bits;
+    integer nx = integer(this->X.size());
+    integer ny = integer(this->Y.size());
+    if ( nx == 0 || ny == 0 || this->Z.empty() || bits == this->_tile_bits ) return;
+
+    vector<real_type> * D[9];
+    D[0] = &this->Z;
+    integer nd = 1+this->nodeArrays( D+1 );
+
+    // size and number of tiles along y of the new layout
+    integer T   = integer(1)<<bits;
+    integer tny = bits == 0 ? 0 : (ny+T-1)>>bits;
+    integer tnx = bits == 0 ? 0 : (nx+T-1)>>bits;
+    size_t  sz  = bits == 0 ? size_t(nx*ny) : size_t(tnx*tny)<<(2*bits);
+
+    integer m      = T-1;
+    size_t  old_sz = this->Z.size();
+    vector<real_type> tmp;
+    for ( integer k = 0; k < nd; ++k ) {
+      vector<real_type> & V = *D[k];
+      if ( V.size() != old_sz ) continue; // table not computed
+      tmp.assign( sz, 0 );
+      for ( integer i = 0; i < nx; ++i ) {
+        for ( integer j = 0; j < ny; ++j ) {
+          integer t  = (i>>bits)*tny+(j>>bits);
+          integer ij = bits == 0 ? i*ny+j : (((t<<bits)+(i&m))<<bits)+(j&m);
+          tmp[size_t(ij)] = V[size_t(this->ipos_C(i,j))];
+        }
+      }
+      V.swap( tmp );
+    }
+    this->_tile_bits = bits;
+    this->_tile_ny   = tny;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::IntervalHint::build( vector<real_type> const & X ) {
+    integer npts = integer(X.size());
+    if ( npts < 2 ) { x0 = scale = 0; table.clear(); return; }
+    integer nb = 2*(npts-1);
+    x0    = X.front();
+    scale = nb/(X.back()-X.front());
+    table.resize( size_t(nb) );
+    integer i = 0;
+    for ( integer b = 0; b < nb; ++b ) {
+      real_type xb = x0 + b/scale;
+      while ( i < npts-2 && X[size_t(i+1)] <= xb ) ++i;
+      table[size_t(b)] = i;
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineSurf::IntervalHint::operator () ( real_type x ) const {
+    real_type t = (x-x0)*scale;
+    if ( !(t > 0) || table.empty() ) return 0;
+    if ( t >= real_type(table.size()) ) return table.back();
+    return table[size_t(t)];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::makeHints() {
+    this->_hint_x.build( this->X );
+    this->_hint_y.build( this->Y );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  real_type const *
+  SplineSurf::rowMajor(
+    vector<real_type> const & V,
+    vector<real_type>       & tmp
+  ) const {
+    if ( this->_tile_bits == 0 ) return V.data();
+    integer nx = integer(this->X.size());
+    integer ny = integer(this->Y.size());
+    tmp.resize( size_t(nx*ny) );
+    for ( integer i = 0; i < nx; ++i )
+      for ( integer j = 0; j < ny; ++j )
+        tmp[size_t(i*ny+j)] = V[size_t(this->ipos_C(i,j))];
+    return tmp.data();
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -120,7 +330,154 @@ namespace Splines {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   void
-  BiCubicSplineBase::load(
+  SplineSurf::gridBasis(
+    bool                along_x,
+    real_type const     p[],
+    integer             n,
+    integer             K,
+    GridBasis           basis,
+    vector<integer>   & idx,
+    vector<real_type> & B
+  ) const {
+    vector<real_type> const & P = along_x ? this->X : this->Y;
+    bool closed     = along_x ? this->_x_closed     : this->_y_closed;
+    bool can_extend = along_x ? this->_x_can_extend : this->_y_can_extend;
+    integer npts    = integer(P.size());
+    integer last    = 0;
+    idx.resize( size_t(n) );
+    B.resize( size_t(n*K) );
+    for ( integer k = 0; k < n; ++k ) {
+      real_type t = p[k];
+      searchInterval( npts, &P.front(), t, last, closed, can_extend );
+      size_t i = size_t(last);
+      idx[size_t(k)] = last;
+      basis( t - P[i], P[i+1] - P[i], &B[size_t(k*K)] );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::evalGrid_D(
+    integer dx, integer dy,
+    real_type const xs[], integer nx,
+    real_type const ys[], integer ny,
+    real_type       out[], integer ldOut
+  ) const {
+    SPLINE_ASSERT(
+      dx >= 0 && dy >= 0 && dx+dy <= 2,
+      "evalGrid_D, derivative order dx = " << dx << " dy = " << dy <<
+      " not supported, must be dx+dy <= 2"
+    )
+    SPLINE_ASSERT(
+      nx >= 0 && ny >= 0 && ldOut >= ny,
+      "evalGrid_D, bad sizes nx = " << nx << " ny = " << ny <<
+      " ldOut = " << ldOut << " (must be >= ny)"
+    )
+    SPLINE_ASSERT(
+      this->X.size() >= 2 && this->Y.size() >= 2,
+      "evalGrid_D, spline not built"
+    )
+    if ( nx == 0 || ny == 0 ) return;
+    this->gridEval( dx, dy, xs, nx, ys, ny, out, ldOut );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::batchChunk(
+    integer         what,
+    real_type const x[],
+    real_type const y[],
+    real_type       out[],
+    size_t          n,
+    bool            sort
+  ) const {
+    integer nX = integer(this->X.size());
+    integer nY = integer(this->Y.size());
+    vector<integer>   I(n), J(n);
+    vector<real_type> tx(n), ty(n);
+    for ( size_t k = 0; k < n; ++k ) {
+      real_type xx = x[k], yy = y[k];
+      integer   li = this->_hint_x( xx ), lj = this->_hint_y( yy );
+      searchInterval( nX, &this->X.front(), xx, li, this->_x_closed, this->_x_can_extend );
+      searchInterval( nY, &this->Y.front(), yy, lj, this->_y_closed, this->_y_can_extend );
+      I[k]  = li;
+      J[k]  = lj;
+      tx[k] = xx - this->X[size_t(li)];
+      ty[k] = yy - this->Y[size_t(lj)];
+    }
+    vector<size_t> perm(n);
+    if ( sort ) {
+      // counting sort on tiles of 8x8 patches, stable inside a tile;
+      // the located points are moved in sorted order so that the
+      // evaluation reads them sequentially
+      size_t ntj = size_t((nY-2) >> 3) + 1;
+      size_t nti = size_t((nX-2) >> 3) + 1;
+      vector<size_t> start( nti*ntj+1, 0 );
+      for ( size_t k = 0; k < n; ++k )
+        ++start[ size_t(I[k] >> 3) * ntj + size_t(J[k] >> 3) + 1 ];
+      for ( size_t t = 1; t < start.size(); ++t ) start[t] += start[t-1];
+      vector<integer>   sI(n), sJ(n);
+      vector<real_type> stx(n), sty(n);
+      for ( size_t k = 0; k < n; ++k ) {
+        size_t pos = start[ size_t(I[k] >> 3) * ntj + size_t(J[k] >> 3) ]++;
+        sI[pos]   = I[k];
+        sJ[pos]   = J[k];
+        stx[pos]  = tx[k];
+        sty[pos]  = ty[k];
+        perm[pos] = k;
+      }
+      I.swap(sI); J.swap(sJ); tx.swap(stx); ty.swap(sty);
+    } else {
+      for ( size_t k = 0; k < n; ++k ) perm[k] = k;
+    }
+    this->batchEval(
+      what, n, &perm.front(), &I.front(), &J.front(),
+      &tx.front(), &ty.front(), out
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::evalBatch(
+    integer         what,
+    real_type const x[],
+    real_type const y[],
+    real_type       out[],
+    size_t          n,
+    bool            sort,
+    integer         nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->X.size() >= 2 && this->Y.size() >= 2,
+      "eval, spline not built"
+    )
+    SPLINE_ASSERT( what >= 0, "jet, order = " << what << " must be >= 0" )
+    size_t const stride = size_t(jetSize(what));
+    parallel_chunks( n, nthreads, [=]( size_t k0, size_t k1 ) {
+      this->batchChunk( what, x+k0, y+k0, out+stride*k0, k1-k0, sort );
+    } );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  SplineSurf::jet( real_type x, real_type y, integer order, real_type J[] ) const {
+    SPLINE_ASSERT( order >= 0, "jet, order = " << order << " must be >= 0" )
+    integer   i  = this->search_x( x );
+    integer   j  = this->search_y( y );
+    real_type tx = x - this->X[size_t(i)];
+    real_type ty = y - this->Y[size_t(j)];
+    size_t    p  = 0;
+    this->batchEval( order, 1, &p, &i, &j, &tx, &ty, J );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineBase::gather(
     integer i, integer j, real_type bili3[4][4]
   ) const {
 
@@ -129,11 +486,10 @@ namespace Splines {
     //
     //  0    2
     //
-    integer ny = integer(Y.size());
-    size_t i0 = size_t(ipos_C(i,j,ny));
-    size_t i1 = size_t(ipos_C(i,j+1,ny));
-    size_t i2 = size_t(ipos_C(i+1,j,ny));
-    size_t i3 = size_t(ipos_C(i+1,j+1,ny));
+    size_t i0 = size_t(ipos_C(i,j));
+    size_t i1 = size_t(ipos_C(i,j+1));
+    size_t i2 = size_t(ipos_C(i+1,j));
+    size_t i3 = size_t(ipos_C(i+1,j+1));
 
     bili3[0][0] = Z[i0];   bili3[0][1] = Z[i1];
     bili3[0][2] = DY[i0];  bili3[0][3] = DY[i1];
@@ -150,6 +506,46 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  BiCubicSplineBase::load(
+    integer i, integer j, real_type bili3[4][4]
+  ) const {
+    if ( this->patches.empty() ) {
+      gather( i, j, bili3 );
+    } else {
+      size_t ipatch = size_t(i)*(Y.size()-1)+size_t(j);
+      real_type const * p = &this->patches[16*ipatch];
+      std::copy( p, p+16, &bili3[0][0] );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineBase::makePatches() {
+    size_t nx = X.size();
+    size_t ny = Y.size();
+    if ( !this->_use_patches || nx < 2 || ny < 2 || DXY.size() != Z.size() ) {
+      vector<real_type>().swap( this->patches ); // release the memory
+      return;
+    }
+    this->patches.resize( 16*(nx-1)*(ny-1) );
+    real_type * p = &this->patches.front();
+    for ( size_t i = 0; i+1 < nx; ++i )
+      for ( size_t j = 0; j+1 < ny; ++j, p += 16 )
+        gather( integer(i), integer(j), reinterpret_cast<real_type(*)[4]>(p) );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineBase::usePatchLayout( bool yes ) {
+    this->_use_patches = yes;
+    this->makePatches();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   real_type
   BiCubicSplineBase::operator () ( real_type x, real_type y ) const {
     real_type bili3[4][4], u[4], v[4];
@@ -230,7 +626,7 @@ namespace Splines {
 
   void
   BiCubicSplineBase::D( real_type x, real_type y, real_type d[3] ) const {
-    real_type bili3[4][4], u[4], u_D[4], v[3], v_D[4];
+    real_type bili3[4][4], u[4], u_D[4], v[4], v_D[4];
     integer i = search_x( x );
     integer j = search_y( y );
     Hermite3   ( x - X[size_t(i)], X[size_t(i+1)] - X[size_t(i)], u    );
@@ -247,7 +643,7 @@ namespace Splines {
 
   void
   BiCubicSplineBase::DD( real_type x, real_type y, real_type d[6] ) const {
-    real_type bili3[4][4], u[4], u_D[4], u_DD[4], v[3], v_D[4], v_DD[4];
+    real_type bili3[4][4], u[4], u_D[4], u_DD[4], v[4], v_D[4], v_DD[4];
     integer i = search_x( x );
     integer j = search_y( y );
     Hermite3   ( x - X[size_t(i)], X[size_t(i+1)] - X[size_t(i)], u    );
@@ -268,15 +664,59 @@ namespace Splines {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   void
-  BiQuinticSplineBase::load(
+  BiCubicSplineBase::gridEval(
+    integer dx, integer dy,
+    real_type const xs[], integer nx,
+    real_type const ys[], integer ny,
+    real_type       out[], integer ldOut
+  ) const {
+    static GridBasis const H[3] = { Hermite3, Hermite3_D, Hermite3_DD };
+    vector<integer>   ii, jj;
+    vector<real_type> U, V;
+    this->gridBasis( true,  xs, nx, 4, H[dx], ii, U );
+    this->gridBasis( false, ys, ny, 4, H[dy], jj, V );
+    grid_eval_patches<4>(
+      &ii.front(), &U.front(), nx,
+      &jj.front(), &V.front(), ny,
+      [this]( integer i, integer j, real_type M[4][4] ) { this->load( i, j, M ); },
+      out, ldOut
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiCubicSplineBase::batchEval(
+    integer         what,
+    size_t          n,
+    size_t    const perm[],
+    integer   const I[],
+    integer   const J[],
+    real_type const tx[],
+    real_type const ty[],
+    real_type       out[]
+  ) const {
+    static HermiteBasis const H[4] = {
+      Hermite3, Hermite3_D, Hermite3_DD, Hermite3_DDD
+    };
+    hermite_jets<4>(
+      what, H, this->X, this->Y,
+      [this]( integer i, integer j, real_type M[4][4] ) { this->load( i, j, M ); },
+      n, perm, I, J, tx, ty, out
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiQuinticSplineBase::gather(
     integer i, integer j, real_type bili5[6][6]
   ) const {
 
-    integer ny = integer(Y.size());
-    size_t i00 = size_t(ipos_C(i,j,ny));
-    size_t i01 = size_t(ipos_C(i,j+1,ny));
-    size_t i10 = size_t(ipos_C(i+1,j,ny));
-    size_t i11 = size_t(ipos_C(i+1,j+1,ny));
+    size_t i00 = size_t(ipos_C(i,j));
+    size_t i01 = size_t(ipos_C(i,j+1));
+    size_t i10 = size_t(ipos_C(i+1,j));
+    size_t i11 = size_t(ipos_C(i+1,j+1));
 
     //
     //  1    3
@@ -331,6 +771,46 @@ namespace Splines {
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+  void
+  BiQuinticSplineBase::load(
+    integer i, integer j, real_type bili5[6][6]
+  ) const {
+    if ( this->patches.empty() ) {
+      gather( i, j, bili5 );
+    } else {
+      size_t ipatch = size_t(i)*(Y.size()-1)+size_t(j);
+      real_type const * p = &this->patches[36*ipatch];
+      std::copy( p, p+36, &bili5[0][0] );
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiQuinticSplineBase::makePatches() {
+    size_t nx = X.size();
+    size_t ny = Y.size();
+    if ( !this->_use_patches || nx < 2 || ny < 2 || DXXYY.size() != Z.size() ) {
+      vector<real_type>().swap( this->patches ); // release the memory
+      return;
+    }
+    this->patches.resize( 36*(nx-1)*(ny-1) );
+    real_type * p = &this->patches.front();
+    for ( size_t i = 0; i+1 < nx; ++i )
+      for ( size_t j = 0; j+1 < ny; ++j, p += 36 )
+        gather( integer(i), integer(j), reinterpret_cast<real_type(*)[6]>(p) );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiQuinticSplineBase::usePatchLayout( bool yes ) {
+    this->_use_patches = yes;
+    this->makePatches();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   real_type
   BiQuinticSplineBase::operator () ( real_type x, real_type y ) const {
     real_type bili5[6][6], u[6], v[6];
@@ -446,6 +926,53 @@ namespace Splines {
     d[5] = bilinear5( u, bili5, v_DD );
   }
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiQuinticSplineBase::gridEval(
+    integer dx, integer dy,
+    real_type const xs[], integer nx,
+    real_type const ys[], integer ny,
+    real_type       out[], integer ldOut
+  ) const {
+    static GridBasis const H[3] = { Hermite5, Hermite5_D, Hermite5_DD };
+    vector<integer>   ii, jj;
+    vector<real_type> U, V;
+    this->gridBasis( true,  xs, nx, 6, H[dx], ii, U );
+    this->gridBasis( false, ys, ny, 6, H[dy], jj, V );
+    grid_eval_patches<6>(
+      &ii.front(), &U.front(), nx,
+      &jj.front(), &V.front(), ny,
+      [this]( integer i, integer j, real_type M[6][6] ) { this->load( i, j, M ); },
+      out, ldOut
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BiQuinticSplineBase::batchEval(
+    integer         what,
+    size_t          n,
+    size_t    const perm[],
+    integer   const I[],
+    integer   const J[],
+    real_type const tx[],
+    real_type const ty[],
+    real_type       out[]
+  ) const {
+    static HermiteBasis const H[6] = {
+      Hermite5, Hermite5_D, Hermite5_DD, Hermite5_DDD, Hermite5_DDDD, Hermite5_DDDDD
+    };
+    hermite_jets<6>(
+      what, H, this->X, this->Y,
+      [this]( integer i, integer j, real_type M[6][6] ) { this->load( i, j, M ); },
+      n, perm, I, J, tx, ty, out
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
   using GenericContainerNamespace::GC_VEC_REAL;
   using GenericContainerNamespace::GC_VEC_INTEGER;
   using GenericContainerNamespace::GC_MAT_REAL;
@@ -57,11 +57,13 @@ either expressed or implied, of the FreeBSD Project.
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <list>
 #include <map>
 #include <utility>      // std::pair
 #include <algorithm>
 #include <thread>
 #include <mutex>
+#include <functional>
 
 //
 // file: Splines
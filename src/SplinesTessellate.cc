@@ -0,0 +1,470 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include "SplinesUtils.hh"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace Splines {
+
+  using std::abs;
+  using std::sqrt;
+  using std::min;
+  using std::max;
+
+  /*\
+   |  Pieces of a segment for a bound `M` of the second derivative in the
+   |  local parameter: (1/m)^2 M / 8 <= tol, at most 2^20 pieces
+  \*/
+
+  static
+  integer
+  numPieces( real_type M, real_type tol ) {
+    real_type r = std::ceil( sqrt( M/(8*tol) ) );
+    if ( !( r > 1 ) ) return 1;
+    if ( r > 1048576 ) return 1048576;
+    return integer(r);
+  }
+
+  // bound of |c0 + c1 u + c2 u^2 + c3 u^3| on [0,1] by the Bernstein coefficients
+  static
+  real_type
+  bernsteinBound( real_type c0, real_type c1, real_type c2, real_type c3 ) {
+    real_type b1 = c0+c1/3;
+    real_type b2 = c0+(2*c1+c2)/3;
+    real_type b3 = c0+c1+c2+c3;
+    return max( max(abs(c0),abs(b1)), max(abs(b2),abs(b3)) );
+  }
+
+  /*\
+   |  Power form in u in [0,1] of the Hermite segments, y0,y1 values,
+   |  d0,d1 first and s0,s1 second derivatives times h and h^2
+  \*/
+
+  static
+  void
+  hermite3( real_type y0, real_type y1, real_type d0, real_type d1, real_type a[4] ) {
+    a[0] = y0;
+    a[1] = d0;
+    a[2] = 3*(y1-y0)-2*d0-d1;
+    a[3] = 2*(y0-y1)+d0+d1;
+  }
+
+  static
+  void
+  hermite5(
+    real_type y0, real_type y1,
+    real_type d0, real_type d1,
+    real_type s0, real_type s1,
+    real_type a[6]
+  ) {
+    real_type dy = y1-y0;
+    a[0] = y0;
+    a[1] = d0;
+    a[2] = s0/2;
+    a[3] = 10*dy-6*d0-4*d1-(3*s0-s1)/2;
+    a[4] = -15*dy+8*d0+7*d1+(3*s0-2*s1)/2;
+    a[5] = 6*dy-3*(d0+d1)+(s1-s0)/2;
+  }
+
+  // largest count of points or triangles that can be indexed by `integer`
+  static size_t const max_count = size_t(std::numeric_limits<integer>::max());
+
+  /*\
+   |  Prefix sums of the pieces, return the number of points counted in
+   |  `size_t`. The sums are stored only when the total is at most
+   |  `max_count`, the caller must check it.
+  \*/
+  static
+  size_t
+  prefixPieces( vector<integer> & off ) {
+    // off[i+1] holds the pieces of segment i
+    size_t n = 1;
+    for ( size_t i = 1; i < off.size(); ++i ) n += size_t(off[i]);
+    if ( n <= max_count )
+      for ( size_t i = 1; i < off.size(); ++i ) off[i] += off[i-1];
+    return n;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  Spline::tessellate(
+    real_type tol,
+    integer   nmax,
+    real_type x[],
+    real_type y[],
+    integer   nthreads
+  ) const {
+    SPLINE_ASSERT( this->npts > 1, "tessellate, spline not built" )
+    SPLINE_ASSERT( tol > 0, "tessellate, expected tol = " << tol << " > 0" )
+    real_type const * D[2] = { nullptr, nullptr };
+    integer nd = this->nodeDerivatives( D );
+    size_t  ns = size_t(this->npts-1);
+
+    vector<integer> off( ns+1, 0 );
+    parallel_chunks( ns, nthreads, [this,tol,nd,&D,&off]( size_t i0, size_t i1 ) {
+      for ( size_t i = i0; i < i1; ++i ) {
+        real_type h = this->X[i+1]-this->X[i];
+        real_type M = 0;
+        if ( nd == 1 ) {
+          real_type a[4];
+          hermite3( this->Y[i], this->Y[i+1], h*D[0][i], h*D[0][i+1], a );
+          M = max( abs(2*a[2]), abs(2*a[2]+6*a[3]) );
+        } else if ( nd == 2 ) {
+          real_type a[6];
+          hermite5(
+            this->Y[i], this->Y[i+1], h*D[0][i], h*D[0][i+1],
+            h*h*D[1][i], h*h*D[1][i+1], a
+          );
+          M = bernsteinBound( 2*a[2], 6*a[3], 12*a[4], 20*a[5] );
+        }
+        off[i+1] = numPieces( M, tol );
+      }
+    } );
+    size_t n = prefixPieces( off );
+    SPLINE_ASSERT(
+      n <= max_count,
+      "tessellate, " << n << " points exceed the integer range, increase tol"
+    )
+    if ( n > size_t(nmax) ) return integer(n);
+
+    parallel_chunks( ns, nthreads, [this,nd,&D,&off,x,y]( size_t i0, size_t i1 ) {
+      for ( size_t i = i0; i < i1; ++i ) {
+        real_type h = this->X[i+1]-this->X[i];
+        real_type a[6] = { this->Y[i], 0, 0, 0, 0, 0 };
+        if ( nd == 1 )
+          hermite3( this->Y[i], this->Y[i+1], h*D[0][i], h*D[0][i+1], a );
+        else if ( nd == 2 )
+          hermite5(
+            this->Y[i], this->Y[i+1], h*D[0][i], h*D[0][i+1],
+            h*h*D[1][i], h*h*D[1][i+1], a
+          );
+        else
+          a[1] = this->Y[i+1]-this->Y[i];
+        integer k0 = off[i];
+        integer m  = off[i+1]-k0;
+        for ( integer k = 0; k < m; ++k ) {
+          real_type u = real_type(k)/m;
+          x[k0+k] = this->X[i]+u*h;
+          y[k0+k] = a[0]+u*(a[1]+u*(a[2]+u*(a[3]+u*(a[4]+u*a[5]))));
+        }
+      }
+    } );
+    x[n-1] = this->X[ns];
+    y[n-1] = this->Y[ns];
+    return integer(n);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineVec::tessellate(
+    real_type tol,
+    integer   nmax,
+    real_type t[],
+    real_type P[],
+    integer   ldP,
+    integer   nthreads
+  ) const {
+    SPLINE_ASSERT( this->_npts > 1, "tessellate, spline not built" )
+    SPLINE_ASSERT( tol > 0, "tessellate, expected tol = " << tol << " > 0" )
+    SPLINE_ASSERT(
+      ldP >= this->_dim,
+      "tessellate, ldP = " << ldP << " < dimension = " << this->_dim
+    )
+    size_t ns = size_t(this->_npts-1);
+    size_t d  = size_t(this->_dim);
+
+    vector<integer> off( ns+1, 0 );
+    parallel_chunks( ns, nthreads, [this,tol,d,&off]( size_t i0, size_t i1 ) {
+      for ( size_t i = i0; i < i1; ++i ) {
+        real_type h = this->_X[i+1]-this->_X[i];
+        real_type M0 = 0, M1 = 0;
+        for ( size_t j = 0; j < d; ++j ) {
+          real_type a[4];
+          hermite3(
+            this->_Y[j][i], this->_Y[j][i+1], h*this->_Yp[j][i], h*this->_Yp[j][i+1], a
+          );
+          M0 += 4*a[2]*a[2];
+          M1 += (2*a[2]+6*a[3])*(2*a[2]+6*a[3]);
+        }
+        off[i+1] = numPieces( sqrt(max(M0,M1)), tol );
+      }
+    } );
+    size_t n = prefixPieces( off );
+    SPLINE_ASSERT(
+      n <= max_count,
+      "tessellate, " << n << " points exceed the integer range, increase tol"
+    )
+    if ( n > size_t(nmax) ) return integer(n);
+
+    parallel_chunks( ns, nthreads, [this,d,&off,t,P,ldP]( size_t i0, size_t i1 ) {
+      for ( size_t i = i0; i < i1; ++i ) {
+        real_type h  = this->_X[i+1]-this->_X[i];
+        integer   k0 = off[i];
+        integer   m  = off[i+1]-k0;
+        for ( integer k = 0; k < m; ++k )
+          t[k0+k] = this->_X[i]+(real_type(k)/m)*h;
+        for ( size_t j = 0; j < d; ++j ) {
+          real_type a[4];
+          hermite3(
+            this->_Y[j][i], this->_Y[j][i+1], h*this->_Yp[j][i], h*this->_Yp[j][i+1], a
+          );
+          real_type * p = P + size_t(k0)*size_t(ldP) + j;
+          for ( integer k = 0; k < m; ++k, p += ldP ) {
+            real_type u = real_type(k)/m;
+            *p = a[0]+u*(a[1]+u*(a[2]+u*a[3]));
+          }
+        }
+      }
+    } );
+    t[n-1] = this->_X[ns];
+    for ( size_t j = 0; j < d; ++j )
+      P[size_t(n-1)*size_t(ldP)+j] = this->_Y[j][ns];
+    return integer(n);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*\
+   |  Bezier net of a Hermite patch: `A` maps the Hermite coefficients of an
+   |  axis (values, derivatives and second derivatives at the two ends, the
+   |  order of `Hermite3`, `Hermite5`) to the `K` Bezier points, `h` the
+   |  length of the interval.
+  \*/
+
+  static
+  void
+  bezierOfHermite( integer K, real_type h, real_type A[6][6] ) {
+    std::fill( &A[0][0], &A[0][0]+36, real_type(0) );
+    if ( K == 4 ) {
+      A[0][0] = 1;
+      A[1][0] = 1; A[1][2] = h/3;
+      A[2][1] = 1; A[2][3] = -h/3;
+      A[3][1] = 1;
+    } else {
+      A[0][0] = 1;
+      A[1][0] = 1; A[1][2] = h/5;
+      A[2][0] = 1; A[2][2] = 2*h/5;  A[2][4] = h*h/20;
+      A[3][1] = 1; A[3][3] = -2*h/5; A[3][5] = h*h/20;
+      A[4][1] = 1; A[4][3] = -h/5;
+      A[5][1] = 1;
+    }
+  }
+
+  // bounds of the second derivatives of the Bezier net `N` of degree `K-1`,
+  // by the convex hull property of the Bernstein basis
+  template <int K>
+  static
+  void
+  bezierNetBound( real_type const N[K][K], real_type B[3] ) {
+    integer const n = K-1;
+    B[0] = B[1] = B[2] = 0;
+    for ( integer r = 0; r < K; ++r ) {
+      for ( integer c = 0; c < K; ++c ) {
+        if ( r+2 < K ) B[0] = max( B[0], abs( N[r+2][c]-2*N[r+1][c]+N[r][c] ) );
+        if ( r+1 < K && c+1 < K )
+          B[1] = max( B[1], abs( N[r+1][c+1]-N[r+1][c]-N[r][c+1]+N[r][c] ) );
+        if ( c+2 < K ) B[2] = max( B[2], abs( N[r][c+2]-2*N[r][c+1]+N[r][c] ) );
+      }
+    }
+    B[0] *= n*(n-1);
+    B[1] *= n*n;
+    B[2] *= n*(n-1);
+  }
+
+  // `B` of the Hermite patch `M` (layout of `bilinear3`, `bilinear5`)
+  template <int K>
+  static
+  void
+  hermitePatchBound(
+    real_type const M[K][K], real_type hx, real_type hy, real_type B[3]
+  ) {
+    real_type Ax[6][6], Ay[6][6], T[K][K], N[K][K];
+    bezierOfHermite( K, hx, Ax );
+    bezierOfHermite( K, hy, Ay );
+    for ( integer p = 0; p < K; ++p ) {
+      for ( integer c = 0; c < K; ++c ) {
+        real_type t = 0;
+        for ( integer q = 0; q < K; ++q ) t += M[p][q]*Ay[c][q];
+        T[p][c] = t;
+      }
+    }
+    for ( integer r = 0; r < K; ++r ) {
+      for ( integer c = 0; c < K; ++c ) {
+        real_type t = 0;
+        for ( integer p = 0; p < K; ++p ) t += Ax[r][p]*T[p][c];
+        N[r][c] = t;
+      }
+    }
+    bezierNetBound<K>( N, B );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  BilinearSpline::patchBound( integer i, integer j, real_type B[3] ) const {
+    B[0] = B[2] = 0;
+    B[1] = abs(
+      this->Z[size_t(this->ipos_C(i+1,j+1))] - this->Z[size_t(this->ipos_C(i+1,j))] -
+      this->Z[size_t(this->ipos_C(i,j+1))]   + this->Z[size_t(this->ipos_C(i,j))]
+    );
+  }
+
+  void
+  BiCubicSplineBase::patchBound( integer i, integer j, real_type B[3] ) const {
+    real_type M[4][4];
+    this->load( i, j, M );
+    hermitePatchBound<4>(
+      M, this->X[size_t(i+1)]-this->X[size_t(i)], this->Y[size_t(j+1)]-this->Y[size_t(j)], B
+    );
+  }
+
+  void
+  BiCubicSplineMapped::patchBound( integer i, integer j, real_type B[3] ) const {
+    real_type M[4][4];
+    this->load( i, j, M );
+    hermitePatchBound<4>(
+      M, this->X[size_t(i+1)]-this->X[size_t(i)], this->Y[size_t(j+1)]-this->Y[size_t(j)], B
+    );
+  }
+
+  void
+  BiQuinticSplineBase::patchBound( integer i, integer j, real_type B[3] ) const {
+    real_type M[6][6];
+    this->load( i, j, M );
+    hermitePatchBound<6>(
+      M, this->X[size_t(i+1)]-this->X[size_t(i)], this->Y[size_t(j+1)]-this->Y[size_t(j)], B
+    );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  integer
+  SplineSurf::tessellate(
+    real_type tol,
+    integer   nvmax,
+    real_type V[],
+    integer   ntmax,
+    integer   T[],
+    integer & nt,
+    integer   nthreads
+  ) const {
+    SPLINE_ASSERT(
+      this->X.size() > 1 && this->Y.size() > 1, "tessellate, spline not built"
+    )
+    SPLINE_ASSERT( tol > 0, "tessellate, expected tol = " << tol << " > 0" )
+    size_t cx = this->X.size()-1;
+    size_t cy = this->Y.size()-1;
+
+    // pieces required by each cell, reduced by column and row
+    vector<integer> mx( cx+1, 1 ), my( cy+1, 1 );
+    mx[0] = my[0] = 0;
+    std::mutex mtx;
+    parallel_chunks( cx, nthreads, [&]( size_t i0, size_t i1 ) {
+      vector<integer> myc( cy, 1 );
+      for ( size_t i = i0; i < i1; ++i ) {
+        integer mxi = 1;
+        for ( size_t j = 0; j < cy; ++j ) {
+          // bounds in the local coordinates, i.e. Mxx hx^2, Mxy hx hy, Myy hy^2
+          real_type B[3];
+          this->patchBound( integer(i), integer(j), B );
+          // the three terms within tol/3 each
+          real_type ex = B[0], exy = 2*B[1], ey = B[2];
+          real_type px = std::ceil( sqrt( ex/(8*tol/3) ) );
+          real_type py = std::ceil( sqrt( ey/(8*tol/3) ) );
+          px = max( px, real_type(1) );
+          py = max( py, real_type(1) );
+          if ( exy/(px*py) > 8*tol/3 ) {
+            real_type f = sqrt( exy/(px*py)/(8*tol/3) );
+            px = std::ceil( px*f );
+            py = std::ceil( py*f );
+          }
+          integer ix = integer( min( px, real_type(1048576) ) );
+          integer iy = integer( min( py, real_type(1048576) ) );
+          mxi    = max( mxi, ix );
+          myc[j] = max( myc[j], iy );
+        }
+        mx[i+1] = mxi;
+      }
+      std::lock_guard<std::mutex> lck(mtx);
+      for ( size_t j = 0; j < cy; ++j ) my[j+1] = max( my[j+1], myc[j] );
+    } );
+
+    size_t nx  = prefixPieces( mx );
+    size_t ny  = prefixPieces( my );
+    size_t nv  = nx*ny;
+    size_t ntt = 2*(nx-1)*(ny-1);
+    SPLINE_ASSERT(
+      nv <= max_count && ntt <= max_count,
+      "tessellate, " << nx << " x " << ny << " mesh exceed the integer range, increase tol"
+    )
+    integer NX = integer(nx);
+    integer NY = integer(ny);
+    nt = integer(ntt);
+    if ( nv > size_t(nvmax) || nt > ntmax ) return integer(nv);
+
+    // the coordinates of the mesh lines
+    vector<real_type> gx( static_cast<size_t>(NX) ), gy( static_cast<size_t>(NY) );
+    for ( size_t i = 0; i < cx; ++i ) {
+      integer m = mx[i+1]-mx[i];
+      for ( integer k = 0; k < m; ++k )
+        gx[size_t(mx[i]+k)] = this->X[i]+((this->X[i+1]-this->X[i])*k)/m;
+    }
+    gx.back() = this->X.back();
+    for ( size_t j = 0; j < cy; ++j ) {
+      integer m = my[j+1]-my[j];
+      for ( integer k = 0; k < m; ++k )
+        gy[size_t(my[j]+k)] = this->Y[j]+((this->Y[j+1]-this->Y[j])*k)/m;
+    }
+    gy.back() = this->Y.back();
+
+    parallel_chunks( size_t(NX), nthreads, [&]( size_t i0, size_t i1 ) {
+      vector<real_type> Z( (i1-i0)*size_t(NY) );
+      this->evalGrid( &gx[i0], integer(i1-i0), &gy.front(), NY, &Z.front(), NY );
+      for ( size_t i = i0; i < i1; ++i ) {
+        for ( size_t j = 0; j < size_t(NY); ++j ) {
+          real_type * v = V + 3*(i*size_t(NY)+j);
+          v[0] = gx[i];
+          v[1] = gy[j];
+          v[2] = Z[(i-i0)*size_t(NY)+j];
+        }
+        if ( i+1 == size_t(NX) ) continue;
+        // two triangles for each rectangle (i,j)-(i+1,j+1)
+        for ( size_t j = 0; j+1 < size_t(NY); ++j ) {
+          integer k00 = integer(i*size_t(NY)+j);
+          integer k10 = k00+NY;
+          integer * tr = T + 6*(i*size_t(NY-1)+j);
+          tr[0] = k00; tr[1] = k10;   tr[2] = k10+1;
+          tr[3] = k00; tr[4] = k10+1; tr[5] = k00+1;
+        }
+      }
+    } );
+    return integer(nv);
+  }
+
+}
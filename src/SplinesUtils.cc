@@ -34,6 +34,7 @@
 \*/
 
 #include "SplinesUtils.hh"
+#include <limits>
 
 //! Various kind of splines
 namespace Splines {
@@ -532,4 +533,122 @@ namespace Splines {
 
   }
 
+  /*
+  //   _        _     _ _
+  //  | |_ _ __(_) __| (_) __ _  __ _
+  //  | __| '__| |/ _` | |/ _` |/ _` |
+  //  | |_| |  | | (_| | | (_| | (_| |
+  //   \__|_|  |_|\__,_|_|\__,_|\__, |
+  //                           |___/
+  */
+
+  void
+  tridiag_factorize(
+    integer   n,
+    real_type L[],
+    real_type D[],
+    real_type U[]
+  ) {
+    for ( integer i = 0; i+1 < n; ++i ) {
+      U[i]   /= D[i];
+      D[i+1] -= L[i+1] * U[i];
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  tridiag_solve(
+    integer         n,
+    real_type const L[],
+    real_type const D[],
+    real_type const U[],
+    real_type       Z[],
+    integer         incZ
+  ) {
+    if ( n <= 0 ) return;
+    Z[0] /= D[0];
+    for ( integer i = 1; i < n; ++i )
+      Z[i*incZ] = ( Z[i*incZ] - L[i] * Z[(i-1)*incZ] ) / D[i];
+    for ( integer i = n-2; i >= 0; --i )
+      Z[i*incZ] -= U[i] * Z[(i+1)*incZ];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  /*\
+   |  Sherman-Morrison: A = T + u v^T with gamma = -D[0],
+   |  u = ( gamma, 0, ..., 0, U[n-1] ), v = ( 1, 0, ..., 0, L[0]/gamma )
+   |  T is the tridiagonal part with D[0] - gamma and
+   |  D[n-1] - L[0]*U[n-1]/gamma on the diagonal.
+   |  Q = T^(-1) u, E[0] = L[0]/gamma, E[1] = 1/(1 + v.Q)
+  \*/
+  void
+  cyclic_tridiag_factorize(
+    integer   n,
+    real_type L[],
+    real_type D[],
+    real_type U[],
+    real_type Q[],
+    real_type E[2]
+  ) {
+    if ( n < 3 ) {
+      // the corners fall on the tridiagonal band
+      if ( n == 1 ) {
+        D[0] += L[0] + U[0];
+      } else if ( n == 2 ) {
+        U[0] += L[0];
+        L[1] += U[1];
+      }
+      L[0] = U[n-1] = 0;
+      tridiag_factorize( n, L, D, U );
+      std::fill( Q, Q+n, 0 );
+      E[0] = E[1] = 0;
+      return;
+    }
+    real_type alpha = L[0];
+    real_type beta  = U[n-1];
+    real_type gamma = -D[0];
+    D[0]   -= gamma;
+    D[n-1] -= alpha*beta/gamma;
+    L[0] = U[n-1] = 0;
+    tridiag_factorize( n, L, D, U );
+    std::fill( Q, Q+n, 0 );
+    Q[0]   = gamma;
+    Q[n-1] = beta;
+    tridiag_solve( n, L, D, U, Q, 1 );
+    E[0] = alpha/gamma;
+    E[1] = 1/( 1 + Q[0] + E[0]*Q[n-1] );
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void
+  cyclic_tridiag_solve(
+    integer         n,
+    real_type const L[],
+    real_type const D[],
+    real_type const U[],
+    real_type const Q[],
+    real_type const E[2],
+    real_type       Z[],
+    integer         incZ
+  ) {
+    tridiag_solve( n, L, D, U, Z, incZ );
+    real_type f = ( Z[0] + E[0]*Z[(n-1)*incZ] ) * E[1];
+    if ( f != 0 )
+      for ( integer i = 0; i < n; ++i ) Z[i*incZ] -= f * Q[i];
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  bool
+  periodic_ends_match( real_type const Y[], integer incY, integer npts ) {
+    if ( npts < 2 ) return true;
+    real_type ymax = 0;
+    for ( integer i = 0; i < npts; ++i ) ymax = std::max( ymax, abs(Y[i*incY]) );
+    real_type const tol = std::sqrt( std::numeric_limits<real_type>::epsilon() );
+    return abs( Y[(npts-1)*incY] - Y[0] ) <= tol * ymax;
+  }
+
 }
@@ -50,6 +50,9 @@ either expressed or implied, of the FreeBSD Project.
 #define SPLINES_UTILS_HH
 
 #include "Splines.hh"
+#include <cstdint>
+#include <exception>
+#include <thread>
 
 //! Various kind of splines
 namespace Splines {
@@ -95,6 +98,230 @@ namespace Splines {
     real_type       imag[3]
   );
 
+  /*
+  //   _     _                          __                            _
+  //  | |__ (_)_ __   __ _ _ __ _   _  / _| ___  _ __ _ __ ___   __ _| |_
+  //  | '_ \| | '_ \ / _` | '__| | | || |_ / _ \| '__| '_ ` _ \ / _` | __|
+  //  | |_) | | | | | (_| | |  | |_| ||  _| (_) | |  | | | | | | (_| | |_
+  //  |_.__/|_|_| |_|\__,_|_|   \__, ||_|  \___/|_|  |_| |_| |_|\__,_|\__|
+  //                           |___/
+  //  helpers for the records of `SplineBinaryFile` (SplinesBinary.cc)
+  */
+
+  static
+  inline
+  size_t
+  binary_pad8( size_t n )
+  { return (n+7) & ~size_t(7); }
+
+  void binary_put_u32( ostream_type & s, std::uint32_t v );
+  void binary_put_reals( ostream_type & s, real_type const * v, size_t n );
+  void binary_put_padding( ostream_type & s, size_t n );
+
+  //! write the record header and the (padded) name
+  void
+  binary_put_header(
+    ostream_type &   s,
+    SplineBinaryKind kind,
+    unsigned         type,
+    unsigned         flags,
+    string const &   name,
+    integer          n1,
+    integer          n2,
+    size_t           payload
+  );
+
+  //! check kind and size of `rec` and return the payload as `real_type`
+  real_type const *
+  binary_payload(
+    SplineBinaryFile::Record const & rec,
+    SplineBinaryKind                 kind,
+    size_t                           nbytes,
+    char const                       where[]
+  );
+
+  //! number of derivatives at the nodes stored for a spline of type `tp`
+  integer
+  binary_node_derivatives( unsigned tp, char const where[] );
+
+  //! `build_view` of the spline `S` of type `tp` on the nodes `X`, `Y`, `D`
+  void
+  binary_build_view(
+    Spline *          S,
+    unsigned          tp,
+    real_type const * X,
+    real_type const * Y,
+    real_type const * D[2],
+    integer           n
+  );
+
+  /*
+  //                          _ _      _
+  //   _ __   __ _ _ __ __ _| | | ___| |
+  //  | '_ \ / _` | '__/ _` | | |/ _ \ |
+  //  | |_) | (_| | | | (_| | | |  __/ |
+  //  | .__/ \__,_|_|  \__,_|_|_|\___|_|
+  //  |_|
+  */
+
+  //! call `fun(k0,k1)` on `nthreads` contiguous chunks of `[0,n)` in parallel
+  /*!
+   | `nthreads <= 0` means all the hardware threads, with one thread (or
+   | `n < 2`) `fun(0,n)` is called directly. An exception thrown by a chunk
+   | is rethrown in the caller after all the chunks are done. If a thread
+   | cannot be started the ones already running are joined before the
+   | `std::system_error` reaches the caller.
+  \*/
+  template <typename FUN>
+  inline
+  void
+  parallel_chunks( size_t n, integer nthreads, FUN const & fun ) {
+    size_t nth = nthreads > 0 ? size_t(nthreads)
+                              : size_t(std::thread::hardware_concurrency());
+    if ( nth > n ) nth = n;
+    if ( nth <= 1 ) { if ( n > 0 ) fun( size_t(0), n ); return; }
+    vector<std::thread>        workers;
+    vector<std::exception_ptr> errors( nth );
+    workers.reserve( nth ); // no reallocation, `emplace_back` cannot throw
+    try {
+      for ( size_t t = 0; t < nth; ++t ) {
+        size_t k0 = (n*t)/nth;
+        size_t k1 = (n*(t+1))/nth;
+        workers.emplace_back( [k0,k1,t,&fun,&errors]() {
+          try { fun( k0, k1 ); }
+          catch (...) { errors[t] = std::current_exception(); }
+        } );
+      }
+    }
+    catch (...) {
+      // a joinable `std::thread` must not be destroyed
+      for ( std::thread & w : workers ) w.join();
+      throw;
+    }
+    for ( std::thread & w : workers ) w.join();
+    for ( std::exception_ptr & e : errors )
+      if ( e ) std::rethrow_exception( e );
+  }
+
+  /*
+  //             _     _
+  //   __ _ _ __(_) __| |
+  //  / _` | '__| |/ _` |
+  // | (_| | |  | | (_| |
+  //  \__, |_|  |_|\__,_|
+  //  |___/
+  //  kernel of `SplineSurf::evalGrid_D`
+  */
+
+  //! `out[a*ldOut+b] = U[a]^T M(ii[a],jj[b]) V[b]` with `K x K` patches
+  /*!
+   | `load(i,j,M)` is called only when the patch changes, and `M*V[b]` is
+   | kept for the following points of the same patch. The sums are done in
+   | the order of `bilinear3`, `bilinear5` so the results are identical.
+  \*/
+  template <int K, typename LOAD>
+  inline
+  void
+  grid_eval_patches(
+    integer   const ii[], real_type const U[], integer nx,
+    integer   const jj[], real_type const V[], integer ny,
+    LOAD    const & load,
+    real_type       out[],
+    integer         ldOut
+  ) {
+    real_type M[K][K], MV[K] = {};
+    for ( integer b = 0; b < ny; ++b ) {
+      real_type const * v  = V + K*b;
+      integer           li = -1;
+      for ( integer a = 0; a < nx; ++a ) {
+        if ( ii[a] != li ) {
+          li = ii[a];
+          load( li, jj[b], M );
+          for ( integer p = 0; p < K; ++p ) {
+            real_type s = M[p][0]*v[0];
+            for ( integer q = 1; q < K; ++q ) s += M[p][q]*v[q];
+            MV[p] = s;
+          }
+        }
+        real_type const * u = U + K*a;
+        real_type res = u[0]*MV[0];
+        for ( integer p = 1; p < K; ++p ) res += u[p]*MV[p];
+        out[a*ldOut+b] = res;
+      }
+    }
+  }
+
+  /*
+  //   _      _
+  //  (_) ___| |_ ___
+  //  | |/ _ \ __/ __|
+  //  | |  __/ |_\__ \
+  // _/ |\___|\__|___/
+  //|__/
+  //  kernel of `SplineSurf::batchEval` for the Hermite patches: `H[d]` is
+  //  the basis of the derivative `d <= deg` along a direction, derivatives
+  //  of higher order are 0. The sums are the ones of `D` and `DD`.
+  */
+
+  typedef void (*HermiteBasis)( real_type t, real_type h, real_type base[] );
+
+  static
+  inline
+  real_type
+  bilinear( real_type const p[4], real_type const M[4][4], real_type const q[4] )
+  { return bilinear3( p, M, q ); }
+
+  static
+  inline
+  real_type
+  bilinear( real_type const p[6], real_type const M[6][6], real_type const q[6] )
+  { return bilinear5( p, M, q ); }
+
+  template <int K, typename LOAD>
+  inline
+  void
+  hermite_jets(
+    integer                   order,
+    HermiteBasis      const   H[],
+    vector<real_type> const & X,
+    vector<real_type> const & Y,
+    LOAD              const & load,
+    size_t                    n,
+    size_t            const   perm[],
+    integer           const   I[],
+    integer           const   J[],
+    real_type         const   tx[],
+    real_type         const   ty[],
+    real_type                 out[]
+  ) {
+    integer const deg    = K-1;
+    integer const nd     = std::min( order, deg );
+    size_t  const stride = size_t(SplineSurf::jetSize(order));
+    real_type M[K][K], u[K][K], v[K][K];
+    integer   li = -1, lj = -1;
+    for ( size_t k = 0; k < n; ++k ) {
+      size_t i = size_t(I[k]);
+      size_t j = size_t(J[k]);
+      if ( I[k] != li || J[k] != lj ) {
+        li = I[k]; lj = J[k];
+        load( li, lj, M );
+      }
+      real_type hx = X[i+1] - X[i];
+      real_type hy = Y[j+1] - Y[j];
+      for ( integer d = 0; d <= nd; ++d ) {
+        H[d]( tx[k], hx, u[d] );
+        H[d]( ty[k], hy, v[d] );
+      }
+      real_type * pJ = out + stride*perm[k];
+      for ( integer o = 0; o <= order; ++o ) {
+        for ( integer a = o; a >= 0; --a ) {
+          integer b = o-a;
+          *pJ++ = a <= deg && b <= deg ? bilinear( u[a], M, v[b] ) : 0;
+        }
+      }
+    }
+  }
+
   /*       _               _    _   _       _   _
   //   ___| |__   ___  ___| | _| \ | | __ _| \ | |
   //  / __| '_ \ / _ \/ __| |/ /  \| |/ _` |  \| |
@@ -108,6 +335,153 @@ namespace Splines {
     integer         DIM
   );
 
+  /*
+  //                             _
+  //    ___ _   _ _ ____   ____ _| |_ _   _ _ __ ___
+  //   / __| | | | '__\ \ / / _` | __| | | | '__/ _ \
+  //  | (__| |_| | |   \ V / (_| | |_| |_| | | |  __/
+  //   \___|\__,_|_|    \_/ \__,_|\__|\__,_|_|  \___|
+  //
+  //  curvature of the planar curve (x(s),y(s)) and its derivatives from
+  //  the jets `jx`, `jy` (`J[k]` = k-th derivative, see `Spline::jet`)
+  */
+
+  static
+  inline
+  real_type
+  curvature_from_jet( real_type const jx[], real_type const jy[] ) {
+    real_type x_1 = jx[1];
+    real_type x_2 = jx[2];
+    real_type y_1 = jy[1];
+    real_type y_2 = jy[2];
+    real_type t6  = x_1 * x_1 + y_1 * y_1;
+    return (x_1 * y_2 - y_1 * x_2) / ( t6 * sqrt(t6) );
+  }
+
+  static
+  inline
+  real_type
+  curvature_D_from_jet( real_type const jx[], real_type const jy[] ) {
+    real_type x_1 = jx[1];
+    real_type x_2 = jx[2];
+    real_type x_3 = jx[3];
+    real_type y_1 = jy[1];
+    real_type y_2 = jy[2];
+    real_type y_3 = jy[3];
+    real_type t1  = x_1 * x_1;
+    real_type t9  = x_2 * x_2;
+    real_type t13 = y_1 * y_1;
+    real_type t17 = y_2 * y_2;
+    real_type t26 = t1 + t13;
+    real_type t27 = t26 * t26;
+    real_type t28 = sqrt(t26);
+    real_type aa  = y_3 * x_1 - y_1 * x_3;
+    real_type bb  = 3 * y_2 * x_2;
+    return ( t1 * ( aa - bb ) + t13 * ( aa + bb )
+             + 3 * x_1 * y_1 * ( t9 - t17 ) ) / ( t28 * t27 );
+  }
+
+  static
+  inline
+  real_type
+  curvature_DD_from_jet( real_type const jx[], real_type const jy[] ) {
+    real_type x_1 = jx[1];
+    real_type x_2 = jx[2];
+    real_type x_3 = jx[3];
+    real_type x_4 = jx[4];
+    real_type y_1 = jy[1];
+    real_type y_2 = jy[2];
+    real_type y_3 = jy[3];
+    real_type y_4 = jy[4];
+
+    real_type t1  = y_1 * y_1;
+    real_type t2  = t1 * t1;
+    real_type t12 = x_2 * x_2;
+    real_type t13 = t12 * x_2;
+    real_type t15 = x_1 * x_3;
+    real_type t16 = 9 * t15;
+    real_type t17 = y_2 * y_2;
+    real_type t21 = x_1 * x_1;
+    real_type t22 = x_4 * t21;
+    real_type t26 = 9 * x_1 * y_2 * y_3;
+    real_type t30 = t21 * x_1;
+    real_type t40 = t17 * y_2;
+    real_type t64 = t21 + t1;
+    real_type t65 = t64 * t64;
+    real_type t67 = sqrt(t64);
+    return (
+      t2 * (x_1 * y_4 + 4 * x_2 * y_3 + 5 * x_3 * y_2 - y_1 * x_4)
+      + t1 * y_1 * (3 * t13 + x_2 * (t16 - 12 * t17) - 2 * t22 - t26)
+      + t1 * ( x_1 * ( 12 * t40 - 33 * y_2 * t12 )
+               + t21 * ( y_2 * x_3 - y_3 * x_2)
+               + 2 * y_4 * t30 )
+      - y_1 * t21 * ( 12 * t13 - x_2 * (t16+33*t17) + t22 + t26 )
+      + t30 * ( y_2 * (12 * t12 - 4 * t15) + y_4 * t21
+                -5 * x_1 * x_2 * y_3 - 3 * t40)
+    ) / (t67*t65*t64);
+  }
+
+  /*
+  //        _                   _
+  //    ___| |__   ___  _ __ __| |___
+  //   / __| '_ \ / _ \| '__/ _` / __|
+  //  | (__| | | | (_) | | | (_| \__ \
+  //   \___|_| |_|\___/|_|  \__,_|___/
+  //
+  //  shared pass of the parametrizations: `d[k] = |P(k+1)-P(k)|` for
+  //  k = 0..npts-2 and, if `dot` is not null, the products of consecutive
+  //  chords `dot[k] = (P(k+1)-P(k)).(P(k)-P(k-1))` for k = 1..npts-2.
+  //  Points are stored by rows (`pnts`, leading dimension `ld_pnts`)
+  //  or by components (`Y[j]` = j-th component of all the points).
+  */
+
+  void
+  chord_pass(
+    integer         dim,
+    integer         npts,
+    real_type const pnts[],
+    integer         ld_pnts,
+    real_type       d[],
+    real_type       dot[]
+  );
+
+  void
+  chord_pass(
+    integer                 dim,
+    integer                 npts,
+    real_type const * const Y[],
+    real_type               d[],
+    real_type               dot[]
+  );
+
+  //! replace `dot[k]` with the turning angle at the point k bounded by pi/2,
+  //! `dot[0]` and `dot[npts-1]` are set to 0
+  void
+  turning_angles(
+    integer         npts,
+    real_type const d[],
+    real_type       dot[]
+  );
+
+  //! segment lengths `len[k]` corrected by the turning angles `th` at the
+  //! two ends (Foley-Nielsen correction with weight `c`), `out` may be `len`
+  void
+  turning_correction(
+    integer         npts,
+    real_type const len[],
+    real_type const th[],
+    real_type       c,
+    real_type       out[]
+  );
+
+  //! knots from the segment lengths, `len` and `t` may be the same vector
+  void
+  knots_from_lengths(
+    integer         npts,
+    real_type const len[],
+    real_type       t[]
+  );
+
   /*
   //    __ _       _ _             _ _  __  __
   //   / _(_)_ __ (_) |_ ___    __| (_)/ _|/ _| ___ _ __ ___ _ __   ___ ___
@@ -317,6 +691,133 @@ namespace Splines {
     integer         npts
   );
 
+  /*
+  //   _        _     _ _
+  //  | |_ _ __(_) __| (_) __ _  __ _
+  //  | __| '__| |/ _` | |/ _` |/ _` |
+  //  | |_| |  | | (_| | | (_| | (_| |
+  //   \__|_|  |_|\__,_|_|\__,_|\__, |
+  //                           |___/
+  //  LU without pivoting of the (diagonally dominant) systems of the
+  //  splines: row i is L[i] z(i-1) + D[i] z(i) + U[i] z(i+1).
+  //  The factorization overwrites D and U and is shared by all the
+  //  right hand sides, `Z` (stride `incZ`) is overwritten by the solution
+  */
+
+  void
+  tridiag_factorize(
+    integer   n,
+    real_type L[],
+    real_type D[],
+    real_type U[]
+  );
+
+  void
+  tridiag_solve(
+    integer         n,
+    real_type const L[],
+    real_type const D[],
+    real_type const U[],
+    real_type       Z[],
+    integer         incZ
+  );
+
+  //! cyclic system, `L[0]` couples the first row with z(n-1) and `U[n-1]`
+  //! the last one with z(0), solved in O(n) with Sherman-Morrison.
+  //! `Q[n]` and `E[2]` store the correction
+  void
+  cyclic_tridiag_factorize(
+    integer   n,
+    real_type L[],
+    real_type D[],
+    real_type U[],
+    real_type Q[],
+    real_type E[2]
+  );
+
+  void
+  cyclic_tridiag_solve(
+    integer         n,
+    real_type const L[],
+    real_type const D[],
+    real_type const U[],
+    real_type const Q[],
+    real_type const E[2],
+    real_type       Z[],
+    integer         incZ
+  );
+
+  /*
+  //  system of the cubic spline for the second derivatives at the nodes
+  //  (SplineCubic.cc), factorized once on the knots `X` and solved for
+  //  each set of values `Y`. `Z` (npts values) is the workspace that
+  //  receives the second derivatives. With the periodic system the last
+  //  point must repeat the first one
+  */
+
+  void
+  CubicSpline_factorize(
+    real_type const      X[],
+    real_type            L[],
+    real_type            D[],
+    real_type            U[],
+    real_type            E[2],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  );
+
+  void
+  CubicSpline_solve(
+    real_type const      X[],
+    real_type const      Y[],
+    integer              incY,
+    real_type            Yp[],
+    integer              incYp,
+    real_type            Z[],
+    integer              incZ,
+    real_type const      L[],
+    real_type const      D[],
+    real_type const      U[],
+    real_type const      E[2],
+    integer              npts,
+    CUBIC_SPLINE_TYPE_BC bc0,
+    CUBIC_SPLINE_TYPE_BC bcn
+  );
+
+  void
+  CubicSpline_factorize_periodic(
+    real_type const X[],
+    real_type       L[],
+    real_type       D[],
+    real_type       U[],
+    real_type       Q[],
+    real_type       E[2],
+    integer         npts
+  );
+
+  void
+  CubicSpline_solve_periodic(
+    real_type const X[],
+    real_type const Y[],
+    integer         incY,
+    real_type       Yp[],
+    integer         incYp,
+    real_type       Z[],
+    integer         incZ,
+    real_type const L[],
+    real_type const D[],
+    real_type const U[],
+    real_type const Q[],
+    real_type const E[2],
+    integer         npts
+  );
+
+  //! true when the last of the `npts` values `Y` (stride `incY`) repeats
+  //! the first one, up to sqrt(epsilon) relative to the largest value
+  bool
+  periodic_ends_match( real_type const Y[], integer incY, integer npts );
+
 }
 
 #endif
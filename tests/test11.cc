@@ -0,0 +1,81 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// compare the sliding window with a spline rebuilt on the last points
+template <typename STYPE>
+real_type
+testWindow( Splines::SplineType1D stype, STYPE & sp ) {
+  integer const capacity = 20;
+  SplineWindow win;
+  win.reserve( capacity, stype );
+  real_type err = 0;
+  for ( integer k = 0; k < 200; ++k ) {
+    real_type x = k*0.1+0.01*sin(real_type(k));
+    win.pushBack( x, sin(x)+0.1*cos(3*x) );
+    if ( win.numPoints() < 2 ) continue;
+    sp.build( win.xNodes(), win.yNodes(), win.numPoints() );
+    for ( integer i = 0; i <= 50; ++i ) {
+      real_type xx = win.xMin() + (win.xMax()-win.xMin())*i/50.0;
+      err = max( err, abs( win(xx)    - sp(xx)    ) );
+      err = max( err, abs( win.D(xx)  - sp.D(xx)  ) );
+      err = max( err, abs( win.DD(xx) - sp.DD(xx) ) );
+    }
+  }
+  win.info(cout);
+  cout << "max error = " << err << '\n';
+  return err;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.11\n\n";
+
+  LinearSpline ls;
+  PchipSpline  pc;
+  AkimaSpline  ak;
+  BesselSpline bs;
+
+  real_type err = 0;
+  err = max( err, testWindow( Splines::LINEAR_TYPE, ls ) );
+  err = max( err, testWindow( Splines::PCHIP_TYPE,  pc ) );
+  err = max( err, testWindow( Splines::AKIMA_TYPE,  ak ) );
+  err = max( err, testWindow( Splines::BESSEL_TYPE, bs ) );
+
+  if ( err > 1e-10 ) {
+    cout << "SplineWindow differs from full rebuild!\n";
+    return 1;
+  }
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <cstdio>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// check that the view spline and the copied spline coincide
+template <typename STYPE>
+real_type
+compare( STYPE const & a, STYPE const & b ) {
+  real_type err = 0;
+  for ( integer i = 0; i <= 200; ++i ) {
+    real_type x = a.xMin() + (a.xMax()-a.xMin())*i/200.0;
+    err = max( err, abs( a(x)    - b(x)    ) );
+    err = max( err, abs( a.D(x)  - b.D(x)  ) );
+    err = max( err, abs( a.DD(x) - b.DD(x) ) );
+  }
+  return err;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.12\n\n";
+
+  integer const n = 1000;
+  vector<real_type> XY(2*n);
+  for ( integer i = 0; i < n; ++i ) {
+    XY[i]   = i*0.01;
+    XY[n+i] = sin(XY[i])+0.1*cos(7*XY[i]);
+  }
+
+  char const fname[] = "test12_data.bin";
+  {
+    ofstream file( fname, ios::binary );
+    file.write( reinterpret_cast<char const*>(&XY.front()), 2*n*sizeof(real_type) );
+  }
+
+  real_type const * data = &XY.front();
+  #ifndef _WIN32
+  // map the table read-only: any write from the spline would crash
+  int fd = open( fname, O_RDONLY );
+  void * ptr = mmap( nullptr, 2*n*sizeof(real_type), PROT_READ, MAP_PRIVATE, fd, 0 );
+  if ( ptr == MAP_FAILED ) { cout << "mmap failed\n"; return 1; }
+  data = static_cast<real_type const*>(ptr);
+  #endif
+
+  real_type err = 0;
+  {
+    PchipSpline v, c;
+    v.build_view( data, data+n, n );
+    c.build( data, data+n, n );
+    v.info(cout);
+    cout << "is_view = " << (v.is_view()?"true":"false") << '\n';
+    err = max( err, compare( v, c ) );
+    try {
+      v.pushBack( 100, 0 );
+      cout << "pushBack on a view must fail\n";
+      err = 1;
+    }
+    catch ( exception const & ) {
+      cout << "pushBack on a view refused, OK\n";
+    }
+  }
+  {
+    CubicSpline v, c;
+    v.build_view( data, data+n, n );
+    c.build( data, data+n, n );
+    err = max( err, compare( v, c ) );
+  }
+  {
+    QuinticSpline v, c;
+    v.build_view( data, data+n, n );
+    c.build( data, data+n, n );
+    err = max( err, compare( v, c ) );
+  }
+  {
+    LinearSpline v, c;
+    v.build_view( data, data+n, n );
+    c.build( data, data+n, n );
+    err = max( err, compare( v, c ) );
+    // rebuilding a view allocates its own storage again
+    v.build( data, data+n, n );
+    cout << "after build is_view = " << (v.is_view()?"true":"false") << '\n';
+  }
+
+  // nodes interleaved as x0 y0 x1 y1 ... need strides, they are copied
+  vector<real_type> IXY(2*n);
+  for ( integer i = 0; i < n; ++i ) {
+    IXY[2*i]   = data[i];
+    IXY[2*i+1] = data[n+i];
+  }
+  {
+    CubicSpline v, s, c;
+    v.build_view( data, 1, data+n, 1, n );
+    s.build_view( &IXY[0], 2, &IXY[1], 2, n );
+    c.build( data, data+n, n );
+    cout << "strided is_view = " << (s.is_view()?"true":"false")
+         << ", unit strides is_view = " << (v.is_view()?"true":"false") << '\n';
+    if ( s.is_view() || !v.is_view() ) err = 1;
+    err = max( err, compare( v, c ) );
+    err = max( err, compare( s, c ) );
+  }
+  {
+    // derivatives interleaved with the values
+    QuinticSpline c, s;
+    c.build( data, data+n, n );
+    vector<real_type> D(2*n);
+    for ( integer i = 0; i < n; ++i ) {
+      D[2*i]   = c.ypNode(i);
+      D[2*i+1] = c.yppNode(i);
+    }
+    s.build_view( &IXY[0], 2, &IXY[1], 2, n, &D[0], 2, &D[1], 2 );
+    err = max( err, compare( s, c ) );
+  }
+  {
+    LinearSpline s, c;
+    s.build_view( &IXY[0], 2, &IXY[1], 2, n );
+    c.build( data, data+n, n );
+    err = max( err, compare( s, c ) );
+  }
+  {
+    ConstantSpline s, c;
+    s.build_view( &IXY[0], 2, &IXY[1], 2, n );
+    c.build( data, data+n, n );
+    err = max( err, compare( s, c ) );
+  }
+
+  #ifndef _WIN32
+  munmap( ptr, 2*n*sizeof(real_type) );
+  close( fd );
+  #endif
+  remove( fname );
+
+  cout << "max error = " << err << '\n';
+  if ( err > 0 ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
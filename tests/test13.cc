@@ -0,0 +1,227 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static
+real_type
+fun( real_type x )
+{ return sin(x)+0.1*cos(7*x); }
+
+static
+real_type
+fun2( real_type x, real_type y )
+{ return sin(x)*cos(y)+0.1*x*y; }
+
+int
+main() {
+
+  cout << "\n\nTEST N.13\n\n";
+
+  integer const n = 200;
+  vector<real_type> X(n), Y(n), Y2(n), Yp(n);
+  for ( integer i = 0; i < n; ++i ) {
+    X[i]  = i*0.05;
+    Y[i]  = fun(X[i]);
+    Y2[i] = X[i]*X[i];
+    Yp[i] = cos(X[i])-0.7*sin(7*X[i]);
+  }
+
+  // surface on a 30 x 20 grid
+  integer const nx = 30, ny = 20;
+  vector<real_type> SX(nx), SY(ny), SZ(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) SX[i] = i*0.1;
+  for ( integer j = 0; j < ny; ++j ) SY[j] = j*0.15;
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      SZ[i*ny+j] = fun2(SX[i],SY[j]);
+
+  // build the objects
+  Spline1D s1("pchip"), s2("quintic"), s3("linear");
+  s1.build( Splines::PCHIP_TYPE,   X, Y );
+  s2.build( Splines::QUINTIC_TYPE, X, Y );
+  s3.build( Splines::LINEAR_TYPE,  X, Y );
+
+  Splines::HermiteSpline hs("hermite");
+  hs.build( &X.front(), &Y.front(), &Yp.front(), n );
+
+  char const * headers[] = { "akima", "constant", "cubic", "quintic" };
+  Splines::SplineType1D stype[] = {
+    Splines::AKIMA_TYPE, Splines::CONSTANT_TYPE,
+    Splines::CUBIC_TYPE, Splines::QUINTIC_TYPE
+  };
+  real_type const * YY[] = { &Y.front(), &Y.front(), &Y2.front(), &Y.front() };
+  SplineSet ss("set");
+  ss.build( 4, n, headers, stype, &X.front(), YY );
+
+  real_type const * VV[] = { &Y.front(), &Y2.front() };
+  SplineVec sv("vec");
+  sv.setup( 2, n, VV );
+  sv.setKnotsChordLength();
+  sv.CatmullRom();
+
+  BilinearSpline  b1("bilinear");
+  BiCubicSpline   b2("bicubic");
+  BiQuinticSpline b3("biquintic");
+  Akima2Dspline   b4("akima2d");
+  b1.build( SX, SY, SZ );
+  b2.build( SX, SY, SZ );
+  b3.build( SX, SY, SZ );
+  b4.build( SX, SY, SZ );
+
+  char const fname[] = "test13_data.bin";
+  {
+    ofstream file( fname, ios::binary );
+    s1.writeBinary( file );
+    s2.writeBinary( file );
+    s3.writeBinary( file );
+    hs.writeBinary( file );
+    ss.writeBinary( file );
+    sv.writeBinary( file );
+    b1.writeBinary( file );
+    b2.writeBinary( file );
+    b3.writeBinary( file );
+    b4.writeBinary( file );
+  }
+
+  real_type err = 0;
+  {
+    SplineBinaryFile f( fname );
+    cout << "records in " << f.name() << " = " << f.numRecords() << '\n';
+    for ( integer r = 0; r < f.numRecords(); ++r )
+      cout << "  " << f.record(r).name << " kind = " << f.record(r).kind
+           << " type = " << f.record(r).type << '\n';
+
+    Spline1D l1("l1"), l2("l2"), l3("l3"), l4("l4");
+    l1.load_view( f, f.find("pchip") );
+    l2.load_view( f, f.find("quintic") );
+    l3.load_view( f, f.find("linear") );
+    l4.load_view( f, f.find("hermite") );
+
+    SplineSet ls;
+    ls.load_view( f, f.find("set") );
+
+    SplineVec lv;
+    lv.load_view( f, f.find("vec") );
+
+    BilinearSpline  lb1;
+    BiCubicSpline   lb2;
+    BiQuinticSpline lb3;
+    Akima2Dspline   lb4;
+    lb1.loadBinary( f, f.find("bilinear") );
+    lb2.loadBinary( f, f.find("bicubic") );
+    lb3.loadBinary( f, f.find("biquintic") );
+    lb4.loadBinary( f, f.find("akima2d") );
+
+    for ( integer i = 0; i <= 500; ++i ) {
+      real_type x = X.front() + (X.back()-X.front())*i/500.0;
+      err = max( err, abs( l1(x)    - s1(x)    ) );
+      err = max( err, abs( l1.D(x)  - s1.D(x)  ) );
+      err = max( err, abs( l2(x)    - s2(x)    ) );
+      err = max( err, abs( l2.DD(x) - s2.DD(x) ) );
+      err = max( err, abs( l3(x)    - s3(x)    ) );
+      err = max( err, abs( l4(x)    - hs(x)    ) );
+      err = max( err, abs( l4.D(x)  - hs.D(x)  ) );
+      for ( integer k = 0; k < ss.numSplines(); ++k ) {
+        err = max( err, abs( ls(x,k)   - ss(x,k)   ) );
+        err = max( err, abs( ls.D(x,k) - ss.D(x,k) ) );
+      }
+      real_type t = i/500.0;
+      err = max( err, abs( lv(t,0) - sv(t,0) ) );
+      err = max( err, abs( lv.D(t,1) - sv.D(t,1) ) );
+    }
+    for ( integer k = 0; k < ss.numSplines(); ++k ) {
+      if ( ls.header(k) != ss.header(k) ||
+           ls.isMonotone(k) != ss.isMonotone(k) ) err = 1;
+      err = max( err, abs( ls.yMin(k) - ss.yMin(k) ) );
+      err = max( err, abs( ls.yMax(k) - ss.yMax(k) ) );
+    }
+    if ( ls.getPosition("cubic") != 2 ) err = 1;
+    cout << "1D, set and vec error = " << err << '\n';
+
+    for ( integer i = 0; i <= 50; ++i ) {
+      for ( integer j = 0; j <= 50; ++j ) {
+        real_type x = SX.front() + (SX.back()-SX.front())*i/50.0;
+        real_type y = SY.front() + (SY.back()-SY.front())*j/50.0;
+        err = max( err, abs( lb1(x,y)     - b1(x,y)     ) );
+        err = max( err, abs( lb2(x,y)     - b2(x,y)     ) );
+        err = max( err, abs( lb2.Dxy(x,y) - b2.Dxy(x,y) ) );
+        err = max( err, abs( lb3(x,y)     - b3(x,y)     ) );
+        err = max( err, abs( lb3.Dyy(x,y) - b3.Dyy(x,y) ) );
+        err = max( err, abs( lb4(x,y)     - b4(x,y)     ) );
+      }
+    }
+    cout << "surfaces error = " << err << '\n';
+
+    // the loaded nodes are in the read only mapping
+    try {
+      lv.setKnotsCentripetal();
+      cout << "setKnotsCentripetal on a view must fail\n";
+      err = 1;
+    }
+    catch ( exception const & ) {
+      cout << "setKnotsCentripetal on a view refused, OK\n";
+    }
+
+    // loading a record of another type must fail
+    try {
+      lb2.loadBinary( f, f.find("biquintic") );
+      cout << "loading a biquintic in a bicubic must fail\n";
+      err = 1;
+    }
+    catch ( exception const & ) {
+      cout << "loading a biquintic in a bicubic refused, OK\n";
+    }
+  }
+
+  // a corrupted file is refused when opened
+  {
+    ofstream file( fname, ios::binary );
+    s1.writeBinary( file );
+    file.write( "SPLX", 4 );
+  }
+  try {
+    SplineBinaryFile f( fname );
+    cout << "corrupted file must be refused\n";
+    err = 1;
+  }
+  catch ( exception const & ) {
+    cout << "corrupted file refused, OK\n";
+  }
+  remove( fname );
+
+  cout << "max error = " << err << '\n';
+  if ( err > 0 ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
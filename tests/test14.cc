@@ -0,0 +1,117 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <random>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// random access evaluation: value and second derivatives at `npts` points
+template <typename SURF>
+real_type
+evaluate(
+  SURF              const & S,
+  vector<real_type> const & px,
+  vector<real_type> const & py,
+  vector<real_type>       & res,
+  double                  & ms
+) {
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  real_type dd[6];
+  for ( size_t k = 0; k < px.size(); ++k ) {
+    S.DD( px[k], py[k], dd );
+    res[k] = dd[0]+dd[1]+dd[2]+dd[3]+dd[4]+dd[5];
+  }
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  ms = chrono::duration<double,milli>(t1-t0).count();
+  real_type acc = 0;
+  for ( size_t k = 0; k < res.size(); ++k ) acc += res[k];
+  return acc;
+}
+
+template <typename SURF>
+bool
+bench(
+  char        const         what[],
+  integer                   n,
+  vector<real_type> const & px,
+  vector<real_type> const & py
+) {
+  vector<real_type> X(n), Y(n), Z(n*n);
+  for ( integer i = 0; i < n; ++i ) X[i] = Y[i] = i/real_type(n-1);
+  for ( integer i = 0; i < n; ++i )
+    for ( integer j = 0; j < n; ++j )
+      Z[i*n+j] = sin(13*X[i])*cos(7*Y[j])+X[i]*Y[j];
+
+  SURF S;
+  S.build( X, Y, Z );
+
+  vector<real_type> r0(px.size()), r1(px.size());
+  double ms0, ms1;
+  evaluate( S, px, py, r0, ms0 );
+  S.usePatchLayout();
+  evaluate( S, px, py, r1, ms1 );
+
+  bool ok = S.patchLayout();
+  for ( size_t k = 0; k < r0.size(); ++k ) ok = ok && r0[k] == r1[k];
+
+  cout << what << " " << n << " x " << n << ", " << px.size()
+       << " random DD evaluations\n"
+       << "  node arrays:  " << ms0 << " ms\n"
+       << "  patch layout: " << ms1 << " ms\n"
+       << "  results " << (ok ? "identical" : "DIFFERENT") << '\n';
+
+  // a rebuild refresh the table
+  S.build( X, Y, Z );
+  evaluate( S, px, py, r1, ms1 );
+  for ( size_t k = 0; k < r0.size(); ++k ) ok = ok && r0[k] == r1[k];
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.14\n\n";
+
+  integer const n    = 2000;
+  size_t  const npts = 1000000;
+  vector<real_type> px(npts), py(npts);
+  mt19937 gen(12345);
+  uniform_real_distribution<real_type> U(0,1);
+  for ( size_t k = 0; k < npts; ++k ) { px[k] = U(gen); py[k] = U(gen); }
+
+  bool ok = bench<BiCubicSpline>( "BiCubic", n, px, py );
+  ok = ok && bench<Akima2Dspline>( "Akima2D", n, px, py );
+  ok = ok && bench<BiQuinticSpline>( "BiQuintic", n, px, py );
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
@@ -0,0 +1,169 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// pointwise derivative of order dx,dy
+template <typename SURF>
+real_type
+pointwise( SURF const & S, integer dx, integer dy, real_type x, real_type y ) {
+  switch ( 3*dx+dy ) {
+  case 0: return S(x,y);
+  case 1: return S.Dy(x,y);
+  case 2: return S.Dyy(x,y);
+  case 3: return S.Dx(x,y);
+  case 4: return S.Dxy(x,y);
+  case 6: return S.Dxx(x,y);
+  }
+  return 0;
+}
+
+// compare grid and scanline evaluation with the pointwise one
+template <typename SURF>
+real_type
+check(
+  SURF              const & S,
+  vector<real_type> const & xs,
+  vector<real_type> const & ys
+) {
+  integer nx = integer(xs.size());
+  integer ny = integer(ys.size());
+  integer ld = ny+3;
+  vector<real_type> G(nx*ld), L(nx);
+  real_type err = 0;
+  for ( integer dx = 0; dx <= 2; ++dx ) {
+    for ( integer dy = 0; dx+dy <= 2; ++dy ) {
+      S.evalGrid_D( dx, dy, &xs.front(), nx, &ys.front(), ny, &G.front(), ld );
+      for ( integer i = 0; i < nx; ++i ) {
+        for ( integer j = 0; j < ny; ++j ) {
+          real_type p = pointwise( S, dx, dy, xs[i], ys[j] );
+          err = max( err, abs(G[i*ld+j]-p)/(1+abs(p)) );
+        }
+      }
+      S.evalScanline_D( dx, dy, ys[ny/2], &xs.front(), nx, &L.front() );
+      for ( integer i = 0; i < nx; ++i )
+        err = max( err, abs(L[i]-G[i*ld+ny/2])/(1+abs(L[i])) );
+    }
+  }
+  return err;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.15\n\n";
+
+  // non uniform nodes
+  integer const nx = 23, ny = 17;
+  vector<real_type> X(nx), Y(ny), Z(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) X[i] = i+0.3*sin(real_type(i));
+  for ( integer j = 0; j < ny; ++j ) Y[j] = 2*j+0.5*cos(real_type(j));
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      Z[i*ny+j] = sin(X[i]/3)*cos(Y[j]/5)+X[i]*Y[j]/100;
+
+  // sorted points, slightly outside the domain at both ends
+  vector<real_type> xs(97), ys(61);
+  for ( size_t i = 0; i < xs.size(); ++i )
+    xs[i] = X.front()-0.2 + (X.back()-X.front()+0.4)*i/(xs.size()-1.0);
+  for ( size_t j = 0; j < ys.size(); ++j )
+    ys[j] = Y.front()-0.2 + (Y.back()-Y.front()+0.4)*j/(ys.size()-1.0);
+
+  cout << "TEST 15.1 grid and scanline vs pointwise\n";
+  real_type const tol = 1e-12;
+  bool ok = true;
+  {
+    BilinearSpline S; S.build( X, Y, Z );
+    real_type e = check( S, xs, ys ); ok = ok && e < tol;
+    cout << "Bilinear   err = " << e << '\n';
+  }
+  {
+    BiCubicSpline S; S.build( X, Y, Z );
+    real_type e = check( S, xs, ys ); ok = ok && e < tol;
+    cout << "BiCubic    err = " << e << '\n';
+    S.usePatchLayout();
+    e = check( S, xs, ys ); ok = ok && e < tol;
+    cout << "BiCubic    err = " << e << " (patch layout)\n";
+  }
+  {
+    Akima2Dspline S; S.build( X, Y, Z );
+    real_type e = check( S, xs, ys ); ok = ok && e < tol;
+    cout << "Akima2D    err = " << e << '\n';
+  }
+  {
+    BiQuinticSpline S; S.build( X, Y, Z );
+    real_type e = check( S, xs, ys ); ok = ok && e < tol;
+    cout << "BiQuintic  err = " << e << '\n';
+  }
+
+  cout << "TEST 15.2 Spline2D\n";
+  Splines::SplineType2D const tps[] = {
+    Splines::BILINEAR_TYPE, Splines::BICUBIC_TYPE,
+    Splines::BIQUINTIC_TYPE, Splines::AKIMA2D_TYPE
+  };
+  for ( Splines::SplineType2D tp : tps ) {
+    Spline2D S;
+    S.build( tp, X, Y, Z );
+    real_type e = check( S, xs, ys ); ok = ok && e < tol;
+    cout << S.type_name() << " err = " << e << '\n';
+  }
+
+  cout << "TEST 15.3 timing, 1000 x 1000 grid\n";
+  {
+    integer const n = 200, m = 1000;
+    vector<real_type> XX(n), YY(n), ZZ(n*n), gx(m), gy(m), G(m*m), P(m*m);
+    for ( integer i = 0; i < n; ++i ) XX[i] = YY[i] = i;
+    for ( integer i = 0; i < n; ++i )
+      for ( integer j = 0; j < n; ++j )
+        ZZ[i*n+j] = sin(XX[i]/7)*cos(YY[j]/11);
+    for ( integer i = 0; i < m; ++i ) gx[i] = gy[i] = (n-1)*i/(m-1.0);
+
+    BiCubicSpline S; S.build( XX, YY, ZZ );
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for ( integer i = 0; i < m; ++i )
+      for ( integer j = 0; j < m; ++j )
+        P[i*m+j] = S( gx[i], gy[j] );
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    S.evalGrid( &gx.front(), m, &gy.front(), m, &G.front(), m );
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    real_type e = 0;
+    for ( integer k = 0; k < m*m; ++k ) e = max( e, abs(G[k]-P[k]) );
+    ok = ok && e < tol;
+    cout << "  pointwise: " << chrono::duration<double,milli>(t1-t0).count() << " ms\n"
+         << "  evalGrid:  " << chrono::duration<double,milli>(t2-t1).count() << " ms\n"
+         << "  err = " << e << '\n';
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
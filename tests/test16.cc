@@ -0,0 +1,166 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <random>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static
+double
+elapsed( chrono::steady_clock::time_point t0 ) {
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  return chrono::duration<double,milli>(t1-t0).count();
+}
+
+// batch results must be identical to the pointwise calls
+template <typename SURF>
+bool
+check(
+  SURF              const & S,
+  vector<real_type> const & px,
+  vector<real_type> const & py
+) {
+  size_t n = px.size();
+  vector<real_type> z(n), d(3*n), dd(6*n);
+  bool ok = true;
+  for ( integer nth = 1; nth <= 3; nth += 2 ) {
+    for ( int sort = 0; sort < 2; ++sort ) {
+      S.eval( &px.front(), &py.front(), &z.front(), n, sort == 1, nth );
+      S.eval_D( &px.front(), &py.front(), &d.front(), n, sort == 1, nth );
+      S.eval_DD( &px.front(), &py.front(), &dd.front(), n, sort == 1, nth );
+      for ( size_t k = 0; k < n; ++k ) {
+        real_type D1[3], D2[6];
+        S.D( px[k], py[k], D1 );
+        S.DD( px[k], py[k], D2 );
+        ok = ok && z[k] == S( px[k], py[k] );
+        for ( size_t l = 0; l < 3; ++l ) ok = ok && d[3*k+l] == D1[l];
+        for ( size_t l = 0; l < 6; ++l ) ok = ok && dd[6*k+l] == D2[l];
+      }
+    }
+  }
+  return ok;
+}
+
+template <typename SURF>
+bool
+bench(
+  char        const         what[],
+  integer                   n,
+  vector<real_type> const & px,
+  vector<real_type> const & py
+) {
+  vector<real_type> X(n), Y(n), Z(n*n);
+  for ( integer i = 0; i < n; ++i ) X[i] = Y[i] = i/real_type(n-1);
+  for ( integer i = 0; i < n; ++i )
+    for ( integer j = 0; j < n; ++j )
+      Z[i*n+j] = sin(13*X[i])*cos(7*Y[j])+X[i]*Y[j];
+
+  SURF S;
+  S.build( X, Y, Z );
+
+  size_t npts = px.size();
+  vector<real_type> r0(npts), r1(npts), r2(npts), r3(npts);
+
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for ( size_t k = 0; k < npts; ++k ) r0[k] = S( px[k], py[k] );
+  double ms0 = elapsed( t0 );
+
+  t0 = chrono::steady_clock::now();
+  S.eval( &px.front(), &py.front(), &r1.front(), npts, false );
+  double ms1 = elapsed( t0 );
+
+  t0 = chrono::steady_clock::now();
+  S.eval( &px.front(), &py.front(), &r2.front(), npts, true );
+  double ms2 = elapsed( t0 );
+
+  t0 = chrono::steady_clock::now();
+  S.eval( &px.front(), &py.front(), &r3.front(), npts, true, 0 );
+  double ms3 = elapsed( t0 );
+
+  bool ok = r0 == r1 && r0 == r2 && r0 == r3;
+  cout << what << " " << n << " x " << n << ", " << npts
+       << " scattered evaluations\n"
+       << "  pointwise:           " << ms0 << " ms\n"
+       << "  batch:               " << ms1 << " ms\n"
+       << "  batch, tile sorted:  " << ms2 << " ms\n"
+       << "  batch, all threads:  " << ms3 << " ms\n"
+       << "  results " << (ok ? "identical" : "DIFFERENT") << '\n';
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.16\n\n";
+
+  mt19937 gen(12345);
+  uniform_real_distribution<real_type> U(-0.05,1.05);
+
+  cout << "TEST 16.1 batch vs pointwise\n";
+  {
+    integer const nx = 31, ny = 27;
+    vector<real_type> X(nx), Y(ny), Z(nx*ny), px(5000), py(5000);
+    for ( integer i = 0; i < nx; ++i ) X[i] = (i+0.3*sin(real_type(i)))/nx;
+    for ( integer j = 0; j < ny; ++j ) Y[j] = (j+0.4*cos(real_type(j)))/ny;
+    for ( integer i = 0; i < nx; ++i )
+      for ( integer j = 0; j < ny; ++j )
+        Z[i*ny+j] = sin(3*X[i])*cos(5*Y[j]);
+    for ( size_t k = 0; k < px.size(); ++k ) { px[k] = U(gen); py[k] = U(gen); }
+
+    BilinearSpline  S1; S1.build( X, Y, Z );
+    BiCubicSpline   S2; S2.build( X, Y, Z );
+    Akima2Dspline   S3; S3.build( X, Y, Z );
+    BiQuinticSpline S4; S4.build( X, Y, Z );
+    bool ok = check( S1, px, py ) && check( S2, px, py ) &&
+              check( S3, px, py ) && check( S4, px, py );
+    // the interval hints follow the nodes: moved, then rebuilt on
+    // nodes with a different range
+    BiCubicSpline S5( std::move(S2) );
+    vector<real_type> X2(nx);
+    for ( integer i = 0; i < nx; ++i ) X2[i] = 0.5*X[i]+0.2;
+    S2.build( X2, Y, Z );
+    ok = ok && check( S5, px, py ) && check( S2, px, py );
+    cout << "  results " << (ok ? "identical" : "DIFFERENT") << '\n';
+    if ( !ok ) return 1;
+  }
+
+  cout << "TEST 16.2 timing\n";
+  size_t const npts = 1000000;
+  vector<real_type> px(npts), py(npts);
+  for ( size_t k = 0; k < npts; ++k ) { px[k] = U(gen); py[k] = U(gen); }
+
+  bool ok = bench<BiCubicSpline>( "BiCubic", 2000, px, py );
+  ok = ok && bench<Akima2Dspline>( "Akima2D", 2000, px, py );
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
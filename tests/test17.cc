@@ -0,0 +1,160 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <random>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// position of d^(a+b)f/dx^a dy^b in a jet
+static
+integer
+ipos( integer a, integer b )
+{ return Splines::SplineSurf::jetSize(a+b-1) + b; }
+
+template <typename SURF>
+bool
+check( char const what[], SURF const & S, integer deg, integer order ) {
+  mt19937 gen(123);
+  uniform_real_distribution<real_type> U(0.05,0.95);
+  integer const nj = SURF::jetSize(order);
+  real_type const h = 1e-5;
+  real_type err_dd = 0, err_fd = 0, err_zero = 0;
+  size_t const npts = 200;
+  vector<real_type> px(npts), py(npts), JB(npts*nj);
+  vector<real_type> J(nj), Jp(nj), Jm(nj), Jq(nj), Jr(nj);
+  for ( size_t k = 0; k < npts; ++k ) {
+    // inside a patch, far from the nodes (nodes are integers)
+    real_type x = px[k] = floor(20*U(gen)) + U(gen);
+    real_type y = py[k] = floor(20*U(gen)) + U(gen);
+    S.jet( x, y, order, &J.front() );
+    real_type dd[6];
+    S.DD( x, y, dd );
+    for ( integer l = 0; l < 6; ++l ) err_dd = max( err_dd, abs(dd[l]-J[l]) );
+    // highest order terms by central differences of the lower jet
+    S.jet( x+h, y, order, &Jp.front() );
+    S.jet( x-h, y, order, &Jm.front() );
+    S.jet( x, y+h, order, &Jq.front() );
+    S.jet( x, y-h, order, &Jr.front() );
+    for ( integer a = order; a >= 0; --a ) {
+      integer b = order-a;
+      real_type d = J[ipos(a,b)], fd;
+      if ( a > 0 ) fd = (Jp[ipos(a-1,b)]-Jm[ipos(a-1,b)])/(2*h);
+      else         fd = (Jq[ipos(a,b-1)]-Jr[ipos(a,b-1)])/(2*h);
+      err_fd = max( err_fd, abs(d-fd)/(1+abs(d)) );
+      if ( a > deg || b > deg ) err_zero = max( err_zero, abs(d) );
+    }
+  }
+  S.jet( &px.front(), &py.front(), order, &JB.front(), npts );
+  bool same = true;
+  for ( size_t k = 0; k < npts; ++k ) {
+    S.jet( px[k], py[k], order, &J.front() );
+    for ( integer l = 0; l < nj; ++l ) same = same && JB[k*nj+l] == J[l];
+  }
+  bool ok = err_dd == 0 && err_fd < 1e-4 && err_zero == 0 && same;
+  cout << what << " order " << order
+       << " |jet-DD| = " << err_dd
+       << " fd err = " << err_fd
+       << " batch " << (same ? "identical" : "DIFFERENT")
+       << (ok ? "" : "  <-- FAILED") << '\n';
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.17\n\n";
+
+  integer const n = 21;
+  vector<real_type> X(n), Y(n), Z(n*n);
+  for ( integer i = 0; i < n; ++i ) X[i] = Y[i] = i;
+  for ( integer i = 0; i < n; ++i )
+    for ( integer j = 0; j < n; ++j )
+      Z[i*n+j] = sin(X[i]/3)*cos(Y[j]/4)+X[i]*Y[j]/50;
+
+  BiCubicSpline   S3; S3.build( X, Y, Z );
+  Akima2Dspline   SA; SA.build( X, Y, Z );
+  BiQuinticSpline S5; S5.build( X, Y, Z );
+
+  cout << "TEST 17.1 jets vs DD and finite differences\n";
+  bool ok = true;
+  for ( integer order = 2; order <= 4; ++order ) {
+    ok = check( "BiCubic  ", S3, 3, order ) && ok;
+    ok = check( "Akima2D  ", SA, 3, order ) && ok;
+  }
+  for ( integer order = 2; order <= 6; ++order )
+    ok = check( "BiQuintic", S5, 5, order ) && ok;
+
+  cout << "TEST 17.2 Spline2D and bilinear\n";
+  {
+    Spline2D S; S.build( Splines::BILINEAR_TYPE, X, Y, Z );
+    real_type J[10], d[3];
+    S.jet( 3.3, 4.7, 3, J );
+    S.D( 3.3, 4.7, d );
+    bool ok1 = J[0] == d[0] && J[1] == d[1] && J[2] == d[2];
+    for ( integer l = 3; l < 10; ++l ) ok1 = ok1 && J[l] == 0;
+    cout << "bilinear jet " << (ok1 ? "ok" : "FAILED") << '\n';
+    ok = ok && ok1;
+  }
+
+  cout << "TEST 17.3 timing, value+gradient+Hessian at 1M points\n";
+  {
+    size_t const npts = 1000000;
+    mt19937 gen(7);
+    uniform_real_distribution<real_type> U(0,20);
+    vector<real_type> px(npts), py(npts), J(6*npts);
+    for ( size_t k = 0; k < npts; ++k ) { px[k] = U(gen); py[k] = U(gen); }
+    real_type acc0 = 0, acc1 = 0, acc2 = 0;
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for ( size_t k = 0; k < npts; ++k )
+      acc0 += S5(px[k],py[k]) + S5.Dx(px[k],py[k]) + S5.Dy(px[k],py[k]) +
+              S5.Dxx(px[k],py[k]) + S5.Dxy(px[k],py[k]) + S5.Dyy(px[k],py[k]);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    real_type jj[6];
+    for ( size_t k = 0; k < npts; ++k ) {
+      S5.jet( px[k], py[k], 2, jj );
+      acc1 += jj[0]+jj[1]+jj[2]+jj[3]+jj[4]+jj[5];
+    }
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    S5.jet( &px.front(), &py.front(), 2, &J.front(), npts );
+    for ( size_t k = 0; k < 6*npts; ++k ) acc2 += J[k];
+    chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+    cout << "BiQuintic\n"
+         << "  6 separate calls: " << chrono::duration<double,milli>(t1-t0).count() << " ms\n"
+         << "  jet:              " << chrono::duration<double,milli>(t2-t1).count() << " ms\n"
+         << "  batch jet:        " << chrono::duration<double,milli>(t3-t2).count() << " ms\n";
+    ok = ok && abs(acc0-acc1) <= 1e-8*abs(acc0) && abs(acc1-acc2) <= 1e-8*abs(acc1);
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
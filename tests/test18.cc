@@ -0,0 +1,130 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <random>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// build with `nth` threads, return the build time and the jets at `px`,`py`
+template <typename SURF>
+double
+build(
+  integer                   nth,
+  vector<real_type> const & X,
+  vector<real_type> const & Y,
+  vector<real_type> const & Z,
+  vector<real_type> const & px,
+  vector<real_type> const & py,
+  vector<real_type>       & jets
+) {
+  SURF S;
+  S.setBuildThreads( nth );
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  S.build( X, Y, Z );
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  jets.resize( px.size()*size_t(SURF::jetSize(4)) );
+  S.jet( &px.front(), &py.front(), 4, &jets.front(), px.size() );
+  return chrono::duration<double,milli>(t1-t0).count();
+}
+
+template <typename SURF>
+bool
+check(
+  char const                what[],
+  vector<real_type> const & X,
+  vector<real_type> const & Y,
+  vector<real_type> const & Z,
+  vector<real_type> const & px,
+  vector<real_type> const & py
+) {
+  vector<real_type> J1, Jn;
+  double ms1 = build<SURF>( 1, X, Y, Z, px, py, J1 );
+  cout << what << " " << X.size() << " x " << Y.size()
+       << "\n  1 thread:  " << ms1 << " ms\n";
+  bool ok = true;
+  integer const nths[] = { 2, 3, 7, 0 };
+  for ( integer nth : nths ) {
+    double ms = build<SURF>( nth, X, Y, Z, px, py, Jn );
+    bool same = J1 == Jn;
+    cout << "  " << nth << " threads: " << ms << " ms, "
+         << (same ? "identical" : "DIFFERENT") << '\n';
+    ok = ok && same;
+  }
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.18\n\n";
+
+  integer const nx = 600, ny = 500;
+  vector<real_type> X(nx), Y(ny), Z(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) X[i] = i+0.3*sin(real_type(i));
+  for ( integer j = 0; j < ny; ++j ) Y[j] = j+0.4*cos(real_type(j));
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      Z[i*ny+j] = sin(X[i]/17)*cos(Y[j]/13)+(i*j%7)/10.0;
+
+  mt19937 gen(31);
+  uniform_real_distribution<real_type> U(0,1);
+  vector<real_type> px(20000), py(20000);
+  for ( size_t k = 0; k < px.size(); ++k ) {
+    px[k] = X.front() + (X.back()-X.front())*U(gen);
+    py[k] = Y.front() + (Y.back()-Y.front())*U(gen);
+  }
+
+  cout << "TEST 18.1 parallel build is bitwise identical to the serial one\n";
+  bool ok = check<BiCubicSpline>( "BiCubic", X, Y, Z, px, py );
+  ok = check<Akima2Dspline>( "Akima2D", X, Y, Z, px, py ) && ok;
+  ok = check<BiQuinticSpline>( "BiQuintic", X, Y, Z, px, py ) && ok;
+
+  cout << "TEST 18.2 Spline2D\n";
+  {
+    Spline2D S1, S4;
+    S4.setBuildThreads( 4 );
+    S1.build( Splines::BIQUINTIC_TYPE, X, Y, Z );
+    S4.build( Splines::BIQUINTIC_TYPE, X, Y, Z );
+    bool same = true;
+    for ( size_t k = 0; k < px.size(); ++k ) {
+      real_type J1[15], J4[15];
+      S1.jet( px[k], py[k], 4, J1 );
+      S4.jet( px[k], py[k], 4, J4 );
+      for ( integer l = 0; l < 15; ++l ) same = same && J1[l] == J4[l];
+    }
+    cout << "  " << (same ? "identical" : "DIFFERENT") << '\n';
+    ok = ok && same;
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static real_type const guard = 1234.5;
+
+// data interleaved with stride `inc`, the other slots must stay untouched
+static
+bool
+untouched( vector<real_type> const & v, integer inc ) {
+  for ( size_t k = 0; k < v.size(); ++k )
+    if ( k % size_t(inc) != 0 && v[k] != guard ) return false;
+  return true;
+}
+
+static
+bool
+same(
+  vector<real_type> const & a,
+  vector<real_type> const & b,
+  integer                   inc
+) {
+  for ( size_t i = 0; i < a.size(); ++i )
+    if ( a[i] != b[i*size_t(inc)] ) return false;
+  return untouched( b, inc );
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.19\n\n";
+
+  integer const n = 41, incY = 3, incYp = 2, incYpp = 5;
+  vector<real_type> X(n), Y(n), Ys(n*incY,guard);
+  for ( integer i = 0; i < n; ++i ) {
+    X[i] = i+0.3*sin(1.7*i);
+    Y[i] = sin(0.3*X[i]) + (i%5 == 0 ? 0.5 : 0);
+    Ys[i*incY] = Y[i];
+  }
+
+  bool ok = true;
+
+  cout << "TEST 19.1 strided slopes are bitwise identical to contiguous ones\n";
+  {
+    vector<real_type> Yp(n), Yps(n*incYp,guard);
+    Splines::Pchip_build( &X.front(), &Y.front(), &Yp.front(), n );
+    Splines::Pchip_build( &X.front(), &Ys.front(), incY, &Yps.front(), incYp, n );
+    bool ok1 = same( Yp, Yps, incYp );
+    cout << "  Pchip:  " << (ok1 ? "ok" : "FAILED") << '\n';
+    ok = ok && ok1;
+
+    fill( Yps.begin(), Yps.end(), guard );
+    Splines::Akima_build( &X.front(), &Y.front(), &Yp.front(), n );
+    Splines::Akima_build( &X.front(), &Ys.front(), incY, &Yps.front(), incYp, n );
+    ok1 = same( Yp, Yps, incYp );
+    cout << "  Akima:  " << (ok1 ? "ok" : "FAILED") << '\n';
+    ok = ok && ok1;
+
+    fill( Yps.begin(), Yps.end(), guard );
+    Splines::Bessel_build( &X.front(), &Y.front(), &Yp.front(), n );
+    Splines::Bessel_build( &X.front(), &Ys.front(), incY, &Yps.front(), incYp, n );
+    ok1 = same( Yp, Yps, incYp );
+    cout << "  Bessel: " << (ok1 ? "ok" : "FAILED") << '\n';
+    ok = ok && ok1;
+
+    Splines::CUBIC_SPLINE_TYPE_BC const bcs[] = {
+      Splines::EXTRAPOLATE_BC, Splines::NATURAL_BC,
+      Splines::PARABOLIC_RUNOUT_BC, Splines::NOT_A_KNOT
+    };
+    for ( Splines::CUBIC_SPLINE_TYPE_BC bc : bcs ) {
+      fill( Yps.begin(), Yps.end(), guard );
+      Splines::CubicSpline_build( &X.front(), &Y.front(), &Yp.front(), n, bc, bc );
+      Splines::CubicSpline_build(
+        &X.front(), &Ys.front(), incY, &Yps.front(), incYp, n, bc, bc
+      );
+      ok1 = same( Yp, Yps, incYp );
+      cout << "  Cubic (bc = " << bc << "): " << (ok1 ? "ok" : "FAILED") << '\n';
+      ok = ok && ok1;
+    }
+  }
+
+  cout << "TEST 19.2 strided quintic derivatives match QuinticSpline\n";
+  {
+    vector<real_type> Yp(n), Ypp(n), Yps(n*incYp), Ypps(n*incYpp);
+    Splines::QUINTIC_SPLINE_TYPE const qts[] = {
+      Splines::CUBIC_QUINTIC, Splines::PCHIP_QUINTIC,
+      Splines::AKIMA_QUINTIC, Splines::BESSEL_QUINTIC
+    };
+    for ( Splines::QUINTIC_SPLINE_TYPE qt : qts ) {
+      QuinticSpline q;
+      q.setQuinticType( qt );
+      q.build( X, Y );
+      for ( integer i = 0; i < n; ++i ) {
+        Yp[size_t(i)]  = q.ypNode(i);
+        Ypp[size_t(i)] = q.yppNode(i);
+      }
+      fill( Yps.begin(), Yps.end(), guard );
+      fill( Ypps.begin(), Ypps.end(), guard );
+      Splines::Quintic_build(
+        qt, &X.front(), &Ys.front(), incY,
+        &Yps.front(), incYp, &Ypps.front(), incYpp, n
+      );
+      bool ok1 = same( Yp, Yps, incYp ) && same( Ypp, Ypps, incYpp );
+      cout << "  sub type " << qt << ": " << (ok1 ? "ok" : "FAILED") << '\n';
+      ok = ok && ok1;
+    }
+  }
+
+  cout << "TEST 19.3 input is not modified\n";
+  {
+    bool ok1 = untouched( Ys, incY );
+    for ( integer i = 0; i < n; ++i ) ok1 = ok1 && Ys[i*incY] == Y[i];
+    cout << "  " << (ok1 ? "ok" : "FAILED") << '\n';
+    ok = ok && ok1;
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
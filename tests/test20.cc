@@ -0,0 +1,184 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// evaluate `d` (value, gradient and hessian) at `px`,`py` in the given order
+template <typename SURF>
+double
+sweep(
+  SURF                    const & S,
+  vector<real_type>       const & px,
+  vector<real_type>       const & py,
+  vector<real_type>             & d
+) {
+  d.resize( 6*px.size() );
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  S.eval_DD( &px.front(), &py.front(), &d.front(), px.size(), false );
+  chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+  return chrono::duration<double,milli>(t1-t0).count();
+}
+
+template <typename SURF>
+bool
+bench(
+  char const                what[],
+  vector<real_type> const & X,
+  vector<real_type> const & Y,
+  vector<real_type> const & Z
+) {
+  integer nx = integer(X.size());
+  integer ny = integer(Y.size());
+
+  // row sweep (y varies fastest), column sweep (x varies fastest), random
+  vector<real_type> rx, ry, cx, cy, ux, uy;
+  for ( integer i = 0; i+1 < nx; i += 2 ) {
+    for ( integer j = 0; j+1 < ny; ++j ) {
+      rx.push_back( (X[size_t(i)]+X[size_t(i+1)])/2 );
+      ry.push_back( (Y[size_t(j)]+Y[size_t(j+1)])/2 );
+    }
+  }
+  for ( integer j = 0; j+1 < ny; j += 2 ) {
+    for ( integer i = 0; i+1 < nx; ++i ) {
+      cx.push_back( (X[size_t(i)]+X[size_t(i+1)])/2 );
+      cy.push_back( (Y[size_t(j)]+Y[size_t(j+1)])/2 );
+    }
+  }
+  mt19937 gen(7);
+  uniform_real_distribution<real_type> U(0,1);
+  for ( size_t k = 0; k < rx.size(); ++k ) {
+    ux.push_back( X.front() + (X.back()-X.front())*U(gen) );
+    uy.push_back( Y.front() + (Y.back()-Y.front())*U(gen) );
+  }
+
+  cout << what << " " << nx << " x " << ny << ", "
+       << rx.size() << " points for each sweep\n"
+       << "  tile    row (ms)  column (ms)  random (ms)\n";
+
+  bool ok = true;
+  vector<real_type> r0, c0, u0, r, c, u;
+  integer const tiles[] = { 0, 8, 16 };
+  for ( integer tile : tiles ) {
+    SURF S;
+    S.setTileSize( tile );
+    S.build( X, Y, Z );
+    double tr = sweep( S, rx, ry, r );
+    double tc = sweep( S, cx, cy, c );
+    double tu = sweep( S, ux, uy, u );
+    cout << "  " << setw(4) << tile << setw(12) << tr
+         << setw(13) << tc << setw(13) << tu << '\n';
+    if ( tile == 0 ) {
+      r0.swap( r ); c0.swap( c ); u0.swap( u );
+    } else {
+      bool same = r == r0 && c == c0 && u == u0;
+      if ( !same ) cout << "  tile " << tile << " results DIFFERENT\n";
+      ok = ok && same;
+    }
+  }
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.20\n\n";
+
+  integer const nx = 1500, ny = 1500;
+  vector<real_type> X(nx), Y(ny), Z(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) X[i] = i+0.3*sin(real_type(i));
+  for ( integer j = 0; j < ny; ++j ) Y[j] = j+0.4*cos(real_type(j));
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      Z[i*ny+j] = sin(X[i]/17)*cos(Y[j]/13)+(i*j%7)/10.0;
+
+  cout << "TEST 20.1 row, column and random sweeps with tiled node tables\n";
+  bool ok = bench<BiCubicSpline>( "BiCubic", X, Y, Z );
+  ok = bench<BiQuinticSpline>( "BiQuintic", X, Y, Z ) && ok;
+
+  cout << "TEST 20.2 layout changed after build, binary round trip\n";
+  {
+    integer const n1 = 37, n2 = 23; // not a multiple of the tile
+    vector<real_type> x(n1), y(n2), z(n1*n2);
+    for ( integer i = 0; i < n1; ++i ) x[i] = i;
+    for ( integer j = 0; j < n2; ++j ) y[j] = j*0.5;
+    for ( integer i = 0; i < n1; ++i )
+      for ( integer j = 0; j < n2; ++j )
+        z[i*n2+j] = sin(x[i]/5)*cos(y[j]/3);
+    Spline2D S0, S1;
+    S1.setTileSize( 16 );
+    S0.build( Splines::BIQUINTIC_TYPE, x, y, z );
+    S1.build( Splines::BIQUINTIC_TYPE, x, y, z );
+    bool same = true;
+    for ( integer k = 0; k < 1000; ++k ) {
+      real_type xx = 36*((k*0.618034)-floor(k*0.618034));
+      real_type yy = 11*((k*0.414214)-floor(k*0.414214));
+      real_type d0[6], d1[6];
+      S0.DD( xx, yy, d0 );
+      S1.DD( xx, yy, d1 );
+      for ( integer l = 0; l < 6; ++l ) same = same && d0[l] == d1[l];
+      S1.setTileSize( (k%3)*4 ); // 0, 4, 8
+      same = same && S1( xx, yy ) == S0( xx, yy );
+    }
+    for ( integer i = 0; i < n1; ++i )
+      for ( integer j = 0; j < n2; ++j )
+        same = same && S1.zNode(i,j) == z[i*n2+j];
+
+    // files are row-major: a tiled spline is read back by any layout
+    BiQuinticSpline B8("b8"), L0, L4;
+    B8.setTileSize( 8 );
+    B8.build( x, y, z );
+    char const fname[] = "test20_data.bin";
+    {
+      ofstream file( fname, ios::binary );
+      B8.writeBinary( file );
+    }
+    SplineBinaryFile f( fname );
+    L4.setTileSize( 4 );
+    L0.loadBinary( f, f.find("b8") );
+    L4.loadBinary( f, f.find("b8") );
+    for ( integer k = 0; k < 1000; ++k ) {
+      real_type xx = 36*((k*0.618034)-floor(k*0.618034));
+      real_type yy = 11*((k*0.414214)-floor(k*0.414214));
+      real_type v = S0( xx, yy );
+      same = same && B8( xx, yy ) == v && L0( xx, yy ) == v && L4( xx, yy ) == v;
+    }
+    cout << "  " << (same ? "identical" : "DIFFERENT") << '\n';
+    ok = ok && same;
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
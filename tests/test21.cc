@@ -0,0 +1,252 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static
+real_type
+rel_err( real_type a, real_type b ) {
+  return abs(a-b)/(1+abs(b));
+}
+
+// a function linear in each variable
+static
+real_type
+multilinear( real_type const x[4], real_type g[4] ) {
+  g[0] = 1         + x[1]*x[2]*x[3];
+  g[1] = -2        + x[0]*x[2]*x[3];
+  g[2] = 0.5*x[3]  + x[0]*x[1]*x[3];
+  g[3] = 0.5*x[2]  + x[0]*x[1]*x[2];
+  return 1 + x[0] - 2*x[1] + 0.5*x[2]*x[3] + x[0]*x[1]*x[2]*x[3];
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.21\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 21.1 multilinear is exact on a multilinear function (4D)\n";
+  {
+    integer const n[4] = { 5, 4, 6, 3 };
+    vector<real_type> g[4];
+    for ( integer k = 0; k < 4; ++k )
+      for ( integer i = 0; i < n[k]; ++i )
+        g[k].push_back( i + 0.2*sin(real_type(3*i+k)) );
+    real_type const * x[4] = {
+      &g[0].front(), &g[1].front(), &g[2].front(), &g[3].front()
+    };
+    vector<real_type> z;
+    real_type gr[4];
+    for ( integer a = 0; a < n[0]; ++a )
+      for ( integer b = 0; b < n[1]; ++b )
+        for ( integer c = 0; c < n[2]; ++c )
+          for ( integer d = 0; d < n[3]; ++d ) {
+            real_type p[4] = { g[0][a], g[1][b], g[2][c], g[3][d] };
+            z.push_back( multilinear( p, gr ) );
+          }
+    SplineND S("4D");
+    S.build( Splines::LINEAR_TYPE, 4, n, x, &z.front() );
+    S.info( cout );
+    real_type err = 0;
+    integer hint[4] = { 0, 0, 0, 0 };
+    for ( integer k = 0; k < 5000; ++k ) {
+      real_type p[4], ge[4], gs[4];
+      for ( integer l = 0; l < 4; ++l ) {
+        real_type t = (k*(0.618034+0.1*l)) - floor(k*(0.618034+0.1*l));
+        p[l] = g[l].front() + (g[l].back()-g[l].front())*t;
+      }
+      real_type fe = multilinear( p, ge );
+      real_type fs = S.eval_D( p, gs, hint );
+      err = max( err, rel_err( fs, fe ) );
+      err = max( err, rel_err( S.eval( p ), fe ) );
+      for ( integer l = 0; l < 4; ++l ) err = max( err, rel_err( gs[l], ge[l] ) );
+    }
+    cout << "  max error = " << err << '\n';
+    ok = ok && err < 1e-12;
+  }
+
+  integer const nx = 23, ny = 17;
+  vector<real_type> X(nx), Y(ny), Z(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) X[i] = i + 0.3*sin(1.7*i);
+  for ( integer j = 0; j < ny; ++j ) Y[j] = 0.5*j + 0.1*cos(2.3*j);
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      Z[i*ny+j] = sin(0.3*X[i])*cos(0.7*Y[j]) + ((i*7+j*3)%5 == 0 ? 0.5 : 0);
+  integer const n2[2] = { nx, ny };
+  real_type const * x2[2] = { &X.front(), &Y.front() };
+
+  cout << "TEST 21.2 2D case against BilinearSpline and BiCubicSpline\n";
+  {
+    BilinearSpline BL;
+    BiCubicSpline  BC;
+    BL.build( X, Y, Z );
+    BC.build( X, Y, Z );
+    SplineND L, C;
+    L.build( Splines::LINEAR_TYPE, 2, n2, x2, &Z.front() );
+    C.build( Splines::PCHIP_TYPE,  2, n2, x2, &Z.front() );
+    real_type errL = 0, errC = 0;
+    for ( integer k = 0; k < 5000; ++k ) {
+      real_type p[2] = {
+        X.front()-1 + (X.back()-X.front()+2)*((k*0.618034)-floor(k*0.618034)),
+        Y.front()-1 + (Y.back()-Y.front()+2)*((k*0.414214)-floor(k*0.414214))
+      };
+      real_type g[2], d[3];
+      real_type f = L.eval_D( p, g );
+      BL.D( p[0], p[1], d );
+      errL = max( errL, max( rel_err(f,d[0]), max( rel_err(g[0],d[1]), rel_err(g[1],d[2]) ) ) );
+      f = C.eval_D( p, g );
+      BC.D( p[0], p[1], d );
+      errC = max( errC, max( rel_err(f,d[0]), max( rel_err(g[0],d[1]), rel_err(g[1],d[2]) ) ) );
+    }
+    cout << "  multilinear vs Bilinear  max error = " << errL
+         << "\n  pchip       vs BiCubic   max error = " << errC << '\n';
+    ok = ok && errL < 1e-12 && errC < 1e-12;
+  }
+
+  cout << "TEST 21.3 1D case against the 1D splines\n";
+  {
+    Splines::SplineType1D const tps[] = {
+      Splines::CUBIC_TYPE, Splines::AKIMA_TYPE,
+      Splines::BESSEL_TYPE, Splines::PCHIP_TYPE
+    };
+    vector<real_type> z1( Z.begin(), Z.begin()+ny );
+    real_type const * y1[1] = { &Y.front() };
+    for ( Splines::SplineType1D tp : tps ) {
+      Spline1D  S1("1D");
+      SplineND  SN;
+      S1.build( tp, &Y.front(), 1, &z1.front(), 1, ny );
+      SN.build( tp, 1, &ny, y1, &z1.front() );
+      real_type err = 0;
+      for ( integer k = 0; k <= 1000; ++k ) {
+        real_type t = Y.front() + (Y.back()-Y.front())*k/1000.0, g;
+        real_type f = SN.eval_D( &t, &g );
+        err = max( err, max( rel_err( f, S1(t) ), rel_err( g, S1.D(t) ) ) );
+      }
+      cout << "  " << setw(7) << left << Splines::spline_type_1D[tp]
+           << " max error = " << err << '\n';
+      ok = ok && err < 1e-12;
+    }
+  }
+
+  cout << "TEST 21.4 gradient of a 3D cubic against finite differences\n";
+  {
+    integer const n[3] = { 12, 9, 7 };
+    vector<real_type> g[3], z;
+    for ( integer k = 0; k < 3; ++k )
+      for ( integer i = 0; i < n[k]; ++i ) g[k].push_back( i*(1+0.1*k) );
+    for ( integer a = 0; a < n[0]; ++a )
+      for ( integer b = 0; b < n[1]; ++b )
+        for ( integer c = 0; c < n[2]; ++c )
+          z.push_back( sin(0.4*g[0][a])*cos(0.3*g[1][b])+0.1*g[2][c]*g[2][c] );
+    real_type const * x[3] = { &g[0].front(), &g[1].front(), &g[2].front() };
+    SplineND S;
+    S.build( Splines::CUBIC_TYPE, 3, n, x, &z.front() );
+    real_type err = 0, h = 1e-6;
+    for ( integer k = 0; k < 1000; ++k ) {
+      real_type p[3], gr[3];
+      for ( integer l = 0; l < 3; ++l ) {
+        real_type t = (k*(0.618034+0.13*l)) - floor(k*(0.618034+0.13*l));
+        p[l] = g[l].front() + (g[l].back()-g[l].front())*t;
+      }
+      S.eval_D( p, gr );
+      for ( integer l = 0; l < 3; ++l ) {
+        real_type pp[3] = { p[0], p[1], p[2] }, pm[3] = { p[0], p[1], p[2] };
+        pp[l] += h; pm[l] -= h;
+        err = max( err, rel_err( gr[l], (S.eval(pp)-S.eval(pm))/(2*h) ) );
+      }
+    }
+    cout << "  max error = " << err << '\n';
+    ok = ok && err < 1e-6;
+  }
+
+  cout << "TEST 21.5 4D engine map, batch evaluation along a path\n";
+  {
+    // speed x load x temperature x altitude
+    integer const n[4] = { 40, 30, 20, 12 };
+    vector<real_type> g[4], z;
+    for ( integer k = 0; k < 4; ++k )
+      for ( integer i = 0; i < n[k]; ++i ) g[k].push_back( i+0.1*sin(real_type(i)) );
+    for ( integer a = 0; a < n[0]; ++a )
+      for ( integer b = 0; b < n[1]; ++b )
+        for ( integer c = 0; c < n[2]; ++c )
+          for ( integer d = 0; d < n[3]; ++d )
+            z.push_back( sin(g[0][a]/7)*cos(g[1][b]/5)+g[2][c]/(1+g[3][d]) );
+    real_type const * x[4] = {
+      &g[0].front(), &g[1].front(), &g[2].front(), &g[3].front()
+    };
+    SplineND S;
+    S.build( Splines::PCHIP_TYPE, 4, n, x, &z.front() );
+
+    size_t const np = 200000;
+    vector<real_type> path(4*np), v1(np), v2(np), v4(np), d1(5*np), d4(5*np);
+    for ( size_t p = 0; p < np; ++p ) {
+      real_type t = real_type(p)/np;
+      for ( integer l = 0; l < 4; ++l )
+        path[4*p+size_t(l)] = g[l].back()*(0.5+0.45*sin(6.2832*(l+1)*t));
+    }
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for ( size_t p = 0; p < np; ++p ) v1[p] = S.eval( &path[4*p] );
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    S.eval( &path.front(), 4, np, &v2.front() );
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    S.eval( &path.front(), 4, np, &v4.front(), 4 );
+    S.eval_D( &path.front(), 4, np, &d1.front() );
+    S.eval_D( &path.front(), 4, np, &d4.front(), 4 );
+
+    bool same = v1 == v2 && v1 == v4 && d1 == d4;
+    for ( size_t p = 0; p < np; ++p ) same = same && d1[5*p] == v1[p];
+    cout << "  " << np << " points, no hints "
+         << chrono::duration<double,milli>(t1-t0).count() << " ms, with hints "
+         << chrono::duration<double,milli>(t2-t1).count() << " ms, "
+         << (same ? "identical" : "DIFFERENT") << '\n';
+    ok = ok && same;
+  }
+
+  cout << "TEST 21.6 evaluation of a spline not built\n";
+  {
+    SplineND E("empty");
+    real_type x[2] = { 0, 0 }, g[2];
+    integer nthrow = 0;
+    try { E.eval( x ); } catch ( exception const & ) { ++nthrow; }
+    try { E.eval_D( x, g ); } catch ( exception const & ) { ++nthrow; }
+    cout << "  " << nthrow << " of 2 rejected\n";
+    ok = ok && nthrow == 2;
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
@@ -0,0 +1,236 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+using Splines::SplineSurf;
+using Splines::BiCubicSplineBase;
+using Splines::BICUBIC_TYPE;
+
+static
+real_type
+surface( real_type x, real_type y ) {
+  return sin(0.05*x)*cos(0.07*y) + 0.3*sin(0.011*x*y) + (fmod(x+y,37.0) < 1 ? 0.2 : 0);
+}
+
+static
+real_type
+terrain( real_type x, real_type y ) {
+  return sin(0.01*x)*cos(0.013*y) + 1e-4*x;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.22\n\n";
+
+  bool ok = true;
+
+  char const fname[]  = "test22_tiles.bin";
+  char const fname2[] = "test22_tiles_big.bin";
+
+  integer const nx = 203, ny = 157;
+  vector<real_type> X(nx), Y(ny), Z(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) X[i] = i + 0.3*sin(1.7*i);
+  for ( integer j = 0; j < ny; ++j ) Y[j] = 0.5*j + 0.1*cos(2.3*j);
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      Z[i*ny+j] = surface( X[i], 2*Y[j] );
+
+  BiCubicSpline BC("in memory");
+  BC.build( X, Y, Z );
+
+  integer const npts = 20000;
+  vector<real_type> px(npts), py(npts);
+  for ( integer k = 0; k < npts; ++k ) {
+    px[k] = X.front()-1 + (X.back()-X.front()+2)*((k*0.618034)-floor(k*0.618034));
+    py[k] = Y.front()-1 + (Y.back()-Y.front()+2)*((k*0.414214)-floor(k*0.414214));
+  }
+
+  cout << "TEST 22.1 tiled file against BiCubicSpline (bitwise)\n";
+  {
+    integer const tiles[] = { 4, 16, 64, 256 };
+    for ( integer T : tiles ) {
+      BiCubicSplineMapped BM("mapped");
+      BM.build( fname, &X.front(), nx, &Y.front(), ny, &Z.front(), ny, T );
+      bool same = BM.zMin() == BC.zMin() && BM.zMax() == BC.zMax();
+      for ( integer i = 0; i < nx; ++i )
+        for ( integer j = 0; j < ny; ++j )
+          same = same &&
+                 BM.zNode(i,j)  == BC.zNode(i,j)  &&
+                 BM.DxNode(i,j) == BC.DxNode(i,j) &&
+                 BM.DyNode(i,j) == BC.DyNode(i,j);
+      // the node accessors are virtual, the base classes see the file
+      SplineSurf        const & SS = BM;
+      BiCubicSplineBase const & SB = BM;
+      for ( integer i = 0; i < nx; i += 7 )
+        for ( integer j = 0; j < ny; j += 5 )
+          same = same &&
+                 SS.zNode(i,j)  == BC.zNode(i,j)  &&
+                 SB.DxNode(i,j) == BC.DxNode(i,j) &&
+                 SB.DyNode(i,j) == BC.DyNode(i,j);
+      same = same && SS.type() == BICUBIC_TYPE &&
+             string(SS.type_name()) != string(BC.type_name());
+      for ( integer k = 0; k < npts; ++k ) {
+        real_type d1[6], d2[6];
+        BM.DD( px[k], py[k], d1 );
+        BC.DD( px[k], py[k], d2 );
+        for ( integer l = 0; l < 6; ++l ) same = same && d1[l] == d2[l];
+        same = same && BM( px[k], py[k] ) == BC( px[k], py[k] );
+      }
+      cout << "  tile " << setw(3) << T << ( same ? " identical\n" : " DIFFERENT\n" );
+      ok = ok && same;
+    }
+  }
+
+  cout << "TEST 22.2 bounded resident set (4 tiles)\n";
+  {
+    BiCubicSplineMapped BM("mapped");
+    BM.build( fname, &X.front(), nx, &Y.front(), ny, &Z.front(), ny, 32 );
+    size_t tb = 3*sizeof(real_type)*32*32;
+    BM.setMaxResident( 4*tb );
+    bool   same  = true;
+    size_t peak  = 0;
+    for ( integer k = 0; k < npts; ++k ) {
+      real_type d1[3], d2[3];
+      BM.D( px[k], py[k], d1 );
+      BC.D( px[k], py[k], d2 );
+      for ( integer l = 0; l < 3; ++l ) same = same && d1[l] == d2[l];
+      peak = max( peak, BM.resident() );
+    }
+    // grid and batch evaluation go through the same cache
+    integer const gx = 300, gy = 200;
+    vector<real_type> xs(gx), ys(gy), G1(gx*gy), G2(gx*gy);
+    for ( integer i = 0; i < gx; ++i ) xs[i] = X.front() + (X.back()-X.front())*i/(gx-1.0);
+    for ( integer j = 0; j < gy; ++j ) ys[j] = Y.front() + (Y.back()-Y.front())*j/(gy-1.0);
+    BM.evalGrid_Dxy( &xs.front(), gx, &ys.front(), gy, &G1.front(), gy );
+    BC.evalGrid_Dxy( &xs.front(), gx, &ys.front(), gy, &G2.front(), gy );
+    same = same && G1 == G2;
+    vector<real_type> B1(6*npts), B2(6*npts);
+    BM.eval_DD( &px.front(), &py.front(), &B1.front(), npts, true, 4 );
+    BC.eval_DD( &px.front(), &py.front(), &B2.front(), npts, true, 1 );
+    same = same && B1 == B2;
+    peak = max( peak, BM.resident() );
+    cout << "  peak resident = " << peak << " bytes (bound " << 4*tb << ")"
+         << ( same ? ", identical\n" : ", DIFFERENT\n" );
+    ok = ok && same && peak <= 4*tb;
+    BM.setMaxResident( 0 );
+    cout << "  after setMaxResident(0) resident = " << BM.resident() << '\n';
+    ok = ok && BM.resident() == 0;
+  }
+
+  cout << "TEST 22.3 reopen the file\n";
+  {
+    BiCubicSplineMapped BM("reopened");
+    BM.open( fname );
+    BM.info( cout );
+    real_type err = 0;
+    for ( integer k = 0; k < npts; ++k )
+      err = max( err, abs( BM( px[k], py[k] ) - BC( px[k], py[k] ) ) );
+    cout << "  nx = " << BM.numPointX() << " ny = " << BM.numPointY()
+         << " tile = " << BM.tileSide() << " max difference = " << err << '\n';
+    ok = ok && err == 0 && BM.numPointX() == nx && BM.numPointY() == ny;
+    BM.close();
+    bool thrown1 = false, thrown2 = false;
+    try { BM( 1, 1 ); } catch ( exception const & ) { thrown1 = true; }
+    try { BM.open( "test22_missing.bin" ); } catch ( exception const & ) { thrown2 = true; }
+    bool thrown = thrown1 && thrown2;
+    cout << "  closed spline and missing file " << ( thrown ? "throw\n" : "do NOT throw\n" );
+    ok = ok && thrown;
+  }
+
+  cout << "TEST 22.4 build from a block reader, never holding the matrix\n";
+  {
+    integer const mx = 3000, my = 2500;
+    vector<real_type> xx(mx), yy(my);
+    for ( integer i = 0; i < mx; ++i ) xx[i] = i;
+    for ( integer j = 0; j < my; ++j ) yy[j] = j;
+    size_t calls = 0, values = 0;
+    BiCubicSplineMapped::BlockReader reader = [&](
+      integer i0, integer i1, integer j0, integer j1, real_type zb[], integer ldZ
+    ) {
+      ++calls;
+      for ( integer i = i0; i < i1; ++i )
+        for ( integer j = j0; j < j1; ++j, ++values )
+          zb[(i-i0)*ldZ+(j-j0)] = terrain( xx[i], yy[j] );
+    };
+    BiCubicSplineMapped BM("reader");
+    BM.setBuildThreads( 2 );
+    BM.setMaxResident( size_t(1) << 20 );
+    auto t0 = chrono::high_resolution_clock::now();
+    BM.build( fname2, &xx.front(), mx, &yy.front(), my, reader, 64 );
+    auto t1 = chrono::high_resolution_clock::now();
+    real_type err = 0;
+    for ( integer k = 0; k < npts; ++k ) {
+      real_type x = (mx-1)*((k*0.618034)-floor(k*0.618034));
+      real_type y = (my-1)*((k*0.414214)-floor(k*0.414214));
+      err = max( err, abs( BM( x, y ) - terrain( x, y ) ) );
+    }
+    auto t2 = chrono::high_resolution_clock::now();
+    cout << "  " << mx << " x " << my << " nodes, " << calls << " blocks, "
+         << setprecision(3) << real_type(values)/(real_type(mx)*my) << " reads per node\n"
+         << "  build " << chrono::duration<double,milli>(t1-t0).count() << " ms, "
+         << npts << " queries " << chrono::duration<double,milli>(t2-t1).count() << " ms, "
+         << "resident " << BM.resident() << " bytes, max error " << err << '\n';
+    ok = ok && err < 1e-4 && BM.resident() <= (size_t(1) << 20);
+  }
+
+  cout << "TEST 22.5 batches on 4 threads with pinned tiles, 1 tile resident\n";
+  {
+    BiCubicSplineMapped BM("pinned");
+    BM.build( fname, &X.front(), nx, &Y.front(), ny, &Z.front(), ny, 16 );
+    size_t tb = 3*sizeof(real_type)*16*16;
+    BM.setMaxResident( tb );
+    vector<real_type> B1(6*npts), B2(6*npts), B3(6*npts);
+    BC.eval_DD( &px.front(), &py.front(), &B1.front(), npts, true, 1 );
+    double tm[2];
+    for ( integer r = 0; r < 2; ++r ) {
+      auto t0 = chrono::high_resolution_clock::now();
+      BM.eval_DD( &px.front(), &py.front(), &B2.front(), npts, true, r == 0 ? 1 : 4 );
+      auto t1 = chrono::high_resolution_clock::now();
+      tm[r] = chrono::duration<double,milli>(t1-t0).count();
+    }
+    BM.eval_DD( &px.front(), &py.front(), &B3.front(), npts, false, 4 );
+    bool same = B1 == B2 && B1 == B3;
+    cout << "  1 thread " << tm[0] << " ms, 4 threads " << tm[1] << " ms, resident "
+         << BM.resident() << " bytes" << ( same ? ", identical\n" : ", DIFFERENT\n" );
+    ok = ok && same && BM.resident() <= tb;
+  }
+
+  std::remove( fname );
+  std::remove( fname2 );
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
@@ -0,0 +1,216 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static
+real_type
+pixel( integer i, integer j ) {
+  return ((i*131+j*71)%256)/255.0 + 0.5*sin(0.05*i)*cos(0.03*j);
+}
+
+static
+double
+elapsed( chrono::high_resolution_clock::time_point t0 ) {
+  return chrono::duration<double,milli>(chrono::high_resolution_clock::now()-t0).count();
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.23\n\n";
+
+  bool ok = true;
+
+  integer const nx = 301, ny = 257;
+  vector<real_type> X(nx), Y(ny), XJ(nx), XP(nx), Z(nx*ny);
+  for ( integer i = 0; i < nx; ++i ) {
+    X[i]  = 2*i;
+    XJ[i] = 2*i + 1e-9*sin(real_type(i)); // nearly uniform
+    XP[i] = 2*i + 0.6*sin(real_type(i));  // not uniform
+  }
+  for ( integer j = 0; j < ny; ++j ) Y[j] = -1 + 0.5*j;
+  for ( integer i = 0; i < nx; ++i )
+    for ( integer j = 0; j < ny; ++j )
+      Z[i*ny+j] = pixel( i, j );
+
+  cout << "TEST 23.1 detection of the uniform axes\n";
+  {
+    BilinearSpline B1, B2, B3;
+    B1.build( X, Y, Z );
+    B2.build( XJ, Y, Z );
+    B3.build( XP, Y, Z );
+    cout << "  uniform " << B1.isUniformX() << B1.isUniformY()
+         << ", jittered " << B2.isUniformX() << B2.isUniformY()
+         << ", perturbed " << B3.isUniformX() << B3.isUniformY() << '\n';
+    ok = ok && B1.isUniformX() && B1.isUniformY() &&
+         B2.isUniformX() && B2.isUniformY() &&
+         !B3.isUniformX() && B3.isUniformY();
+    B1.clear();
+    ok = ok && !B1.isUniformX();
+  }
+
+  // points inside, on the nodes and outside the grid
+  integer const npts = 50000;
+  vector<real_type> px(npts), py(npts);
+  for ( integer k = 0; k < npts; ++k ) {
+    real_type a = (k*0.618034)-floor(k*0.618034);
+    real_type b = (k*0.414214)-floor(k*0.414214);
+    px[k] = XJ.front() + (XJ.back()-XJ.front())*a;
+    py[k] = Y.front()  + (Y.back()-Y.front())*b;
+    if ( k % 7 == 0 ) { px[k] = XJ[k%nx]; py[k] = Y[k%ny]; }
+  }
+
+  cout << "TEST 23.2 fast path against the batch (search) path, bitwise\n";
+  {
+    integer const tiles[] = { 0, 16 };
+    for ( integer T : tiles ) {
+      BilinearSpline B;
+      B.setTileSize( T );
+      B.build( XJ, Y, Z );
+      vector<real_type> d(3*npts), z(npts), r(npts);
+      B.eval_D( &px.front(), &py.front(), &d.front(), npts );
+      B.resample( &px.front(), &py.front(), &r.front(), npts );
+      bool same = true;
+      for ( integer k = 0; k < npts; ++k ) {
+        real_type dd[3];
+        B.D( px[k], py[k], dd );
+        same = same && B( px[k], py[k] ) == d[3*k] && r[k] == d[3*k];
+        if ( k % 7 != 0 ) // on the nodes the one-sided derivatives depend on the interval
+          same = same && dd[1] == d[3*k+1] && dd[2] == d[3*k+2] &&
+                 B.Dx( px[k], py[k] ) == d[3*k+1] && B.Dy( px[k], py[k] ) == d[3*k+2];
+      }
+      cout << "  tile " << setw(2) << T << ( same ? " identical\n" : " DIFFERENT\n" );
+      ok = ok && same;
+    }
+  }
+
+  cout << "TEST 23.3 extended and closed axes, out of range\n";
+  {
+    BilinearSpline B;
+    B.build( X, Y, Z );
+    B.make_x_unbounded();
+    B.make_y_closed();
+    vector<real_type> qx(npts), qy(npts), z(npts), r(npts);
+    for ( integer k = 0; k < npts; ++k ) {
+      qx[k] = X.front() - 20 + (X.back()-X.front()+40)*((k*0.618034)-floor(k*0.618034));
+      qy[k] = Y.front() - 50 + (Y.back()-Y.front()+100)*((k*0.414214)-floor(k*0.414214));
+    }
+    B.eval( &qx.front(), &qy.front(), &z.front(), npts, false );
+    B.resample( &qx.front(), &qy.front(), &r.front(), npts, 3 );
+    bool same = z == r;
+    for ( integer k = 0; k < npts; k += 13 ) same = same && B( qx[k], qy[k] ) == z[k];
+    B.make_x_bounded();
+    bool thrown = false;
+    try { B.resample( &qx.front(), &qy.front(), &r.front(), npts ); }
+    catch ( exception const & ) { thrown = true; }
+    cout << "  " << ( same ? "identical" : "DIFFERENT" )
+         << ", out of range " << ( thrown ? "throws\n" : "does NOT throw\n" );
+    ok = ok && same && thrown;
+  }
+
+  cout << "TEST 23.4 single precision\n";
+  {
+    BilinearSpline B;
+    B.build( X, Y, Z );
+    vector<float>     fx( px.begin(), px.end() ), fy( py.begin(), py.end() );
+    vector<float>     f1(npts), f2(npts);
+    vector<real_type> dx( fx.begin(), fx.end() ), dy( fy.begin(), fy.end() ), r(npts);
+    B.resample( &dx.front(), &dy.front(), &r.front(), npts );
+    B.resample( &fx.front(), &fy.front(), &f1.front(), npts );
+    B.useFloatTable();
+    B.resample( &fx.front(), &fy.front(), &f2.front(), npts );
+    real_type err = 0;
+    for ( integer k = 0; k < npts; ++k ) err = max( err, abs(f1[k]-r[k])/(1+abs(r[k])) );
+    cout << "  max error = " << err
+         << ( f1 == f2 ? ", float table identical\n" : ", float table DIFFERENT\n" );
+    ok = ok && err < 1e-5 && f1 == f2 && B.floatTable();
+  }
+
+  cout << "TEST 23.5 image resampling (1024 x 1024, rotation and zoom)\n";
+  {
+    integer const N = 1024;
+    vector<real_type> G(N), GP(N), I(N*N);
+    for ( integer i = 0; i < N; ++i ) { G[i] = i; GP[i] = i + 0.3*sin(real_type(i)); }
+    for ( integer i = 0; i < N; ++i )
+      for ( integer j = 0; j < N; ++j )
+        I[i*N+j] = pixel( i, j );
+    BilinearSpline BU, BN;
+    BU.build( G, G, I );
+    BN.build( GP, G, I );
+    BU.useFloatTable();
+    integer const M = 1400; // output image M x M
+    size_t  const n = size_t(M)*M;
+    vector<real_type> qx(n), qy(n), out(n);
+    vector<float>     fx(n), fy(n), fout(n);
+    real_type c = cos(0.3), s = sin(0.3);
+    for ( integer a = 0; a < M; ++a )
+      for ( integer b = 0; b < M; ++b ) {
+        real_type u = (a-M/2)*0.6, v = (b-M/2)*0.6;
+        size_t    k = size_t(a)*M+b;
+        qx[k] = min( real_type(N-1), max( real_type(0), N/2 + c*u - s*v ) );
+        qy[k] = min( real_type(N-1), max( real_type(0), N/2 + s*u + c*v ) );
+        fx[k] = float(qx[k]);
+        fy[k] = float(qy[k]);
+      }
+    real_type chk = 0;
+    // best of 3 runs
+    auto best = [&]( std::function<void()> const & f ) {
+      double t = 1e300;
+      for ( integer r = 0; r < 3; ++r ) {
+        auto t0 = chrono::high_resolution_clock::now();
+        f();
+        t = min( t, elapsed( t0 ) );
+      }
+      return t;
+    };
+    double tN = best( [&]() { for ( size_t k = 0; k < n; ++k ) chk += BN( qx[k], qy[k] ); } );
+    double tU = best( [&]() { for ( size_t k = 0; k < n; ++k ) chk += BU( qx[k], qy[k] ); } );
+    double tE = best( [&]() { BU.eval( &qx.front(), &qy.front(), &out.front(), n ); } );
+    double tR = best( [&]() { BU.resample( &qx.front(), &qy.front(), &out.front(), n ); } );
+    double tF = best( [&]() { BU.resample( &fx.front(), &fy.front(), &fout.front(), n ); } );
+    real_type Mp = real_type(n)/1000; // points per ms -> Mpoints/s
+    cout << setprecision(3)
+         << "  operator() non uniform " << setw(8) << Mp/tN << " Mpoints/s\n"
+         << "  operator() uniform     " << setw(8) << Mp/tU << " Mpoints/s\n"
+         << "  eval (sorted batch)    " << setw(8) << Mp/tE << " Mpoints/s\n"
+         << "  resample double        " << setw(8) << Mp/tR << " Mpoints/s\n"
+         << "  resample float         " << setw(8) << Mp/tF << " Mpoints/s\n"
+         << "  (checksum " << chk << ")\n";
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
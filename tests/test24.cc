@@ -0,0 +1,152 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// curve with `dim` components on `npts` points, graded knots in [0,1]
+static
+void
+build_curve( SplineVec & S, integer dim, integer npts ) {
+  vector<real_type> P( size_t(dim*npts) ), T( npts );
+  for ( integer i = 0; i < npts; ++i ) {
+    real_type t = real_type(i)/(npts-1);
+    T[i] = t*(1+0.3*sin(3*t))/(1+0.3*sin(3.0));
+    for ( integer k = 0; k < dim; ++k )
+      P[i*dim+k] = cos( 0.1*i*(k+1) ) + 0.05*k*i + 0.01*sin(real_type(7*i+k));
+  }
+  S.setup( dim, npts, &P.front(), dim );
+  S.setKnots( &T.front() );
+  S.CatmullRom();
+}
+
+// compare eval .. eval_DDD of `A` and `B` at `n` points, `inc` = 2
+static
+bool
+same_values( SplineVec const & A, SplineVec const & B, integer n ) {
+  integer dim = A.dimension();
+  vector<real_type> va(2*dim), vb(2*dim);
+  bool ok = true;
+  for ( integer k = 0; k <= n; ++k ) {
+    real_type x = -0.1 + 1.2*k/n;
+    A.eval( x, &va.front(), 2 );     B.eval( x, &vb.front(), 2 );     ok = ok && va == vb;
+    A.eval_D( x, &va.front(), 2 );   B.eval_D( x, &vb.front(), 2 );   ok = ok && va == vb;
+    A.eval_DD( x, &va.front(), 2 );  B.eval_DD( x, &vb.front(), 2 );  ok = ok && va == vb;
+    A.eval_DDD( x, &va.front(), 2 ); B.eval_DDD( x, &vb.front(), 2 ); ok = ok && va == vb;
+  }
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.24\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 24.1 interleaved storage against the split storage, bitwise\n";
+  for ( integer dim = 1; dim <= 7; ++dim ) {
+    SplineVec A("split"), B("interleaved"), C("late");
+    B.useInterleaved();
+    build_curve( A, dim, 57 );
+    build_curve( B, dim, 57 );
+    build_curve( C, dim, 57 );
+    C.useInterleaved(); // after the derivatives
+    bool same = same_values( A, B, 1000 ) && same_values( A, C, 1000 ) &&
+                B.interleaved() && !A.interleaved();
+    cout << "  dim = " << dim << ( same ? " identical\n" : " DIFFERENT\n" );
+    ok = ok && same;
+  }
+
+  cout << "TEST 24.2 move and view keep the layout\n";
+  {
+    SplineVec A("vec"), B;
+    build_curve( A, 3, 40 );
+    B.useInterleaved();
+    build_curve( B, 3, 40 );
+    SplineVec M( std::move(B) );
+    bool same = M.interleaved() && same_values( A, M, 200 );
+
+    char const fname[] = "test24_data.bin";
+    {
+      ofstream file( fname, ios::binary );
+      A.writeBinary( file );
+    }
+    {
+      SplineBinaryFile f( fname );
+      SplineVec V;
+      V.useInterleaved();
+      V.load_view( f, f.find("vec") );
+      same = same && same_values( A, V, 200 );
+    }
+    std::remove( fname );
+    cout << "  " << ( same ? "identical\n" : "DIFFERENT\n" );
+    ok = ok && same;
+  }
+
+  cout << "TEST 24.3 3D trajectory, sweep and random queries\n";
+  {
+    integer const npts = 1000000, nq = 1000000;
+    SplineVec A("split"), B("interleaved");
+    B.useInterleaved();
+    build_curve( A, 3, npts );
+    build_curve( B, 3, npts );
+    vector<real_type> xs( nq ), xr( nq );
+    for ( integer k = 0; k < nq; ++k ) {
+      xs[k] = real_type(k)/nq;
+      xr[k] = (k*0.618034)-floor(k*0.618034);
+    }
+    real_type v[3], sum = 0;
+    for ( integer q = 0; q < 2; ++q ) {
+      vector<real_type> const & xq = q == 0 ? xs : xr;
+      double tA = 1e300, tB = 1e300;
+      for ( integer r = 0; r < 3; ++r ) {
+        auto t0 = chrono::high_resolution_clock::now();
+        for ( integer k = 0; k < nq; ++k ) { A.eval_D( xq[k], v, 1 ); sum += v[0]+v[1]+v[2]; }
+        auto t1 = chrono::high_resolution_clock::now();
+        for ( integer k = 0; k < nq; ++k ) { B.eval_D( xq[k], v, 1 ); sum += v[0]+v[1]+v[2]; }
+        auto t2 = chrono::high_resolution_clock::now();
+        tA = min( tA, chrono::duration<double,milli>(t1-t0).count() );
+        tB = min( tB, chrono::duration<double,milli>(t2-t1).count() );
+      }
+      cout << setprecision(3) << ( q == 0 ? "  sweep\n" : "  random\n" )
+           << "    split       " << setw(8) << nq/tA/1000 << " Mevals/s\n"
+           << "    interleaved " << setw(8) << nq/tB/1000 << " Mevals/s\n";
+    }
+    cout << "  (checksum " << sum << ")\n";
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
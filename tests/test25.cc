@@ -0,0 +1,196 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// planar spiral on `npts` points, chord length knots
+static
+void
+build_spiral( SplineVec & S, integer npts ) {
+  vector<real_type> P( size_t(2*npts) ), T( npts );
+  for ( integer i = 0; i < npts; ++i ) {
+    real_type a = 18.84955592153876*i/(npts-1);
+    real_type r = 1+0.2*a;
+    P[2*i]   = r*cos(a);
+    P[2*i+1] = r*sin(a);
+  }
+  T[0] = 0;
+  for ( integer i = 1; i < npts; ++i )
+    T[i] = T[i-1] + hypot( P[2*i]-P[2*i-2], P[2*i+1]-P[2*i-1] );
+  S.setup( 2, npts, &P.front(), 2 );
+  S.setKnots( &T.front() );
+  S.CatmullRom();
+}
+
+// length of the polyline on `n` points uniform in the parameter
+static
+real_type
+polyline_length( SplineVec const & S, integer n ) {
+  real_type p0[2], p1[2], L = 0;
+  S.eval( S.xMin(), p0, 1 );
+  for ( integer k = 1; k <= n; ++k ) {
+    S.eval( S.xMin() + ((S.xMax()-S.xMin())*k)/n, p1, 1 );
+    L += hypot( p1[0]-p0[0], p1[1]-p0[1] );
+    p0[0] = p1[0]; p0[1] = p1[1];
+  }
+  return L;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.25\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 25.1 segment with graded knots, arc-length is the distance\n";
+  {
+    integer const npts = 20;
+    vector<real_type> P( 3*npts ), T( npts );
+    for ( integer i = 0; i < npts; ++i ) {
+      real_type u = real_type(i)/(npts-1);
+      T[i]       = u;
+      P[3*i]     = 1+2*u*u;
+      P[3*i+1]   = 2-1*u*u;
+      P[3*i+2]   = 3+2*u*u;
+    }
+    SplineVec S("segment");
+    S.setup( 3, npts, &P.front(), 3 );
+    S.setKnots( &T.front() );
+    S.CatmullRom();
+    S.buildArcLength( 1e-12 );
+    real_type err = abs( S.length() - 3 ), v[3];
+    for ( integer k = 0; k <= 100; ++k ) {
+      real_type s = 0.03*k;
+      S.eval_at_arclength( s, v, 1 );
+      err = max( err, abs( hypot( v[0]-1, hypot( v[1]-2, v[2]-3 ) ) - s ) );
+    }
+    cout << "  max error " << err << '\n';
+    ok = ok && err < 1e-10;
+  }
+
+  cout << "TEST 25.2 spiral, length against a fine polyline\n";
+  {
+    SplineVec S("spiral");
+    build_spiral( S, 200 );
+    real_type Lp = polyline_length( S, 2000000 );
+    real_type L0 = S.length(); // no table
+    S.buildArcLength();
+    real_type L1 = S.length();
+    integer   n1 = S.arcLengthCells();
+    S.buildArcLength( 1e-10 );
+    real_type L2 = S.length();
+    cout << setprecision(12)
+         << "  polyline " << Lp << '\n'
+         << "  direct   " << L0 << '\n'
+         << "  table    " << L1 << " cells " << n1 << '\n'
+         << "  adaptive " << L2 << " cells " << S.arcLengthCells() << '\n'
+         << setprecision(6);
+    ok = ok && L0 == L1 && abs(L2-Lp) < 1e-8*Lp && abs(L1-Lp) < 1e-6*Lp;
+  }
+
+  cout << "TEST 25.3 inversion, batch and sampling\n";
+  {
+    SplineVec S("spiral");
+    build_spiral( S, 200 );
+    S.buildArcLength( 1e-10 );
+    integer const n = 1001;
+    real_type L = S.length();
+    vector<real_type> s( n ), t( n ), V( 2*n ), W( 2*n );
+    for ( integer k = 0; k < n; ++k ) s[k] = (L*k)/(n-1);
+    s[n-1] = L;
+    S.s_to_t( n, &s.front(), &t.front() );
+    S.eval_at_arclength( n, &s.front(), &V.front(), 2 );
+    S.sample_arclength( n, &W.front(), 2 );
+    real_type err = 0;
+    bool same = V == W;
+    for ( integer k = 0; k < n; ++k ) {
+      same = same && t[k] == S.s_to_t( s[k] );
+      err  = max( err, abs( S.t_to_s( t[k] ) - s[k] ) );
+    }
+    // equal spacing of the samples
+    real_type h = L/(n-1), herr = 0;
+    for ( integer k = 1; k < n; ++k )
+      herr = max( herr, abs( hypot( W[2*k]-W[2*k-2], W[2*k+1]-W[2*k-1] ) - h ) );
+    cout << "  round trip error " << err
+         << "\n  batch " << ( same ? "identical" : "DIFFERENT" )
+         << "\n  chord - spacing " << herr << " (spacing " << h << ")\n";
+    ok = ok && same && err < 1e-10*L && herr < 1e-3*h;
+  }
+
+  cout << "TEST 25.4 closed curve wraps, table dropped by CatmullRom\n";
+  {
+    SplineVec S("spiral");
+    build_spiral( S, 200 );
+    S.make_closed();
+    S.buildArcLength();
+    real_type L = S.length();
+    bool wrap = abs( S.s_to_t( 0.25*L ) - S.s_to_t( 2.25*L ) ) < 1e-12*S.xMax() &&
+                abs( S.s_to_t( 0.25*L ) - S.s_to_t( -0.75*L ) ) < 1e-12*S.xMax();
+    S.CatmullRom();
+    wrap = wrap && !S.hasArcLength();
+    cout << "  " << ( wrap ? "ok\n" : "FAILED\n" );
+    ok = ok && wrap;
+  }
+
+  cout << "TEST 25.5 equidistant points, scalar queries against the cursor\n";
+  {
+    SplineVec S("spiral");
+    build_spiral( S, 5000 );
+    S.buildArcLength();
+    integer const n = 200000;
+    real_type L = S.length();
+    vector<real_type> V( 2*n );
+    double tA = 1e300, tB = 1e300;
+    real_type sum = 0;
+    for ( integer r = 0; r < 3; ++r ) {
+      auto t0 = chrono::high_resolution_clock::now();
+      for ( integer k = 0; k < n; ++k )
+        S.eval_at_arclength( (L*k)/(n-1), &V[2*k], 1 );
+      auto t1 = chrono::high_resolution_clock::now();
+      S.sample_arclength( n, &V.front(), 2 );
+      auto t2 = chrono::high_resolution_clock::now();
+      sum += V[n];
+      tA = min( tA, chrono::duration<double,milli>(t1-t0).count() );
+      tB = min( tB, chrono::duration<double,milli>(t2-t1).count() );
+    }
+    cout << setprecision(4)
+         << "  scalar " << setw(8) << tA << " ms\n"
+         << "  cursor " << setw(8) << tB << " ms\n"
+         << "  (checksum " << sum << ")\n";
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
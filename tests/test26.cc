@@ -0,0 +1,215 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// winding road with `dim` components on `npts` points, chord length knots
+static
+void
+build_road( SplineVec & S, integer dim, integer npts ) {
+  vector<real_type> P( size_t(dim*npts) ), T( npts );
+  real_type x = 0, y = 0, z = 0;
+  for ( integer i = 0; i < npts; ++i ) {
+    real_type a = 0.7*sin(0.05*i) + 0.4*sin(0.013*i+1);
+    x += 10*cos(a); y += 10*sin(a); z = 5*sin(0.02*i);
+    P[dim*i] = x; P[dim*i+1] = y;
+    if ( dim > 2 ) P[dim*i+2] = z;
+  }
+  T[0] = 0;
+  for ( integer i = 1; i < npts; ++i ) {
+    real_type l = 0;
+    for ( integer k = 0; k < dim; ++k )
+      l += (P[dim*i+k]-P[dim*i-dim+k])*(P[dim*i+k]-P[dim*i-dim+k]);
+    T[i] = T[i-1] + sqrt(l);
+  }
+  S.setup( dim, npts, &P.front(), dim );
+  S.setKnots( &T.front() );
+  S.CatmullRom();
+}
+
+// pseudo random points around the curve
+static
+void
+gps_points( SplineVec const & S, integer n, vector<real_type> & P, bool trace ) {
+  integer dim = S.dimension();
+  P.resize( size_t(dim*n) );
+  vector<real_type> v( dim );
+  for ( integer k = 0; k < n; ++k ) {
+    real_type r = (k*0.618034)-floor(k*0.618034);
+    real_type t = S.xMin() + (S.xMax()-S.xMin())*( trace ? real_type(k)/n : r );
+    S.eval( t, &v.front(), 1 );
+    for ( integer j = 0; j < dim; ++j )
+      P[dim*k+j] = v[j] + 8*sin( 12.9898*k + 78.233*j );
+  }
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.26\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 26.1 against dense sampling of the curve\n";
+  for ( integer dim = 2; dim <= 3; ++dim ) {
+    SplineVec S("road");
+    build_road( S, dim, 400 );
+    SplineVecBVH B( S );
+    integer const ns = 400000, nq = 300;
+    vector<real_type> C( size_t(dim*(ns+1)) ), P, q( dim ), v( dim );
+    for ( integer k = 0; k <= ns; ++k )
+      S.eval( S.xMin() + ((S.xMax()-S.xMin())*k)/ns, &C[dim*k], 1 );
+    gps_points( S, nq, P, false );
+    real_type worse = 0, better = 0, onc = 0;
+    for ( integer k = 0; k < nq; ++k ) {
+      real_type const * p = &P[dim*k];
+      real_type dmin = 1e300;
+      for ( integer m = 0; m <= ns; ++m ) {
+        real_type l = 0;
+        for ( integer j = 0; j < dim; ++j ) l += (C[dim*m+j]-p[j])*(C[dim*m+j]-p[j]);
+        dmin = min( dmin, l );
+      }
+      dmin = sqrt(dmin);
+      real_type t;
+      real_type d = B.closestPoint( p, t, &q.front() );
+      S.eval( t, &v.front(), 1 );
+      real_type e = 0, l = 0;
+      for ( integer j = 0; j < dim; ++j ) {
+        e = max( e, abs( v[j]-q[j] ) );
+        l += (q[j]-p[j])*(q[j]-p[j]);
+      }
+      onc    = max( onc, max( e, abs( sqrt(l)-d ) ) );
+      worse  = max( worse, d-dmin );
+      better = max( better, dmin-d );
+    }
+    cout << "  dim = " << dim << " nodes " << B.numNodes()
+         << "\n    worse than sampling  " << worse
+         << "\n    better than sampling " << better
+         << "\n    point on the curve   " << onc << '\n';
+    // the dense samples are ~0.01 apart
+    ok = ok && worse <= 1e-10 && better < 0.005 && onc < 1e-10;
+  }
+
+  cout << "TEST 26.2 tracking and threads give the same distances\n";
+  {
+    SplineVec S("road");
+    build_road( S, 2, 2000 );
+    SplineVecBVH B( S );
+    integer const n = 20000;
+    vector<real_type> P, t0( n ), d0( n ), t1( n ), d1( n ), t2( n ), d2( n );
+    gps_points( S, n, P, true );
+    B.closestPoints( n, &P.front(), 2, &t0.front(), &d0.front() );
+    B.closestPoints( n, &P.front(), 2, &t1.front(), &d1.front(), nullptr, 0, true );
+    B.closestPoints( n, &P.front(), 2, &t2.front(), &d2.front(), nullptr, 0, true, 4 );
+    real_type err = 0;
+    for ( integer k = 0; k < n; ++k )
+      err = max( err, max( abs(d0[k]-d1[k]), abs(d0[k]-d2[k]) ) );
+    cout << "  max difference " << err << '\n';
+    ok = ok && err < 1e-12;
+  }
+
+  cout << "TEST 26.3 segments with loops, several local minima\n";
+  {
+    // uneven knots make loops and hairpins inside one segment, the
+    // nearest sample of a coarse scan can be in the wrong basin
+    mt19937 gen(7);
+    uniform_real_distribution<real_type> U(0,1);
+    integer const ncurves = 300, ns = 20000;
+    integer   nbad  = 0;
+    real_type worse = 0;
+    for ( integer c = 0; c < ncurves; ++c ) {
+      integer const n = 4;
+      vector<real_type> P( 2*n ), T( n ), C( 2*(ns+1) ), q( 2 );
+      for ( integer i = 0; i < n; ++i ) {
+        P[2*i] = 4*U(gen); P[2*i+1] = 4*U(gen);
+        T[i]   = i == 0 ? 0 : T[i-1] + 0.05 + U(gen);
+      }
+      SplineVec S("loops");
+      S.setup( 2, n, &P.front(), 2 );
+      S.setKnots( &T.front() );
+      S.buildCubic();
+      SplineVecBVH B( S );
+      for ( integer k = 0; k <= ns; ++k )
+        S.eval( S.xMin() + ((S.xMax()-S.xMin())*k)/ns, &C[2*k], 1 );
+      for ( integer k = 0; k < 5; ++k ) {
+        real_type p[2] = { 4*U(gen), 4*U(gen) };
+        real_type dmin = 1e300;
+        for ( integer m = 0; m <= ns; ++m )
+          dmin = min( dmin, (C[2*m]-p[0])*(C[2*m]-p[0])+(C[2*m+1]-p[1])*(C[2*m+1]-p[1]) );
+        real_type t;
+        real_type e = B.closestPoint( p, t, &q.front() ) - sqrt(dmin);
+        worse = max( worse, e );
+        if ( e > 1e-10 ) ++nbad;
+      }
+    }
+    cout << "  worse than sampling " << worse << ", " << nbad
+         << " of " << 5*ncurves << " queries\n";
+    ok = ok && nbad == 0;
+  }
+
+  cout << "TEST 26.4 one million GPS points on a 100000 points road\n";
+  {
+    SplineVec S("road");
+    build_road( S, 2, 100000 );
+    auto tb0 = chrono::high_resolution_clock::now();
+    SplineVecBVH B( S );
+    auto tb1 = chrono::high_resolution_clock::now();
+    integer const n = 1000000;
+    vector<real_type> P, R, t( n ), d( n );
+    gps_points( S, n, P, true );
+    gps_points( S, n, R, false );
+    cout << setprecision(4) << "  build "
+         << chrono::duration<double,milli>(tb1-tb0).count() << " ms\n";
+    real_type sum = 0;
+    for ( integer q = 0; q < 3; ++q ) {
+      double tq = 1e300;
+      for ( integer r = 0; r < 3; ++r ) {
+        auto t0 = chrono::high_resolution_clock::now();
+        if ( q == 0 ) B.closestPoints( n, &R.front(), 2, &t.front(), &d.front() );
+        if ( q == 1 ) B.closestPoints( n, &P.front(), 2, &t.front(), &d.front() );
+        if ( q == 2 ) B.closestPoints( n, &P.front(), 2, &t.front(), &d.front(), nullptr, 0, true );
+        auto t1 = chrono::high_resolution_clock::now();
+        tq = min( tq, chrono::duration<double,milli>(t1-t0).count() );
+        sum += d[n/2];
+      }
+      char const * what[] = { "random    ", "trace     ", "trace warm" };
+      cout << "  " << what[q] << setw(8) << n/tq/1000 << " Mqueries/s\n";
+    }
+    cout << "  (checksum " << sum << ")\n";
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
@@ -0,0 +1,231 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+using Splines::HermiteSpline;
+using Splines::curvature;
+using Splines::curvature_D;
+using Splines::curvature_DD;
+
+// ellipse of semiaxes `a`, `b` with `npts` points, chord length knots
+static
+void
+build_ellipse(
+  SplineVec & S,
+  integer     npts,
+  real_type   a,
+  real_type   b,
+  bool        interleaved
+) {
+  vector<real_type> P( size_t(2*npts) ), T( npts );
+  for ( integer i = 0; i < npts; ++i ) {
+    real_type th = 6.283185307179586*i/(npts-1);
+    P[2*i]   = a*cos(th);
+    P[2*i+1] = b*sin(th);
+  }
+  T[0] = 0;
+  for ( integer i = 1; i < npts; ++i )
+    T[i] = T[i-1] + hypot( P[2*i]-P[2*i-2], P[2*i+1]-P[2*i-1] );
+  S.useInterleaved( interleaved );
+  S.setup( 2, npts, &P.front(), 2 );
+  S.setKnots( &T.front() );
+  S.CatmullRom();
+}
+
+// jet against the separate calls, bitwise
+static
+bool
+same_jet( Spline const & S, integer n ) {
+  bool ok = true;
+  real_type J[6];
+  for ( integer k = 0; k <= n; ++k ) {
+    real_type x = S.xMin() + ((S.xMax()-S.xMin())*k)/n;
+    S.jet( x, 5, J );
+    ok = ok && J[0] == S(x)       && J[1] == S.D(x)    && J[2] == S.DD(x) &&
+               J[3] == S.DDD(x)   && J[4] == S.DDDD(x) && J[5] == S.DDDDD(x);
+  }
+  return ok;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.27\n\n";
+
+  bool ok = true;
+
+  vector<real_type> xx(30), yy(30);
+  for ( integer i = 0; i < 30; ++i ) {
+    xx[i] = i + 0.3*sin(real_type(i));
+    yy[i] = sin(0.4*i) + 0.1*i;
+  }
+
+  cout << "TEST 27.1 jet against the separate derivatives\n";
+  {
+    CubicSpline   C; C.build( &xx.front(), &yy.front(), 30 );
+    QuinticSpline Q; Q.build( &xx.front(), &yy.front(), 30 );
+    PchipSpline   P; P.build( &xx.front(), &yy.front(), 30 );
+    LinearSpline  L; L.build( &xx.front(), &yy.front(), 30 );
+    bool same = same_jet( C, 997 ) && same_jet( Q, 997 ) &&
+                same_jet( P, 997 ) && same_jet( L, 997 );
+    cout << "  " << ( same ? "identical\n" : "DIFFERENT\n" );
+    ok = ok && same;
+  }
+
+  cout << "TEST 27.2 SplineVec against a pair of Hermite splines\n";
+  for ( integer il = 0; il < 2; ++il ) {
+    SplineVec S("ellipse");
+    build_ellipse( S, 101, 3, 1, il == 1 );
+    integer n = S.numPoints();
+    vector<real_type> X(n), Y(n), DX(n), DY(n);
+    for ( integer i = 0; i < n; ++i ) {
+      X[i]  = S.yNode( i, 0 );  Y[i]  = S.yNode( i, 1 );
+      DX[i] = S.ypNode( i, 0 ); DY[i] = S.ypNode( i, 1 );
+    }
+    HermiteSpline HX, HY;
+    HX.build( S.xNodes(), 1, &X.front(), 1, &DX.front(), 1, n );
+    HY.build( S.xNodes(), 1, &Y.front(), 1, &DY.front(), 1, n );
+    integer const m = 1000;
+    vector<real_type> t( m ), k0( m ), k1( m ), k2( m );
+    for ( integer k = 0; k < m; ++k ) t[k] = S.xMin() + ((S.xMax()-S.xMin())*k)/m;
+    bool same = true;
+    for ( integer d = 0; d < 3; ++d ) {
+      if ( d == 0 ) { S.curvature( m, &t.front(), &k0.front() ); curvature( m, &t.front(), HX, HY, &k1.front() ); }
+      if ( d == 1 ) { S.curvature_D( m, &t.front(), &k0.front() ); curvature_D( m, &t.front(), HX, HY, &k1.front() ); }
+      if ( d == 2 ) { S.curvature_DD( m, &t.front(), &k0.front() ); curvature_DD( m, &t.front(), HX, HY, &k1.front() ); }
+      for ( integer k = 0; k < m; ++k ) {
+        if ( d == 0 ) k2[k] = S.curvature( t[k] );
+        if ( d == 1 ) k2[k] = S.curvature_D( t[k] );
+        if ( d == 2 ) k2[k] = S.curvature_DD( t[k] );
+      }
+      same = same && k0 == k1 && k0 == k2;
+    }
+    // the derivative of the curvature against finite differences
+    real_type h = 1e-5, err = 0;
+    for ( integer k = 1; k < m; k += 37 ) {
+      real_type fd = ( S.curvature(t[k]+h) - S.curvature(t[k]-h) )/(2*h);
+      err = max( err, abs( fd - S.curvature_D(t[k]) ) );
+    }
+    cout << ( il == 0 ? "  split      " : "  interleaved" )
+         << ( same ? " identical" : " DIFFERENT" )
+         << ", finite differences " << err << '\n';
+    ok = ok && same && err < 1e-6;
+  }
+
+  cout << "TEST 27.3 curvature extrema of an ellipse\n";
+  {
+    SplineVec S("ellipse");
+    build_ellipse( S, 101, 3, 1, false );
+    S.buildCurvatureTable();
+    // dense sampling of each segment
+    real_type err = 0, kmax_all = 0;
+    for ( integer i = 0; i+1 < S.numPoints(); ++i ) {
+      real_type kmin, tmin, kmax, tmax, smin = 1e300, smax = -1e300;
+      S.curvatureExtrema( i, kmin, tmin, kmax, tmax );
+      // the curvature jumps at the knots, `curvature` there is of the next
+      // segment: interior samples only
+      for ( integer k = 1; k < 2000; ++k ) {
+        real_type kap = S.curvature( S.xNode(i) + ((S.xNode(i+1)-S.xNode(i))*k)/2000 );
+        smin = min( smin, kap );
+        smax = max( smax, kap );
+      }
+      // the table is never worse than the samples and lies on the curve
+      err = max( err, max( kmin-smin, smax-kmax ) );
+      if ( tmin > S.xNode(i) && tmin < S.xNode(i+1) )
+        err = max( err, abs( kmin - S.curvature( tmin ) ) );
+      if ( tmax > S.xNode(i) && tmax < S.xNode(i+1) )
+        err = max( err, abs( kmax - S.curvature( tmax ) ) );
+      kmax_all = max( kmax_all, kmax );
+    }
+    real_type bound = S.maxAbsCurvature( S.xMin(), S.xMax() );
+    // maximum of the ellipse is a/b^2 = 3, Catmull-Rom overshoots at the knots
+    cout << "  table against samples " << err
+         << "\n  max curvature " << kmax_all << " (ellipse 3), bound " << bound
+         << "\n  bound on [0,1] " << S.maxAbsCurvature( 0, 1 ) << '\n';
+    ok = ok && err < 1e-12 && bound == kmax_all && abs(kmax_all-3) < 0.3 &&
+         S.maxAbsCurvature( 0, 1 ) >= S.curvature( 0.5 );
+    S.CatmullRom();
+    ok = ok && !S.hasCurvatureTable();
+  }
+
+  cout << "TEST 27.4 timing, 1000000 curvature_DD\n";
+  {
+    integer const n = 1000000;
+    SplineVec S("ellipse");
+    build_ellipse( S, 10000, 3, 1, false );
+    integer np = S.numPoints();
+    vector<real_type> X(np), Y(np), DX(np), DY(np);
+    for ( integer i = 0; i < np; ++i ) {
+      X[i]  = S.yNode( i, 0 );  Y[i]  = S.yNode( i, 1 );
+      DX[i] = S.ypNode( i, 0 ); DY[i] = S.ypNode( i, 1 );
+    }
+    HermiteSpline HX, HY;
+    HX.build( S.xNodes(), 1, &X.front(), 1, &DX.front(), 1, np );
+    HY.build( S.xNodes(), 1, &Y.front(), 1, &DY.front(), 1, np );
+    vector<real_type> t( n ), k( n );
+    for ( integer j = 0; j < n; ++j ) t[j] = S.xMin() + ((S.xMax()-S.xMin())*j)/n;
+    double tm[4] = { 1e300, 1e300, 1e300, 1e300 };
+    real_type sum = 0;
+    for ( integer r = 0; r < 3; ++r ) {
+      auto t0 = chrono::high_resolution_clock::now();
+      for ( integer j = 0; j < n; ++j ) {
+        // the separate calls, as before the jets
+        real_type x_1 = HX.D(t[j]), x_2 = HX.DD(t[j]), x_3 = HX.DDD(t[j]), x_4 = HX.DDDD(t[j]);
+        real_type y_1 = HY.D(t[j]), y_2 = HY.DD(t[j]), y_3 = HY.DDD(t[j]), y_4 = HY.DDDD(t[j]);
+        sum += x_1+x_2+x_3+x_4+y_1+y_2+y_3+y_4;
+      }
+      auto t1 = chrono::high_resolution_clock::now();
+      for ( integer j = 0; j < n; ++j ) sum += curvature_DD( t[j], HX, HY );
+      auto t2 = chrono::high_resolution_clock::now();
+      for ( integer j = 0; j < n; ++j ) sum += S.curvature_DD( t[j] );
+      auto t3 = chrono::high_resolution_clock::now();
+      S.curvature_DD( n, &t.front(), &k.front() );
+      auto t4 = chrono::high_resolution_clock::now();
+      sum += k[n/2];
+      tm[0] = min( tm[0], chrono::duration<double,milli>(t1-t0).count() );
+      tm[1] = min( tm[1], chrono::duration<double,milli>(t2-t1).count() );
+      tm[2] = min( tm[2], chrono::duration<double,milli>(t3-t2).count() );
+      tm[3] = min( tm[3], chrono::duration<double,milli>(t4-t3).count() );
+    }
+    cout << setprecision(4)
+         << "  8 separate calls    " << setw(8) << tm[0] << " ms\n"
+         << "  Spline pair, jets   " << setw(8) << tm[1] << " ms\n"
+         << "  SplineVec           " << setw(8) << tm[2] << " ms\n"
+         << "  SplineVec batch     " << setw(8) << tm[3] << " ms\n"
+         << "  (checksum " << sum << ")\n";
+  }
+
+  if ( !ok ) return 1;
+
+  cout << "ALL DONE!\n\n\n\n";
+
+  return 0;
+}
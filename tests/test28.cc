@@ -0,0 +1,277 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static char const * pnames[] = {
+  "uniform", "chordal", "centripetal", "universal", "FoleyNielsen", "FangHung"
+};
+
+static
+void
+parametrize(
+  integer         kind,
+  integer         dim,
+  integer         npts,
+  real_type const P[],
+  integer         ldP,
+  real_type       t[]
+) {
+  switch ( kind ) {
+  case 0: Splines::uniform( dim, npts, P, ldP, t );           break;
+  case 1: Splines::chordal( dim, npts, P, ldP, t );           break;
+  case 2: Splines::centripetal( dim, npts, P, ldP, 0.5, t );  break;
+  case 3: Splines::universal( dim, npts, P, ldP, t );         break;
+  case 4: Splines::FoleyNielsen( dim, npts, P, ldP, t );      break;
+  case 5: Splines::FangHung( dim, npts, P, ldP, t );          break;
+  }
+}
+
+static
+real_type
+max_diff( vector<real_type> const & a, vector<real_type> const & b ) {
+  real_type err = 0;
+  for ( size_t i = 0; i < a.size(); ++i ) err = max( err, abs(a[i]-b[i]) );
+  return err;
+}
+
+// first order distance of (x,y) from the ellipse of semiaxes a, b
+static
+real_type
+ellipse_dist( real_type x, real_type y, real_type a, real_type b ) {
+  real_type f  = (x*x)/(a*a) + (y*y)/(b*b) - 1;
+  real_type gx = 2*x/(a*a);
+  real_type gy = 2*y/(b*b);
+  return abs(f)/hypot(gx,gy);
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.28\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 28.1 known cases\n";
+  {
+    // collinear graded points in 3D, stored with a padding column
+    integer const n = 9, ld = 4;
+    vector<real_type> P( n*ld, 99 ), ref( n ), t( n );
+    for ( integer i = 0; i < n; ++i ) {
+      real_type s = i*i*0.25;
+      P[i*ld+0] = 1+s; P[i*ld+1] = 2-2*s; P[i*ld+2] = 2*s;
+      ref[i]    = s/((n-1)*(n-1)*0.25);
+    }
+    Splines::chordal( 3, n, &P.front(), ld, &t.front() );
+    real_type e1 = max_diff( t, ref );
+    Splines::centripetal( 3, n, &P.front(), ld, 1.0, &t.front() );
+    real_type e2 = max_diff( t, ref );
+    // straight line: no turning angles, Foley-Nielsen is chordal
+    Splines::FoleyNielsen( 3, n, &P.front(), ld, &t.front() );
+    real_type e3 = max_diff( t, ref );
+    vector<real_type> tc( n );
+    Splines::centripetal( 3, n, &P.front(), ld, 0.5, &tc.front() );
+    Splines::FangHung( 3, n, &P.front(), ld, &t.front() );
+    real_type e4 = max_diff( t, tc );
+    Splines::uniform( 3, n, &P.front(), ld, &t.front() );
+    for ( integer i = 0; i < n; ++i ) ref[i] = real_type(i)/(n-1);
+    real_type e5 = max_diff( t, ref );
+    cout << "  chordal " << e1 << ", centripetal(1) " << e2
+         << ", Foley-Nielsen " << e3 << ", Fang-Hung " << e4
+         << ", uniform " << e5 << '\n';
+    ok = ok && e1 < 1e-15 && e2 < 1e-15 && e3 < 1e-15 && e4 < 1e-15 && e5 == 0;
+
+    // square corners: the turning angles are pi/2
+    real_type Q[] = { 0, 0, 1, 0, 1, 1, 0, 1 };
+    real_type const pi = 3.141592653589793;
+    real_type l0 = 1+3*pi/8, l1 = 1+3*pi/4;
+    Splines::FoleyNielsen( 2, 4, Q, 2, &t.front() );
+    real_type e6 = max( abs( t[1] - l0/(2*l0+l1) ),
+                        abs( t[2] - (l0+l1)/(2*l0+l1) ) );
+    cout << "  Foley-Nielsen on a square " << e6 << '\n';
+    ok = ok && e6 < 1e-15;
+
+    // universal: maxima of the clamped uniform cubic B-splines
+    Splines::universal( 2, 4, Q, 2, &t.front() );
+    real_type e7 = max( abs( t[1] - 1.0/3 ), abs( t[2] - 2.0/3 ) );
+    integer const m = 12;
+    vector<real_type> tu( m );
+    Splines::universal( 2, m, Q, 2, &tu.front() );
+    for ( integer i = 0; i < m; ++i ) {
+      e7 = max( e7, abs( tu[i] + tu[m-1-i] - 1 ) );
+      if ( i > 0 ) ok = ok && tu[i] > tu[i-1];
+      if ( i >= 3 && i <= m-4 ) e7 = max( e7, abs( tu[i] - real_type(i-1)/(m-3) ) );
+    }
+    cout << "  universal " << e7 << " (";
+    for ( integer i = 0; i < 3; ++i ) cout << tu[i] << ' ';
+    cout << "...)\n";
+    ok = ok && e7 < 1e-12;
+
+    // coincident points fall back to the uniform knots
+    real_type Z[] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+    Splines::chordal( 2, 4, Z, 2, &t.front() );
+    bool uni = t[0] == 0 && t[1] == 1.0/3 && t[2] == 2.0/3 && t[3] == 1;
+    cout << "  coincident points " << ( uni ? "uniform\n" : "WRONG\n" );
+    ok = ok && uni;
+  }
+
+  cout << "TEST 28.2 SplineVec knots against the free functions\n";
+  {
+    integer const n = 50;
+    for ( integer dim = 2; dim <= 5; ++dim ) {
+      vector<real_type> P( n*dim ), t( n );
+      for ( integer i = 0; i < n; ++i )
+        for ( integer j = 0; j < dim; ++j )
+          P[i*dim+j] = sin( 0.3*i*(j+1) + j ) + 0.01*i*i;
+      SplineVec S("knots");
+      S.setup( dim, n, &P.front(), dim );
+      bool same = true;
+      for ( integer kind = 1; kind <= 4; ++kind ) {
+        if ( kind == 3 ) continue;
+        parametrize( kind, dim, n, &P.front(), dim, &t.front() );
+        if ( kind == 1 ) S.setKnotsChordLength();
+        if ( kind == 2 ) S.setKnotsCentripetal();
+        if ( kind == 4 ) S.setKnotsFoley();
+        for ( integer i = 0; i < n; ++i ) same = same && t[i] == S.xNode(i);
+      }
+      cout << "  dim " << dim << ( same ? " identical\n" : " DIFFERENT\n" );
+      ok = ok && same;
+    }
+  }
+
+  cout << "TEST 28.3 curve quality, Catmull-Rom through irregular samples\n";
+  {
+    // ellipse 3 x 1 sampled with clustered angles, and a spiral with
+    // alternating short and long chords
+    real_type const a = 3, b = 1;
+    integer   const n = 41;
+    vector<real_type> P( 2*n ), t( n );
+    real_type err[6];
+    for ( integer c = 0; c < 2; ++c ) {
+      for ( integer i = 0; i < n; ++i ) {
+        real_type s = real_type(i)/(n-1);
+        if ( c == 0 ) {
+          real_type th = 6.283185307179586*( s + 0.05*sin(6.283185307179586*3*s) );
+          P[2*i] = a*cos(th); P[2*i+1] = b*sin(th);
+        } else {
+          real_type th = 4*3.141592653589793*( s + ( i%2 == 1 ? 0.3/(n-1) : 0 ) );
+          P[2*i] = (1+th)*cos(th); P[2*i+1] = (1+th)*sin(th);
+        }
+      }
+      cout << ( c == 0 ? "  ellipse, distance from the curve\n"
+                       : "  spiral, distance from the curve\n" );
+      for ( integer kind = 0; kind < 6; ++kind ) {
+        parametrize( kind, 2, n, &P.front(), 2, &t.front() );
+        SplineVec S("quality");
+        S.setup( 2, n, &P.front(), 2 );
+        S.setKnots( &t.front() );
+        S.CatmullRom();
+        real_type e = 0;
+        for ( integer k = 0; k <= 20000; ++k ) {
+          real_type tt = (S.xMax()*k)/20000, x = S(tt,0), y = S(tt,1);
+          if ( c == 0 ) {
+            e = max( e, ellipse_dist( x, y, a, b ) );
+          } else {
+            // distance from the Archimedes spiral r = 1 + theta, along the radius
+            real_type r  = hypot( x, y );
+            real_type th = atan2( y, x );
+            real_type d  = 1e300;
+            for ( integer w = -1; w <= 3; ++w )
+              d = min( d, abs( r - 1 - th - 6.283185307179586*w ) );
+            e = max( e, d );
+          }
+        }
+        err[kind] = e;
+        cout << "    " << setw(14) << left << pnames[kind] << right << e << '\n';
+      }
+      // samples near uniform in the angle favour the uniform knots on the
+      // ellipse, with uneven chords the geometric parametrizations win
+      if ( c == 0 ) {
+        for ( integer kind = 0; kind < 6; ++kind ) ok = ok && err[kind] < 0.05;
+      } else {
+        for ( integer kind = 1; kind < 6; ++kind )
+          if ( kind != 3 ) ok = ok && err[kind] < err[0];
+      }
+    }
+  }
+
+  cout << "TEST 28.4 timing, 10000000 points\n";
+  {
+    integer const n = 10000000;
+    for ( integer dim = 2; dim <= 3; ++dim ) {
+      vector<real_type> P( size_t(n)*dim ), t( n ), tr( n );
+      for ( integer i = 0; i < n; ++i )
+        for ( integer j = 0; j < dim; ++j )
+          P[size_t(i)*dim+j] = sin( 1e-5*i*(j+1) ) + 1e-7*i;
+      cout << "  dim " << dim << '\n';
+      // reference: scalar loop recomputing the distances
+      double best = 1e300;
+      for ( integer r = 0; r < 3; ++r ) {
+        auto t0 = chrono::high_resolution_clock::now();
+        tr[0] = 0;
+        for ( integer k = 1; k < n; ++k ) {
+          real_type const * p0 = &P[size_t(k-1)*dim];
+          real_type const * p1 = p0 + dim;
+          real_type dst = 0;
+          for ( integer j = 0; j < dim; ++j ) {
+            real_type c = p1[j] - p0[j];
+            dst += c*c;
+          }
+          tr[k] = tr[k-1] + sqrt(dst);
+        }
+        for ( integer k = 1; k < n-1; ++k ) tr[k] /= tr[n-1];
+        tr[n-1] = 1;
+        auto t1 = chrono::high_resolution_clock::now();
+        best = min( best, chrono::duration<double,milli>(t1-t0).count() );
+      }
+      cout << "    " << setw(14) << left << "scalar loop" << right
+           << setw(8) << fixed << setprecision(2) << best << " ms\n";
+      for ( integer kind = 0; kind < 6; ++kind ) {
+        best = 1e300;
+        for ( integer r = 0; r < 3; ++r ) {
+          auto t0 = chrono::high_resolution_clock::now();
+          parametrize( kind, dim, n, &P.front(), dim, &t.front() );
+          auto t1 = chrono::high_resolution_clock::now();
+          best = min( best, chrono::duration<double,milli>(t1-t0).count() );
+        }
+        cout << "    " << setw(14) << left << pnames[kind] << right
+             << setw(8) << best << " ms\n";
+        if ( kind == 1 ) ok = ok && max_diff( t, tr ) < 1e-12;
+      }
+      cout.unsetf( ios::fixed );
+      cout << setprecision(6);
+    }
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static Splines::CUBIC_SPLINE_TYPE_BC const bcs[] = {
+  Splines::EXTRAPOLATE_BC, Splines::NATURAL_BC,
+  Splines::PARABOLIC_RUNOUT_BC, Splines::NOT_A_KNOT
+};
+
+int
+main() {
+
+  cout << "\n\nTEST N.29\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 29.1 SplineVec::buildCubic against a CubicSpline per component\n";
+  {
+    integer const n = 40, dim = 3;
+    vector<real_type> P( n*dim ), T( n ), C( n );
+    for ( integer i = 0; i < n; ++i ) {
+      P[i*dim+0] = cos(0.2*i) + 0.01*i*i;
+      P[i*dim+1] = sin(0.3*i);
+      P[i*dim+2] = 0.1*i;
+    }
+    for ( Splines::CUBIC_SPLINE_TYPE_BC bc : bcs ) {
+      SplineVec S("vec");
+      S.setup( dim, n, &P.front(), dim );
+      S.setKnotsCentripetal();
+      S.buildCubic( bc, bc );
+      bool same = true;
+      for ( integer j = 0; j < dim; ++j ) {
+        for ( integer i = 0; i < n; ++i ) C[i] = P[i*dim+j];
+        CubicSpline CS;
+        CS.setInitialBC( bc );
+        CS.setFinalBC( bc );
+        CS.build( S.xNodes(), &C.front(), n );
+        for ( integer i = 0; i < n; ++i ) same = same && CS.ypNode(i) == S.ypNode(i,j);
+      }
+      cout << "  bc = " << bc << ( same ? " identical\n" : " DIFFERENT\n" );
+      ok = ok && same;
+    }
+  }
+
+  cout << "TEST 29.2 a cubic is reproduced by not-a-knot\n";
+  // uniform and perturbed knots, on uniform knots the not-a-knot rows
+  // must not leave a zero pivot
+  for ( integer k = 0; k < 2; ++k ) {
+    real_type const pert = 0.3*k;
+    for ( integer n = 4; n <= 10; n += 3 ) {
+      vector<real_type> P( 2*n ), T( n );
+      for ( integer i = 0; i < n; ++i ) {
+        real_type t = T[i] = i + pert*sin(real_type(i));
+        P[2*i]   = t*t*t - 2*t + 1;
+        P[2*i+1] = 0.5*t*t*t + t*t;
+      }
+      SplineVec S("nak");
+      S.setup( 2, n, &P.front(), 2 );
+      S.setKnots( &T.front() );
+      S.buildCubic( Splines::NOT_A_KNOT, Splines::NOT_A_KNOT );
+      real_type err = 0;
+      for ( integer j = 0; j <= 200; ++j ) {
+        real_type t = S.xMin() + ((S.xMax()-S.xMin())*j)/200;
+        err = max( err, abs( S(t,0) - (t*t*t - 2*t + 1) ) );
+        err = max( err, abs( S(t,1) - (0.5*t*t*t + t*t) ) );
+        err = max( err, abs( S.DD(t,1) - (3*t + 2) ) );
+      }
+      cout << "  knots " << ( k == 0 ? "uniform  " : "perturbed" )
+           << " npts " << n << " max error " << err << '\n';
+      ok = ok && err < 1e-11;
+    }
+  }
+
+  cout << "TEST 29.3 closed curve, C2 at the seam\n";
+  {
+    // ellipse with the first point repeated
+    integer const n = 33;
+    real_type const a = 2, b = 1;
+    vector<real_type> P( 2*n );
+    for ( integer i = 0; i < n; ++i ) {
+      real_type th = 6.283185307179586*(i%(n-1))/(n-1) + 0.1*sin(real_type(i%(n-1)));
+      P[2*i]   = a*cos(th);
+      P[2*i+1] = b*sin(th);
+    }
+    SplineVec S("closed");
+    S.setup( 2, n, &P.front(), 2 );
+    S.setKnotsChordLength();
+    S.make_closed();
+    S.buildCubic();
+    // one sided limits of D and DD, exact on each cubic piece
+    real_type jmp = 0, h = 1e-6;
+    for ( integer j = 0; j < 2; ++j ) {
+      for ( integer i = 1; i < n; ++i ) {
+        // at the seam the right side is the beginning of the first segment
+        real_type xl = S.xNode(i)-h;
+        real_type xr = i+1 < n ? S.xNode(i)+h : S.xMin()+h;
+        real_type dl = S.D(xl,j)  + h*S.DD(xl,j) + (h*h/2)*S.DDD(xl,j);
+        real_type dr = S.D(xr,j)  - h*S.DD(xr,j) + (h*h/2)*S.DDD(xr,j);
+        real_type ddl = S.DD(xl,j) + h*S.DDD(xl,j);
+        real_type ddr = S.DD(xr,j) - h*S.DDD(xr,j);
+        jmp = max( jmp, max( abs(dl-dr), abs(ddl-ddr) ) );
+      }
+    }
+    real_type dist_closed = 0, dist_open = 0;
+    SplineVec O("open");
+    O.setup( 2, n, &P.front(), 2 );
+    O.setKnotsChordLength();
+    O.buildCubic();
+    for ( integer k = 0; k <= 4000; ++k ) {
+      real_type t = (S.xMax()*k)/4000;
+      real_type x = S(t,0)/a, y = S(t,1)/b;
+      dist_closed = max( dist_closed, abs( x*x + y*y - 1 ) );
+      x = O(t,0)/a; y = O(t,1)/b;
+      dist_open = max( dist_open, abs( x*x + y*y - 1 ) );
+    }
+    cout << "  jump of D, DD " << jmp
+         << "\n  ellipse residual, closed " << dist_closed
+         << " open " << dist_open << '\n';
+    ok = ok && jmp < 1e-9 && dist_closed < dist_open;
+  }
+
+  cout << "TEST 29.4 timing, 1000000 points in 3D\n";
+  {
+    integer const n = 1000000, dim = 3;
+    vector<real_type> P( size_t(n)*dim ), C( n );
+    for ( integer i = 0; i < n; ++i )
+      for ( integer j = 0; j < dim; ++j )
+        P[size_t(i)*dim+j] = sin( 1e-4*i*(j+1) );
+    SplineVec S("timing");
+    S.setup( dim, n, &P.front(), dim );
+    S.setKnotsChordLength();
+    double tv = 1e300, tc = 1e300;
+    for ( integer r = 0; r < 3; ++r ) {
+      auto t0 = chrono::high_resolution_clock::now();
+      S.buildCubic();
+      auto t1 = chrono::high_resolution_clock::now();
+      for ( integer j = 0; j < dim; ++j ) {
+        for ( integer i = 0; i < n; ++i ) C[i] = P[size_t(i)*dim+j];
+        CubicSpline CS;
+        CS.build( S.xNodes(), &C.front(), n );
+      }
+      auto t2 = chrono::high_resolution_clock::now();
+      tv = min( tv, chrono::duration<double,milli>(t1-t0).count() );
+      tc = min( tc, chrono::duration<double,milli>(t2-t1).count() );
+    }
+    cout << fixed << setprecision(2)
+         << "  buildCubic          " << setw(8) << tv << " ms\n"
+         << "  CubicSpline per dim " << setw(8) << tc << " ms\n";
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
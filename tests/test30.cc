@@ -0,0 +1,280 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static real_type const m_2pi = 6.283185307179586;
+
+int
+main() {
+
+  cout << "\n\nTEST N.30\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 30.1 periodic CubicSpline on a periodic function\n";
+  {
+    integer const n = 21;
+    vector<real_type> X( n ), Y( n );
+    for ( integer i = 0; i < n; ++i ) {
+      X[i] = m_2pi*i/(n-1) + ( i > 0 && i+1 < n ? 0.05*sin(real_type(3*i)) : 0 );
+      Y[i] = sin(X[i]) + 0.3*cos(2*X[i]);
+    }
+    Y[n-1] = Y[0];
+    CubicSpline P, N;
+    P.setInitialBC( Splines::PERIODIC_BC );
+    P.setFinalBC( Splines::PERIODIC_BC );
+    P.build( X, Y );
+    N.build( X, Y );
+    real_type h = 1e-7;
+    real_type jP = abs( P.ypNode(0) - P.ypNode(n-1) ) +
+                   abs( P.DD(X[0]+h) - P.DD(X[n-1]-h) );
+    real_type jN = abs( N.ypNode(0) - N.ypNode(n-1) ) +
+                   abs( N.DD(X[0]+h) - N.DD(X[n-1]-h) );
+    real_type err = 0;
+    for ( integer k = 0; k <= 1000; ++k ) {
+      real_type x = (m_2pi*k)/1000;
+      err = max( err, abs( P(x) - sin(x) - 0.3*cos(2*x) ) );
+    }
+    cout << "  seam jump of D+DD, periodic " << jP << " natural " << jN
+         << "\n  closed " << P.is_closed() << " max error " << err << '\n';
+    ok = ok && jP < 1e-5 && jN > 1e-2 && P.is_closed() && err < 1e-3;
+  }
+
+  cout << "TEST 30.2 SplineVec::buildCubic(PERIODIC_BC) against CubicSpline\n";
+  {
+    integer const n = 30, dim = 2;
+    vector<real_type> P( n*dim ), C( n );
+    for ( integer i = 0; i < n; ++i ) {
+      real_type th = m_2pi*(i%(n-1))/(n-1);
+      P[i*dim+0] = 2*cos(th) + 0.2*cos(3*th);
+      P[i*dim+1] = sin(th);
+    }
+    SplineVec S("vec");
+    S.setup( dim, n, &P.front(), dim );
+    S.setKnotsCentripetal();
+    S.buildCubic( Splines::PERIODIC_BC, Splines::PERIODIC_BC );
+    real_type diff = 0;
+    for ( integer j = 0; j < dim; ++j ) {
+      for ( integer i = 0; i < n; ++i ) C[i] = P[i*dim+j];
+      CubicSpline CS;
+      CS.setInitialBC( Splines::PERIODIC_BC );
+      CS.setFinalBC( Splines::PERIODIC_BC );
+      CS.build( S.xNodes(), &C.front(), n );
+      for ( integer i = 0; i < n; ++i )
+        diff = max( diff, abs( CS.ypNode(i) - S.ypNode(i,j) ) );
+    }
+    cout << "  closed " << S.is_closed() << " max slope difference " << diff << '\n';
+    ok = ok && S.is_closed() && diff < 1e-12;
+  }
+
+  cout << "TEST 30.3 periodic quintic, D DD DDD continuous at the seam\n";
+  {
+    integer const n = 25;
+    vector<real_type> X( n ), Y( n );
+    for ( integer i = 0; i < n; ++i ) {
+      X[i] = m_2pi*i/(n-1) + ( i > 0 && i+1 < n ? 0.04*cos(real_type(5*i)) : 0 );
+      Y[i] = cos(X[i]) + 0.5*sin(3*X[i]);
+    }
+    Y[n-1] = Y[0];
+    QuinticSpline Q;
+    Q.setQuinticType( Splines::PERIODIC_QUINTIC );
+    Q.build( X, Y );
+    real_type h  = 1e-7;
+    real_type a  = X[0]+h, b = X[n-1]-h;
+    real_type j1 = abs( Q.D(a)   - Q.D(b) );
+    real_type j2 = abs( Q.DD(a)  - Q.DD(b) );
+    real_type j3 = abs( Q.DDD(a) - Q.DDD(b) );
+    real_type err = 0;
+    for ( integer k = 0; k <= 1000; ++k ) {
+      real_type x = (m_2pi*k)/1000;
+      err = max( err, abs( Q(x) - cos(x) - 0.5*sin(3*x) ) );
+    }
+    cout << "  jumps " << j1 << ' ' << j2 << ' ' << j3
+         << " closed " << Q.is_closed() << " max error " << err << '\n';
+    ok = ok && j1 < 1e-5 && j2 < 1e-5 && j3 < 1e-4 && Q.is_closed() && err < 1e-3;
+  }
+
+  cout << "TEST 30.4 surfaces closed along x\n";
+  {
+    integer const nx = 33, ny = 11;
+    vector<real_type> X( nx ), Y( ny ), Z( nx*ny );
+    for ( integer i = 0; i < nx; ++i ) X[i] = m_2pi*i/(nx-1);
+    for ( integer j = 0; j < ny; ++j ) Y[j] = real_type(j)/(ny-1);
+    for ( integer i = 0; i < nx; ++i )
+      for ( integer j = 0; j < ny; ++j )
+        Z[i*ny+j] = ( sin(X[i]) + 0.4*cos(2*X[i]) )*( 1 + Y[j]*Y[j] );
+    for ( integer j = 0; j < ny; ++j ) Z[(nx-1)*ny+j] = Z[j];
+    BiCubicSpline  C, Co;
+    BiQuinticSpline Q, Qo;
+    C.make_x_closed();
+    Q.make_x_closed();
+    C.build( X, Y, Z );
+    Co.build( X, Y, Z );
+    Q.build( X, Y, Z );
+    Qo.build( X, Y, Z );
+    // the bicubic has zero cross derivatives and is only C1 between the
+    // grid lines, DD is checked along the grid lines y = Y[j]
+    real_type h = 1e-7, jC = 0, jCo = 0, jQ = 0, jQo = 0;
+    real_type a = X[0]+h, b = X[nx-1]-h;
+    for ( integer j = 0; j < ny; ++j ) {
+      real_type y = Y[j], ym = j+1 < ny ? (Y[j]+Y[j+1])/2 : Y[j];
+      jC  = max( jC,  abs( C.Dx(a,ym)  - C.Dx(b,ym)  ) + abs( C.Dxx(a,y)  - C.Dxx(b,y)  ) );
+      jCo = max( jCo, abs( Co.Dx(a,ym) - Co.Dx(b,ym) ) + abs( Co.Dxx(a,y) - Co.Dxx(b,y) ) );
+      jQ  = max( jQ,  abs( Q.Dx(a,ym)  - Q.Dx(b,ym)  ) + abs( Q.Dxx(a,ym)  - Q.Dxx(b,ym)  ) );
+      jQo = max( jQo, abs( Qo.Dx(a,ym) - Qo.Dx(b,ym) ) + abs( Qo.Dxx(a,ym) - Qo.Dxx(b,ym) ) );
+    }
+    cout << "  seam jump of Dx+Dxx, bicubic " << jC << " (open " << jCo << ")"
+         << "\n                      biquintic " << jQ << " (open " << jQo << ")\n";
+    // same data transposed, closed along y
+    BiCubicSpline  Ct;
+    BiQuinticSpline Qt;
+    Ct.make_y_closed();
+    Qt.make_y_closed();
+    Ct.build( Y, X, Z, false, true );
+    Qt.build( Y, X, Z, false, true );
+    real_type dt = 0;
+    for ( integer k = 0; k <= 100; ++k ) {
+      real_type x = 0.063*k, y = 0.01*k;
+      dt = max( dt, abs( Ct(y,x) - C(x,y) ) + abs( Qt(y,x) - Q(x,y) ) );
+    }
+    cout << "  closed along y, difference with the transposed " << dt << '\n';
+    // through the wrapper, closed before the first build and kept by a rebuild
+    Spline2D W("wrap");
+    W.make_x_closed();
+    W.build( Splines::BIQUINTIC_TYPE, X, Y, Z );
+    W.build( Splines::BICUBIC_TYPE, X, Y, Z );
+    real_type dw = 0;
+    for ( integer k = 0; k <= 100; ++k ) {
+      real_type x = 0.063*k, y = 0.01*k;
+      dw = max( dw, abs( W(x,y) - C(x,y) ) + abs( W.Dx(x,y) - C.Dx(x,y) ) );
+    }
+    cout << "  Spline2D closed along x, difference " << dw << '\n';
+    ok = ok && jC < 1e-5 && jQ < 1e-5 && jCo > 1e-3 && jQo > 1e-3 && dt < 1e-12;
+    ok = ok && W.is_x_closed() && !W.is_y_closed() && dw == 0;
+  }
+
+  cout << "TEST 30.5 periodic ends that do not match are rejected\n";
+  {
+    integer const n = 21;
+    vector<real_type> X( n ), Y( n ), P( 2*n );
+    for ( integer i = 0; i < n; ++i ) {
+      X[i] = m_2pi*i/(n-1);
+      Y[i] = cos(X[i]);
+      P[2*i] = cos(X[i]); P[2*i+1] = sin(X[i]);
+    }
+    // round off on the repeated value is accepted
+    Y[n-1] = 1+1e-14;
+    bool ok1 = true;
+    try {
+      CubicSpline S;
+      S.setInitialBC( Splines::PERIODIC_BC );
+      S.setFinalBC( Splines::PERIODIC_BC );
+      S.build( X, Y );
+    } catch ( exception const & ) { ok1 = false; }
+    Y[n-1] = 1.1;
+    integer nthrow = 0;
+    try {
+      CubicSpline S;
+      S.setInitialBC( Splines::PERIODIC_BC );
+      S.setFinalBC( Splines::PERIODIC_BC );
+      S.build( X, Y );
+    } catch ( exception const & ) { ++nthrow; }
+    try {
+      QuinticSpline S;
+      S.setQuinticType( Splines::PERIODIC_QUINTIC );
+      S.build( X, Y );
+    } catch ( exception const & ) { ++nthrow; }
+    P[2*n-1] = 0.1;
+    try {
+      SplineVec S;
+      S.setup( 2, n, &P.front(), 2 );
+      S.setKnotsChordLength();
+      S.buildCubic( Splines::PERIODIC_BC, Splines::PERIODIC_BC );
+    } catch ( exception const & ) { ++nthrow; }
+    P[2*n-1] = 0;
+    try {
+      SplineVec S;
+      S.setup( 2, n, &P.front(), 2 );
+      S.setKnotsChordLength();
+      S.buildCubic( Splines::PERIODIC_BC, Splines::NATURAL_BC );
+    } catch ( exception const & ) { ++nthrow; }
+    integer const ny = 5;
+    vector<real_type> YY( ny ), Z( n*ny );
+    for ( integer j = 0; j < ny; ++j ) YY[j] = j;
+    for ( integer i = 0; i < n; ++i )
+      for ( integer j = 0; j < ny; ++j ) Z[i*ny+j] = Y[i]*(1+j);
+    try {
+      BiCubicSpline S;
+      S.make_x_closed();
+      S.build( X, YY, Z );
+    } catch ( exception const & ) { ++nthrow; }
+    try {
+      BiQuinticSpline S;
+      S.make_x_closed();
+      S.build( X, YY, Z );
+    } catch ( exception const & ) { ++nthrow; }
+    cout << "  round off " << ( ok1 ? "accepted" : "REJECTED" )
+         << ", " << nthrow << " of 6 mismatches rejected\n";
+    ok = ok && ok1 && nthrow == 6;
+  }
+
+  cout << "TEST 30.6 timing of the cyclic solver, 1000000 points\n";
+  {
+    integer const n = 1000000;
+    vector<real_type> X( n ), Y( n );
+    for ( integer i = 0; i < n; ++i ) {
+      X[i] = m_2pi*i/(n-1);
+      Y[i] = sin(X[i]*10);
+    }
+    Y[n-1] = Y[0];
+    double tp = 1e300, tn = 1e300;
+    for ( integer r = 0; r < 3; ++r ) {
+      CubicSpline P, N;
+      P.setInitialBC( Splines::PERIODIC_BC );
+      P.setFinalBC( Splines::PERIODIC_BC );
+      auto t0 = chrono::high_resolution_clock::now();
+      P.build( X, Y );
+      auto t1 = chrono::high_resolution_clock::now();
+      N.build( X, Y );
+      auto t2 = chrono::high_resolution_clock::now();
+      tp = min( tp, chrono::duration<double,milli>(t1-t0).count() );
+      tn = min( tn, chrono::duration<double,milli>(t2-t1).count() );
+    }
+    cout << fixed << setprecision(2)
+         << "  periodic " << setw(8) << tp << " ms\n"
+         << "  natural  " << setw(8) << tn << " ms\n";
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
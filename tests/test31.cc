@@ -0,0 +1,238 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+static real_type const m_pi = 3.141592653589793;
+
+// graph of y = A sin(w x + f) on [x0,x1], parametrized by x
+static
+void
+graph(
+  SplineVec & S, integer n, real_type x0, real_type x1,
+  real_type A, real_type w, real_type f
+) {
+  vector<real_type> P( 2*n ), T( n );
+  for ( integer i = 0; i < n; ++i ) {
+    T[i]     = x0 + ((x1-x0)*i)/(n-1);
+    P[2*i]   = T[i];
+    P[2*i+1] = A*sin(w*T[i]+f);
+  }
+  S.setup( 2, n, &P.front(), 2 );
+  S.setKnots( &T.front() );
+  S.buildCubic();
+}
+
+static
+real_type
+gap( SplineVec const & A, real_type ta, SplineVec const & B, real_type tb ) {
+  return hypot( A(ta,0)-B(tb,0), A(ta,1)-B(tb,1) );
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.31\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 31.1 two closed curves\n";
+  {
+    integer const n = 41;
+    vector<real_type> P( 2*n ), Q( 2*n );
+    for ( integer i = 0; i < n; ++i ) {
+      real_type th = 2*m_pi*(i%(n-1))/(n-1);
+      P[2*i] = cos(th);     P[2*i+1] = sin(th);
+      Q[2*i] = 1+cos(th);   Q[2*i+1] = 0.3+0.5*sin(th);
+    }
+    SplineVec A("circle"), B("ellipse");
+    A.setup( 2, n, &P.front(), 2 ); A.setKnotsCentripetal(); A.buildCubic( Splines::PERIODIC_BC, Splines::PERIODIC_BC );
+    B.setup( 2, n, &Q.front(), 2 ); B.setKnotsCentripetal(); B.buildCubic( Splines::PERIODIC_BC, Splines::PERIODIC_BC );
+    SplineVecBVH TA( A ), TB( B );
+    vector<real_type> ta, tb;
+    bool complete = false;
+    integer nh = TA.intersect( TB, ta, tb, &complete );
+    real_type res = 0;
+    for ( integer k = 0; k < nh; ++k ) res = max( res, gap( A, ta[k], B, tb[k] ) );
+    cout << "  " << nh << " intersections, residual " << res
+         << ( complete ? "\n" : " INCOMPLETE\n" );
+    ok = ok && nh == 2 && res < 1e-10 && complete;
+  }
+
+  cout << "TEST 31.2 two waves\n";
+  {
+    // sin(x) = 0.8 cos(x) at x = atan(0.8) + k pi
+    SplineVec A("sin"), B("cos");
+    graph( A, 200, 0, 20, 1,   1, 0 );
+    graph( B, 173, 0, 20, 0.8, 1, m_pi/2 );
+    SplineVecBVH TA( A, 2 ), TB( B, 8 );
+    vector<real_type> ta, tb;
+    integer nh = TA.intersect( TB, ta, tb );
+    real_type res = 0, err = 0;
+    for ( integer k = 0; k < nh; ++k ) {
+      res = max( res, gap( A, ta[k], B, tb[k] ) );
+      err = max( err, abs( ta[k] - atan(0.8) - k*m_pi ) );
+    }
+    cout << "  " << nh << " intersections, residual " << res
+         << " error on x " << err << '\n';
+    ok = ok && nh == 7 && res < 1e-12 && err < 1e-5;
+  }
+
+  cout << "TEST 31.3 curve and line segments\n";
+  {
+    SplineVec A("sin");
+    graph( A, 200, 0, 20, 1, 1, 0 );
+    SplineVecBVH TA( A );
+    real_type P0[2] = { -1, 0.5 }, P1[2] = { 21, 0.5 };
+    vector<real_type> t, s;
+    integer nh = TA.intersectSegment( P0, P1, t, s );
+    real_type res = 0;
+    for ( integer k = 0; k < nh; ++k ) {
+      res = max( res, abs( A(t[k],1) - 0.5 ) );
+      res = max( res, abs( A(t[k],0) - (P0[0]+s[k]*(P1[0]-P0[0])) ) );
+    }
+    cout << "  horizontal: " << nh << " intersections, residual " << res << '\n';
+    ok = ok && nh == 7 && res < 1e-12;
+    // vertical segment through a knot: found once
+    real_type x = A.xNode(50);
+    real_type V0[2] = { x, -2 }, V1[2] = { x, 2 };
+    nh = TA.intersectSegment( V0, V1, t, s );
+    cout << "  through a knot: " << nh << " intersection at t = " << t[0]
+         << " (knot " << x << ")\n";
+    ok = ok && nh == 1 && abs( t[0] - x ) < 1e-12;
+    // short segment between the waves
+    real_type S0[2] = { 3, 0.5 }, S1[2] = { 4, 0.6 };
+    nh = TA.intersectSegment( S0, S1, t, s );
+    cout << "  short segment: " << nh << " intersections\n";
+    ok = ok && nh == 0;
+  }
+
+  cout << "TEST 31.4 batch of curves, threads\n";
+  {
+    integer const nc = 120;
+    vector<SplineVec *>            S( nc );
+    vector<SplineVecBVH *>         T( nc );
+    vector<SplineVecBVH const *>   C( nc );
+    for ( integer i = 0; i < nc; ++i ) {
+      S[i] = new SplineVec("wave");
+      graph( *S[i], 100, 0.1*(i%10), 10+0.1*(i%7), 0.5+0.01*i, 1+0.02*i, 0.1*i );
+      T[i] = new SplineVecBVH( *S[i] );
+      C[i] = T[i];
+    }
+    vector<SplineVecBVH::Hit> h1, h4;
+    auto t0 = chrono::high_resolution_clock::now();
+    bool complete1 = SplineVecBVH::intersectAll( C, h1, 1 );
+    auto t1 = chrono::high_resolution_clock::now();
+    bool complete4 = SplineVecBVH::intersectAll( C, h4, 4 );
+    auto t2 = chrono::high_resolution_clock::now();
+    bool same = h1.size() == h4.size() && complete1 && complete4;
+    for ( size_t k = 0; same && k < h1.size(); ++k )
+      same = h1[k].a == h4[k].a && h1[k].b == h4[k].b &&
+             h1[k].ta == h4[k].ta && h1[k].tb == h4[k].tb;
+    // against the pairwise queries
+    size_t    npair = 0;
+    real_type res   = 0;
+    for ( integer i = 0; i < nc; ++i ) {
+      for ( integer j = i+1; j < nc; ++j ) {
+        vector<real_type> ta, tb;
+        npair += size_t( T[i]->intersect( *T[j], ta, tb ) );
+      }
+    }
+    for ( SplineVecBVH::Hit const & h : h1 )
+      res = max( res, gap( *S[h.a], h.ta, *S[h.b], h.tb ) );
+    cout << "  " << h1.size() << " intersections, residual " << res
+         << ( same ? ", threads identical" : ", threads DIFFERENT" )
+         << ( npair == h1.size() ? ", pairwise identical\n" : ", pairwise DIFFERENT\n" );
+    ok = ok && same && npair == h1.size() && res < 1e-12;
+
+    // line segments
+    integer const nl = 200;
+    vector<real_type> L( 4*nl );
+    for ( integer k = 0; k < nl; ++k ) {
+      L[4*k+0] = 0.05*k;  L[4*k+1] = -1.5;
+      L[4*k+2] = 10-0.04*k; L[4*k+3] = 1.5;
+    }
+    vector<SplineVecBVH::Hit> hl;
+    auto t3 = chrono::high_resolution_clock::now();
+    SplineVecBVH::intersectAllSegments( C, nl, &L[0], &L[2], 4, hl, 4 );
+    auto t4 = chrono::high_resolution_clock::now();
+    size_t nseg = 0;
+    for ( integer i = 0; i < nc; ++i ) {
+      for ( integer k = 0; k < nl; ++k ) {
+        vector<real_type> t, s;
+        nseg += size_t( T[i]->intersectSegment( &L[4*k], &L[4*k+2], t, s ) );
+      }
+    }
+    cout << "  " << hl.size() << " intersections with the segments"
+         << ( nseg == hl.size() ? ", single queries identical\n" : ", single queries DIFFERENT\n" );
+    ok = ok && nseg == hl.size() && !hl.empty();
+
+    cout << fixed << setprecision(2)
+         << "  curve pairs, 1 thread  " << setw(8) << chrono::duration<double,milli>(t1-t0).count() << " ms\n"
+         << "  curve pairs, 4 threads " << setw(8) << chrono::duration<double,milli>(t2-t1).count() << " ms\n"
+         << "  curve-segment, 4 thr.  " << setw(8) << chrono::duration<double,milli>(t4-t3).count() << " ms\n";
+    // a tree not built in the batch is an error, not a crash
+    SplineVecBVH E;
+    C.push_back( &E );
+    integer nthrow = 0;
+    try { SplineVecBVH::intersectAll( C, h1, 4 ); }
+    catch ( exception const & ) { ++nthrow; }
+    try { SplineVecBVH::intersectAllSegments( C, nl, &L[0], &L[2], 4, hl, 4 ); }
+    catch ( exception const & ) { ++nthrow; }
+    cout << "  tree not built, " << nthrow << " of 2 batches rejected\n";
+    ok = ok && nthrow == 2;
+    for ( integer i = 0; i < nc; ++i ) { delete T[i]; delete S[i]; }
+  }
+
+  cout << "TEST 31.5 overlapping arcs are reported incomplete\n";
+  {
+    SplineVec A("sin"), B("sin shifted");
+    // same nodes on [5,9.9], the two splines coincide far from the ends
+    graph( A, 100, 0, 9.9,  1, 1, 0 );
+    graph( B, 100, 5, 14.9, 1, 1, 0 );
+    SplineVecBVH TA( A ), TB( B );
+    vector<real_type> ta, tb;
+    bool complete = true;
+    integer nh = TA.intersect( TB, ta, tb, &complete );
+    vector<SplineVecBVH const *> C = { &TA, &TB };
+    vector<SplineVecBVH::Hit>    h;
+    bool completeAll = SplineVecBVH::intersectAll( C, h, 2 );
+    real_type res = 0;
+    for ( integer k = 0; k < nh; ++k ) res = max( res, gap( A, ta[k], B, tb[k] ) );
+    cout << "  " << nh << " points of the overlap, residual " << scientific << res
+         << ( complete || completeAll ? ", NOT reported\n" : ", reported incomplete\n" );
+    ok = ok && !complete && !completeAll && res < 1e-8;
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
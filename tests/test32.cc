@@ -0,0 +1,257 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// largest distance between the spline and the polyline, 16 samples per piece
+static
+real_type
+graphError( Spline const & S, integer n, real_type const x[], real_type const y[] ) {
+  real_type err = 0;
+  for ( integer k = 0; k+1 < n; ++k ) {
+    for ( integer s = 1; s < 16; ++s ) {
+      real_type u  = s/16.0;
+      real_type xx = x[k]+u*(x[k+1]-x[k]);
+      err = max( err, abs( S(xx) - (y[k]+u*(y[k+1]-y[k])) ) );
+    }
+  }
+  return err;
+}
+
+// smallest uniform sampling with the error below tol
+static
+integer
+uniformPoints( Spline const & S, real_type tol ) {
+  integer n = 8;
+  vector<real_type> x, y;
+  for ( ;; n = n+n/4 ) {
+    x.resize( n ); y.resize( n );
+    for ( integer k = 0; k < n; ++k ) {
+      x[k] = S.xMin() + ((S.xMax()-S.xMin())*k)/(n-1);
+      y[k] = S(x[k]);
+    }
+    if ( graphError( S, n, &x.front(), &y.front() ) <= tol ) return n;
+  }
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.32\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 32.1 graph of 1D splines\n";
+  {
+    // straight line with a sharp bump at x = 7
+    integer const n = 60;
+    vector<real_type> X( n ), Y( n );
+    for ( integer i = 0; i < n; ++i ) {
+      X[i] = (10.0*i)/(n-1);
+      Y[i] = 0.2*X[i] + exp( -20*(X[i]-7)*(X[i]-7) );
+    }
+    CubicSpline   C;
+    QuinticSpline Q;
+    AkimaSpline   A;
+    LinearSpline  L;
+    C.build( X, Y );
+    Q.build( X, Y );
+    A.build( X, Y );
+    L.build( X, Y );
+    Spline const * S[] = { &C, &Q, &A, &L };
+    for ( Spline const * s : S ) {
+      for ( real_type tol : { 1e-3, 1e-5 } ) {
+        integer np = s->tessellate( tol, 0, nullptr, nullptr );
+        vector<real_type> x( np ), y( np );
+        integer np1 = s->tessellate( tol, np, &x.front(), &y.front(), 4 );
+        real_type err = graphError( *s, np, &x.front(), &y.front() );
+        integer   nu  = uniformPoints( *s, tol );
+        cout << "  " << setw(8) << s->type_name() << " tol " << tol
+             << " points " << setw(5) << np << " (uniform " << setw(5) << nu
+             << ") error " << err << '\n';
+        ok = ok && np1 == np && err <= tol && x.back() == s->xMax() &&
+             ( s == &L || np < nu );
+      }
+    }
+  }
+
+  cout << "TEST 32.2 SplineVec curve\n";
+  {
+    integer const n = 50;
+    vector<real_type> P( 2*n );
+    for ( integer i = 0; i < n; ++i ) {
+      real_type th = 0.25*i;
+      P[2*i]   = (1+0.1*th)*cos(th);
+      P[2*i+1] = (1+0.1*th)*sin(th) + ( i > 30 ? 0.5*(i-30) : 0 );
+    }
+    SplineVec S("spiral");
+    S.setup( 2, n, &P.front(), 2 );
+    S.setKnotsCentripetal();
+    S.buildCubic();
+    real_type tol = 1e-4;
+    integer np = S.tessellate( tol, 0, nullptr, nullptr, 2 );
+    vector<real_type> t( np ), Q( 3*np ), t1( np ), Q1( 3*np );
+    S.tessellate( tol, np, &t.front(),  &Q.front(),  3, 1 );
+    S.tessellate( tol, np, &t1.front(), &Q1.front(), 3, 4 );
+    bool same = true;
+    for ( integer k = 0; k < np; ++k )
+      same = same && t[k] == t1[k] && Q[3*k] == Q1[3*k] && Q[3*k+1] == Q1[3*k+1];
+    real_type err = 0;
+    for ( integer k = 0; k+1 < np; ++k ) {
+      for ( integer s = 1; s < 16; ++s ) {
+        real_type u  = s/16.0;
+        real_type tt = t[k]+u*(t[k+1]-t[k]);
+        real_type ex = S(tt,0) - (Q[3*k]+u*(Q[3*k+3]-Q[3*k]));
+        real_type ey = S(tt,1) - (Q[3*k+1]+u*(Q[3*k+4]-Q[3*k+1]));
+        err = max( err, hypot( ex, ey ) );
+      }
+    }
+    cout << "  " << np << " points for " << n << " knots, error " << err
+         << ( same ? ", threads identical\n" : ", threads DIFFERENT\n" );
+    ok = ok && same && err <= tol && t.back() == S.xMax();
+    integer nsmall = S.tessellate( tol, 10, &t.front(), &Q.front(), 3 );
+    ok = ok && nsmall == np && t1 == t;
+  }
+
+  cout << "TEST 32.3 triangle meshes of surfaces\n";
+  {
+    integer const nx = 21, ny = 15;
+    vector<real_type> X( nx ), Y( ny ), Z( nx*ny );
+    for ( integer i = 0; i < nx; ++i ) X[i] = (4.0*i)/(nx-1);
+    for ( integer j = 0; j < ny; ++j ) Y[j] = (2.0*j)/(ny-1);
+    for ( integer i = 0; i < nx; ++i )
+      for ( integer j = 0; j < ny; ++j )
+        Z[i*ny+j] = X[i] < 2 ? 0.3*X[i]+0.1*Y[j] : sin(3*X[i])*cos(2*Y[j]);
+    BiCubicSpline   C;
+    BiQuinticSpline Q;
+    BilinearSpline  L;
+    C.build( X, Y, Z );
+    Q.build( X, Y, Z );
+    L.build( X, Y, Z );
+    Splines::SplineSurf const * S[] = { &C, &Q, &L };
+    real_type tol = 1e-3;
+    for ( Splines::SplineSurf const * s : S ) {
+      integer nt;
+      integer nv = s->tessellate( tol, 0, nullptr, 0, nullptr, nt );
+      vector<real_type> V( 3*size_t(nv) );
+      vector<integer>   T( 3*size_t(nt) );
+      s->tessellate( tol, nv, &V.front(), nt, &T.front(), nt, 4 );
+      // error at points inside the triangles, orientation
+      real_type err = 0;
+      bool      ccw = true;
+      for ( integer k = 0; k < nt; ++k ) {
+        real_type const * a = &V[3*size_t(T[3*k])];
+        real_type const * b = &V[3*size_t(T[3*k+1])];
+        real_type const * c = &V[3*size_t(T[3*k+2])];
+        ccw = ccw && (b[0]-a[0])*(c[1]-a[1]) - (b[1]-a[1])*(c[0]-a[0]) > 0;
+        for ( real_type l1 : { 1/3.0, 0.1, 0.45 } ) {
+          for ( real_type l2 : { 1/3.0, 0.45, 0.1 } ) {
+            real_type l0 = 1-l1-l2;
+            real_type x  = l0*a[0]+l1*b[0]+l2*c[0];
+            real_type y  = l0*a[1]+l1*b[1]+l2*c[1];
+            real_type z  = l0*a[2]+l1*b[2]+l2*c[2];
+            err = max( err, abs( (*s)(x,y) - z ) );
+          }
+        }
+      }
+      cout << "  " << setw(15) << s->type_name() << " vertices " << setw(6) << nv
+           << " triangles " << setw(6) << nt << " error " << err
+           << ( ccw ? " ccw\n" : " WRONG ORIENTATION\n" );
+      ok = ok && ccw && err <= tol;
+    }
+    // out-of-core surface, the same mesh of the BiCubicSpline
+    BiCubicSplineMapped M;
+    M.build( "test32_tiles.bin", &X.front(), nx, &Y.front(), ny, &Z.front(), ny, 8 );
+    integer nt, ntM;
+    integer nv  = C.tessellate( tol, 0, nullptr, 0, nullptr, nt );
+    integer nvM = M.tessellate( tol, 0, nullptr, 0, nullptr, ntM );
+    vector<real_type> V( 3*size_t(nv) ), VM( 3*size_t(nv) );
+    vector<integer>   T( 3*size_t(nt) ),  TM( 3*size_t(nt) );
+    C.tessellate( tol, nv, &V.front(), nt, &T.front(), nt, 1 );
+    M.tessellate( tol, nv, &VM.front(), nt, &TM.front(), ntM, 4 );
+    bool same = nvM == nv && ntM == nt && V == VM && T == TM;
+    cout << "  " << setw(15) << M.type_name() << " vertices " << setw(6) << nvM
+         << " triangles " << setw(6) << ntM
+         << ( same ? " same mesh of BiCubic\n" : " DIFFERENT mesh\n" );
+    ok = ok && same;
+    M.close();
+    std::remove( "test32_tiles.bin" );
+    // counts that do not fit in an integer are refused
+    integer nthrow = 0;
+    try {
+      C.tessellate( 1e-300, 0, nullptr, 0, nullptr, nt );
+    } catch ( exception const & ) { ++nthrow; }
+    vector<real_type> XX( 4000 ), YY( 4000 );
+    for ( size_t i = 0; i < XX.size(); ++i ) {
+      XX[i] = i*0.01;
+      YY[i] = sin(40*XX[i]);
+    }
+    CubicSpline CS;
+    CS.build( XX, YY );
+    try {
+      CS.tessellate( 1e-300, 0, nullptr, nullptr );
+    } catch ( exception const & ) { ++nthrow; }
+    cout << "  " << nthrow << " of 2 integer overflows refused\n";
+    ok = ok && nthrow == 2;
+  }
+
+  cout << "TEST 32.4 timing, 1000000 knots\n";
+  {
+    integer const n = 1000000;
+    vector<real_type> X( n ), Y( n );
+    for ( integer i = 0; i < n; ++i ) {
+      X[i] = 1e-3*i;
+      Y[i] = sin(X[i]) + 0.1*sin(40*X[i]);
+    }
+    CubicSpline C;
+    C.build( X, Y );
+    real_type tol = 1e-6;
+    integer np = C.tessellate( tol, 0, nullptr, nullptr );
+    vector<real_type> x( np ), y( np );
+    double t1 = 1e300, t4 = 1e300;
+    for ( integer r = 0; r < 3; ++r ) {
+      auto a = chrono::high_resolution_clock::now();
+      C.tessellate( tol, np, &x.front(), &y.front(), 1 );
+      auto b = chrono::high_resolution_clock::now();
+      C.tessellate( tol, np, &x.front(), &y.front(), 4 );
+      auto c = chrono::high_resolution_clock::now();
+      t1 = min( t1, chrono::duration<double,milli>(b-a).count() );
+      t4 = min( t4, chrono::duration<double,milli>(c-b).count() );
+    }
+    cout << "  " << np << " points\n" << fixed << setprecision(2)
+         << "  1 thread  " << setw(8) << t1 << " ms\n"
+         << "  4 threads " << setw(8) << t4 << " ms\n";
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
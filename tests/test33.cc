@@ -0,0 +1,213 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// cubic Bezier at u by de Casteljau
+static
+real_type
+bezierEval( real_type const P[4], real_type u ) {
+  real_type L[4], R[4];
+  bezierSplit( P, u, L, R );
+  return L[3];
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.33\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 33.1 Hermite <-> Bezier, de Casteljau\n";
+  {
+    real_type P[4], L[4], R[4], p0, p1, t0, t1;
+    hermiteToBezier( 1, 2, -3, 0.5, P );
+    bezierToHermite( P, p0, p1, t0, t1 );
+    real_type err = abs(p0-1)+abs(p1-2)+abs(t0+3)+abs(t1-0.5);
+    bezierSplit( P, 0.3, L, R );
+    for ( integer k = 0; k <= 20; ++k ) {
+      real_type u = k/20.0;
+      err = max( err, abs( bezierEval(L,u) - bezierEval(P,0.3*u) ) );
+      err = max( err, abs( bezierEval(R,u) - bezierEval(P,0.3+0.7*u) ) );
+    }
+    cout << "  error " << err << '\n';
+    ok = ok && err < 1e-14;
+  }
+
+  integer const n = 25;
+  vector<real_type> X( n ), Y( n );
+  for ( integer i = 0; i < n; ++i ) {
+    X[i] = i + 0.3*sin(real_type(i));
+    Y[i] = sin(0.7*X[i]) + 0.05*X[i]*X[i];
+  }
+  CubicSpline C;
+  C.build( X, Y );
+
+  cout << "TEST 33.2 CubicSplineBase::toBezier\n";
+  {
+    vector<real_type> P( 3*(n-1)+1 );
+    C.toBezier( &P.front() );
+    real_type err = 0;
+    for ( integer i = 0; i+1 < n; ++i ) {
+      for ( integer k = 0; k <= 10; ++k ) {
+        real_type u = k/10.0;
+        real_type x = X[i] + u*(X[i+1]-X[i]);
+        err = max( err, abs( bezierEval( &P[3*i], u ) - C(x) ) );
+      }
+    }
+    cout << "  max error " << err << '\n';
+    ok = ok && err < 1e-13;
+  }
+
+  cout << "TEST 33.3 CubicSplineBase::cut and split\n";
+  {
+    real_type const ab[][2] = {
+      { 2.5, 17.2 }, { X[3], X[10] }, { 5.1, 5.4 }, { X[0], X[n-1] }, { X[4], 11.3 }
+    };
+    real_type err = 0;
+    bool same_knots = true;
+    for ( auto const & r : ab ) {
+      Splines::HermiteSpline H;
+      C.cut( r[0], r[1], H );
+      same_knots = same_knots && H.xMin() == r[0] && H.xMax() == r[1];
+      for ( integer k = 0; k+1 < H.numPoints(); ++k )
+        same_knots = same_knots && H.xNode(k) < H.xNode(k+1);
+      for ( integer k = 0; k <= 200; ++k ) {
+        real_type x = r[0] + ((r[1]-r[0])*k)/200;
+        err = max( err, abs( H(x) - C(x) ) + abs( H.D(x) - C.D(x) ) + abs( H.DD(x) - C.DD(x) ) );
+      }
+    }
+    CubicSpline Cin;
+    Cin.build( X, Y );
+    Cin.cut( 3.3, 9.9, Cin ); // in place
+    for ( integer k = 0; k <= 200; ++k ) {
+      real_type x = 3.3 + (6.6*k)/200;
+      err = max( err, abs( Cin(x) - C(x) ) );
+    }
+    // the target of a cut is open, even when it was closed before
+    Splines::HermiteSpline T;
+    T.make_closed();
+    C.cut( 3.3, 9.9, T );
+    bool opened = !T.is_closed();
+    for ( integer k = 0; k <= 200; ++k ) {
+      real_type x = 9.9 - (6.6*k)/200;
+      err = max( err, abs( T(x) - C(x) ) );
+    }
+    CubicSpline L, R;
+    C.split( 7.77, L, R );
+    real_type jmp = abs( L(7.77)-R(7.77) ) + abs( L.D(7.77)-R.D(7.77) );
+    for ( integer k = 0; k <= 200; ++k ) {
+      real_type x = X[0] + ((X[n-1]-X[0])*k)/200;
+      err = max( err, abs( ( x <= 7.77 ? L(x) : R(x) ) - C(x) ) );
+    }
+    cout << "  max error " << err << " split jump " << jmp
+         << ( same_knots ? " knots ok\n" : " BAD KNOTS\n" );
+    if ( !opened ) cout << "  the target of cut is still closed\n";
+    ok = ok && err < 1e-12 && jmp < 1e-14 && same_knots && opened &&
+         L.numPoints() + R.numPoints() == n + 2;
+  }
+
+  cout << "TEST 33.4 SplineVec::toBezier, cut and split\n";
+  for ( bool inter : { false, true } ) {
+    integer const dim = 3;
+    vector<real_type> P( dim*n );
+    for ( integer i = 0; i < n; ++i ) {
+      P[dim*i+0] = cos(0.4*i);
+      P[dim*i+1] = sin(0.4*i);
+      P[dim*i+2] = 0.1*i;
+    }
+    SplineVec S("helix");
+    S.setup( dim, n, &P.front(), dim );
+    S.setKnotsCentripetal();
+    S.buildCubic();
+    S.useInterleaved( inter );
+    // Bezier points, stride 4
+    vector<real_type> B( 4*(3*(n-1)+1) );
+    S.toBezier( &B.front(), 4 );
+    real_type err = 0;
+    for ( integer i = 0; i+1 < n; ++i ) {
+      for ( integer j = 0; j < dim; ++j ) {
+        real_type Q[4] = { B[4*(3*i)+j], B[4*(3*i+1)+j], B[4*(3*i+2)+j], B[4*(3*i+3)+j] };
+        for ( integer k = 0; k <= 10; ++k ) {
+          real_type u = k/10.0;
+          real_type t = S.xNode(i) + u*(S.xNode(i+1)-S.xNode(i));
+          err = max( err, abs( bezierEval( Q, u ) - S(t,j) ) );
+        }
+      }
+    }
+    real_type a = S.xMin() + 0.17*(S.xMax()-S.xMin());
+    real_type b = S.xMin() + 0.61*(S.xMax()-S.xMin());
+    SplineVec T("cut"), L("L"), R("R");
+    T.setup( dim, n+10, &vector<real_type>( dim*(n+10) ).front(), dim ); // larger, reused
+    S.cut( a, b, T );
+    S.split( b, L, R );
+    real_type errc = 0;
+    for ( integer k = 0; k <= 300; ++k ) {
+      real_type t = a + ((b-a)*k)/300;
+      real_type s = S.xMin() + ((S.xMax()-S.xMin())*k)/300;
+      for ( integer j = 0; j < dim; ++j ) {
+        errc = max( errc, abs( T(t,j) - S(t,j) ) + abs( T.D(t,j) - S.D(t,j) ) );
+        errc = max( errc, abs( ( s <= b ? L(s,j) : R(s,j) ) - S(s,j) ) );
+      }
+    }
+    cout << "  interleaved " << inter << " toBezier error " << err
+         << " cut/split error " << errc << " knots " << T.numPoints() << '\n';
+    ok = ok && err < 1e-13 && errc < 1e-12 && T.xMin() == a && T.xMax() == b && !T.is_closed();
+  }
+
+  cout << "TEST 33.5 timing, 1000000 knots\n";
+  {
+    integer const N = 1000000;
+    vector<real_type> XX( N ), YY( N ), P( 3*(N-1)+1 );
+    for ( integer i = 0; i < N; ++i ) { XX[i] = 1e-3*i; YY[i] = sin(XX[i]); }
+    CubicSpline CC;
+    CC.build( XX, YY );
+    Splines::HermiteSpline H;
+    double tb = 1e300, tc = 1e300;
+    for ( integer r = 0; r < 3; ++r ) {
+      auto t0 = chrono::high_resolution_clock::now();
+      CC.toBezier( &P.front() );
+      auto t1 = chrono::high_resolution_clock::now();
+      CC.cut( 100.5, 900.5, H );
+      auto t2 = chrono::high_resolution_clock::now();
+      tb = min( tb, chrono::duration<double,milli>(t1-t0).count() );
+      tc = min( tc, chrono::duration<double,milli>(t2-t1).count() );
+    }
+    cout << fixed << setprecision(2)
+         << "  toBezier " << setw(8) << tb << " ms\n"
+         << "  cut      " << setw(8) << tc << " ms\n";
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
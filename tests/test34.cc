@@ -0,0 +1,137 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// RPN 14 of test4, cut at the repeated node 8.7
+static real_type xx0[] = { 7.99, 8.09,       8.19,       8.7,      8.7, 9.2,      10,       12,       15,       20       };
+static real_type yy0[] = { 0,    2.76429e-5, 4.37498e-2, 0.169183, 0.169183, 0.469428, 0.943740, 0.998636, 0.999919, 0.999994 };
+
+// slopes of the cubic through the first four points, then the
+// segment after the cut that has a not-a-knot begin
+static real_type yp0[] = {
+  -0.28857050372337223, 0.25393618086168646, 0.5853197802766309, -1.008643452528299,
+  0.50916351885991429, 0.65556665111579226, 0.43741378402201553, -0.17179411594359367,
+  0.32764890368494498, -1.4589539597470504
+};
+
+// toolpath of test4
+static real_type xx1[] = { 0.11, 0.12, 0.15, 0.16 };
+static real_type yy1[] = { 0.0003, 0.0003, 0.0004, 0.0004 };
+static real_type yp1[] = {
+  -0.0021666666666666674, 0.0018333333333333326,
+  0.0018333333333333357, -0.0021666666666666705
+};
+
+static
+bool
+check_slopes(
+  CubicSpline const & S,
+  real_type   const   yp[],
+  real_type           tol
+) {
+  real_type err = 0;
+  for ( integer i = 0; i < S.numPoints(); ++i )
+    err = max( err, abs( S.ypNode(i) - yp[i] ) );
+  cout << "  max slope error " << err << '\n';
+  return err <= tol;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.34\n\n";
+
+  bool ok = true;
+
+  cout << "TEST 34.1 not-a-knot at the end of a segment cut at a repeated node\n";
+  {
+    CubicSpline S;
+    S.build( xx0, yy0, 10 );
+    ok = check_slopes( S, yp0, 1e-12 ) && ok;
+  }
+
+  cout << "TEST 34.2 not-a-knot on 4 points is the interpolating cubic\n";
+  {
+    CubicSpline S;
+    S.setInitialBC( Splines::NOT_A_KNOT );
+    S.setFinalBC( Splines::NOT_A_KNOT );
+    S.build( xx1, yy1, 4 );
+    ok = check_slopes( S, yp1, 1e-15 ) && ok;
+    real_type jmp = abs( S.DDD(0.115) - S.DDD(0.155) );
+    cout << "  jump of DDD " << jmp << '\n';
+    ok = ok && jmp < 1e-6;
+  }
+
+  cout << "TEST 34.3 three points\n";
+  {
+    real_type x[] = { 0, 1, 3 }, y[] = { 1, 2, 0 };
+    // not-a-knot on both sides, the parabola 1 + 5/3 x - 2/3 x^2
+    CubicSpline P;
+    P.setInitialBC( Splines::NOT_A_KNOT );
+    P.setFinalBC( Splines::NOT_A_KNOT );
+    P.build( x, y, 3 );
+    real_type err = 0;
+    for ( integer i = 0; i < 3; ++i )
+      err = max( err, abs( P.ypNode(i) - (5-4*x[i])/3 ) );
+    cout << "  parabola, max slope error " << err << '\n';
+    ok = ok && err < 1e-14;
+    // not-a-knot on one side only, a single cubic with natural end
+    CubicSpline C;
+    C.setInitialBC( Splines::NOT_A_KNOT );
+    C.setFinalBC( Splines::NATURAL_BC );
+    C.build( x, y, 3 );
+    real_type jmp = abs( C.DDD(0.5) - C.DDD(2) );
+    cout << "  not-a-knot/natural, jump of DDD " << jmp
+         << " DD at the end " << C.DD(3) << '\n';
+    ok = ok && jmp < 1e-12 && abs(C.DD(3)) < 1e-12;
+  }
+
+  cout << "TEST 34.4 two points are the segment for every BC\n";
+  {
+    Splines::CUBIC_SPLINE_TYPE_BC const bcs[] = {
+      Splines::EXTRAPOLATE_BC, Splines::NATURAL_BC,
+      Splines::PARABOLIC_RUNOUT_BC, Splines::NOT_A_KNOT
+    };
+    real_type x[] = { 1, 3 }, y[] = { 2, -1 };
+    for ( Splines::CUBIC_SPLINE_TYPE_BC bc : bcs ) {
+      CubicSpline S;
+      S.setInitialBC( bc );
+      S.setFinalBC( bc );
+      S.build( x, y, 2 );
+      bool ok1 = S.ypNode(0) == -1.5 && S.ypNode(1) == -1.5;
+      cout << "  bc = " << bc << ( ok1 ? " ok\n" : " FAILED\n" );
+      ok = ok && ok1;
+    }
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
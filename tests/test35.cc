@@ -0,0 +1,311 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <thread>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+
+// expose the per thread interval hints of a 1D spline, a set or a vector
+template <typename S>
+class Probe : public S {
+public:
+  Probe( string const & n ) : S(n) {}
+
+  size_t
+  hints() const {
+    std::lock_guard<std::mutex> lck(this->lastInterval_mutex);
+    return this->lastInterval_by_thread.size();
+  }
+
+  integer
+  hint() const {
+    std::lock_guard<std::mutex> lck(this->lastInterval_mutex);
+    auto it = this->lastInterval_by_thread.find(std::this_thread::get_id());
+    return it == this->lastInterval_by_thread.end() ? -1 : it->second;
+  }
+};
+
+// same for the two hint maps of a surface
+template <typename S>
+class SurfProbe : public S {
+public:
+  SurfProbe( string const & n ) : S(n) {}
+
+  size_t
+  hints() const {
+    std::lock_guard<std::mutex> lck1(this->lastInterval_x_mutex);
+    std::lock_guard<std::mutex> lck2(this->lastInterval_y_mutex);
+    return this->lastInterval_x_by_thread.size() +
+           this->lastInterval_y_by_thread.size();
+  }
+
+  integer
+  hint() const {
+    std::lock_guard<std::mutex> lck1(this->lastInterval_x_mutex);
+    std::lock_guard<std::mutex> lck2(this->lastInterval_y_mutex);
+    std::thread::id id = std::this_thread::get_id();
+    auto ix = this->lastInterval_x_by_thread.find(id);
+    auto iy = this->lastInterval_y_by_thread.find(id);
+    if ( ix == this->lastInterval_x_by_thread.end() ||
+         iy == this->lastInterval_y_by_thread.end() ) return -1;
+    return 1000*ix->second + iy->second;
+  }
+};
+
+// expose the owned spline of the wrappers
+class Probe1D : public Spline1D {
+public:
+  Probe1D( string const & n ) : Spline1D(n) {}
+  Splines::Spline const * spline() const { return this->pSpline; }
+};
+
+class Probe2D : public Spline2D {
+public:
+  Probe2D( string const & n ) : Spline2D(n) {}
+  Splines::SplineSurf const * spline() const { return this->pSpline2D; }
+};
+
+// evaluate from two more threads, each one adds its own hint
+template <typename F>
+static
+void
+in_threads( F f ) {
+  std::thread t1(f), t2(f);
+  t1.join();
+  t2.join();
+}
+
+static bool ok = true;
+
+static
+void
+check( bool cond, char const msg[] ) {
+  if ( !cond ) {
+    cout << "  FAILED: " << msg << '\n';
+    ok = false;
+  }
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.35\n\n";
+
+  integer const n = 100;
+  vector<real_type> X(n), Y(n), Y2(n);
+  for ( integer i = 0; i < n; ++i ) {
+    X[i]  = i*0.1;
+    Y[i]  = sin(X[i]);
+    Y2[i] = X[i]*X[i];
+  }
+  real_type const xa = 7.72, xb = 2.33;
+
+  cout << "TEST 35.1 move a CubicSpline\n";
+  {
+    Probe<CubicSpline> a("a");
+    a.build( X, Y );
+    real_type va = a(xa);
+    in_threads( [&a,xb]() { a(xb); } );
+    size_t  na = a.hints();
+    integer ha = a.hint();
+    check( na == 3 && ha == 77, "hints of the main and of two threads" );
+
+    Probe<CubicSpline> b( std::move(a) );
+    check( b.hints() == na && b.hint() == ha, "hints moved" );
+    check( a.hints() == 0, "moved-from hints empty" );
+    check( b(xa) == va && b.numPoints() == n, "eval after move" );
+
+    // the moved-from spline can be built again
+    a.build( X, Y2 );
+    check( abs( a(xb) - xb*xb ) < 1e-3 && a.hints() == 1, "reuse moved-from" );
+
+    // move assignment drops the hints of the target
+    Probe<CubicSpline> c("c");
+    c.build( X, Y2 );
+    c(xb);
+    c = std::move(b);
+    check( c.hints() == na && c.hint() == ha, "hints move assigned" );
+    check( b.hints() == 0, "move assigned-from hints cleared" );
+    check( c(xa) == va, "eval after move assignment" );
+    b.build( X, Y );
+    check( b(xa) == va, "reuse move assigned-from" );
+  }
+
+  cout << "TEST 35.2 move a SplineVec\n";
+  {
+    real_type const * VV[] = { &Y.front(), &Y2.front() };
+    Probe<SplineVec> a("a");
+    a.setup( 2, n, VV );
+    a.setKnotsChordLength();
+    a.CatmullRom();
+    real_type const ta = 0.83, tb = 0.21;
+    real_type va = a(ta,1);
+    in_threads( [&a,tb]() { a(tb,0); } );
+    size_t  na = a.hints();
+    integer ha = a.hint();
+    check( na == 3 && ha > 0, "hints of the main and of two threads" );
+
+    Probe<SplineVec> b( std::move(a) );
+    check( b.hints() == na && b.hint() == ha, "hints moved" );
+    check( a.hints() == 0, "moved-from hints empty" );
+    check( b(ta,1) == va, "eval after move" );
+
+    a.setup( 2, n, VV );
+    a.setKnotsChordLength();
+    a.CatmullRom();
+    check( a(ta,1) == va && a.hints() == 1, "reuse moved-from" );
+
+    Probe<SplineVec> c("c");
+    c.setup( 2, n, VV );
+    c.setKnotsCentripetal();
+    c.CatmullRom();
+    c(tb,0);
+    c = std::move(b);
+    check( c.hints() == na && c.hint() == ha, "hints move assigned" );
+    check( b.hints() == 0, "move assigned-from hints cleared" );
+    check( c(ta,1) == va, "eval after move assignment" );
+  }
+
+  cout << "TEST 35.3 move a SplineSet\n";
+  {
+    char const * headers[] = { "akima", "constant", "cubic", "quintic" };
+    Splines::SplineType1D stype[] = {
+      Splines::AKIMA_TYPE, Splines::CONSTANT_TYPE,
+      Splines::CUBIC_TYPE, Splines::QUINTIC_TYPE
+    };
+    real_type const * YY[] = { &Y.front(), &Y.front(), &Y2.front(), &Y.front() };
+    Probe<SplineSet> a("a");
+    a.build( 4, n, headers, stype, &X.front(), YY );
+    real_type va = a(xa,2);
+    in_threads( [&a,xb]() { a(xb,0); } );
+    // the splines in the arena keep the search hints, the set only
+    // holds the one of the constructing thread
+    size_t  na = a.hints();
+    integer ha = a.hint();
+    check( na == 1 && ha == 0, "hint of the constructing thread" );
+
+    Probe<SplineSet> b( std::move(a) );
+    check( b.hints() == na && b.hint() == ha, "hints moved" );
+    check( a.hints() == 0, "moved-from hints empty" );
+    check( b(xa,2) == va && b.getPosition("cubic") == 2, "eval after move" );
+
+    a.build( 4, n, headers, stype, &X.front(), YY );
+    check( a(xa,2) == va, "reuse moved-from" );
+
+    Probe<SplineSet> c("c");
+    c.build( 4, n, headers, stype, &X.front(), YY );
+    c(xb,1);
+    c = std::move(b);
+    check( c.hints() == na && c.hint() == ha, "hints move assigned" );
+    check( b.hints() == 0, "move assigned-from hints cleared" );
+    check( c(xa,2) == va && c.numSplines() == 4, "eval after move assignment" );
+  }
+
+  cout << "TEST 35.4 move a BiCubicSpline\n";
+  {
+    integer const nx = 30, ny = 20;
+    vector<real_type> SX(nx), SY(ny), SZ(nx*ny);
+    for ( integer i = 0; i < nx; ++i ) SX[i] = i*0.1;
+    for ( integer j = 0; j < ny; ++j ) SY[j] = j*0.15;
+    for ( integer i = 0; i < nx; ++i )
+      for ( integer j = 0; j < ny; ++j )
+        SZ[i*ny+j] = sin(SX[i])*cos(SY[j]);
+
+    SurfProbe<BiCubicSpline> a("a");
+    a.build( SX, SY, SZ );
+    real_type va = a(2.12,1.91);
+    in_threads( [&a]() { a(0.55,0.4); } );
+    size_t  na = a.hints();
+    integer ha = a.hint();
+    check( na == 6 && ha == 21012, "hints of the main and of two threads" );
+
+    SurfProbe<BiCubicSpline> b( std::move(a) );
+    check( b.hints() == na && b.hint() == ha, "hints moved" );
+    check( a.hints() == 0, "moved-from hints empty" );
+    check( b(2.12,1.91) == va, "eval after move" );
+
+    a.build( SX, SY, SZ );
+    check( a(2.12,1.91) == va && a.hints() == 2, "reuse moved-from" );
+
+    SurfProbe<BiCubicSpline> c("c");
+    c.build( SX, SY, SZ );
+    c(0.55,0.4);
+    c = std::move(b);
+    check( c.hints() == na && c.hint() == ha, "hints move assigned" );
+    check( b.hints() == 0, "move assigned-from hints cleared" );
+    check( c(2.12,1.91) == va, "eval after move assignment" );
+  }
+
+  cout << "TEST 35.5 move the Spline1D and Spline2D wrappers\n";
+  {
+    Probe1D a("a");
+    a.build( Splines::QUINTIC_TYPE, X, Y );
+    real_type va = a(xa);
+    Splines::Spline const * pa = a.spline();
+
+    Probe1D b( std::move(a) );
+    check( b.spline() == pa && a.spline() == nullptr, "spline moved" );
+    check( b(xa) == va, "eval after move" );
+
+    a.build( Splines::CUBIC_TYPE, X, Y2 );
+    check( abs( a(xb) - xb*xb ) < 1e-3, "reuse moved-from" );
+
+    Probe1D c("c");
+    c.build( Splines::LINEAR_TYPE, X, Y );
+    c = std::move(b);
+    check( c.spline() == pa && b.spline() == nullptr, "spline move assigned" );
+    check( c(xa) == va, "eval after move assignment" );
+
+    vector<real_type> SZ(n*n);
+    for ( integer i = 0; i < n; ++i )
+      for ( integer j = 0; j < n; ++j )
+        SZ[i*n+j] = Y[i]*Y2[j];
+
+    Probe2D s("s");
+    s.build( Splines::BIQUINTIC_TYPE, X, X, SZ );
+    real_type vs = s(xa,xb);
+    Splines::SplineSurf const * ps = s.spline();
+
+    Probe2D t( std::move(s) );
+    check( t.spline() == ps && s.spline() == nullptr, "surface moved" );
+    check( t(xa,xb) == vs, "eval after move" );
+
+    s.build( Splines::BICUBIC_TYPE, X, X, SZ );
+    check( abs( s(xa,xb) - vs ) < 1e-3, "reuse moved-from" );
+
+    Probe2D u("u");
+    u.build( Splines::BILINEAR_TYPE, X, X, SZ );
+    u = std::move(t);
+    check( u.spline() == ps && t.spline() == nullptr, "surface move assigned" );
+    check( u(xa,xb) == vs, "eval after move assignment" );
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}
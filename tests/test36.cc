@@ -0,0 +1,212 @@
+/*--------------------------------------------------------------------------*\
+ |                                                                          |
+ |  Copyright (C) 2016                                                      |
+ |                                                                          |
+ |         , __                 , __                                        |
+ |        /|/  \               /|/  \                                       |
+ |         | __/ _   ,_         | __/ _   ,_                                | 
+ |         |   \|/  /  |  |   | |   \|/  /  |  |   |                        |
+ |         |(__/|__/   |_/ \_/|/|(__/|__/   |_/ \_/|/                       |
+ |                           /|                   /|                        |
+ |                           \|                   \|                        |
+ |                                                                          |
+ |      Enrico Bertolazzi                                                   |
+ |      Dipartimento di Ingegneria Industriale                              |
+ |      Universita` degli Studi di Trento                                   |
+ |      email: enrico.bertolazzi@unitn.it                                   |
+ |                                                                          |
+\*--------------------------------------------------------------------------*/
+
+#include "Splines.hh"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+using namespace SplinesLoad;
+using namespace std;
+using Splines::real_type;
+using Splines::integer;
+using Splines::SplineType1D;
+
+static
+real_type
+fun( integer k, real_type x )
+{ return sin((k+1)*0.3*x)+k; }
+
+static
+real_type
+fun_D( integer k, real_type x )
+{ return (k+1)*0.3*cos((k+1)*0.3*x); }
+
+// the same spline built alone, with its own memory
+static
+unique_ptr<Splines::Spline>
+reference(
+  SplineType1D    tp,
+  integer         n,
+  real_type const X[],
+  real_type const Y[],
+  real_type const Yp[]
+) {
+  unique_ptr<Splines::Spline> S;
+  switch ( tp ) {
+  case Splines::CONSTANT_TYPE: S.reset( new Splines::ConstantSpline() ); break;
+  case Splines::LINEAR_TYPE:   S.reset( new Splines::LinearSpline()   ); break;
+  case Splines::CUBIC_TYPE:    S.reset( new Splines::CubicSpline()    ); break;
+  case Splines::AKIMA_TYPE:    S.reset( new Splines::AkimaSpline()    ); break;
+  case Splines::BESSEL_TYPE:   S.reset( new Splines::BesselSpline()   ); break;
+  case Splines::PCHIP_TYPE:    S.reset( new Splines::PchipSpline()    ); break;
+  case Splines::QUINTIC_TYPE:  S.reset( new Splines::QuinticSpline()  ); break;
+  case Splines::HERMITE_TYPE:
+    {
+      Splines::HermiteSpline * H = new Splines::HermiteSpline();
+      S.reset( H );
+      H->build( X, Y, Yp, n );
+      return S;
+    }
+  default:
+    return S;
+  }
+  S->build( X, Y, n );
+  return S;
+}
+
+// build `ss` with the types `stype` and compare every spline with the
+// one built alone
+static
+bool
+build_and_check(
+  SplineSet &        ss,
+  integer            nspl,
+  integer            npts,
+  SplineType1D const stype[]
+) {
+  vector<real_type>          X(npts);
+  vector<vector<real_type> > Y(nspl), Yp(nspl);
+  vector<real_type const *>  pY(nspl), pYp(nspl);
+  vector<string>             names(nspl);
+  vector<char const *>       headers(nspl);
+  for ( integer i = 0; i < npts; ++i ) X[i] = i*(10.0/(npts-1));
+  for ( integer k = 0; k < nspl; ++k ) {
+    Y[k].resize(npts);
+    Yp[k].resize(npts);
+    for ( integer i = 0; i < npts; ++i ) {
+      Y[k][i]  = fun( k, X[i] );
+      Yp[k][i] = fun_D( k, X[i] );
+    }
+    pY[k]      = &Y[k].front();
+    pYp[k]     = &Yp[k].front();
+    names[k]   = "s" + to_string(k);
+    headers[k] = names[k].c_str();
+  }
+  ss.build( nspl, npts, &headers.front(), stype, &X.front(), &pY.front(), &pYp.front() );
+
+  bool ok = ss.numSplines() == nspl && ss.numPoints() == npts;
+  real_type err = 0;
+  for ( integer k = 0; k < nspl; ++k ) {
+    Splines::Spline const * S = ss.getSpline(k);
+    ok = ok && S->type() == stype[k] && ss.getPosition(headers[k]) == k;
+    ok = ok && reinterpret_cast<uintptr_t>(S) % alignof(Splines::Spline) == 0;
+    unique_ptr<Splines::Spline> R = reference( stype[k], npts, &X.front(), pY[k], pYp[k] );
+    for ( integer i = 0; i <= 300; ++i ) {
+      real_type x = X.front() + (X.back()-X.front())*i/300.0;
+      err = max( err, abs( ss(x,k)   - (*R)(x) ) );
+      err = max( err, abs( ss.D(x,k) - R->D(x) ) );
+    }
+  }
+  cout << "  " << nspl << " splines, " << npts << " points, max error " << err << '\n';
+  return ok && err <= 1e-12;
+}
+
+int
+main() {
+
+  cout << "\n\nTEST N.36\n\n";
+
+  bool ok = true;
+
+  SplineType1D const mix1[] = {
+    Splines::CONSTANT_TYPE, Splines::QUINTIC_TYPE, Splines::LINEAR_TYPE,
+    Splines::HERMITE_TYPE,  Splines::CUBIC_TYPE,   Splines::AKIMA_TYPE,
+    Splines::BESSEL_TYPE,   Splines::PCHIP_TYPE
+  };
+  SplineType1D const mix2[] = {
+    Splines::QUINTIC_TYPE, Splines::QUINTIC_TYPE, Splines::CONSTANT_TYPE
+  };
+  SplineType1D const mix3[] = {
+    Splines::LINEAR_TYPE,  Splines::PCHIP_TYPE,  Splines::HERMITE_TYPE,
+    Splines::CONSTANT_TYPE, Splines::CUBIC_TYPE, Splines::QUINTIC_TYPE,
+    Splines::AKIMA_TYPE,   Splines::LINEAR_TYPE, Splines::BESSEL_TYPE,
+    Splines::QUINTIC_TYPE, Splines::CONSTANT_TYPE
+  };
+
+  cout << "TEST 36.1 one arena for every spline type\n";
+  {
+    SplineSet ss("set");
+    ok = build_and_check( ss, 8, 40, mix1 ) && ok;
+  }
+
+  cout << "TEST 36.2 rebuild in the same set, smaller and larger arena\n";
+  {
+    SplineSet ss("set");
+    ok = build_and_check( ss, 8, 40, mix1 ) && ok;
+    ok = build_and_check( ss, 3, 7, mix2 ) && ok;
+    ok = build_and_check( ss, 11, 120, mix3 ) && ok;
+    ok = build_and_check( ss, 8, 40, mix1 ) && ok;
+  }
+
+  cout << "TEST 36.3 a failed build leaves a set that can be rebuilt\n";
+  {
+    SplineSet ss("set");
+    ok = build_and_check( ss, 8, 40, mix1 ) && ok;
+    // hermite without derivatives after a few splines already placed
+    real_type X[] = { 0, 1, 2, 3 }, Y[] = { 0, 1, 0, 1 };
+    real_type const * YY[] = { Y, Y, Y };
+    char const * headers[] = { "a", "b", "c" };
+    SplineType1D const stype[] = {
+      Splines::CUBIC_TYPE, Splines::QUINTIC_TYPE, Splines::HERMITE_TYPE
+    };
+    try {
+      ss.build( 3, 4, headers, stype, X, YY );
+      cout << "  hermite without derivatives must fail\n";
+      ok = false;
+    }
+    catch ( exception const & ) {
+      cout << "  hermite without derivatives refused, OK\n";
+    }
+    ok = build_and_check( ss, 11, 120, mix3 ) && ok;
+
+    // destroyed right after the failure
+    SplineSet ss2("set2");
+    try {
+      ss2.build( 3, 4, headers, stype, X, YY );
+      ok = false;
+    }
+    catch ( exception const & ) {
+    }
+  }
+
+  cout << "TEST 36.4 sets moved around by a growing vector\n";
+  {
+    vector<SplineSet> sets;
+    vector<real_type> vals;
+    for ( integer i = 0; i < 9; ++i ) {
+      sets.emplace_back( "set" + to_string(i) );
+      ok = build_and_check( sets.back(), 3, 10+i, mix2 ) && ok;
+      vals.push_back( sets.back()(5.1,1) );
+    }
+    real_type err = 0;
+    for ( integer i = 0; i < 9; ++i )
+      err = max( err, abs( sets[i](5.1,1) - vals[i] ) );
+    cout << "  error after the moves " << err << '\n';
+    ok = ok && err == 0;
+  }
+
+  if ( !ok ) return 1;
+  cout << "ALL DONE!\n\n\n\n";
+  return 0;
+}